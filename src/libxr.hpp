@@ -2,10 +2,13 @@
 
 #include "app_framework.hpp"
 #include "async.hpp"
+#include "blocking_queue.hpp"
 #include "database.hpp"
 #include "double_buffer.hpp"
 #include "event.hpp"
+#include "event_count.hpp"
 #include "flag.hpp"
+#include "flat_hash_map.hpp"
 #include "inertia.hpp"
 #include "kinematic.hpp"
 #include "latest_snapshot.hpp"
@@ -33,6 +36,7 @@
 #include "ramfs.hpp"
 #include "semaphore.hpp"
 #include "stack.hpp"
+#include "task_scheduler.hpp"
 #include "terminal.hpp"
 #include "thread.hpp"
 #include "timebase.hpp"
@@ -0,0 +1,142 @@
+#include "batch.hpp"
+
+#include <limits>
+#include <utility>
+
+#include "libxr_mem.hpp"
+
+using namespace LibXR;
+
+void Topic::PackedBatchEntryHeader::SetDataLen(uint16_t len)
+{
+  data_len_raw[0] = static_cast<uint8_t>(len);
+  data_len_raw[1] = static_cast<uint8_t>(len >> 8);
+}
+
+uint16_t Topic::PackedBatchEntryHeader::GetDataLen() const
+{
+  return static_cast<uint16_t>(static_cast<uint16_t>(data_len_raw[0]) |
+                               static_cast<uint16_t>(data_len_raw[1]) << 8);
+}
+
+void Topic::PackedBatchEntryHeader::SetTimestampDelta(int32_t delta)
+{
+  const auto value = static_cast<uint32_t>(delta);
+  for (size_t i = 0; i < sizeof(timestamp_delta_raw); i++)
+  {
+    timestamp_delta_raw[i] = static_cast<uint8_t>(value >> (i * 8U));
+  }
+}
+
+int32_t Topic::PackedBatchEntryHeader::GetTimestampDelta() const
+{
+  uint32_t value = 0;
+  for (size_t i = 0; i < sizeof(timestamp_delta_raw); i++)
+  {
+    value |= static_cast<uint32_t>(timestamp_delta_raw[i]) << (i * 8U);
+  }
+  return static_cast<int32_t>(value);
+}
+
+Topic::BatchPacker::BatchPacker(size_t buffer_length, FlushCallback flush,
+                                size_t flush_size, uint32_t flush_deadline_us)
+    : buffer_(new uint8_t[buffer_length], buffer_length),
+      flush_(std::move(flush)),
+      flush_size_(flush_size == 0 || flush_size > buffer_length ? buffer_length
+                                                                : flush_size),
+      flush_deadline_us_(flush_deadline_us)
+{
+  ASSERT(buffer_length > PackBaseSize(PACKET_VERSION_BATCH) + ENTRY_HEADER_SIZE);
+}
+
+Topic::BatchPacker::~BatchPacker() { delete[] static_cast<uint8_t*>(buffer_.addr_); }
+
+ErrorCode Topic::BatchPacker::AddRaw(TopicHandle topic, ConstRawData data,
+                                     MicrosecondTimestamp timestamp, bool in_isr)
+{
+  ASSERT(topic != nullptr);
+  ASSERT(data.addr_ != nullptr);
+
+  const size_t frame_overhead = PackBaseSize(PACKET_VERSION_BATCH);
+  const size_t entry_size = ENTRY_HEADER_SIZE + data.size_;
+  if (data.size_ != topic->data_.payload_size ||
+      data.size_ > std::numeric_limits<uint16_t>::max() ||
+      frame_overhead + entry_size > buffer_.size_)
+  {
+    return ErrorCode::SIZE_ERR;
+  }
+
+  int64_t delta = 0;
+  if (entry_count_ > 0)
+  {
+    delta = static_cast<int64_t>(static_cast<uint64_t>(timestamp)) -
+            static_cast<int64_t>(static_cast<uint64_t>(base_timestamp_));
+    if (frame_overhead + body_size_ + entry_size > buffer_.size_ ||
+        delta < std::numeric_limits<int32_t>::min() ||
+        delta > std::numeric_limits<int32_t>::max())
+    {
+      (void)Flush(in_isr);
+      delta = 0;
+    }
+  }
+
+  if (entry_count_ == 0)
+  {
+    base_timestamp_ = timestamp;
+    opened_at_ = NowTimestamp();
+  }
+
+  auto* entry = static_cast<uint8_t*>(buffer_.addr_) + sizeof(PackedDataHeader) +
+                body_size_;
+  auto* header = reinterpret_cast<PackedBatchEntryHeader*>(entry);
+  header->topic_name_crc32 = topic->data_.crc32;
+  header->SetDataLen(static_cast<uint16_t>(data.size_));
+  header->SetTimestampDelta(static_cast<int32_t>(delta));
+  LibXR::Memory::FastCopy(entry + ENTRY_HEADER_SIZE, data.addr_, data.size_);
+
+  body_size_ += entry_size;
+  entry_count_++;
+
+  if (frame_overhead + body_size_ >= flush_size_)
+  {
+    (void)Flush(in_isr);
+  }
+  else
+  {
+    (void)Poll(in_isr);
+  }
+  return ErrorCode::OK;
+}
+
+ErrorCode Topic::BatchPacker::Flush(bool in_isr)
+{
+  if (entry_count_ == 0)
+  {
+    return ErrorCode::EMPTY;
+  }
+
+  SealPacket(0, buffer_, base_timestamp_, body_size_, PACKET_VERSION_BATCH);
+  const ConstRawData frame(buffer_.addr_,
+                           body_size_ + PackBaseSize(PACKET_VERSION_BATCH));
+
+  body_size_ = 0;
+  entry_count_ = 0;
+  flush_.Run(in_isr, frame);
+  return ErrorCode::OK;
+}
+
+ErrorCode Topic::BatchPacker::Poll(bool in_isr)
+{
+  if (entry_count_ == 0 || flush_deadline_us_ == 0)
+  {
+    return ErrorCode::EMPTY;
+  }
+
+  const uint64_t waited = static_cast<uint64_t>(NowTimestamp()) -
+                          static_cast<uint64_t>(opened_at_);
+  if (waited < flush_deadline_us_)
+  {
+    return ErrorCode::EMPTY;
+  }
+  return Flush(in_isr);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../packet/packet.hpp"
+#include "../topic.hpp"
+#include "libxr_cb.hpp"
+
+namespace LibXR
+{
+#ifndef __DOXYGEN__
+LIBXR_PACKED_BEGIN
+/**
+ * @struct Topic::PackedBatchEntryHeader
+ * @brief 批量帧内单条消息的 10 字节紧凑头 / Compact 10-byte header of one message
+ *        inside a batch frame
+ *
+ * @note 批量帧沿用 16 字节 `PackedDataHeader`，版本字段为 `PACKET_VERSION_BATCH`，
+ *       `topic_name_crc32` 保留为 0，时间戳是帧内第一条消息的时间戳；数据区是若干
+ *       `entry_header(10) + payload` 紧挨着排列，尾部 CRC32C 覆盖整帧。
+ *       条目头布局固定为：`topic_crc32(4) + data_len(2) + timestamp_delta_us(4)`，
+ *       时间戳差值为相对帧时间戳的有符号小端 32 位微秒数。
+ *       A batch frame keeps the 16-byte `PackedDataHeader` with
+ *       `PACKET_VERSION_BATCH` in the version field, `topic_name_crc32` reserved as 0
+ *       and the timestamp of the first message in the frame; the data area is a run of
+ *       back-to-back `entry_header(10) + payload` records, and the trailing CRC32C
+ *       covers the whole frame.
+ *       The entry header layout is fixed as:
+ *       `topic_crc32(4) + data_len(2) + timestamp_delta_us(4)`, where the delta is a
+ *       signed little-endian 32-bit microsecond offset from the frame timestamp.
+ */
+struct Topic::PackedBatchEntryHeader
+{
+  uint32_t topic_name_crc32;  ///< 目标 topic 名称 CRC32 键。CRC32 key of the target topic
+                              ///< name.
+  uint8_t data_len_raw[2];    ///< 小端 16 位 payload 长度。Little-endian 16-bit payload
+                              ///< length.
+  uint8_t timestamp_delta_raw[4];  ///< 小端有符号 32 位时间戳差值。Little-endian signed
+                                   ///< 32-bit timestamp delta.
+
+  /**
+   * @brief 设置 payload 长度 / Set the payload length
+   * @param len payload 长度 / Payload length
+   */
+  void SetDataLen(uint16_t len);
+
+  /**
+   * @brief 获取 payload 长度 / Get the payload length
+   * @return payload 长度 / Returns the payload length
+   */
+  uint16_t GetDataLen() const;
+
+  /**
+   * @brief 设置相对帧时间戳的差值 / Set the delta from the frame timestamp
+   * @param delta 微秒差值 / Delta in microseconds
+   */
+  void SetTimestampDelta(int32_t delta);
+
+  /**
+   * @brief 获取相对帧时间戳的差值 / Get the delta from the frame timestamp
+   * @return 微秒差值 / Returns the delta in microseconds
+   */
+  int32_t GetTimestampDelta() const;
+};
+
+static_assert(sizeof(Topic::PackedBatchEntryHeader) == 10);
+LIBXR_PACKED_END
+#endif
+
+/**
+ * @class Topic::BatchPacker
+ * @brief 把多条消息（可来自不同 topic）攒进一个批量帧的打包器 / Packer accumulating
+ *        several messages, possibly from different topics, into one batch frame
+ *
+ * 每条消息只多占 10 字节条目头，整帧共用一个 16 字节头和一个 CRC32C，适合高频小
+ * payload 的链路。帧满、达到刷出阈值或超过刷出期限时，封好的整帧交给刷出回调。
+ * Each message only costs a 10-byte entry header, and the whole frame shares one
+ * 16-byte header and one CRC32C, which suits links carrying small high-rate payloads.
+ * When the frame is full, reaches the flush threshold, or passes the flush deadline,
+ * the sealed frame is handed to the flush callback.
+ *
+ * @note 刷出回调拿到的字节视图指向打包器内部缓冲区，只在回调期间有效。
+ *       The byte view handed to the flush callback points into the packer's internal
+ *       buffer and is only valid during the callback.
+ * @note 打包器本身不加锁，同一时刻只能由一个上下文调用。
+ *       The packer takes no lock and must be driven from one context at a time.
+ */
+class Topic::BatchPacker
+{
+ public:
+  /**
+   * @typedef FlushCallback
+   * @brief 接收一整个已封好批量帧的回调 / Callback receiving one sealed batch frame
+   */
+  using FlushCallback = LibXR::Callback<ConstRawData>;
+
+  static constexpr size_t ENTRY_HEADER_SIZE =
+      sizeof(PackedBatchEntryHeader);  ///< 每条消息的条目头开销。Per-message entry
+                                       ///< header overhead.
+
+  /**
+   * @brief 构造打包器并分配帧缓冲区 / Construct the packer and allocate its frame
+   *        buffer
+   * @param buffer_length 帧缓冲区大小，即单帧最大字节数 / Frame buffer size, i.e. the
+   *        largest frame in bytes
+   * @param flush 接收已封好帧的回调 / Callback receiving sealed frames
+   * @param flush_size 帧达到该字节数即刷出，0 表示只在放不下时刷出 / Flush once the
+   *        frame reaches this many bytes; 0 flushes only when the next message no
+   *        longer fits
+   * @param flush_deadline_us 第一条消息入帧后最多等待的微秒数，0 表示不按期限刷出 /
+   *        Longest wait in microseconds after the first message enters the frame; 0
+   *        disables deadline flushing
+   *
+   * @note 接收端 `Server` 的缓冲区需不小于 `buffer_length`，否则整帧会被丢弃。
+   *       The receiving `Server` needs a buffer of at least `buffer_length`, otherwise
+   *       whole frames get dropped.
+   */
+  BatchPacker(size_t buffer_length, FlushCallback flush, size_t flush_size = 0,
+              uint32_t flush_deadline_us = 0);
+
+  ~BatchPacker();
+
+  BatchPacker(const BatchPacker&) = delete;
+  BatchPacker& operator=(const BatchPacker&) = delete;
+
+  /**
+   * @brief 把一个精确类型消息加入当前帧 / Add one exact-typed message to the current
+   *        frame
+   * @tparam Data payload 类型 / Payload type
+   * @param topic 消息所属 topic / Topic the message belongs to
+   * @param data 待加入 payload / Payload to add
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param in_isr 触发刷出时是否位于 ISR / Whether a triggered flush runs in ISR
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode Add(TopicHandle topic, const Data& data,
+                MicrosecondTimestamp timestamp = NowTimestamp(), bool in_isr = false)
+  {
+    CheckTopicPayload<Data>();
+    ASSERT(topic != nullptr);
+    ASSERT(topic->data_.payload_type_id == TypeID::GetID<Data>());
+    return AddRaw(topic, ConstRawData(data), timestamp, in_isr);
+  }
+
+  /**
+   * @brief 把一段 raw payload 加入当前帧 / Add one raw payload to the current frame
+   * @param topic 消息所属 topic / Topic the message belongs to
+   * @param data payload 字节，长度须等于 topic 固定大小 / Payload bytes whose size must
+   *        match the topic's fixed size
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param in_isr 触发刷出时是否位于 ISR / Whether a triggered flush runs in ISR
+   * @return 成功返回 `OK`；长度不符或单条消息放不进空帧返回 `SIZE_ERR` / Returns `OK`
+   *         on success, `SIZE_ERR` when the size mismatches or one message cannot fit
+   *         in an empty frame
+   *
+   * @note 放不下新消息或时间戳差值超出 32 位时，先刷出当前帧再写入。
+   *       When the new message does not fit or its timestamp delta overflows 32 bits,
+   *       the current frame is flushed first.
+   */
+  ErrorCode AddRaw(TopicHandle topic, ConstRawData data, MicrosecondTimestamp timestamp,
+                   bool in_isr = false);
+
+  /**
+   * @brief 封好当前帧并交给刷出回调 / Seal the current frame and hand it to the flush
+   *        callback
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 成功返回 `OK`，当前帧为空返回 `EMPTY` / Returns `OK`, or `EMPTY` when the
+   *         current frame holds no message
+   */
+  ErrorCode Flush(bool in_isr = false);
+
+  /**
+   * @brief 检查刷出期限，到期则刷出 / Check the flush deadline and flush when it has
+   *        passed
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 本次刷出返回 `OK`，未到期或为空返回 `EMPTY` / Returns `OK` when it flushed,
+   *         `EMPTY` when nothing was due
+   */
+  ErrorCode Poll(bool in_isr = false);
+
+  /**
+   * @brief 当前帧里的消息条数 / Number of messages in the current frame
+   * @return 消息条数 / Message count
+   */
+  size_t EntryCount() const { return entry_count_; }
+
+  /**
+   * @brief 当前帧封好后的字节数 / Byte size of the current frame once sealed
+   * @return 帧字节数，空帧为 0 / Frame size in bytes, 0 for an empty frame
+   */
+  size_t Size() const
+  {
+    return entry_count_ == 0 ? 0 : body_size_ + PackBaseSize(PACKET_VERSION_BATCH);
+  }
+
+ private:
+  RawData buffer_;          ///< 帧缓冲区。Frame buffer.
+  FlushCallback flush_;     ///< 刷出回调。Flush callback.
+  size_t flush_size_;       ///< 刷出阈值字节数。Flush threshold in bytes.
+  uint32_t flush_deadline_us_;  ///< 刷出期限微秒数。Flush deadline in microseconds.
+  size_t body_size_ = 0;    ///< 已写入的数据区字节数。Bytes written into the data area.
+  size_t entry_count_ = 0;  ///< 当前帧消息条数。Messages in the current frame.
+  MicrosecondTimestamp base_timestamp_;  ///< 帧时间戳。Frame timestamp.
+  MicrosecondTimestamp opened_at_;  ///< 第一条消息入帧的时刻。Time the first message
+                                    ///< entered the frame.
+};
+}  // namespace LibXR
@@ -0,0 +1,138 @@
+#include "executor.hpp"
+
+#include <cstring>
+
+#include "libxr_mem.hpp"
+
+using namespace LibXR;
+
+Topic::CallbackExecutor::CallbackExecutor(uint32_t worker_num,
+                                          uint32_t max_callbacks_per_worker,
+                                          size_t stack_depth, Thread::Priority priority)
+    : worker_num_(worker_num), max_callbacks_per_worker_(max_callbacks_per_worker)
+{
+  ASSERT(worker_num > 0);
+  ASSERT(max_callbacks_per_worker > 0);
+
+  workers_ = new Worker*[worker_num_];
+  for (uint32_t i = 0; i < worker_num_; ++i)
+  {
+    workers_[i] = new Worker(this, max_callbacks_per_worker_);
+    workers_[i]->thread.Create<Worker*>(workers_[i], WorkerMain, "topic_cb_exec",
+                                        stack_depth, priority);
+  }
+}
+
+ErrorCode Topic::CallbackExecutor::AssignWorker(uint32_t& index)
+{
+  // 就绪队列容量等于绑定上限，只在上限内占位才能保证每个回调块总能入队。
+  // 多个 topic 可能并发注册，所以用 CAS 占位。
+  // The ready queue holds exactly the binding limit, so a block may only bind below
+  // it to be guaranteed a ready slot. Several topics may register concurrently, hence
+  // the CAS.
+  const uint32_t start = next_worker_.fetch_add(1, std::memory_order_relaxed);
+  for (uint32_t offset = 0; offset < worker_num_; ++offset)
+  {
+    const uint32_t candidate = (start + offset) % worker_num_;
+    auto& bound = workers_[candidate]->bound;
+    uint32_t current = bound.load(std::memory_order_relaxed);
+    while (current < max_callbacks_per_worker_)
+    {
+      if (bound.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+      {
+        index = candidate;
+        return ErrorCode::OK;
+      }
+    }
+  }
+  return ErrorCode::FULL;
+}
+
+void Topic::CallbackExecutor::Submit(DeferredCallbackBlock& block,
+                                     MicrosecondTimestamp timestamp, void* payload_addr,
+                                     bool from_callback, bool in_isr)
+{
+  auto ans = block.queue->PushBytesWithWriter(
+      1,
+      [&](void* buffer, size_t)
+      {
+        auto bytes = static_cast<uint8_t*>(buffer);
+        std::memcpy(bytes, &timestamp, sizeof(timestamp));
+        LibXR::Memory::FastCopy(bytes + block.payload_offset, payload_addr,
+                                block.payload_size);
+        return ErrorCode::OK;
+      });
+
+  if (ans != ErrorCode::OK)
+  {
+    block.dropped.fetch_add(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (block.pending.fetch_add(1, std::memory_order_acq_rel) != 0)
+  {
+    return;
+  }
+
+  auto& worker = *workers_[block.worker_index];
+  auto push_ans = worker.ready.Push(&block);
+  ASSERT(push_ans == ErrorCode::OK);
+  UNUSED(push_ans);
+
+  if (from_callback)
+  {
+    worker.sem.PostFromCallback(in_isr);
+  }
+  else
+  {
+    worker.sem.Post();
+  }
+}
+
+void Topic::CallbackExecutor::Drain(DeferredCallbackBlock& block)
+{
+  uint32_t todo = block.pending.load(std::memory_order_acquire);
+  while (todo != 0)
+  {
+    for (uint32_t i = 0; i < todo; ++i)
+    {
+      auto ans = block.queue->PopBytesWithReader(
+          1,
+          [&](const void* buffer, size_t)
+          {
+            auto bytes = static_cast<uint8_t*>(const_cast<void*>(buffer));
+            MicrosecondTimestamp timestamp;
+            std::memcpy(&timestamp, bytes, sizeof(timestamp));
+            block.cb.Run(false, timestamp, bytes + block.payload_offset,
+                         block.payload_size);
+            return ErrorCode::OK;
+          });
+      ASSERT(ans == ErrorCode::OK);
+      UNUSED(ans);
+    }
+    run_num_.fetch_add(todo, std::memory_order_relaxed);
+
+    // 计数归零前新到的消息由本轮继续执行，归零后的下一条会重新投递本块。
+    // Messages arriving before the count reaches zero are run by this loop; the first
+    // one after that hands the block to the worker again.
+    todo = block.pending.fetch_sub(todo, std::memory_order_acq_rel) - todo;
+  }
+}
+
+void Topic::CallbackExecutor::WorkerMain(Worker* worker)
+{
+  while (true)
+  {
+    if (worker->sem.Wait() != ErrorCode::OK)
+    {
+      continue;
+    }
+
+    DeferredCallbackBlock* block = nullptr;
+    while (worker->ready.Pop(block) == ErrorCode::OK)
+    {
+      worker->owner->Drain(*block);
+    }
+  }
+}
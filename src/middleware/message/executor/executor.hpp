@@ -0,0 +1,260 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "../subscriber/callback.hpp"
+#include "../topic.hpp"
+#include "mpmc_queue.hpp"
+#include "semaphore.hpp"
+#include "spsc_queue_base.hpp"
+#include "thread.hpp"
+
+namespace LibXR
+{
+/**
+ * @struct Topic::DeferredCallbackBlock
+ * @brief 绑定到执行器的回调订阅块 / Callback subscriber block bound to an executor
+ *
+ * 发布路径只把时间戳和 payload 拷进本块私有的 SPSC 队列；`pending` 从 0 变 1 时把本块
+ * 投递给所属工作线程一次，工作线程清空队列后再把计数减回去，因此每个块同一时刻最多在
+ * 就绪队列里出现一次，回调也总在同一工作线程上按序执行。
+ * The publish path only copies the timestamp and payload into the private SPSC queue
+ * of this block; when `pending` goes from 0 to 1 the block is handed to its worker
+ * once, and the worker subtracts what it drained afterwards. Each block therefore sits
+ * in a ready queue at most once, and its callbacks always run in order on one worker.
+ *
+ * @note 队列对象单独分配：`SPSCQueueBase` 按缓存行对齐，直接内嵌会改变链表节点里数据的
+ *       偏移，订阅链表按 `SuberBlock` 遍历时就对不上 / The queue is allocated separately:
+ *       `SPSCQueueBase` is cache-line aligned, and embedding it would move the data
+ *       offset inside the list node so walking the list as `SuberBlock` would no longer
+ *       match
+ */
+struct Topic::DeferredCallbackBlock : public Topic::SuberBlock
+{
+  /**
+   * @brief 构造一个延迟回调订阅块 / Construct one deferred callback subscriber block
+   * @param callback 要挂接的回调句柄 / Callback handle to attach
+   * @param topic_payload_size 当前 topic 的固定 payload 字节数 / Fixed payload size of
+   *        the topic
+   * @param topic_payload_alignment 当前 topic payload 对齐 / Payload alignment of the
+   *        topic
+   * @param queue_depth 待执行消息的队列深度 / Depth of the pending-message queue
+   * @param owner 所属执行器 / Owning executor
+   * @param worker 绑定的工作线程下标 / Index of the bound worker
+   */
+  DeferredCallbackBlock(Callback& callback, size_t topic_payload_size,
+                        size_t topic_payload_alignment, size_t queue_depth,
+                        CallbackExecutor* owner, uint32_t worker)
+      : cb(callback),
+        payload_size(topic_payload_size),
+        payload_offset(AlignUp(sizeof(MicrosecondTimestamp), topic_payload_alignment)),
+        queue(new SPSCQueueBase(payload_offset + topic_payload_size,
+                                topic_payload_alignment > alignof(MicrosecondTimestamp)
+                                    ? topic_payload_alignment
+                                    : alignof(MicrosecondTimestamp),
+                                queue_depth)),
+        executor(owner),
+        worker_index(worker)
+  {
+    type = SuberType::DEFERRED_CALLBACK;
+  }
+
+  /**
+   * @brief 按对齐向上取整 / Round up to an alignment
+   * @param size 原始字节数 / Raw byte count
+   * @param align 对齐要求 / Alignment
+   * @return 对齐后的字节数 / Aligned byte count
+   */
+  static size_t AlignUp(size_t size, size_t align)
+  {
+    return (size + align - 1) / align * align;
+  }
+
+  Callback cb;                         ///< 订阅的回调句柄。Subscribed callback handle.
+  size_t payload_size = 0;             ///< topic 固定 payload 字节数。Fixed payload size.
+  size_t payload_offset = 0;           ///< 元素内 payload 偏移。Payload offset in element.
+  SPSCQueueBase* queue;                ///< 待执行消息队列。Pending-message queue.
+  std::atomic<uint32_t> pending = 0;   ///< 已入队未执行的条数。Queued, not yet run.
+  std::atomic<uint64_t> dropped = 0;   ///< 队列满丢弃的条数。Dropped on a full queue.
+  CallbackExecutor* executor;          ///< 所属执行器。Owning executor.
+  uint32_t worker_index;               ///< 绑定的工作线程。Bound worker index.
+};
+
+/**
+ * @class Topic::CallbackExecutor
+ * @brief 在固定工作线程上执行回调订阅者的执行器 / Executor that runs callback
+ *        subscribers on a fixed set of worker threads
+ *
+ * 通过 `Topic::RegisterCallback(cb, executor)` 绑定的回调不再占用发布线程：发布只做一次
+ * payload 拷贝和一次入队，回调在绑定的工作线程上执行。每个回调按注册顺序轮流分配到一个
+ * 工作线程，已绑满的线程会被跳过；所有线程都绑满时注册返回 `ErrorCode::FULL`。同一回调
+ * 的消息保持发布顺序且不会并发执行。
+ * Callbacks bound through `Topic::RegisterCallback(cb, executor)` no longer occupy the
+ * publishing thread: a publish does one payload copy and one enqueue, and the callback
+ * runs on its bound worker. Callbacks are assigned to workers round-robin in
+ * registration order, skipping workers that are already full; once every worker is
+ * full, registration returns `ErrorCode::FULL`. Messages of one callback keep publish
+ * order and never run concurrently.
+ *
+ * @note 包含初始化期动态内存分配并创建线程，执行器应长期存在 / Contains
+ *       initialization-time dynamic allocation and creates threads; executors are
+ *       expected to be long-lived
+ */
+class Topic::CallbackExecutor
+{
+ public:
+  /**
+   * @brief 构造执行器并启动工作线程 / Construct the executor and start its workers
+   * @param worker_num 工作线程数 / Number of worker threads
+   * @param max_callbacks_per_worker 每个工作线程可绑定的回调上限 / Maximum callbacks
+   *        bound to one worker
+   * @param stack_depth 工作线程栈大小 / Worker stack size
+   * @param priority 工作线程优先级 / Worker priority
+   */
+  CallbackExecutor(uint32_t worker_num, uint32_t max_callbacks_per_worker = 16,
+                   size_t stack_depth = 4096,
+                   Thread::Priority priority = Thread::Priority::MEDIUM);
+
+  CallbackExecutor(const CallbackExecutor&) = delete;
+  CallbackExecutor& operator=(const CallbackExecutor&) = delete;
+
+  /**
+   * @brief 获取工作线程数 / Get the number of worker threads
+   * @return 工作线程数 / Number of worker threads
+   */
+  [[nodiscard]] uint32_t WorkerNum() const { return worker_num_; }
+
+  /**
+   * @brief 获取因回调队列满而丢弃的消息总数 / Get the total messages dropped because a
+   *        callback queue was full
+   * @return 丢弃条数 / Dropped message count
+   */
+  [[nodiscard]] uint64_t GetDroppedNum() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 获取已执行的回调次数 / Get the number of callback runs completed
+   * @return 已执行次数 / Completed run count
+   */
+  [[nodiscard]] uint64_t GetRunNum() const
+  {
+    return run_num_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  friend class Topic;
+
+  /**
+   * @struct Worker
+   * @brief 单个工作线程的就绪队列与唤醒信号 / Ready queue and wake signal of one
+   *        worker
+   */
+  struct Worker
+  {
+    Worker(CallbackExecutor* executor, uint32_t capacity)
+        : owner(executor), ready(capacity)
+    {
+    }
+
+    CallbackExecutor* owner;  ///< 所属执行器。Owning executor.
+    MPMCQueue<DeferredCallbackBlock*> ready;  ///< 有待执行消息的回调。Callbacks with
+                                              ///< pending messages.
+    Semaphore sem;                    ///< 就绪队列计数信号。Ready-queue counting signal.
+    Thread thread;                    ///< 工作线程。Worker thread.
+    std::atomic<uint32_t> bound = 0;  ///< 已绑定回调数。Bound callback count.
+  };
+
+  /**
+   * @brief 为新回调选择一个尚未绑满的工作线程 / Pick a worker with spare capacity for
+   *        a new callback
+   * @param index 选中的工作线程下标 / Index of the chosen worker
+   * @return 成功返回 `ErrorCode::OK`；全部绑满返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::FULL` when every worker
+   *         is full
+   */
+  ErrorCode AssignWorker(uint32_t& index);
+
+  /**
+   * @brief 把一条发布投递给延迟回调 / Submit one publish to a deferred callback
+   * @param block 目标回调块 / Target callback block
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param payload_addr payload 地址 / Payload address
+   * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
+   *        path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   */
+  void Submit(DeferredCallbackBlock& block, MicrosecondTimestamp timestamp,
+              void* payload_addr, bool from_callback, bool in_isr);
+
+  /**
+   * @brief 执行一个回调块里当前全部待执行消息 / Run every pending message of one
+   *        callback block
+   * @param block 目标回调块 / Target callback block
+   */
+  void Drain(DeferredCallbackBlock& block);
+
+  /**
+   * @brief 工作线程入口 / Worker thread entry
+   * @param worker 工作线程状态 / Worker state
+   */
+  static void WorkerMain(Worker* worker);
+
+  Worker** workers_ = nullptr;         ///< 工作线程状态数组。Worker state array.
+  uint32_t worker_num_ = 0;            ///< 工作线程数。Worker count.
+  uint32_t max_callbacks_per_worker_;  ///< 每线程回调上限。Per-worker callback limit.
+  std::atomic<uint32_t> next_worker_ = 0;  ///< 轮转分配游标。Round-robin cursor.
+  std::atomic<uint64_t> dropped_ = 0;      ///< 丢弃总数。Total dropped messages.
+  std::atomic<uint64_t> run_num_ = 0;      ///< 已执行次数。Completed runs.
+};
+
+/**
+ * @brief 注册一个在执行器上运行的回调 / Register a callback that runs on an executor
+ * @param cb 需要注册的回调函数 / Callback function to register
+ * @param executor 执行回调的执行器 / Executor running the callback
+ * @param queue_depth 该回调可积压的消息数，超出时丢弃新消息 / Messages this callback
+ *        may queue; newer messages are dropped beyond that
+ * @return 成功返回 `ErrorCode::OK`；所有工作线程都已绑满时返回 `ErrorCode::FULL`
+ *         Returns `ErrorCode::OK` on success; `ErrorCode::FULL` when every worker is
+ *         already bound to its limit
+ *
+ * @note 包含初始化期动态内存分配，回调订阅应长期存在 / Contains initialization-time
+ * dynamic allocation; callback subscriptions are expected to be long-lived
+ * @note 回调收到的 `in_isr` 恒为 false，payload 指向执行器内部副本，只在本次调用内
+ * 有效 / The callback always receives `in_isr == false`, and the payload points to an
+ * executor-owned copy that is valid only for the current call
+ */
+inline ErrorCode Topic::RegisterCallback(Callback& cb, CallbackExecutor& executor,
+                                         size_t queue_depth)
+{
+  return AttachCallback(cb, executor, queue_depth, nullptr);
+}
+
+inline ErrorCode Topic::AttachCallback(Callback& cb, CallbackExecutor& executor,
+                                       size_t queue_depth, Filter* filter)
+{
+  if (!cb.IsRawPayloadView())
+  {
+    ASSERT(block_->data_.payload_type_id == cb.PayloadTypeID());
+  }
+  ASSERT(queue_depth > 0);
+
+  uint32_t worker = 0;
+  if (executor.AssignWorker(worker) != ErrorCode::OK)
+  {
+    return ErrorCode::FULL;
+  }
+
+  auto node = new (std::align_val_t(LibXR::CONCURRENCY_ALIGNMENT))
+      LockFreeList::Node<DeferredCallbackBlock>(
+          cb, block_->data_.payload_size, block_->data_.payload_alignment, queue_depth,
+          &executor, worker);
+  node->data_.filter.store(filter, std::memory_order_relaxed);
+  block_->data_.subers.Add(*node);
+  return ErrorCode::OK;
+}
+}  // namespace LibXR
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+
+#include "../topic.hpp"
+#include "latest_snapshot.hpp"
+
+namespace LibXR
+{
+/**
+ * @struct Topic::LatestStore
+ * @brief topic 最新值缓存的类型擦除头 / Type-erased header of one topic latest-value
+ *        cache
+ *
+ * 发布路径在持有 topic 发布锁时调用 `store` 写入最新值，因此生产端始终串行；读取端
+ * 通过 `reading` 标志串行化，读者之间冲突时直接返回而不等待。
+ * The publish path calls `store` while holding the topic publish lock, so the
+ * producer side is always serialized; readers serialize through the `reading` flag
+ * and return immediately instead of waiting when they collide.
+ */
+struct Topic::LatestStore
+{
+  void (*store)(LatestStore& latest, MicrosecondTimestamp timestamp,
+                const void* payload_addr);  ///< 写入一条最新值。Store one latest value.
+  std::atomic<bool> ready{false};    ///< 至少发布过一次。At least one publish happened.
+  std::atomic<bool> reading{false};  ///< 有读者正在拷贝。A reader is currently copying.
+};
+
+/**
+ * @struct Topic::LatestValue
+ * @brief 按精确类型持有三槽快照的最新值缓存 / Latest-value cache holding one
+ *        triple-slot snapshot of the exact payload type
+ * @tparam Data payload 类型 / Payload type
+ */
+template <typename Data>
+struct Topic::LatestValue : public LatestStore
+{
+  LatestValue() : snapshot(Message<Data>{})
+  {
+    store = [](LatestStore& latest, MicrosecondTimestamp timestamp,
+               const void* payload_addr)
+    {
+      auto& self = static_cast<LatestValue&>(latest);
+      self.snapshot.StoreWith(
+          [&](Message<Data>& slot)
+          {
+            slot.timestamp = timestamp;
+            slot.data = *static_cast<const Data*>(payload_addr);
+          });
+      self.ready.store(true, std::memory_order_release);
+    };
+  }
+
+  LatestSnapshot<Message<Data>> snapshot;  ///< 三槽最新值快照。Triple-slot snapshot.
+};
+
+template <typename Data>
+ErrorCode Topic::EnableLatest()
+{
+  CheckTopicPayload<Data>();
+
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  CheckSubscriberType<Data>(*this);
+
+  if (block_->data_.latest.load(std::memory_order_acquire) != nullptr)
+  {
+    return ErrorCode::OK;
+  }
+
+  LatestStore* expected = nullptr;
+  auto latest = new LatestValue<Data>;
+  if (!block_->data_.latest.compare_exchange_strong(expected, latest,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+  {
+    delete latest;
+  }
+  return ErrorCode::OK;
+}
+
+template <typename Data>
+ErrorCode Topic::GetLatest(Message<Data>& message)
+{
+  CheckTopicPayload<Data>();
+
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  CheckSubscriberType<Data>(*this);
+
+  auto latest = block_->data_.latest.load(std::memory_order_acquire);
+  if (latest == nullptr)
+  {
+    return ErrorCode::NOT_SUPPORT;
+  }
+
+  if (!latest->ready.load(std::memory_order_acquire))
+  {
+    return ErrorCode::EMPTY;
+  }
+
+  if (latest->reading.exchange(true, std::memory_order_acquire))
+  {
+    return ErrorCode::BUSY;
+  }
+
+  static_cast<LatestValue<Data>*>(latest)->snapshot.LoadLatest(message);
+  latest->reading.store(false, std::memory_order_release);
+  return ErrorCode::OK;
+}
+}  // namespace LibXR
@@ -0,0 +1,127 @@
+#include "loan.hpp"
+
+#include <algorithm>
+
+#include "../subscriber/async.hpp"
+
+using namespace LibXR;
+
+Topic::LoanPool::LoanPool(size_t payload_size, size_t payload_alignment,
+                          size_t slot_count)
+    : slot_count_(slot_count),
+      payload_alignment_(std::max(payload_alignment, alignof(std::max_align_t))),
+      slots_(nullptr),
+      storage_(nullptr),
+      free_slots_(std::max<size_t>(slot_count, 2))
+{
+  ASSERT(payload_size > 0);
+  ASSERT(slot_count > 0);
+  ASSERT((payload_alignment & (payload_alignment - 1)) == 0);
+
+  const size_t stride =
+      (payload_size + payload_alignment - 1) / payload_alignment * payload_alignment;
+
+  slots_ = new LoanSlot[slot_count_];
+  storage_ = static_cast<std::byte*>(
+      ::operator new[](stride * slot_count_, std::align_val_t(payload_alignment_)));
+
+  for (size_t index = 0; index < slot_count_; ++index)
+  {
+    auto slot = &slots_[index];
+    slot->ref_count.store(0, std::memory_order_relaxed);
+    slot->timestamp = MicrosecondTimestamp();
+    slot->pool = this;
+    slot->payload = storage_ + index * stride;
+    auto ans = free_slots_.Push(slot);
+    ASSERT(ans == ErrorCode::OK);
+    UNUSED(ans);
+  }
+}
+
+Topic::LoanPool::~LoanPool()
+{
+  ::operator delete[](storage_, std::align_val_t(payload_alignment_));
+  delete[] slots_;
+}
+
+Topic::LoanSlot* Topic::LoanPool::Acquire()
+{
+  LoanSlot* slot = nullptr;
+  if (free_slots_.Pop(slot) != ErrorCode::OK)
+  {
+    return nullptr;
+  }
+
+  slot->ref_count.store(1, std::memory_order_relaxed);
+  return slot;
+}
+
+void Topic::LoanPool::Retain(LoanSlot* slot)
+{
+  ASSERT(slot != nullptr);
+  slot->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Topic::LoanPool::Release(LoanSlot* slot)
+{
+  ASSERT(slot != nullptr);
+  auto prev = slot->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+  ASSERT(prev != 0);
+
+  if (prev == 1)
+  {
+    auto ans = slot->pool->free_slots_.Push(slot);
+    ASSERT(ans == ErrorCode::OK);
+    UNUSED(ans);
+  }
+}
+
+void* Topic::ASyncBlock::TakeData()
+{
+  // 出借槽位由所有订阅者共享，不能交出可写引用。
+  // The loan slot is shared by every subscriber, so no writable reference may leak.
+  if (loan != nullptr)
+  {
+    copy_payload(buff_addr, loan->payload);
+    ReleaseLoan();
+  }
+  return buff_addr;
+}
+
+void Topic::ASyncBlock::ReleaseLoan()
+{
+  if (loan != nullptr)
+  {
+    LoanPool::Release(loan);
+    loan = nullptr;
+  }
+}
+
+ErrorCode Topic::EnableLoan(size_t slot_count)
+{
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  if (slot_count == 0)
+  {
+    return ErrorCode::ARG_ERR;
+  }
+
+  if (block_->data_.loan_pool.load(std::memory_order_acquire) != nullptr)
+  {
+    return ErrorCode::OK;
+  }
+
+  LoanPool* expected = nullptr;
+  auto pool = new LoanPool(block_->data_.payload_size, block_->data_.payload_alignment,
+                           slot_count);
+  if (!block_->data_.loan_pool.compare_exchange_strong(expected, pool,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_acquire))
+  {
+    delete pool;
+  }
+  return ErrorCode::OK;
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "../topic.hpp"
+
+namespace LibXR
+{
+/**
+ * @struct Topic::LoanSlot
+ * @brief 出借池里的一个引用计数槽位 / One reference-counted slot of the loan pool
+ *
+ * 槽位在发布后只读；发布者和每个持有引用的订阅者各占一份计数，最后一个释放者把
+ * 槽位还给所属池。
+ * The slot is read-only once published; the publisher and every subscriber holding a
+ * reference own one count each, and the last releaser returns the slot to its pool.
+ */
+struct Topic::LoanSlot
+{
+  std::atomic<uint32_t> ref_count;  ///< 当前引用计数。Current reference count.
+  MicrosecondTimestamp timestamp;   ///< 发布时写入的时间戳。Timestamp written on publish.
+  LoanPool* pool;                   ///< 所属出借池。Owning loan pool.
+  void* payload;  ///< 槽位 payload 起始地址。Payload base address of this slot.
+};
+
+/**
+ * @class Topic::LoanPool
+ * @brief 每个 topic 独立持有的定长出借池 / Fixed-size loan pool owned by one topic
+ *
+ * 空闲槽位放在 MPMC 队列里，因此出借和归还都可以发生在任意线程。
+ * Free slots live in an MPMC queue, so loans and releases may happen on any thread.
+ */
+class Topic::LoanPool
+{
+ public:
+  /**
+   * @brief 构造一个出借池 / Construct one loan pool
+   * @param payload_size 单个 payload 字节数 / Byte size of one payload
+   * @param payload_alignment payload 对齐要求 / Payload alignment requirement
+   * @param slot_count 槽位个数 / Number of slots
+   * @note 包含初始化期动态内存分配 / Contains initialization-time dynamic allocation
+   */
+  LoanPool(size_t payload_size, size_t payload_alignment, size_t slot_count);
+
+  /**
+   * @brief 析构出借池；仅用于丢弃并发 `EnableLoan()` 中落败且从未出借的池 /
+   *        Destroy the pool; only used to discard a never-loaned pool that lost a
+   *        concurrent `EnableLoan()`
+   */
+  ~LoanPool();
+
+  LoanPool(const LoanPool&) = delete;
+  LoanPool& operator=(const LoanPool&) = delete;
+
+  /**
+   * @brief 取出一个空闲槽位，引用计数置为 1 / Take one free slot with its reference
+   *        count set to 1
+   * @return 成功返回槽位，池已耗尽返回空 / Returns the slot, or null when exhausted
+   */
+  LoanSlot* Acquire();
+
+  /**
+   * @brief 为一个已出借槽位增加一份引用 / Add one reference to a loaned slot
+   * @param slot 目标槽位 / Target slot
+   */
+  static void Retain(LoanSlot* slot);
+
+  /**
+   * @brief 释放一份引用；最后一份引用会把槽位还回池 / Drop one reference; the last
+   *        reference returns the slot to its pool
+   * @param slot 目标槽位 / Target slot
+   */
+  static void Release(LoanSlot* slot);
+
+  /**
+   * @brief 获取池内槽位总数 / Get the total slot count of the pool
+   * @return 槽位总数 / Total slot count
+   */
+  [[nodiscard]] size_t SlotCount() const { return slot_count_; }
+
+  /**
+   * @brief 获取当前空闲槽位数（并发快照）/ Get the current free-slot count (concurrent
+   *        snapshot)
+   * @return 空闲槽位数 / Free-slot count
+   */
+  [[nodiscard]] size_t FreeCount() const { return free_slots_.Size(); }
+
+ private:
+  const size_t slot_count_;         ///< 槽位总数。Total slot count.
+  const size_t payload_alignment_;  ///< payload 存储区对齐。Payload storage alignment.
+  LoanSlot* slots_;                 ///< 槽位控制块数组。Array of slot control blocks.
+  std::byte* storage_;              ///< payload 存储区。Payload storage.
+  MPMCQueue<LoanSlot*> free_slots_;  ///< 空闲槽位队列。Queue of free slots.
+};
+
+/**
+ * @class Topic::LoanedData
+ * @brief 指向出借槽位的独占式句柄 / Move-only handle referring to one loaned slot
+ * @tparam Data payload 类型 / Payload type
+ *
+ * 发布者通过 `Topic::Loan()` 取得可写句柄，`Topic::PublishLoan()` 后句柄被清空；
+ * 订阅者从 `LoanQueuedSubscriber::Pop()` 取得只读引用。句柄析构或 `Reset()` 时
+ * 自动释放引用。
+ * Publishers obtain a writable handle through `Topic::Loan()`, and the handle is
+ * cleared by `Topic::PublishLoan()`; subscribers obtain read-only references from
+ * `LoanQueuedSubscriber::Pop()`. The reference is released on destruction or
+ * `Reset()`.
+ */
+template <typename Data>
+class Topic::LoanedData
+{
+ public:
+  /**
+   * @brief 构造一个空句柄 / Construct one empty handle
+   */
+  LoanedData() = default;
+
+  /**
+   * @brief 析构时释放持有的引用 / Release the held reference on destruction
+   */
+  ~LoanedData() { Reset(); }
+
+  LoanedData(const LoanedData&) = delete;
+  LoanedData& operator=(const LoanedData&) = delete;
+
+  /**
+   * @brief 移动构造，转移引用 / Move-construct, transferring the reference
+   * @param other 被转移的句柄 / Handle to move from
+   */
+  LoanedData(LoanedData&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+
+  /**
+   * @brief 移动赋值，转移引用 / Move-assign, transferring the reference
+   * @param other 被转移的句柄 / Handle to move from
+   * @return 当前句柄 / Returns the current handle
+   */
+  LoanedData& operator=(LoanedData&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Reset();
+      slot_ = other.slot_;
+      other.slot_ = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief 检查句柄是否持有槽位 / Check whether the handle holds a slot
+   * @return 持有返回 `true` / Returns `true` when a slot is held
+   */
+  [[nodiscard]] bool Valid() const { return slot_ != nullptr; }
+
+  /**
+   * @brief 获取 payload 指针 / Get the payload pointer
+   * @return payload 指针；空句柄返回空 / Payload pointer, or null for an empty handle
+   */
+  [[nodiscard]] Data* GetData() const
+  {
+    return slot_ ? reinterpret_cast<Data*>(slot_->payload) : nullptr;
+  }
+
+  /**
+   * @brief 访问 payload 成员 / Access payload members
+   * @return payload 指针 / Payload pointer
+   */
+  Data* operator->() const
+  {
+    ASSERT(slot_ != nullptr);
+    return GetData();
+  }
+
+  /**
+   * @brief 解引用 payload / Dereference the payload
+   * @return payload 引用 / Payload reference
+   */
+  Data& operator*() const
+  {
+    ASSERT(slot_ != nullptr);
+    return *GetData();
+  }
+
+  /**
+   * @brief 获取消息时间戳；发布前为默认值 / Get the message timestamp; default before
+   *        publish
+   * @return 消息时间戳 / Message timestamp
+   */
+  [[nodiscard]] MicrosecondTimestamp GetTimestamp() const
+  {
+    return slot_ ? slot_->timestamp : MicrosecondTimestamp();
+  }
+
+  /**
+   * @brief 释放持有的引用 / Release the held reference
+   */
+  void Reset()
+  {
+    if (slot_ != nullptr)
+    {
+      LoanPool::Release(slot_);
+      slot_ = nullptr;
+    }
+  }
+
+ private:
+  friend class Topic;
+  template <typename>
+  friend class LoanQueuedSubscriber;
+
+  LoanSlot* slot_ = nullptr;  ///< 持有的槽位。Held slot.
+};
+
+template <typename Data>
+ErrorCode Topic::Loan(LoanedData<Data>& data)
+{
+  CheckTopicPayload<Data>();
+
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  CheckPublishContract(block_, TypeID::GetID<Data>(), sizeof(Data), alignof(Data));
+
+  auto pool = block_->data_.loan_pool.load(std::memory_order_acquire);
+  if (pool == nullptr)
+  {
+    return ErrorCode::NOT_SUPPORT;
+  }
+
+  auto slot = pool->Acquire();
+  if (slot == nullptr)
+  {
+    return ErrorCode::EMPTY;
+  }
+
+  new (slot->payload) Data;
+  data.Reset();
+  data.slot_ = slot;
+  return ErrorCode::OK;
+}
+
+template <typename Data>
+ErrorCode Topic::PublishLoanTyped(LoanedData<Data>& data, MicrosecondTimestamp timestamp,
+                                  bool from_callback, bool in_isr)
+{
+  CheckTopicPayload<Data>();
+
+  if (block_ == nullptr || !data.Valid())
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  if (data.slot_->pool != block_->data_.loan_pool.load(std::memory_order_acquire))
+  {
+    return ErrorCode::ARG_ERR;
+  }
+
+  if (from_callback)
+  {
+    LockFromCallback(block_);
+  }
+  else
+  {
+    Lock(block_);
+  }
+
+  CheckPublishContract(block_, TypeID::GetID<Data>(), sizeof(Data), alignof(Data));
+  data.slot_->timestamp = timestamp;
+  DispatchSubscribers(block_, timestamp, data.slot_->payload, data.slot_, from_callback,
+                      in_isr);
+
+  if (from_callback)
+  {
+    UnlockFromCallback(block_);
+  }
+  else
+  {
+    Unlock(block_);
+  }
+
+  data.Reset();
+  return ErrorCode::OK;
+}
+}  // namespace LibXR
@@ -40,24 +40,54 @@ MicrosecondTimestamp Topic::PackedDataHeader::GetTimestamp() const
 }
 
 void Topic::PackBytes(uint32_t topic_name_crc32, RawData buffer,
-                      MicrosecondTimestamp timestamp, ConstRawData data)
+                      MicrosecondTimestamp timestamp, ConstRawData data, uint8_t version)
 {
   ASSERT(buffer.addr_ != nullptr);
-  ASSERT(buffer.size_ >= PACK_BASE_SIZE + data.size_);
+  ASSERT(buffer.size_ >= PackBaseSize(version) + data.size_);
 
   auto* pack = reinterpret_cast<PackedData<uint8_t>*>(buffer.addr_);
-
   LibXR::Memory::FastCopy(&pack->raw.data_, data.addr_, data.size_);
 
+  SealPacket(topic_name_crc32, buffer, timestamp, data.size_, version);
+}
+
+void Topic::SealPacket(uint32_t topic_name_crc32, RawData buffer,
+                       MicrosecondTimestamp timestamp, size_t data_size, uint8_t version)
+{
+  ASSERT(buffer.addr_ != nullptr);
+  ASSERT(buffer.size_ >= PackBaseSize(version) + data_size);
+
+  auto* pack = reinterpret_cast<PackedData<uint8_t>*>(buffer.addr_);
+
   pack->raw.header_.prefix = PACKET_PREFIX;
-  pack->raw.header_.version = PACKET_VERSION;
+  pack->raw.header_.version = version;
   pack->raw.header_.topic_name_crc32 = topic_name_crc32;
-  pack->raw.header_.SetDataLen(data.size_);
+  pack->raw.header_.SetDataLen(data_size);
   pack->raw.header_.SetTimestamp(timestamp);
   pack->raw.header_.pack_header_crc8 =
       CRC8::Calculate(&pack->raw, sizeof(PackedDataHeader) - sizeof(uint8_t));
 
-  uint8_t* crc8_pack = reinterpret_cast<uint8_t*>(
-      reinterpret_cast<uint8_t*>(pack) + PACK_BASE_SIZE + data.size_ - sizeof(uint8_t));
-  *crc8_pack = CRC8::Calculate(pack, PACK_BASE_SIZE - sizeof(uint8_t) + data.size_);
+  const size_t checked_size = sizeof(PackedDataHeader) + data_size;
+  uint8_t* trailer = reinterpret_cast<uint8_t*>(pack) + checked_size;
+  if (version == PACKET_VERSION_CRC32C || version == PACKET_VERSION_BATCH)
+  {
+    const uint32_t crc = CRC32C::Calculate(pack, checked_size);
+    for (size_t i = 0; i < sizeof(crc); i++)
+    {
+      trailer[i] = static_cast<uint8_t>(crc >> (i * 8U));
+    }
+  }
+  else
+  {
+    *trailer = CRC8::Calculate(pack, checked_size);
+  }
+}
+
+bool Topic::VerifyPacket(const void* packet, size_t size, uint8_t version)
+{
+  if (version == PACKET_VERSION_CRC32C || version == PACKET_VERSION_BATCH)
+  {
+    return CRC32C::Verify(packet, size);
+  }
+  return CRC8::Verify(packet, size);
 }
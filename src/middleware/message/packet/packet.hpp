@@ -96,6 +96,43 @@ class Topic::PackedData
    */
   MicrosecondTimestamp GetTimestamp() const { return raw.header_.GetTimestamp(); }
 };
+
+/**
+ * @class Topic::PackedDataCRC32C
+ * @brief 尾部带 CRC32C 的完整打包消息 / Fully packed message with a trailing CRC32C
+ * @tparam Data payload 类型 / Payload type
+ *
+ * @note 头部与 `PackedData` 相同（版本字段为 `PACKET_VERSION_CRC32C`，头部仍用 CRC8），
+ *       尾部 CRC32C 以小端存放并覆盖头部和 payload。
+ *       The header matches `PackedData` (with `PACKET_VERSION_CRC32C` in the version
+ *       field and the header still guarded by CRC8); the trailing little-endian
+ *       CRC32C covers header and payload.
+ */
+template <typename Data>
+class Topic::PackedDataCRC32C
+{
+  static_assert(TopicPayload<Data>);
+
+ public:
+  /**
+   * @brief `PackedDataHeader + payload` 的原始字节布局 / Raw byte layout consisting of
+   *        `PackedDataHeader + payload`
+   */
+  struct
+  {
+    PackedDataHeader header_;     ///< 固定头。Fixed packet header.
+    uint8_t data_[sizeof(Data)];  ///< payload 原始字节区。Raw payload byte area.
+  } raw;  ///< 固定头和 payload 组成的原始字节布局。Raw byte layout made of the fixed
+          ///< header and payload.
+
+  uint8_t crc32c_[4];  ///< 尾部小端 CRC32C。Trailing little-endian CRC32C.
+
+  /**
+   * @brief 读取 packet 里的时间戳 / Read the timestamp stored in this packet
+   * @return packet 时间戳 / Packet timestamp
+   */
+  MicrosecondTimestamp GetTimestamp() const { return raw.header_.GetTimestamp(); }
+};
 LIBXR_PACKED_END
 #endif
 
@@ -120,4 +157,28 @@ ErrorCode Topic::PackData(const Data& data, PackedData<Data>& packet,
   PackBytes(block_->data_.crc32, RawData(packet), timestamp, ConstRawData(data));
   return ErrorCode::OK;
 }
+
+/**
+ * @brief 按当前 topic 的名字和类型契约把一条消息打包成尾部带 CRC32C 的 packet / Pack
+ *        one message into one packet with a trailing CRC32C using the current topic
+ *        name and type contract
+ * @tparam Data payload 类型 / Payload type
+ * @param data 待打包 payload / Payload to pack
+ * @param packet 输出 packet / Output packed message
+ * @param timestamp 要写入包头的时间戳 / Timestamp to store into the packet header
+ * @return 操作结果错误码 / Error code
+ */
+template <typename Data>
+ErrorCode Topic::PackData(const Data& data, PackedDataCRC32C<Data>& packet,
+                          MicrosecondTimestamp timestamp)
+{
+  CheckTopicPayload<Data>();
+  ASSERT(block_ != nullptr);
+  ASSERT(block_->data_.payload_type_id == TypeID::GetID<Data>());
+  ASSERT(block_->data_.payload_size == sizeof(Data));
+
+  PackBytes(block_->data_.crc32, RawData(packet), timestamp, ConstRawData(data),
+            PACKET_VERSION_CRC32C);
+  return ErrorCode::OK;
+}
 }  // namespace LibXR
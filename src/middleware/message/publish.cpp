@@ -1,7 +1,17 @@
+#include <algorithm>
 #include <atomic>
+#include <iterator>
+
+#include "libxr_mem.hpp"
 
 #include "subscriber/async.hpp"
+#include "executor/executor.hpp"
+#include "latest/latest.hpp"
+#include "loan/loan.hpp"
+#include "stats/stats.hpp"
 #include "subscriber/callback.hpp"
+#include "subscriber/filter.hpp"
+#include "subscriber/loan_queue.hpp"
 #include "subscriber/queue.hpp"
 #include "subscriber/sync.hpp"
 #include "timebase.hpp"
@@ -9,9 +19,16 @@
 
 using namespace LibXR;
 
-void Topic::DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp,
-                               void* payload_addr, bool from_callback, bool in_isr)
+bool Topic::DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp,
+                               void* payload_addr, LoanSlot* loan, bool from_callback,
+                               bool in_isr)
 {
+  auto filter = block.filter.load(std::memory_order_acquire);
+  if (filter != nullptr && !filter->Accept(timestamp, payload_addr))
+  {
+    return false;
+  }
+
   switch (block.type)
   {
     case SuberType::SYNC:
@@ -45,7 +62,15 @@ void Topic::DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp
       auto async = static_cast<ASyncBlock*>(&block);
       if (async->state.load(std::memory_order_acquire) == ASyncSubscriberState::WAITING)
       {
-        async->copy_payload(async->buff_addr, payload_addr);
+        if (loan != nullptr)
+        {
+          LoanPool::Retain(loan);
+          async->loan = loan;
+        }
+        else
+        {
+          async->copy_payload(async->buff_addr, payload_addr);
+        }
         async->timestamp = timestamp;
         async->state.store(ASyncSubscriberState::DATA_READY, std::memory_order_release);
       }
@@ -54,8 +79,7 @@ void Topic::DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp
     case SuberType::QUEUE:
     {
       auto queue_block = static_cast<QueueBlock*>(&block);
-      queue_block->fun(timestamp, payload_addr, *queue_block);
-      break;
+      return queue_block->fun(timestamp, payload_addr, *queue_block, !from_callback);
     }
     case SuberType::CALLBACK:
     {
@@ -63,18 +87,192 @@ void Topic::DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp
       cb_block->Run(from_callback && in_isr, timestamp, payload_addr);
       break;
     }
+    case SuberType::DEFERRED_CALLBACK:
+    {
+      auto deferred = static_cast<DeferredCallbackBlock*>(&block);
+      deferred->executor->Submit(*deferred, timestamp, payload_addr, from_callback,
+                                 in_isr);
+      break;
+    }
+    case SuberType::LOAN_QUEUE:
+    {
+      auto loan_block = static_cast<LoanQueueBlock*>(&block);
+      auto slot = loan;
+      if (slot != nullptr)
+      {
+        LoanPool::Retain(slot);
+      }
+      else
+      {
+        auto pool = loan_block->topic->data_.loan_pool.load(std::memory_order_acquire);
+        slot = pool ? pool->Acquire() : nullptr;
+        if (slot == nullptr)
+        {
+          return false;
+        }
+        LibXR::Memory::FastCopy(slot->payload, payload_addr,
+                                loan_block->topic->data_.payload_size);
+        slot->timestamp = timestamp;
+      }
+
+      if (loan_block->queue->Push(slot) != ErrorCode::OK)
+      {
+        LoanPool::Release(slot);
+        return false;
+      }
+      break;
+    }
   }
+  return true;
 }
 
 void Topic::DispatchSubscribers(TopicHandle topic, MicrosecondTimestamp timestamp,
-                                void* payload_addr, bool from_callback, bool in_isr)
+                                void* payload_addr, LoanSlot* loan, bool from_callback,
+                                bool in_isr)
+{
+  auto latest = topic->data_.latest.load(std::memory_order_acquire);
+  if (latest != nullptr)
+  {
+    latest->store(*latest, timestamp, payload_addr);
+  }
+
+  auto stats = topic->data_.stats.load(std::memory_order_acquire);
+  const MicrosecondTimestamp start = stats != nullptr ? NowTimestamp() : timestamp;
+  // 只在统计开启时清零和累加投递计数。Only clear and accumulate the delivery counts
+  // while stats are enabled.
+  uint32_t delivered[SUBER_TYPE_NUM];
+  if (stats != nullptr)
+  {
+    std::fill(std::begin(delivered), std::end(delivered), 0U);
+  }
+  auto count_delivered = [&](SuberType type, size_t num)
+  {
+    if (stats != nullptr)
+    {
+      delivered[static_cast<size_t>(type)] += static_cast<uint32_t>(num);
+    }
+  };
+
+  bool has_callback = false;
+  topic->data_.subers.Foreach<SuberBlock>(
+      [&](SuberBlock& block)
+      {
+        if (block.type == SuberType::CALLBACK)
+        {
+          has_callback = true;
+          return ErrorCode::OK;
+        }
+        if (DispatchSubscriber(block, timestamp, payload_addr, loan, from_callback,
+                               in_isr))
+        {
+          count_delivered(block.type, 1);
+        }
+        return ErrorCode::OK;
+      });
+
+  if (has_callback)
+  {
+    topic->data_.subers.Foreach<SuberBlock>(
+        [&](SuberBlock& block)
+        {
+          if (block.type == SuberType::CALLBACK &&
+              DispatchSubscriber(block, timestamp, payload_addr, loan, from_callback,
+                                 in_isr))
+          {
+            count_delivered(block.type, 1);
+          }
+          return ErrorCode::OK;
+        });
+  }
+
+  if (stats != nullptr)
+  {
+    stats->Record(1, topic->data_.payload_size, delivered, start);
+  }
+}
+
+void Topic::DispatchSubscribersBatch(TopicHandle topic, const PublishBatchView& batch,
+                                     bool from_callback, bool in_isr)
 {
+  const size_t last = batch.count - 1;
+  auto latest = topic->data_.latest.load(std::memory_order_acquire);
+  if (latest != nullptr)
+  {
+    latest->store(*latest, batch.Timestamp(last), batch.Payload(last));
+  }
+
+  auto stats = topic->data_.stats.load(std::memory_order_acquire);
+  const MicrosecondTimestamp start =
+      stats != nullptr ? NowTimestamp() : batch.Timestamp(last);
+  uint32_t delivered[SUBER_TYPE_NUM];
+  if (stats != nullptr)
+  {
+    std::fill(std::begin(delivered), std::end(delivered), 0U);
+  }
+  auto count_delivered = [&](SuberType type, size_t num)
+  {
+    if (stats != nullptr)
+    {
+      delivered[static_cast<size_t>(type)] += static_cast<uint32_t>(num);
+    }
+  };
+
+  bool has_callback = false;
   topic->data_.subers.Foreach<SuberBlock>(
-      [=](SuberBlock& block)
+      [&](SuberBlock& block)
       {
-        DispatchSubscriber(block, timestamp, payload_addr, from_callback, in_isr);
+        if (block.type == SuberType::CALLBACK)
+        {
+          has_callback = true;
+          return ErrorCode::OK;
+        }
+        // 带过滤器的队列订阅者要逐条判定，不能整批入队。Filtered queue subscribers
+        // must judge message by message and cannot take the whole batch at once.
+        if (block.type == SuberType::QUEUE &&
+            block.filter.load(std::memory_order_acquire) == nullptr)
+        {
+          auto queue_block = static_cast<QueueBlock*>(&block);
+          count_delivered(block.type,
+                          queue_block->batch_fun(batch, *queue_block, !from_callback));
+          return ErrorCode::OK;
+        }
+        for (size_t i = 0; i < batch.count; i++)
+        {
+          if (DispatchSubscriber(block, batch.Timestamp(i), batch.Payload(i), nullptr,
+                                 from_callback, in_isr))
+          {
+            count_delivered(block.type, 1);
+          }
+        }
         return ErrorCode::OK;
       });
+
+  if (has_callback)
+  {
+    topic->data_.subers.Foreach<SuberBlock>(
+        [&](SuberBlock& block)
+        {
+          if (block.type != SuberType::CALLBACK)
+          {
+            return ErrorCode::OK;
+          }
+          for (size_t i = 0; i < batch.count; i++)
+          {
+            if (DispatchSubscriber(block, batch.Timestamp(i), batch.Payload(i), nullptr,
+                                   from_callback, in_isr))
+            {
+              count_delivered(block.type, 1);
+            }
+          }
+          return ErrorCode::OK;
+        });
+  }
+
+  if (stats != nullptr)
+  {
+    stats->Record(batch.count, batch.count * topic->data_.payload_size, delivered,
+                  start);
+  }
 }
 
 MicrosecondTimestamp Topic::NowTimestamp() { return Timebase::GetMicroseconds(); }
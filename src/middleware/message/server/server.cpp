@@ -2,7 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
+#include "../batch/batch.hpp"
 #include "../packet/packet.hpp"
 #include "crc.hpp"
 #include "libxr_mem.hpp"
@@ -10,8 +12,7 @@
 using namespace LibXR;
 
 Topic::Server::Server(size_t buffer_length)
-    : topic_map_([](const uint32_t& a, const uint32_t& b) { return (a > b) - (a < b); }),
-      queue_(1, buffer_length)
+    : queue_(1, buffer_length)
 {
   ASSERT(buffer_length > PACK_BASE_SIZE);
   parse_buff_.size_ = buffer_length;
@@ -28,8 +29,7 @@ void Topic::Server::Register(TopicHandle topic)
 
   ASSERT(topic->data_.payload_size + PACK_BASE_SIZE <= parse_buff_.size_);
 
-  auto* node = new RBTree<uint32_t>::Node<TopicHandle>(topic);
-  topic_map_.Insert(*node, topic->key);
+  (void)topic_map_.Insert(topic->key, topic);
 }
 
 size_t Topic::Server::ParseData(ConstRawData data)
@@ -46,7 +46,15 @@ size_t Topic::Server::ParseDataRaw(ConstRawData data, bool from_callback, bool i
 {
   size_t count = 0;
 
-  (void)queue_.PushBatchBytes(data.addr_, data.size_);
+  if (status_ == Status::WAIT_START && queue_.Size() == 0)
+  {
+    count = ParseInPlace(data, from_callback, in_isr);
+  }
+
+  if (data.size_ > 0)
+  {
+    (void)queue_.PushBatchBytes(data.addr_, data.size_);
+  }
 
   while (true)
   {
@@ -62,33 +70,107 @@ size_t Topic::Server::ParseDataRaw(ConstRawData data, bool from_callback, bool i
 
     if (status_ == Status::WAIT_DATA_CRC)
     {
-      switch (ReadPayload(from_callback, in_isr))
+      size_t delivered = 0;
+      switch (ReadPayload(from_callback, in_isr, delivered))
       {
         case ParseResult::NEED_MORE:
           return count;
         case ParseResult::DROPPED:
           continue;
         case ParseResult::DELIVERED:
-          count++;
+          count += delivered;
           continue;
       }
     }
   }
 }
 
+size_t Topic::Server::ParseInPlace(ConstRawData& data, bool from_callback, bool in_isr)
+{
+  size_t count = 0;
+  auto* cursor = static_cast<const uint8_t*>(data.addr_);
+  size_t remain = data.size_;
+
+  while (remain > 0)
+  {
+    auto* start = static_cast<const uint8_t*>(std::memchr(cursor, PACKET_PREFIX, remain));
+    if (start == nullptr)
+    {
+      remain = 0;
+      break;
+    }
+    remain -= static_cast<size_t>(start - cursor);
+    cursor = start;
+
+    if (remain < sizeof(PackedDataHeader))
+    {
+      break;
+    }
+
+    // 与暂存路径一致：坏头整块丢弃。Same as the staged path: a bad header is dropped
+    // as a whole.
+    if (!CRC8::Verify(cursor, sizeof(PackedDataHeader)) ||
+        !AcceptHeader(*reinterpret_cast<const PackedDataHeader*>(cursor)))
+    {
+      ResetParser();
+      cursor += sizeof(PackedDataHeader);
+      remain -= sizeof(PackedDataHeader);
+      continue;
+    }
+
+    const size_t packet_size = data_len_ + PackBaseSize(current_version_);
+    if (remain < packet_size)
+    {
+      ResetParser();
+      break;
+    }
+
+    if (VerifyPacket(cursor, packet_size, current_version_))
+    {
+      if (current_version_ == PACKET_VERSION_BATCH)
+      {
+        count += DeliverBatch(cursor + sizeof(PackedDataHeader), from_callback, in_isr);
+      }
+      else
+      {
+        Deliver(cursor + sizeof(PackedDataHeader), false, from_callback, in_isr);
+        count++;
+      }
+    }
+    else
+    {
+      ResetParser();
+    }
+
+    cursor += packet_size;
+    remain -= packet_size;
+  }
+
+  data = ConstRawData(cursor, remain);
+  return count;
+}
+
 bool Topic::Server::SyncToPacketStart()
 {
-  auto queue_size = queue_.Size();
-  for (uint32_t i = 0; i < queue_size; i++)
+  // 队列里的数据最多分成两段连续区域；逐段用 memchr 找前缀，前面的垃圾一次丢掉。
+  // Queued bytes form at most two contiguous regions; scan each with memchr and drop
+  // the garbage in front of the prefix in one go.
+  size_t remain = queue_.Size();
+  while (remain > 0)
   {
-    uint8_t prefix = 0;
-    queue_.PeekBytes(&prefix);
-    if (prefix == PACKET_PREFIX)
+    const size_t span = LibXR::min(remain, queue_.length_ - queue_.head_);
+    const auto* region = queue_.queue_array_ + queue_.head_;
+    const auto* start =
+        static_cast<const uint8_t*>(std::memchr(region, PACKET_PREFIX, span));
+    const size_t garbage = start ? static_cast<size_t>(start - region) : span;
+    (void)queue_.PopBatchBytes(nullptr, garbage);
+
+    if (start != nullptr)
     {
       status_ = Status::WAIT_TOPIC;
       return true;
     }
-    queue_.PopBytes();
+    remain -= span;
   }
 
   return false;
@@ -108,64 +190,141 @@ bool Topic::Server::ReadHeader()
     return true;
   }
 
-  auto* header = reinterpret_cast<PackedDataHeader*>(parse_buff_.addr_);
-  if (header->version != PACKET_VERSION)
+  if (!AcceptHeader(*reinterpret_cast<PackedDataHeader*>(parse_buff_.addr_)))
   {
     ResetParser();
     return true;
   }
 
-  auto* node = topic_map_.Search<TopicHandle>(header->topic_name_crc32);
+  status_ = Status::WAIT_DATA_CRC;
+  return true;
+}
+
+bool Topic::Server::AcceptHeader(const PackedDataHeader& header)
+{
+  if (header.version != PACKET_VERSION && header.version != PACKET_VERSION_CRC32C &&
+      header.version != PACKET_VERSION_BATCH)
+  {
+    return false;
+  }
+
+  if (header.version == PACKET_VERSION_BATCH)
+  {
+    // 批量帧的目标 topic 在各条目头里，这里只检查整帧能否放进暂存缓冲区。
+    // A batch frame names its topics per entry, so only check that the whole frame
+    // fits in the staging buffer here.
+    current_version_ = header.version;
+    data_len_ = header.GetDataLen();
+    current_timestamp_ = header.GetTimestamp();
+    return data_len_ + PackBaseSize(current_version_) <= queue_.length_;
+  }
+
+  const auto* node = topic_map_.Find(header.topic_name_crc32);
   if (node == nullptr)
   {
-    ResetParser();
-    return true;
+    return false;
   }
 
-  data_len_ = header->GetDataLen();
-  current_timestamp_ = header->GetTimestamp();
+  current_version_ = header.version;
+  data_len_ = header.GetDataLen();
+  current_timestamp_ = header.GetTimestamp();
   current_topic_ = *node;
   const auto target_size = current_topic_->data_.payload_size;
 
   if (target_size + PACK_BASE_SIZE > parse_buff_.size_)
   {
-    ResetParser();
-    return true;
+    return false;
   }
 
-  if (data_len_ + PACK_BASE_SIZE > queue_.length_)
+  if (data_len_ + PackBaseSize(current_version_) > queue_.length_)
   {
-    ResetParser();
-    return true;
+    return false;
   }
 
-  status_ = Status::WAIT_DATA_CRC;
   return true;
 }
 
-Topic::Server::ParseResult Topic::Server::ReadPayload(bool from_callback, bool in_isr)
+Topic::Server::ParseResult Topic::Server::ReadPayload(bool from_callback, bool in_isr,
+                                                      size_t& delivered)
 {
-  if (queue_.Size() < data_len_ + sizeof(uint8_t))
+  const size_t packet_size = data_len_ + PackBaseSize(current_version_);
+  const size_t remain_size = packet_size - sizeof(PackedDataHeader);
+  if (queue_.Size() < remain_size)
   {
     return ParseResult::NEED_MORE;
   }
 
   auto* payload_addr =
       reinterpret_cast<uint8_t*>(parse_buff_.addr_) + sizeof(PackedDataHeader);
-  queue_.PopBatchBytes(payload_addr, data_len_ + sizeof(uint8_t));
+  queue_.PopBatchBytes(payload_addr, remain_size);
 
-  if (!CRC8::Verify(parse_buff_.addr_,
-                    data_len_ + sizeof(PackedDataHeader) + sizeof(uint8_t)))
+  if (!VerifyPacket(parse_buff_.addr_, packet_size, current_version_))
   {
     ResetParser();
     return ParseResult::DROPPED;
   }
 
+  if (current_version_ == PACKET_VERSION_BATCH)
+  {
+    delivered = DeliverBatch(payload_addr, from_callback, in_isr);
+  }
+  else
+  {
+    Deliver(payload_addr, true, from_callback, in_isr);
+    delivered = 1;
+  }
+  return ParseResult::DELIVERED;
+}
+
+size_t Topic::Server::DeliverBatch(const uint8_t* body, bool from_callback, bool in_isr)
+{
+  const size_t body_size = data_len_;
+  const auto frame_timestamp = static_cast<uint64_t>(current_timestamp_);
+  size_t count = 0;
+  size_t offset = 0;
+
+  while (body_size - offset >= sizeof(PackedBatchEntryHeader))
+  {
+    const auto* entry = reinterpret_cast<const PackedBatchEntryHeader*>(body + offset);
+    const size_t entry_len = entry->GetDataLen();
+    offset += sizeof(PackedBatchEntryHeader);
+    if (entry_len > body_size - offset)
+    {
+      break;
+    }
+
+    // 未注册的 topic 只跳过本条目。Unregistered topics only skip their own entry.
+    const auto* node = topic_map_.Find(entry->topic_name_crc32);
+    if (node != nullptr)
+    {
+      current_topic_ = *node;
+      data_len_ = static_cast<uint32_t>(entry_len);
+      current_timestamp_ = MicrosecondTimestamp(
+          frame_timestamp + static_cast<uint64_t>(entry->GetTimestampDelta()));
+      // 条目可能落在暂存缓冲区深处，按非暂存处理，短包和错位都先拷到缓冲区开头；
+      // 拷贝只覆盖当前条目及之前的字节，后续条目不受影响。
+      // An entry may sit deep in the staging buffer, so treat it as unstaged and copy
+      // short or misaligned payloads to the buffer start; the copy only overwrites the
+      // current entry and the bytes before it, leaving later entries intact.
+      Deliver(body + offset, false, from_callback, in_isr);
+      count++;
+    }
+    offset += entry_len;
+  }
+
+  ResetParser();
+  return count;
+}
+
+void Topic::Server::Deliver(const void* payload_addr, bool staged, bool from_callback,
+                            bool in_isr)
+{
   const auto target_size = current_topic_->data_.payload_size;
-  void* publish_addr = payload_addr;
-  if (reinterpret_cast<uintptr_t>(payload_addr) %
-          current_topic_->data_.payload_alignment !=
-      0)
+  const bool aligned = reinterpret_cast<uintptr_t>(payload_addr) %
+                           current_topic_->data_.payload_alignment ==
+                       0;
+  void* publish_addr = const_cast<void*>(payload_addr);
+  if (!aligned || (!staged && data_len_ < target_size))
   {
     publish_addr = parse_buff_.addr_;
     if (data_len_ >= target_size)
@@ -190,13 +349,13 @@ Topic::Server::ParseResult Topic::Server::ReadPayload(bool from_callback, bool i
   }
 
   ResetParser();
-  return ParseResult::DELIVERED;
 }
 
 void Topic::Server::ResetParser()
 {
   status_ = Status::WAIT_START;
   data_len_ = 0;
+  current_version_ = 0;
   current_topic_ = nullptr;
   current_timestamp_ = MicrosecondTimestamp();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../topic.hpp"
+#include "flat_hash_map.hpp"
 #include "queue.hpp"
 
 namespace LibXR
@@ -22,6 +23,20 @@ namespace LibXR
  * incoming packet payload is shorter than the topic's fixed size, only the leading prefix
  * is guaranteed valid and the remaining tail stays unspecified; when it is longer, only
  * the prefix matching the topic size is kept and the rest is truncated.
+ * @note 同时接受 `PACKET_VERSION`（尾部 CRC8）和 `PACKET_VERSION_CRC32C`（尾部 CRC32C）
+ *       两种 packet，按每包头部的版本字段区分。
+ *       Accepts both `PACKET_VERSION` (trailing CRC8) and `PACKET_VERSION_CRC32C`
+ *       (trailing CRC32C) packets, told apart by the version field of each header.
+ * @note `PACKET_VERSION_BATCH` 批量帧整帧校验后逐条发布，`ParseData*()` 返回的是发布的
+ *       消息条数而不是帧数。
+ *       `PACKET_VERSION_BATCH` frames are verified as a whole and then published entry
+ *       by entry, so `ParseData*()` counts published messages rather than frames.
+ * @note 暂存队列为空时，输入里完整的 packet 直接就地校验并发布，订阅者拿到的 payload
+ *       可能直接指向调用者的输入缓冲区；只有跨输入块的 packet 才经过暂存队列。
+ *       While the staging queue is empty, complete packets in the input are verified
+ *       and published in place, so subscribers may receive a payload pointing straight
+ *       into the caller's input buffer; only packets straddling input chunks go through
+ *       the staging queue.
  */
 class Topic::Server
 {
@@ -61,13 +76,14 @@ class Topic::Server
    *       The server's internal staging buffer is allocated once at
    *       `CACHE_LINE_SIZE` alignment during construction; registration also
    *       asserts that the topic's `payload_alignment <= CACHE_LINE_SIZE`.
+   * @note 同一 topic 重复注册会被忽略。Registering the same topic again is ignored.
    */
   void Register(TopicHandle topic);
 
   /**
    * @brief 在普通上下文里喂入一批新字节 / Feed one new byte batch in normal context
    * @param data 新收到的原始字节 / Newly received raw bytes
-   * @return 成功解析并发布的包数量 / Number of packets parsed and published
+   * @return 成功发布的消息数量 / Number of messages published
    */
   size_t ParseData(ConstRawData data);
 
@@ -75,7 +91,7 @@ class Topic::Server
    * @brief 在回调/ISR 路径里喂入一批新字节 / Feed one new byte batch in callback/ISR path
    * @param data 新收到的原始字节 / Newly received raw bytes
    * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
-   * @return 成功解析并发布的包数量 / Number of packets parsed and published
+   * @return 成功发布的消息数量 / Number of messages published
    */
   size_t ParseDataFromCallback(ConstRawData data, bool in_isr);
 
@@ -101,11 +117,31 @@ class Topic::Server
    */
   size_t ParseDataRaw(ConstRawData data, bool from_callback, bool in_isr);
 
+  /**
+   * @brief 直接在调用者输入里解析完整 packet / Parse complete packets directly out of
+   *        the caller's input
+   * @param data 输入字节，返回时前移到未处理的剩余部分 / Input bytes; advanced to the
+   *        unprocessed remainder on return
+   * @param from_callback 是否来自回调路径 / Whether the current parse comes from
+   *        callback path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 成功解析并发布的包数量 / Number of packets parsed and published
+   *
+   * @note 只在暂存队列为空时使用；遇到跨输入块的残包就停下，剩余字节交给暂存队列。
+   *       Used only while the staging queue is empty; stops at a packet that straddles
+   *       the input chunk and leaves the remaining bytes to the staging queue.
+   */
+  size_t ParseInPlace(ConstRawData& data, bool from_callback, bool in_isr);
+
   /**
    * @brief 把输入流同步到下一条 packet 起点 / Synchronize the input stream to the next
    *        packet start
    * @return 若已找到起始字节则返回 `true`，否则返回 `false` / Returns `true` when a
    *         packet start byte is found, otherwise `false`
+   *
+   * @note 按连续区域整段扫描并批量丢弃垃圾字节，不再逐字节 peek/pop。
+   *       Scans whole contiguous regions and drops garbage in bulk instead of peeking
+   *       and popping one byte at a time.
    */
   bool SyncToPacketStart();
 
@@ -117,15 +153,59 @@ class Topic::Server
    */
   bool ReadHeader();
 
+  /**
+   * @brief 校验一个完整头部并记录当前包上下文 / Validate one full header and record the
+   *        current packet context
+   * @param header 待校验头部 / Header to validate
+   * @return 头部可接受返回 `true`，否则返回 `false` / Returns `true` when the header is
+   *         accepted, otherwise `false`
+   */
+  bool AcceptHeader(const PackedDataHeader& header);
+
   /**
    * @brief 读取当前包的 payload 和尾 CRC，并在成功时发布 / Read the payload and
    *        trailing CRC of the current packet and publish it on success
    * @param from_callback 是否来自回调路径 / Whether the current parse comes from
    *        callback path
    * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @param delivered 输出本包发布的消息条数 / Output number of messages this packet
+   *        published
    * @return 当前 payload 阶段的处理结果 / Result of the current payload stage
    */
-  ParseResult ReadPayload(bool from_callback, bool in_isr);
+  ParseResult ReadPayload(bool from_callback, bool in_isr, size_t& delivered);
+
+  /**
+   * @brief 把当前包的 payload 发布到目标 topic / Publish the payload of the current
+   *        packet into its target topic
+   * @param payload_addr 已校验 payload 地址 / Address of the verified payload
+   * @param staged payload 是否位于暂存缓冲区 / Whether the payload sits in the staging
+   *        buffer
+   * @param from_callback 是否来自回调路径 / Whether the current parse comes from
+   *        callback path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   *
+   * @note 地址未按 topic 对齐，或 payload 在调用者输入里且短于 topic 固定大小时，先拷进
+   *       暂存缓冲区再发布。
+   *       The payload is copied into the staging buffer first when its address is not
+   *       aligned for the topic, or when it lives in the caller's input and is shorter
+   *       than the topic's fixed size.
+   */
+  void Deliver(const void* payload_addr, bool staged, bool from_callback, bool in_isr);
+
+  /**
+   * @brief 拆开一个已校验的批量帧并逐条发布 / Unpack one verified batch frame and
+   *        publish its entries one by one
+   * @param body 批量帧数据区地址 / Address of the batch frame data area
+   * @param from_callback 是否来自回调路径 / Whether the current parse comes from
+   *        callback path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 发布的消息条数 / Number of messages published
+   *
+   * @note 目标 topic 未注册的条目被跳过，条目长度越过帧尾时停止拆包。
+   *       Entries whose topic is not registered are skipped, and unpacking stops at an
+   *       entry whose length runs past the frame end.
+   */
+  size_t DeliverBatch(const uint8_t* body, bool from_callback, bool in_isr);
 
   /**
    * @brief 清空当前包的解析上下文并回到找起点状态 / Clear the current packet parsing
@@ -134,10 +214,13 @@ class Topic::Server
   void ResetParser();
 
   Status status_ = Status::WAIT_START;  ///< 当前 parser 阶段。Current parser stage.
+  uint8_t current_version_ =
+      0;  ///< 当前包头声明的 packet 版本。Packet version declared by the current header.
   uint32_t data_len_ =
       0;  ///< 当前包头声明的 payload 长度。Payload length declared by the current header.
-  RBTree<uint32_t> topic_map_;  ///< 从 topic 名称 CRC32 到 topic 句柄的映射。Map from
-                                ///< topic-name CRC32 to topic handle.
+  FlatHashMap<TopicHandle> topic_map_;  ///< 从 topic 名称 CRC32 到 topic 句柄的
+                                        ///< 映射。Map from topic-name CRC32 to topic
+                                        ///< handle.
   QueueBase queue_;             ///< 输入字节 FIFO。Input byte FIFO.
   RawData parse_buff_;  ///< 当前包头和 payload 的暂存缓冲区。Staging buffer holding the
                         ///< current header and payload.
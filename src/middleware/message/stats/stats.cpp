@@ -0,0 +1,246 @@
+#include "stats.hpp"
+
+#include <bit>
+#include <cstring>
+#include <iterator>
+
+#include "stdio.hpp"
+
+using namespace LibXR;
+
+namespace
+{
+#if LIBXR_PRINT_INTEGER_ENABLE_64BIT
+uint64_t PrintableCount(uint64_t value) { return value; }
+#else
+// 未开启 64 位整数输出时饱和到 32 位。Saturate to 32 bits when 64-bit integer output
+// is disabled.
+uint32_t PrintableCount(uint64_t value)
+{
+  return value > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value);
+}
+#endif
+
+size_t DispatchBucket(uint64_t elapsed_us)
+{
+  const size_t bucket = static_cast<size_t>(std::bit_width(elapsed_us));
+  return bucket < Topic::STATS_DISPATCH_BUCKETS ? bucket
+                                                : Topic::STATS_DISPATCH_BUCKETS - 1;
+}
+
+void PrintStats(const Topic::TopicStats& stats, bool enabled)
+{
+  STDIO::Print<"0x{:08x} size={}">(stats.key, stats.payload_size);
+  if (!enabled)
+  {
+    STDIO::Print<" stats=off\r\n">();
+    return;
+  }
+
+  const uint64_t avg_us =
+      stats.dispatches == 0 ? 0 : stats.dispatch_time_us / stats.dispatches;
+  STDIO::Print<" pub={} bytes={} avg={}us max={}us\r\n">(
+      PrintableCount(stats.published), PrintableCount(stats.published_bytes),
+      PrintableCount(avg_us), stats.dispatch_max_us);
+
+  static constexpr const char* SUBER_TYPE_NAMES[] = {
+      "sync", "async", "queue", "callback", "loan_queue", "deferred"};
+  static_assert(std::size(SUBER_TYPE_NAMES) == Topic::SUBER_TYPE_NUM,
+                "every SuberType needs a name");
+  STDIO::Print<"  fanout">();
+  for (size_t i = 0; i < Topic::SUBER_TYPE_NUM; i++)
+  {
+    if (stats.subscribers[i] != 0 || stats.delivered[i] != 0)
+    {
+      STDIO::Print<" {}={}/{}">(SUBER_TYPE_NAMES[i], stats.subscribers[i],
+                                PrintableCount(stats.delivered[i]));
+    }
+  }
+
+  STDIO::Print<"\r\n  dispatch_us">();
+  for (size_t i = 0; i < Topic::STATS_DISPATCH_BUCKETS; i++)
+  {
+    const uint32_t floor_us = i == 0 ? 0U : 1U << (i - 1);
+    STDIO::Print<" {}:{}">(floor_us, stats.dispatch_histogram[i]);
+  }
+  STDIO::Print<"\r\n">();
+}
+}  // namespace
+
+void Topic::StatsStore::Record(size_t count, size_t bytes,
+                               const uint32_t (&delivered_now)[SUBER_TYPE_NUM],
+                               MicrosecondTimestamp start)
+{
+  const uint64_t elapsed_us =
+      static_cast<uint64_t>(NowTimestamp()) - static_cast<uint64_t>(start);
+
+  published.fetch_add(count, std::memory_order_relaxed);
+  published_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  dispatches.fetch_add(1, std::memory_order_relaxed);
+  dispatch_time_us.fetch_add(elapsed_us, std::memory_order_relaxed);
+  dispatch_histogram[DispatchBucket(elapsed_us)].fetch_add(1, std::memory_order_relaxed);
+
+  const uint32_t elapsed_u32 =
+      elapsed_us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(elapsed_us);
+  uint32_t peak = dispatch_max_us.load(std::memory_order_relaxed);
+  while (elapsed_u32 > peak &&
+         !dispatch_max_us.compare_exchange_weak(peak, elapsed_u32,
+                                                std::memory_order_relaxed))
+  {
+  }
+
+  for (size_t i = 0; i < SUBER_TYPE_NUM; i++)
+  {
+    if (delivered_now[i] != 0)
+    {
+      delivered[i].fetch_add(delivered_now[i], std::memory_order_relaxed);
+    }
+  }
+}
+
+void Topic::StatsStore::Load(TopicStats& stats) const
+{
+  stats.published = published.load(std::memory_order_relaxed);
+  stats.published_bytes = published_bytes.load(std::memory_order_relaxed);
+  stats.dispatches = dispatches.load(std::memory_order_relaxed);
+  stats.dispatch_time_us = dispatch_time_us.load(std::memory_order_relaxed);
+  stats.dispatch_max_us = dispatch_max_us.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < STATS_DISPATCH_BUCKETS; i++)
+  {
+    stats.dispatch_histogram[i] = dispatch_histogram[i].load(std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < SUBER_TYPE_NUM; i++)
+  {
+    stats.delivered[i] = delivered[i].load(std::memory_order_relaxed);
+  }
+}
+
+void Topic::StatsStore::Reset()
+{
+  published.store(0, std::memory_order_relaxed);
+  published_bytes.store(0, std::memory_order_relaxed);
+  dispatches.store(0, std::memory_order_relaxed);
+  dispatch_time_us.store(0, std::memory_order_relaxed);
+  dispatch_max_us.store(0, std::memory_order_relaxed);
+  for (auto& bucket : dispatch_histogram)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  for (auto& count : delivered)
+  {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+ErrorCode Topic::EnableStats()
+{
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  if (block_->data_.stats.load(std::memory_order_acquire) != nullptr)
+  {
+    return ErrorCode::OK;
+  }
+
+  StatsStore* expected = nullptr;
+  auto stats = new StatsStore;
+  if (!block_->data_.stats.compare_exchange_strong(expected, stats,
+                                                   std::memory_order_acq_rel,
+                                                   std::memory_order_acquire))
+  {
+    delete stats;
+  }
+  return ErrorCode::OK;
+}
+
+ErrorCode Topic::GetStats(TopicStats& stats) const
+{
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  stats = {};
+  stats.key = block_->data_.crc32;
+  stats.payload_size = block_->data_.payload_size;
+  block_->data_.subers.Foreach<SuberBlock>(
+      [&](SuberBlock& block)
+      {
+        stats.subscribers[static_cast<size_t>(block.type)]++;
+        return ErrorCode::OK;
+      });
+
+  auto store = block_->data_.stats.load(std::memory_order_acquire);
+  if (store == nullptr)
+  {
+    return ErrorCode::NOT_SUPPORT;
+  }
+
+  store->Load(stats);
+  return ErrorCode::OK;
+}
+
+ErrorCode Topic::ResetStats()
+{
+  if (block_ == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+
+  auto store = block_->data_.stats.load(std::memory_order_acquire);
+  if (store == nullptr)
+  {
+    return ErrorCode::NOT_SUPPORT;
+  }
+
+  store->Reset();
+  return ErrorCode::OK;
+}
+
+ErrorCode Topic::Domain::EnableStats()
+{
+  return Foreach([](Topic topic) { return topic.EnableStats(); });
+}
+
+int Topic::StatsCommand(Domain* domain, int argc, char** argv)
+{
+  if (domain == nullptr)
+  {
+    domain = EnsureDefaultDomain();
+  }
+
+  if (argc == 2 && strcmp(argv[1], "enable") == 0)
+  {
+    (void)domain->EnableStats();
+    return 0;
+  }
+
+  if (argc == 2 && strcmp(argv[1], "reset") == 0)
+  {
+    (void)domain->Foreach(
+        [](Topic topic)
+        {
+          (void)topic.ResetStats();
+          return ErrorCode::OK;
+        });
+    return 0;
+  }
+
+  if (argc != 1)
+  {
+    STDIO::Print<"usage: {} [enable|reset]\r\n">(argv[0]);
+    return -1;
+  }
+
+  (void)domain->Foreach(
+      [](Topic topic)
+      {
+        TopicStats stats;
+        const bool enabled = topic.GetStats(stats) == ErrorCode::OK;
+        PrintStats(stats, enabled);
+        return ErrorCode::OK;
+      });
+  return 0;
+}
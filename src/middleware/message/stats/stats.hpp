@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../topic.hpp"
+
+namespace LibXR
+{
+/**
+ * @struct Topic::StatsStore
+ * @brief topic 运行统计的原子计数块 / Atomic counter block of one topic's runtime
+ *        statistics
+ *
+ * 发布路径在持有 topic 发布锁时调用 `Record()`，因此写入端始终串行；计数仍用原子
+ * 变量，是为了让其他线程随时读取快照或清零而不必拿发布锁。
+ * The publish path calls `Record()` while holding the topic publish lock, so writers
+ * are always serialized; the counters are still atomics so other threads can take a
+ * snapshot or clear them at any time without taking the publish lock.
+ */
+struct Topic::StatsStore
+{
+  /**
+   * @brief 记录一次分发 / Record one dispatch
+   * @param count 本次分发的消息数 / Messages carried by this dispatch
+   * @param bytes 本次分发的 payload 字节数 / Payload bytes carried by this dispatch
+   * @param delivered 按订阅者种类统计的投递次数 / Deliveries per subscriber kind
+   * @param start 分发开始时间 / Time the dispatch started
+   */
+  void Record(size_t count, size_t bytes, const uint32_t (&delivered)[SUBER_TYPE_NUM],
+              MicrosecondTimestamp start);
+
+  /**
+   * @brief 把计数写入快照 / Copy the counters into a snapshot
+   * @param stats 输出快照 / Output snapshot
+   */
+  void Load(TopicStats& stats) const;
+
+  /**
+   * @brief 清零全部计数 / Clear every counter
+   */
+  void Reset();
+
+  std::atomic<uint64_t> published{0};         ///< 已发布消息数。Messages published.
+  std::atomic<uint64_t> published_bytes{0};   ///< 已发布字节数。Bytes published.
+  std::atomic<uint64_t> dispatches{0};        ///< 分发调用次数。Dispatch calls.
+  std::atomic<uint64_t> dispatch_time_us{0};  ///< 分发累计耗时。Total dispatch time.
+  std::atomic<uint32_t> dispatch_max_us{0};   ///< 单次最长耗时。Longest dispatch.
+  std::atomic<uint32_t> dispatch_histogram[STATS_DISPATCH_BUCKETS]{};  ///< 耗时直方图。
+                                                                     ///< Time histogram.
+  std::atomic<uint64_t> delivered[SUBER_TYPE_NUM]{};  ///< 各种类投递次数。Deliveries
+                                                      ///< per subscriber kind.
+};
+}  // namespace LibXR
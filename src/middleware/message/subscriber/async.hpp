@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../topic.hpp"
+#include "filter.hpp"
 
 namespace LibXR
 {
@@ -32,8 +33,22 @@ struct Topic::ASyncBlock : public Topic::SuberBlock
                             ///< one payload using the subscriber's exact type.
   MicrosecondTimestamp
       timestamp;  ///< 最近接收的消息时间戳。Latest received message timestamp.
+  LoanSlot* loan = nullptr;  ///< 出借发布时持有的槽位引用。Slot reference held after a
+                             ///< loaned publish.
   std::atomic<ASyncSubscriberState> state =
       ASyncSubscriberState::IDLE;  ///< 当前异步订阅状态。Current async subscriber state.
+
+  /**
+   * @brief 若持有出借槽位，把槽位内容拷入本地缓冲区并归还引用 / If a loan slot is
+   *        held, copy it into the local buffer and return the reference
+   * @return 本地缓冲区地址 / Local buffer address
+   */
+  void* TakeData();
+
+  /**
+   * @brief 归还持有的出借槽位引用 / Return the held loan-slot reference
+   */
+  void ReleaseLoan();
 };
 
 /**
@@ -126,6 +141,30 @@ class Topic::ASyncSubscriber
     return *this;
   }
 
+  /**
+   * @brief 给该订阅者挂上过滤器 / Attach a filter to this subscriber
+   * @param filter 决定哪些消息送达的过滤器，必须活得比订阅者久 / Filter deciding which
+   *        messages get delivered; it must outlive the subscriber
+   * @note 只有放行的消息会写进本地缓冲区 / Only accepted messages are written into the
+   *       local buffer
+   */
+  void SetFilter(Filter& filter)
+  {
+    ASSERT(block_ != nullptr);
+    filter.CheckPayloadType(TypeID::GetID<Data>());
+    block_->data_.filter.store(&filter, std::memory_order_release);
+  }
+
+  /**
+   * @brief 摘掉过滤器，恢复接收全部消息 / Detach the filter and receive every message
+   *        again
+   */
+  void ClearFilter()
+  {
+    ASSERT(block_ != nullptr);
+    block_->data_.filter.store(nullptr, std::memory_order_release);
+  }
+
   /**
    * @brief 检查数据是否可用 / Check whether data is available
    * @return 数据已准备好返回 `true`，否则返回 `false` / Returns `true` if data is ready,
@@ -146,6 +185,11 @@ class Topic::ASyncSubscriber
    *       If the local buffer is currently `DATA_READY`, this read clears the
    *       state back to `IDLE`; later publishes are ignored again until
    *       `StartWaiting()` is called
+   * @note 若数据来自 `PublishLoan()`，这里才把共享的出借槽位拷入本地缓冲区并归还，
+   *       返回的引用始终指向订阅者自己的缓冲区 /
+   *       If the data came from `PublishLoan()`, the shared loan slot is copied into
+   *       the local buffer and returned here, so the reference always points at the
+   *       subscriber's own buffer
    */
   Data& GetData()
   {
@@ -154,7 +198,7 @@ class Topic::ASyncSubscriber
     {
       block_->data_.state.store(ASyncSubscriberState::IDLE, std::memory_order_release);
     }
-    return *reinterpret_cast<Data*>(block_->data_.buff_addr);
+    return *reinterpret_cast<Data*>(block_->data_.TakeData());
   }
 
   /**
@@ -168,11 +212,15 @@ class Topic::ASyncSubscriber
    * @note 异步订阅者只接收 `WAITING` 状态下的下一次发布；`IDLE` 或 `DATA_READY`
    * 状态下的新发布会被忽略 / Async subscribers only capture the next publish while in
    * `WAITING` state; new publishes in `IDLE` or `DATA_READY` state are ignored
+   * @note 这里会先归还上一次出借发布留下、未经 `GetData()` 取走的槽位引用 / This
+   *       first returns any slot reference a previous loaned publish left behind
+   *       without a `GetData()` call
    */
   void StartWaiting()
   {
     if (block_->data_.state.load(std::memory_order_acquire) == ASyncSubscriberState::IDLE)
     {
+      block_->data_.ReleaseLoan();
       block_->data_.state.store(ASyncSubscriberState::WAITING, std::memory_order_release);
     }
   }
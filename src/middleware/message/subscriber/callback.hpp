@@ -544,6 +544,14 @@ class Topic::Callback
    */
   bool IsRawPayloadView() const { return block_->accepts_raw_payload; }
 
+  /**
+   * @brief 判断两个句柄是否指向同一个回调块 / Tell whether two handles share one
+   *        callback block
+   * @param other 另一个回调句柄 / The other callback handle
+   * @return 指向同一回调块返回 true / Returns true when both share one callback block
+   */
+  bool operator==(const Callback& other) const { return block_ == other.block_; }
+
  private:
   /**
    * @brief 用指定执行块构造回调句柄 / Construct one callback handle from the given
@@ -592,6 +600,10 @@ struct Topic::CallbackBlock : public Topic::SuberBlock
 
   /// 注册到的 topic 固定 payload 字节数。Fixed payload size of the subscribed topic.
   size_t payload_size = 0;
+
+  /// 注销时等待回收的标志，回收后置位。Flag the unregistering thread waits on; set
+  /// once the block is reclaimed.
+  std::atomic<bool>* reclaimed = nullptr;
 };
 
 /**
@@ -603,7 +615,9 @@ struct Topic::CallbackBlock : public Topic::SuberBlock
  * @note 回调在发布锁内运行，不应重入发布同一个主题 / The callback runs while the publish
  * lock is held and should not re-enter publishing on the same topic
  */
-inline void Topic::RegisterCallback(Callback& cb)
+inline void Topic::RegisterCallback(Callback& cb) { AttachCallback(cb, nullptr); }
+
+inline void Topic::AttachCallback(Callback& cb, Filter* filter)
 {
   if (!cb.IsRawPayloadView())
   {
@@ -612,6 +626,7 @@ inline void Topic::RegisterCallback(Callback& cb)
 
   auto node = new (std::align_val_t(LibXR::CONCURRENCY_ALIGNMENT))
       LockFreeList::Node<CallbackBlock>(cb, block_->data_.payload_size);
+  node->data_.filter.store(filter, std::memory_order_relaxed);
   block_->data_.subers.Add(*node);
 }
 }  // namespace LibXR
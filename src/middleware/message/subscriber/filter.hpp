@@ -0,0 +1,288 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "../topic.hpp"
+
+namespace LibXR
+{
+/**
+ * @class Topic::Filter
+ * @brief 订阅者侧的抽取与内容过滤器 / Subscriber-side decimation and content filter
+ *
+ * 过滤器挂在订阅块上，由发布路径在拷贝 payload 或占用队列槽位之前判定；被拒绝的消息
+ * 对该订阅者来说没有任何开销。判定顺序为谓词、最小间隔、按计数抽取，前一步拒绝的消息
+ * 不会推进后一步的状态。
+ * The filter sits on a subscriber block and is evaluated by the publish path before
+ * the payload is copied or a queue slot is taken, so rejected messages cost that
+ * subscriber nothing. Checks run in the order predicate, minimum interval, count
+ * decimation, and a message rejected by an earlier step does not advance the state of
+ * later ones.
+ *
+ * @note 抽取状态只在持有 topic 发布锁时更新；一个过滤器只应挂给一个订阅者，且必须活得
+ *       比订阅者久。
+ *       Decimation state is only updated while the topic publish lock is held; one
+ *       filter should serve exactly one subscriber and must outlive it.
+ * @note 最小间隔按消息时间戳计算，而不是按到达时的时钟。
+ *       The minimum interval is measured on message timestamps, not on the clock at
+ *       arrival.
+ */
+class Topic::Filter
+{
+  /**
+   * @struct PredicateTraits
+   * @brief 从谓词函数指针里取出绑定参数和 payload 类型 / Extract the bound argument and
+   *        payload types from a predicate function pointer
+   * @tparam Function 谓词函数类型 / Predicate function type
+   */
+  template <typename Function>
+  struct PredicateTraits
+  {
+    static_assert(sizeof(Function) == 0,
+                  "LibXR::Topic::Filter predicate must be bool(Arg, const Data&) or "
+                  "bool(Arg, MicrosecondTimestamp, const Data&).");
+  };
+
+  /**
+   * @struct PredicateTraits<bool (*)(ArgType, const Data&)>
+   * @brief 只看 payload 的谓词 / Predicate looking only at the payload
+   */
+  template <typename ArgType, typename Data>
+  struct PredicateTraits<bool (*)(ArgType, const Data&)>
+  {
+    using Arg = ArgType;  ///< 绑定参数类型。Bound argument type.
+    using Payload = Data;  ///< payload 类型。Payload type.
+
+    /**
+     * @brief 调用谓词 / Invoke the predicate
+     */
+    static bool Invoke(bool (*fun)(ArgType, const Data&), ArgType arg,
+                       MicrosecondTimestamp, const Data& data)
+    {
+      return fun(arg, data);
+    }
+  };
+
+  /**
+   * @struct PredicateTraits<bool (*)(ArgType, MicrosecondTimestamp, const Data&)>
+   * @brief 同时看时间戳和 payload 的谓词 / Predicate looking at both the timestamp
+   *        and the payload
+   */
+  template <typename ArgType, typename Data>
+  struct PredicateTraits<bool (*)(ArgType, MicrosecondTimestamp, const Data&)>
+  {
+    using Arg = ArgType;  ///< 绑定参数类型。Bound argument type.
+    using Payload = Data;  ///< payload 类型。Payload type.
+
+    /**
+     * @brief 调用谓词 / Invoke the predicate
+     */
+    static bool Invoke(bool (*fun)(ArgType, MicrosecondTimestamp, const Data&),
+                       ArgType arg, MicrosecondTimestamp timestamp, const Data& data)
+    {
+      return fun(arg, timestamp, data);
+    }
+  };
+
+  using ErasedFun = void (*)();  ///< 擦除类型后的谓词函数指针。Type-erased predicate
+                                 ///< function pointer.
+  using PredicateFun = bool (*)(const Filter&, MicrosecondTimestamp,
+                                const void*);  ///< 类型化谓词的跳板。Trampoline into
+                                               ///< the typed predicate.
+
+ public:
+  /**
+   * @brief 构造一个放行全部消息的过滤器 / Construct a filter that accepts every message
+   */
+  Filter() = default;
+
+  Filter(const Filter&) = delete;
+  Filter& operator=(const Filter&) = delete;
+
+  /**
+   * @brief 每 `every_n` 条只放行一条 / Let through only one message out of every
+   *        `every_n`
+   * @param every_n 抽取比例，0 和 1 都表示不抽取 / Decimation ratio; 0 and 1 both
+   *        disable decimation
+   * @return 当前过滤器，便于链式配置 / This filter, for chained configuration
+   * @note 放行的是每组的第一条，订阅后第一条消息立即送达 / The first message of each
+   *       group is the one let through, so the first message after subscribing arrives
+   *       right away
+   */
+  Filter& Decimate(uint32_t every_n)
+  {
+    every_n_ = every_n > 1 ? every_n : 1;
+    phase_ = 0;
+    return *this;
+  }
+
+  /**
+   * @brief 限制放行的最小时间间隔 / Limit accepted messages to a minimum spacing
+   * @param min_interval_us 两条放行消息之间的最小时间戳差，0 表示不限速 / Minimum
+   *        timestamp gap between two accepted messages, 0 disables the limit
+   * @return 当前过滤器，便于链式配置 / This filter, for chained configuration
+   */
+  Filter& Throttle(uint32_t min_interval_us)
+  {
+    min_interval_us_ = min_interval_us;
+    has_last_ = false;
+    return *this;
+  }
+
+  /**
+   * @brief 设置内容谓词 / Set the content predicate
+   * @tparam ArgType 绑定参数类型，须为指针 / Bound argument type, must be a pointer
+   * @tparam Callable 无捕获可调用对象类型 / Capture-free callable type
+   * @param fun 签名为 `bool(Arg, const Data&)` 或
+   *        `bool(Arg, MicrosecondTimestamp, const Data&)` 的谓词，返回 `true` 表示放行 /
+   *        Predicate with signature `bool(Arg, const Data&)` or
+   *        `bool(Arg, MicrosecondTimestamp, const Data&)`, returning `true` to accept
+   * @param arg 传给谓词的参数 / Argument passed to the predicate
+   * @return 当前过滤器，便于链式配置 / This filter, for chained configuration
+   * @note 谓词在发布锁内、拷贝 payload 之前运行，应当短小且不阻塞 / The predicate runs
+   *       inside the publish lock before the payload is copied, so it should be short
+   *       and non-blocking
+   */
+  template <typename ArgType, typename Callable>
+  Filter& Where(Callable fun, ArgType arg)
+  {
+    using Function = decltype(+std::declval<Callable>());
+    using Traits = PredicateTraits<Function>;
+    static_assert(std::is_pointer_v<typename Traits::Arg>,
+                  "LibXR::Topic::Filter predicate argument must be a pointer.");
+    static_assert(std::is_convertible_v<ArgType, typename Traits::Arg>,
+                  "LibXR::Topic::Filter predicate argument type mismatch.");
+    CheckTopicPayload<typename Traits::Payload>();
+
+    fun_ = reinterpret_cast<ErasedFun>(+fun);
+    arg_ = const_cast<void*>(
+        static_cast<const void*>(static_cast<typename Traits::Arg>(arg)));
+    payload_type_id_ = TypeID::GetID<typename Traits::Payload>();
+    predicate_ = [](const Filter& self, MicrosecondTimestamp timestamp,
+                    const void* payload_addr)
+    {
+      return Traits::Invoke(reinterpret_cast<Function>(self.fun_),
+                            static_cast<typename Traits::Arg>(self.arg_), timestamp,
+                            *static_cast<const typename Traits::Payload*>(payload_addr));
+    };
+    return *this;
+  }
+
+  /**
+   * @brief 判定一条消息是否放行 / Decide whether one message gets through
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param payload_addr payload 地址 / Payload address
+   * @return 放行返回 `true` / Returns `true` when the message is accepted
+   */
+  bool Accept(MicrosecondTimestamp timestamp, const void* payload_addr)
+  {
+    if (predicate_ != nullptr && !predicate_(*this, timestamp, payload_addr))
+    {
+      return Reject();
+    }
+
+    const auto now_us = static_cast<uint64_t>(timestamp);
+    if (min_interval_us_ != 0 && has_last_ && now_us - last_us_ < min_interval_us_)
+    {
+      return Reject();
+    }
+
+    if (every_n_ > 1)
+    {
+      const bool first_of_group = phase_ == 0;
+      phase_ = phase_ + 1 == every_n_ ? 0 : phase_ + 1;
+      if (!first_of_group)
+      {
+        return Reject();
+      }
+    }
+
+    last_us_ = now_us;
+    has_last_ = true;
+    return true;
+  }
+
+  /**
+   * @brief 读取被过滤掉的消息数 / Read how many messages were filtered out
+   * @return 被拒绝的消息数 / Rejected message count
+   */
+  uint32_t Rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 取谓词要求的 payload 类型 / Get the payload type required by the predicate
+   * @return 类型标识；未设置谓词时为空 / Type ID, or null when no predicate is set
+   */
+  TypeID::ID PayloadTypeID() const { return payload_type_id_; }
+
+  /**
+   * @brief 断言过滤器的谓词能用于某种 payload / Assert that the filter predicate fits
+   *        one payload type
+   * @param payload_type_id 订阅者看到的 payload 类型 / Payload type seen by the
+   *        subscriber
+   */
+  void CheckPayloadType(TypeID::ID payload_type_id) const
+  {
+    ASSERT(payload_type_id_ == nullptr || payload_type_id_ == payload_type_id);
+  }
+
+ private:
+  /**
+   * @brief 记一次拒绝 / Count one rejection
+   * @return 恒为 `false` / Always `false`
+   */
+  bool Reject()
+  {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  PredicateFun predicate_ = nullptr;  ///< 谓词跳板，为空表示不看内容。Predicate
+                                      ///< trampoline, null when content is ignored.
+  ErasedFun fun_ = nullptr;           ///< 用户谓词。User predicate.
+  void* arg_ = nullptr;               ///< 谓词绑定参数。Predicate bound argument.
+  TypeID::ID payload_type_id_ = nullptr;  ///< 谓词的 payload 类型。Predicate payload
+                                          ///< type.
+  uint32_t every_n_ = 1;          ///< 抽取比例。Decimation ratio.
+  uint32_t phase_ = 0;            ///< 当前组内位置。Position inside the current group.
+  uint32_t min_interval_us_ = 0;  ///< 最小放行间隔。Minimum accepted spacing.
+  bool has_last_ = false;         ///< 是否放行过消息。Whether any message was accepted.
+  uint64_t last_us_ = 0;          ///< 上次放行的时间戳。Timestamp of the last accept.
+  std::atomic<uint32_t> rejected_ = 0;  ///< 被拒绝的消息数。Rejected message count.
+};
+
+/**
+ * @brief 注册一个带过滤器的回调订阅者 / Register one callback subscriber behind a
+ *        filter
+ * @param cb 需要注册的回调函数 / Callback function to register
+ * @param filter 决定哪些消息送进回调的过滤器 / Filter deciding which messages reach the
+ *        callback
+ *
+ * @note 包含初始化期动态内存分配，回调订阅应长期存在 / Contains initialization-time
+ * dynamic allocation; callback subscriptions are expected to be long-lived
+ */
+inline void Topic::RegisterCallback(Callback& cb, Filter& filter)
+{
+  filter.CheckPayloadType(block_->data_.payload_type_id);
+  AttachCallback(cb, &filter);
+}
+
+/**
+ * @brief 注册一个带过滤器、在执行器上运行的回调 / Register a filtered callback that runs
+ *        on an executor
+ * @param cb 需要注册的回调函数 / Callback function to register
+ * @param executor 执行回调的执行器 / Executor running the callback
+ * @param filter 决定哪些消息入队的过滤器 / Filter deciding which messages get queued
+ * @param queue_depth 该回调可积压的消息数 / Messages this callback may queue
+ * @return 操作结果错误码 / Error code
+ *
+ * @note 过滤在发布线程上进行，被拒绝的消息不会占用执行器队列 / Filtering happens on the
+ * publishing thread, so rejected messages never take an executor queue slot
+ */
+inline ErrorCode Topic::RegisterCallback(Callback& cb, CallbackExecutor& executor,
+                                         Filter& filter, size_t queue_depth)
+{
+  filter.CheckPayloadType(block_->data_.payload_type_id);
+  return AttachCallback(cb, executor, queue_depth, &filter);
+}
+}  // namespace LibXR
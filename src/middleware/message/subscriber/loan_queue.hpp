@@ -0,0 +1,220 @@
+#pragma once
+
+#include <atomic>
+
+#include "../loan/loan.hpp"
+#include "../topic.hpp"
+#include "filter.hpp"
+
+namespace LibXR
+{
+/**
+ * @struct Topic::LoanQueueBlock
+ * @brief 引用队列订阅者自己挂的数据块 / Data block owned by one reference-queue
+ *        subscriber
+ */
+struct Topic::LoanQueueBlock : public Topic::SuberBlock
+{
+  TopicHandle topic;  ///< 所属 topic，用于非出借发布时借槽。Owning topic, used to borrow
+                      ///< a slot for non-loaned publishes.
+  SPSCQueue<LoanSlot*>* queue;  ///< 槽位引用队列。Queue of slot references.
+  std::atomic<bool>* reclaimed = nullptr;  ///< 注销时等待回收的标志。Flag the
+                                           ///< destroying subscriber waits on.
+};
+
+/**
+ * @class Topic::LoanQueuedSubscriber
+ * @brief 每次发布只入队一份槽位引用的订阅者 / Subscriber that enqueues only one slot
+ *        reference on each publish
+ * @tparam Data 订阅的数据类型 / Subscribed data type
+ *
+ * 通过 `PublishLoan()` 发布时直接共享发布者的槽位，不拷贝 payload；普通 `Publish()`
+ * 时从 topic 出借池借一个槽位并拷贝一次，池未启用或已耗尽时丢弃本次发布。
+ * Publishes made through `PublishLoan()` share the publisher's slot without copying
+ * the payload; plain `Publish()` borrows one slot from the topic loan pool and copies
+ * once, and the publish is dropped when the pool is disabled or exhausted.
+ */
+template <typename Data>
+class Topic::LoanQueuedSubscriber
+{
+ public:
+  /**
+   * @brief 通过主题名称构造引用队列订阅者 / Construct a reference-queue subscriber by
+   *        topic name
+   * @param name 订阅的主题名称 / Name of the subscribed topic
+   * @param length 队列容量 / Queue capacity
+   * @param domain 可选的域指针 / Optional domain pointer
+   * @note 包含初始化期动态内存分配，订阅者应长期存在 / Contains initialization-time
+   * dynamic allocation; subscribers are expected to be long-lived
+   */
+  LoanQueuedSubscriber(const char* name, size_t length, Domain* domain = nullptr)
+      : LoanQueuedSubscriber(Topic(WaitTopic(name, UINT32_MAX, domain)), length)
+  {
+  }
+
+  /**
+   * @brief 通过 `Topic` 句柄构造引用队列订阅者 / Construct a reference-queue subscriber
+   *        from a `Topic` handle
+   * @param topic 订阅的主题 / Subscribed topic
+   * @param length 队列容量 / Queue capacity
+   * @note 包含初始化期动态内存分配，订阅者应长期存在 / Contains initialization-time
+   * dynamic allocation; subscribers are expected to be long-lived
+   * @note 队列里每个未取走的引用都占住一个出借槽位；出借池容量应覆盖所有引用队列
+   *       的积压 /
+   *       Every reference still queued pins one loan slot; the loan pool should be
+   *       sized to cover the backlog of all reference queues
+   */
+  LoanQueuedSubscriber(Topic topic, size_t length)
+  {
+    Topic::CheckSubscriberType<Data>(topic);
+
+    block_ = new LockFreeList::Node<LoanQueueBlock>;
+    block_->data_.type = SuberType::LOAN_QUEUE;
+    block_->data_.topic = topic.block_;
+    block_->data_.queue = new SPSCQueue<LoanSlot*>(length);
+    topic.block_->data_.subers.Add(*block_);
+  }
+
+  /**
+   * @brief 注销订阅块并释放队列中尚未取走的引用 / Unregister the subscriber block and
+   *        release every reference still queued
+   * @note 会等待进行中的发布，不能在 ISR 或本 topic 的回调里析构 / Waits for in-flight
+   *       publishes, so it must not run from an ISR or from a callback of this topic
+   */
+  ~LoanQueuedSubscriber() { Release(); }
+
+  LoanQueuedSubscriber(const LoanQueuedSubscriber& other) = delete;
+  LoanQueuedSubscriber& operator=(const LoanQueuedSubscriber& other) = delete;
+
+  /**
+   * @brief 移动构造引用队列订阅者 / Move-construct one reference-queue subscriber
+   * @param other 被转移的订阅者 / Subscriber to move from
+   * @note 这里只移动本地句柄指针；底层订阅块仍留在 topic 的订阅链表里 /
+   *       This moves only the local handle pointer; the underlying subscriber
+   *       block stays registered in the topic list
+   */
+  LoanQueuedSubscriber(LoanQueuedSubscriber&& other) noexcept : block_(other.block_)
+  {
+    other.block_ = nullptr;
+  }
+
+  /**
+   * @brief 移动赋值引用队列订阅者 / Move-assign one reference-queue subscriber
+   * @param other 被转移的订阅者 / Subscriber to move from
+   * @return 当前订阅者 / Returns the current subscriber
+   * @note 当前持有的订阅块会先被注销，其排队引用随之释放 / The block held so far is
+   *       unregistered first and its queued references are released
+   */
+  LoanQueuedSubscriber& operator=(LoanQueuedSubscriber&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Release();
+      block_ = other.block_;
+      other.block_ = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief 给该订阅者挂上过滤器 / Attach a filter to this subscriber
+   * @param filter 决定哪些消息送达的过滤器，必须活得比订阅者久 / Filter deciding which
+   *        messages get delivered; it must outlive the subscriber
+   * @note 被过滤掉的消息不会借槽位或占用引用队列 / Filtered-out messages neither
+   *       borrow a slot nor take a reference-queue entry
+   */
+  void SetFilter(Filter& filter)
+  {
+    ASSERT(block_ != nullptr);
+    filter.CheckPayloadType(TypeID::GetID<Data>());
+    block_->data_.filter.store(&filter, std::memory_order_release);
+  }
+
+  /**
+   * @brief 摘掉过滤器，恢复接收全部消息 / Detach the filter and receive every message
+   *        again
+   */
+  void ClearFilter()
+  {
+    ASSERT(block_ != nullptr);
+    block_->data_.filter.store(nullptr, std::memory_order_release);
+  }
+
+  /**
+   * @brief 取出队头的一份只读引用 / Pop one read-only reference from the queue front
+   * @param data 接收引用的句柄；原有引用会先被释放 / Handle receiving the reference;
+   *        any reference it held is released first
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::EMPTY` when the queue
+   *         is empty
+   */
+  ErrorCode Pop(LoanedData<Data>& data)
+  {
+    ASSERT(block_ != nullptr);
+
+    LoanSlot* slot = nullptr;
+    auto ans = block_->data_.queue->Pop(slot);
+    if (ans != ErrorCode::OK)
+    {
+      return ans;
+    }
+
+    data.Reset();
+    data.slot_ = slot;
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 获取队列中尚未取走的引用数 / Get the number of references not yet popped
+   * @return 引用个数 / Reference count
+   */
+  [[nodiscard]] size_t Size() const { return block_->data_.queue->Size(); }
+
+ private:
+  /**
+   * @brief 注销当前订阅块并等待其回收 / Unregister the current block and wait for it
+   *        to be reclaimed
+   */
+  void Release()
+  {
+    if (block_ == nullptr)
+    {
+      return;
+    }
+    std::atomic<bool> reclaimed = false;
+    block_->data_.reclaimed = &reclaimed;
+    const ErrorCode ans =
+        RetireSubscriber(block_->data_.topic, *block_, ReclaimBlock, reclaimed);
+    UNUSED(ans);
+    ASSERT(ans == ErrorCode::OK);
+    block_ = nullptr;
+  }
+
+  /**
+   * @brief 宽限期结束后归还排队引用并释放订阅块 / Return the queued references and
+   *        free the subscriber block once its grace period has ended
+   * @param node 被摘下的订阅链表节点 / Unlinked subscriber list node
+   */
+  static void ReclaimBlock(LockFreeList::BaseNode* node)
+  {
+    auto* block = static_cast<LockFreeList::Node<LoanQueueBlock>*>(node);
+    std::atomic<bool>* reclaimed = block->data_.reclaimed;
+    LoanSlot* slot = nullptr;
+    while (block->data_.queue->Pop(slot) == ErrorCode::OK)
+    {
+      // 借句柄析构归还这份引用。The handle returns the reference on scope exit.
+      LoanedData<Data> queued;
+      queued.slot_ = slot;
+    }
+    delete block->data_.queue;
+    delete block;
+    if (reclaimed != nullptr)
+    {
+      reclaimed->store(true, std::memory_order_release);
+    }
+  }
+
+  LockFreeList::Node<LoanQueueBlock>* block_ =
+      nullptr;  ///< 订阅者数据块。Subscriber data block.
+};
+}  // namespace LibXR
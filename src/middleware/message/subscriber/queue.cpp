@@ -0,0 +1,85 @@
+#include "queue.hpp"
+
+#include <algorithm>
+
+#include "thread.hpp"
+
+using namespace LibXR;
+
+bool Topic::QueueBlock::Push(const void* element, bool may_block)
+{
+  ErrorCode ans = TryPush(element);
+
+  if (ans != ErrorCode::OK)
+  {
+    switch (policy)
+    {
+      case QueueOverflowPolicy::DROP_NEWEST:
+        break;
+      case QueueOverflowPolicy::OVERWRITE_OLDEST:
+      {
+        // 发布侧临时当一个消费者挤掉队头；消费者同时取走也只会让这次挤不到。
+        // The publish side acts as one extra consumer and evicts the front entry; a
+        // consumer popping at the same time only makes this eviction find nothing.
+        ASSERT(shared_queue != nullptr);
+        if (shared_queue->PopBytes(nullptr) == ErrorCode::OK)
+        {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        ans = TryPush(element);
+        break;
+      }
+      case QueueOverflowPolicy::BLOCK:
+      {
+        if (!may_block)
+        {
+          break;
+        }
+        // 挂起睡眠而不是让出：SCHED_FIFO 下让出永远轮不到低优先级的消费者。
+        // 消费者经 `Pop()` 取数会唤醒这里；直接从队列取数则靠退避超时重试。
+        // Park instead of yielding: under SCHED_FIFO a yield never lets a lower-priority
+        // consumer run. A consumer popping through `Pop()` wakes this wait; pops made
+        // directly on the queue are picked up by the backoff timeout.
+        const uint32_t start_time = Thread::GetTime();
+        uint32_t backoff_ms = 1;
+        while (ans != ErrorCode::OK)
+        {
+          const auto elapsed = static_cast<uint32_t>(Thread::GetTime() - start_time);
+          if (elapsed >= block_timeout_ms)
+          {
+            break;
+          }
+          const EventCount::Key key = not_full.PrepareWait();
+          ans = TryPush(element);
+          if (ans == ErrorCode::OK)
+          {
+            break;
+          }
+          (void)not_full.Wait(key, std::min(backoff_ms, block_timeout_ms - elapsed));
+          backoff_ms = std::min(backoff_ms * 2, BLOCK_MAX_BACKOFF_MS);
+          ans = TryPush(element);
+        }
+        break;
+      }
+    }
+  }
+
+  if (ans != ErrorCode::OK)
+  {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  UpdateHighWatermark();
+  return true;
+}
+
+void Topic::QueueBlock::UpdateHighWatermark()
+{
+  const auto depth = static_cast<uint32_t>(Depth());
+  uint32_t peak = high_watermark.load(std::memory_order_relaxed);
+  while (depth > peak &&
+         !high_watermark.compare_exchange_weak(peak, depth, std::memory_order_relaxed))
+  {
+  }
+}
@@ -1,25 +1,186 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+
 #include "../topic.hpp"
+#include "event_count.hpp"
+#include "filter.hpp"
 
 namespace LibXR
 {
 /**
  * @struct Topic::QueueBlock
  * @brief 队列订阅者自己挂的数据块 / Data block owned by one queued subscriber
+ *
+ * @note `queue` 和 `shared_queue` 只有一个非空；只有 MPMC 队列允许发布侧再当一个消费者
+ *       挤掉最旧条目，所以 `OVERWRITE_OLDEST` 只配 `shared_queue`。
+ *       Exactly one of `queue` and `shared_queue` is set; only an MPMC queue lets the
+ *       publish side act as an extra consumer that evicts the oldest entry, so
+ *       `OVERWRITE_OLDEST` pairs only with `shared_queue`.
  */
 struct Topic::QueueBlock : public Topic::SuberBlock
 {
-  SPSCQueueBase* queue;  ///< 指向订阅队列基类。Pointer to the subscribed queue base.
-  void (*fun)(MicrosecondTimestamp, void*,
-              QueueBlock&);  ///< 把一条发布转发进队列。Adapter that forwards one publish
-                             ///< into the queue.
+  SPSCQueueBase* queue = nullptr;  ///< 指向 SPSC 订阅队列。Pointer to the SPSC
+                                   ///< subscribed queue.
+  MPMCQueueBase* shared_queue = nullptr;  ///< 指向 MPMC 订阅队列。Pointer to the MPMC
+                                          ///< subscribed queue.
+  TypeID::ID payload_type_id = nullptr;  ///< 订阅的 payload 类型，用于校验过滤器。
+                                         ///< Subscribed payload type, used to check
+                                         ///< filters.
+  bool (*fun)(MicrosecondTimestamp, void*, QueueBlock&,
+              bool);  ///< 把一条发布转发进队列，末参数表示能否阻塞，返回是否入队。
+                      ///< Adapter that forwards one publish into the queue; the last
+                      ///< argument tells whether it may block, and the result tells
+                      ///< whether it was enqueued.
+  size_t (*batch_fun)(const PublishBatchView&, QueueBlock&,
+                      bool);  ///< 把一整批发布转发进队列，返回入队条数。Adapter that
+                              ///< forwards a whole batch publish into the queue and
+                              ///< returns how many were enqueued.
+  QueueOverflowPolicy policy =
+      QueueOverflowPolicy::DROP_NEWEST;  ///< 队列满时的策略。Policy for a full queue.
+  uint32_t block_timeout_ms = 0;  ///< `BLOCK` 策略的最长等待毫秒数。Longest wait of the
+                                  ///< `BLOCK` policy in milliseconds.
+  std::atomic<uint32_t> dropped = 0;  ///< 丢掉的消息数。Messages lost.
+  std::atomic<uint32_t> high_watermark = 0;  ///< 入队后的最大深度。Largest depth seen
+                                             ///< after a push.
+  EventCount not_full;  ///< `BLOCK` 发布者等待消费者腾出空间。`BLOCK` publishers wait
+                        ///< here for the consumer to make room.
+
+  /// `BLOCK` 策略两次重试之间的最长睡眠毫秒数。Longest sleep of the `BLOCK` policy
+  /// between two retries, in milliseconds.
+  static constexpr uint32_t BLOCK_MAX_BACKOFF_MS = 8;
+
+  /**
+   * @brief 按溢出策略把一个元素推入队列并更新计数 / Push one element according to the
+   *        overflow policy and update the counters
+   * @param element 已按队列元素布局准备好的字节 / Bytes already laid out as one queue
+   *        element
+   * @param may_block 当前路径能否阻塞 / Whether the current path may block
+   * @return 成功入队返回 `true`，被丢弃返回 `false` / Returns `true` when enqueued,
+   *         `false` when dropped
+   *
+   * @note 回调/ISR 路径不能阻塞，`BLOCK` 策略在那里退化为 `DROP_NEWEST`。
+   *       Callback/ISR paths cannot block, so `BLOCK` degrades to `DROP_NEWEST` there.
+   */
+  bool Push(const void* element, bool may_block);
+
+  /**
+   * @brief 记一次成功入队后的深度 / Record the depth after a successful push
+   */
+  void UpdateHighWatermark();
+
+  /**
+   * @brief 按溢出策略把一整批消息推入队列 / Push a whole burst according to the
+   *        overflow policy
+   * @tparam Data payload 类型 / Payload type
+   * @tparam WITH_TIMESTAMP 队列元素是否为 `Message<Data>` / Whether queue elements are
+   *         `Message<Data>`
+   * @param batch 本次批量发布 / Current batch publish
+   * @param may_block 当前路径能否阻塞 / Whether the current path may block
+   * @return 实际入队的条数 / Number of messages actually enqueued
+   *
+   * @note SPSC 队列配 `DROP_NEWEST` 时，放得下的前缀一次批量写入，其余计为丢弃；
+   *       其他组合逐条走 `Push()`，语义与逐条发布相同。
+   *       With an SPSC queue and `DROP_NEWEST`, the prefix that fits is written in one
+   *       batch and the rest counts as dropped; other combinations go through `Push()`
+   *       one by one, with the same semantics as single publishes.
+   */
+  template <typename Data, bool WITH_TIMESTAMP>
+  size_t PushBatch(const PublishBatchView& batch, bool may_block)
+  {
+    if (queue == nullptr || policy != QueueOverflowPolicy::DROP_NEWEST)
+    {
+      size_t pushed = 0;
+      for (size_t i = 0; i < batch.count; i++)
+      {
+        if constexpr (WITH_TIMESTAMP)
+        {
+          Message<Data> message{batch.Timestamp(i),
+                                *reinterpret_cast<Data*>(batch.Payload(i))};
+          pushed += Push(&message, may_block) ? 1 : 0;
+        }
+        else
+        {
+          pushed += Push(batch.Payload(i), may_block) ? 1 : 0;
+        }
+      }
+      return pushed;
+    }
+
+    // 只有本发布者会写队尾，空闲空间在这里只会变多，这一段一定能写进去。
+    // Only this publisher writes the tail, so free space can only grow from here and
+    // the whole prefix is guaranteed to fit.
+    const size_t count = std::min(batch.count, queue->EmptySize());
+    if (count > 0)
+    {
+      if constexpr (WITH_TIMESTAMP)
+      {
+        size_t index = 0;
+        (void)queue->PushBytesWithWriter(
+            count,
+            [&](void* buffer, size_t chunk_count)
+            {
+              auto* messages = static_cast<Message<Data>*>(buffer);
+              for (size_t i = 0; i < chunk_count; i++, index++)
+              {
+                messages[i] = {batch.Timestamp(index),
+                               *reinterpret_cast<Data*>(batch.Payload(index))};
+              }
+              return ErrorCode::OK;
+            });
+      }
+      else
+      {
+        (void)queue->PushBatchBytes(batch.payloads, count);
+      }
+      UpdateHighWatermark();
+    }
+
+    if (count < batch.count)
+    {
+      dropped.fetch_add(static_cast<uint32_t>(batch.count - count),
+                        std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 尝试把一个元素推入队列一次 / Try once to push one element into the queue
+   * @param element 元素字节 / Element bytes
+   * @return 操作结果错误码 / Error code
+   */
+  ErrorCode TryPush(const void* element)
+  {
+    return queue != nullptr ? queue->PushBytes(element)
+                            : shared_queue->PushBytes(element);
+  }
+
+  /**
+   * @brief 读取当前队列深度 / Read the current queue depth
+   * @return 队列深度 / Queue depth
+   */
+  size_t Depth() const { return queue != nullptr ? queue->Size() : shared_queue->Size(); }
 };
 
 /**
  * @class Topic::QueuedSubscriber
  * @brief 每次发布都往队列里塞一份数据的订阅者 / Subscriber that pushes one entry into
  *        a queue on each publish
+ *
+ * @note 队列满时按 `QueueOverflowPolicy` 处理，默认 `DROP_NEWEST` 直接丢掉本次发布；
+ *       丢包数和最大深度可以通过 `GetStats()` 在运行时读取。
+ *       A full queue is handled by the `QueueOverflowPolicy`; the default
+ *       `DROP_NEWEST` drops the current publish. Drop count and peak depth are readable
+ *       at runtime through `GetStats()`.
+ * @note `BLOCK` 策略在发布路径上持有 topic 锁等待，同一 topic 的其他发布者也会一起等。
+ *       发布者挂起睡眠而不是让出 CPU，通过 `Pop()` 取数会立即唤醒它；直接从队列取数时
+ *       它按退避间隔（最长 `BLOCK_MAX_BACKOFF_MS`）醒来重试。
+ *       The `BLOCK` policy waits on the publish path while holding the topic lock, so
+ *       other publishers of the same topic wait as well. The publisher parks instead of
+ *       yielding; popping through `Pop()` wakes it at once, while pops made directly on
+ *       the queue are noticed at the next backoff retry (at most
+ *       `BLOCK_MAX_BACKOFF_MS` apart).
  */
 class Topic::QueuedSubscriber
 {
@@ -31,20 +192,23 @@ class Topic::QueuedSubscriber
    * @param queue 订阅的数据队列 / Subscribed data queue
    * @param domain 可选的域指针，默认为 `nullptr` / Optional domain pointer, default
    * `nullptr`
+   * @param policy 队列满时的策略，SPSC 队列不支持 `OVERWRITE_OLDEST` / Policy for a
+   *        full queue; SPSC queues do not support `OVERWRITE_OLDEST`
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
    * @note 包含初始化期动态内存分配，订阅者应长期存在 / Contains initialization-time
    * dynamic allocation; subscribers are expected to be long-lived
    * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
    *       为止 /
    *       Queued subscribers keep only a pointer to `queue`; the queue object
    *       itself must outlive the subscriber's use of it
-   * @note 每次发布都会直接调一次底层 `SPSCQueueBase::PushBytes()`；如果 push 不进去，
-   *       这次发布就直接丢掉 /
-   *       Each publish directly calls one underlying `SPSCQueueBase::PushBytes()`;
-   *       if that push cannot fit, this publish is dropped immediately
    */
   template <typename Data>
-  QueuedSubscriber(const char* name, SPSCQueue<Data>& queue, Domain* domain = nullptr)
-      : QueuedSubscriber(Topic(WaitTopic(name, UINT32_MAX, domain)), queue)
+  QueuedSubscriber(const char* name, SPSCQueue<Data>& queue, Domain* domain = nullptr,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
+      : QueuedSubscriber(Topic(WaitTopic(name, UINT32_MAX, domain)), queue, policy,
+                         block_timeout_ms)
   {
   }
 
@@ -56,19 +220,22 @@ class Topic::QueuedSubscriber
    * @param queue 订阅的消息队列 / Subscribed message queue
    * @param domain 可选的域指针，默认为 `nullptr` / Optional domain pointer, default
    * `nullptr`
+   * @param policy 队列满时的策略，SPSC 队列不支持 `OVERWRITE_OLDEST` / Policy for a
+   *        full queue; SPSC queues do not support `OVERWRITE_OLDEST`
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
    * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
    *       为止 /
    *       Queued subscribers keep only a pointer to `queue`; the queue object
    *       itself must outlive the subscriber's use of it
-   * @note 每次发布都会直接调一次底层 `SPSCQueueBase::PushBytes()`；如果 push 不进去，
-   *       这次发布就直接丢掉 /
-   *       Each publish directly calls one underlying `SPSCQueueBase::PushBytes()`;
-   *       if that push cannot fit, this publish is dropped immediately
    */
   template <typename Data>
   QueuedSubscriber(const char* name, SPSCQueue<Message<Data>>& queue,
-                   Domain* domain = nullptr)
-      : QueuedSubscriber(Topic(WaitTopic(name, UINT32_MAX, domain)), queue)
+                   Domain* domain = nullptr,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
+      : QueuedSubscriber(Topic(WaitTopic(name, UINT32_MAX, domain)), queue, policy,
+                         block_timeout_ms)
   {
   }
 
@@ -78,29 +245,28 @@ class Topic::QueuedSubscriber
    * @tparam Data 队列存储的数据类型 / Data type stored in the queue
    * @param topic 订阅的主题 / Subscribed topic
    * @param queue 订阅的数据队列 / Subscribed data queue
+   * @param policy 队列满时的策略，SPSC 队列不支持 `OVERWRITE_OLDEST` / Policy for a
+   *        full queue; SPSC queues do not support `OVERWRITE_OLDEST`
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
    * @note 包含初始化期动态内存分配，订阅者应长期存在 / Contains initialization-time
    * dynamic allocation; subscribers are expected to be long-lived
    * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
    *       为止 /
    *       Queued subscribers keep only a pointer to `queue`; the queue object
    *       itself must outlive the subscriber's use of it
-   * @note 每次发布都会直接调一次底层 `SPSCQueueBase::PushBytes()`；如果 push 不进去，
-   *       这次发布就直接丢掉 /
-   *       Each publish directly calls one underlying `SPSCQueueBase::PushBytes()`;
-   *       if that push cannot fit, this publish is dropped immediately
+   * @note SPSC 队列的消费侧不允许第二个消费者，发布侧无法挤掉最旧条目；传入
+   *       `OVERWRITE_OLDEST` 在任何构建下都会在构造时报致命错误 / An SPSC queue admits
+   *       no second consumer, so the publish side cannot evict its oldest entry;
+   *       passing `OVERWRITE_OLDEST` is a fatal error at construction in every build
    */
   template <typename Data>
-  QueuedSubscriber(Topic topic, SPSCQueue<Data>& queue)
+  QueuedSubscriber(Topic topic, SPSCQueue<Data>& queue,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
   {
-    Topic::CheckSubscriberType<Data>(topic);
-
-    block_ = new LockFreeList::Node<QueueBlock>;
-    block_->data_.type = SuberType::QUEUE;
-    block_->data_.queue = &queue;
-    block_->data_.fun = [](MicrosecondTimestamp, void* payload_addr, QueueBlock& block)
-    { (void)block.queue->PushBytes(payload_addr); };
-
-    topic.block_->data_.subers.Add(*block_);
+    REQUIRE(policy != QueueOverflowPolicy::OVERWRITE_OLDEST);
+    Attach<Data, false>(topic, &queue, nullptr, policy, block_timeout_ms);
   }
 
   /**
@@ -109,31 +275,66 @@ class Topic::QueuedSubscriber
    * @tparam Data 队列消息的数据类型 / Data type stored in the queue message
    * @param topic 订阅的主题 / Subscribed topic
    * @param queue 订阅的消息队列 / Subscribed message queue
+   * @param policy 队列满时的策略，SPSC 队列不支持 `OVERWRITE_OLDEST` / Policy for a
+   *        full queue; SPSC queues do not support `OVERWRITE_OLDEST`
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
    * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
    *       为止 /
    *       Queued subscribers keep only a pointer to `queue`; the queue object
    *       itself must outlive the subscriber's use of it
-   * @note 每次发布都会直接调一次底层 `SPSCQueueBase::PushBytes()`；如果 push 不进去，
-   *       这次发布就直接丢掉 /
-   *       Each publish directly calls one underlying `SPSCQueueBase::PushBytes()`;
-   *       if that push cannot fit, this publish is dropped immediately
    */
   template <typename Data>
-  QueuedSubscriber(Topic topic, SPSCQueue<Message<Data>>& queue)
+  QueuedSubscriber(Topic topic, SPSCQueue<Message<Data>>& queue,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
   {
-    Topic::CheckSubscriberType<Data>(topic);
+    REQUIRE(policy != QueueOverflowPolicy::OVERWRITE_OLDEST);
+    Attach<Data, true>(topic, &queue, nullptr, policy, block_timeout_ms);
+  }
 
-    block_ = new LockFreeList::Node<QueueBlock>;
-    block_->data_.type = SuberType::QUEUE;
-    block_->data_.queue = &queue;
-    block_->data_.fun =
-        [](MicrosecondTimestamp timestamp, void* payload_addr, QueueBlock& block)
-    {
-      Message<Data> message{timestamp, *reinterpret_cast<Data*>(payload_addr)};
-      (void)block.queue->PushBytes(&message);
-    };
+  /**
+   * @brief 使用 `Topic` 和 MPMC 队列构造订阅者 / Construct a subscriber from a `Topic`
+   * and an MPMC queue
+   * @tparam Data 队列存储的数据类型 / Data type stored in the queue
+   * @param topic 订阅的主题 / Subscribed topic
+   * @param queue 订阅的数据队列 / Subscribed data queue
+   * @param policy 队列满时的策略 / Policy for a full queue
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
+   * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
+   *       为止 /
+   *       Queued subscribers keep only a pointer to `queue`; the queue object
+   *       itself must outlive the subscriber's use of it
+   */
+  template <typename Data>
+  QueuedSubscriber(Topic topic, MPMCQueue<Data>& queue,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
+  {
+    Attach<Data, false>(topic, nullptr, &queue, policy, block_timeout_ms);
+  }
 
-    topic.block_->data_.subers.Add(*block_);
+  /**
+   * @brief 使用 `Topic` 和带时间戳消息的 MPMC 队列构造订阅者 / Construct a subscriber
+   * from a `Topic` and an MPMC queue of timestamped messages
+   * @tparam Data 队列消息的数据类型 / Data type stored in the queue message
+   * @param topic 订阅的主题 / Subscribed topic
+   * @param queue 订阅的消息队列 / Subscribed message queue
+   * @param policy 队列满时的策略 / Policy for a full queue
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
+   * @note 队列订阅者只保存 `queue` 的指针；队列对象本身必须至少活到订阅者不再使用
+   *       为止 /
+   *       Queued subscribers keep only a pointer to `queue`; the queue object
+   *       itself must outlive the subscriber's use of it
+   */
+  template <typename Data>
+  QueuedSubscriber(Topic topic, MPMCQueue<Message<Data>>& queue,
+                   QueueOverflowPolicy policy = QueueOverflowPolicy::DROP_NEWEST,
+                   uint32_t block_timeout_ms = 0)
+  {
+    Attach<Data, true>(topic, nullptr, &queue, policy, block_timeout_ms);
   }
 
   /**
@@ -182,7 +383,123 @@ class Topic::QueuedSubscriber
     return *this;
   }
 
+  /**
+   * @brief 给该订阅者挂上过滤器 / Attach a filter to this subscriber
+   * @param filter 决定哪些消息送达的过滤器，必须活得比订阅者久 / Filter deciding which
+   *        messages get delivered; it must outlive the subscriber
+   * @note 被过滤掉的消息不占队列槽位，也不计入丢包 / Filtered-out messages take no
+   *       queue slot and do not count as drops
+   */
+  void SetFilter(Filter& filter)
+  {
+    ASSERT(block_ != nullptr);
+    filter.CheckPayloadType(block_->data_.payload_type_id);
+    block_->data_.filter.store(&filter, std::memory_order_release);
+  }
+
+  /**
+   * @brief 摘掉过滤器，恢复接收全部消息 / Detach the filter and receive every message
+   *        again
+   */
+  void ClearFilter()
+  {
+    ASSERT(block_ != nullptr);
+    block_->data_.filter.store(nullptr, std::memory_order_release);
+  }
+
+  /**
+   * @brief 从订阅队列取出一个元素，并唤醒等待空间的 `BLOCK` 发布者 / Pop one element
+   *        from the subscribed queue and wake a `BLOCK` publisher waiting for room
+   * @tparam ElementType 队列元素类型，`Data` 或 `Message<Data>` / Queue element type,
+   *         `Data` or `Message<Data>`
+   * @param item 接收元素 / Receives the element
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename ElementType>
+  ErrorCode Pop(ElementType& item)
+  {
+    ASSERT(block_ != nullptr);
+    QueueBlock& block = block_->data_;
+    const ErrorCode ans = block.queue != nullptr ? block.queue->PopBytes(&item)
+                                                 : block.shared_queue->PopBytes(&item);
+    if (ans == ErrorCode::OK && block.policy == QueueOverflowPolicy::BLOCK)
+    {
+      block.not_full.NotifyOne();
+    }
+    return ans;
+  }
+
+  /**
+   * @brief 读取丢包数和最大队列深度 / Read the drop count and peak queue depth
+   * @return 当前计数快照 / Current counter snapshot
+   */
+  QueueStats GetStats() const
+  {
+    ASSERT(block_ != nullptr);
+    return {block_->data_.dropped.load(std::memory_order_relaxed),
+            block_->data_.high_watermark.load(std::memory_order_relaxed)};
+  }
+
+  /**
+   * @brief 清零丢包数和最大队列深度 / Clear the drop count and peak queue depth
+   */
+  void ResetStats()
+  {
+    ASSERT(block_ != nullptr);
+    block_->data_.dropped.store(0, std::memory_order_relaxed);
+    block_->data_.high_watermark.store(0, std::memory_order_relaxed);
+  }
+
  private:
+  /**
+   * @brief 创建订阅块并挂到 topic 上 / Create the subscriber block and attach it to the
+   *        topic
+   * @tparam Data payload 类型 / Payload type
+   * @tparam WITH_TIMESTAMP 队列元素是否为 `Message<Data>` / Whether queue elements are
+   *         `Message<Data>`
+   * @param topic 订阅的主题 / Subscribed topic
+   * @param queue SPSC 队列，或空 / SPSC queue, or null
+   * @param shared_queue MPMC 队列，或空 / MPMC queue, or null
+   * @param policy 队列满时的策略 / Policy for a full queue
+   * @param block_timeout_ms `BLOCK` 策略的最长等待毫秒数 / Longest wait of the `BLOCK`
+   *        policy in milliseconds
+   */
+  template <typename Data, bool WITH_TIMESTAMP>
+  void Attach(Topic topic, SPSCQueueBase* queue, MPMCQueueBase* shared_queue,
+              QueueOverflowPolicy policy, uint32_t block_timeout_ms)
+  {
+    Topic::CheckSubscriberType<Data>(topic);
+
+    block_ = new LockFreeList::Node<QueueBlock>;
+    block_->data_.type = SuberType::QUEUE;
+    block_->data_.queue = queue;
+    block_->data_.shared_queue = shared_queue;
+    block_->data_.payload_type_id = TypeID::GetID<Data>();
+    block_->data_.policy = policy;
+    block_->data_.block_timeout_ms = block_timeout_ms;
+    if constexpr (WITH_TIMESTAMP)
+    {
+      block_->data_.fun = [](MicrosecondTimestamp timestamp, void* payload_addr,
+                             QueueBlock& block, bool may_block)
+      {
+        Message<Data> message{timestamp, *reinterpret_cast<Data*>(payload_addr)};
+        return block.Push(&message, may_block);
+      };
+    }
+    else
+    {
+      block_->data_.fun = [](MicrosecondTimestamp, void* payload_addr, QueueBlock& block,
+                             bool may_block)
+      { return block.Push(payload_addr, may_block); };
+    }
+    block_->data_.batch_fun = [](const PublishBatchView& batch, QueueBlock& block,
+                                 bool may_block)
+    { return block.PushBatch<Data, WITH_TIMESTAMP>(batch, may_block); };
+
+    topic.block_->data_.subers.Add(*block_);
+  }
+
+
   LockFreeList::Node<QueueBlock>* block_ =
       nullptr;  ///< 订阅者数据块。Subscriber data block.
 };
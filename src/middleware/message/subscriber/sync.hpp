@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../topic.hpp"
+#include "filter.hpp"
 
 namespace LibXR
 {
@@ -142,6 +143,30 @@ class Topic::SyncSubscriber
     return *this;
   }
 
+  /**
+   * @brief 给该订阅者挂上过滤器 / Attach a filter to this subscriber
+   * @param filter 决定哪些消息送达的过滤器，必须活得比订阅者久 / Filter deciding which
+   *        messages get delivered; it must outlive the subscriber
+   * @note 抽取计数覆盖每一次发布，不论当时是否有人在 `Wait()` / Decimation counts
+   *       every publish, whether or not a `Wait()` is pending at the time
+   */
+  void SetFilter(Filter& filter)
+  {
+    ASSERT(block_ != nullptr);
+    filter.CheckPayloadType(TypeID::GetID<Data>());
+    block_->data_.filter.store(&filter, std::memory_order_release);
+  }
+
+  /**
+   * @brief 摘掉过滤器，恢复接收全部消息 / Detach the filter and receive every message
+   *        again
+   */
+  void ClearFilter()
+  {
+    ASSERT(block_ != nullptr);
+    block_->data_.filter.store(nullptr, std::memory_order_release);
+  }
+
   /**
    * @brief 等待接收数据 / Wait for data reception
    * @param timeout 超时时间，默认为 `UINT32_MAX` / Timeout period, default `UINT32_MAX`
@@ -1,10 +1,13 @@
 #include "topic.hpp"
 
 #include <atomic>
+#include <new>
 
 #include "crc.hpp"
+#include "executor/executor.hpp"
 #include "libxr_def.hpp"
 #include "mutex.hpp"
+#include "subscriber/callback.hpp"
 
 using namespace LibXR;
 
@@ -97,7 +100,7 @@ Topic::Domain::Domain(const char* name)
 
   auto crc32 = CRC32::Calculate(name, strlen(name));
 
-  auto domain = domain_->Search<RBTree<uint32_t>>(crc32);
+  auto domain = domain_->Search<TopicTable>(crc32);
 
   if (domain != nullptr)
   {
@@ -105,8 +108,7 @@ Topic::Domain::Domain(const char* name)
     return;
   }
 
-  node_ = new LibXR::RBTree<uint32_t>::Node<LibXR::RBTree<uint32_t>>(
-      [](const uint32_t& a, const uint32_t& b) { return (a > b) - (a < b); });
+  node_ = new LibXR::RBTree<uint32_t>::Node<TopicTable>();
 
   domain_->Insert(*node_, crc32);
 }
@@ -129,7 +131,8 @@ Topic::Topic(const char* name, TypeID::ID payload_type_id, size_t payload_size,
 
   auto crc32 = CRC32::Calculate(name, strlen(name));
 
-  auto topic = domain->node_->data_.Search<Block>(crc32);
+  auto* found = domain->node_->data_.index.Find(crc32);
+  auto topic = found != nullptr ? *found : nullptr;
 
   if (topic)
   {
@@ -151,6 +154,9 @@ Topic::Topic(const char* name, TypeID::ID payload_type_id, size_t payload_size,
     block_->data_.payload_size = payload_size;
     block_->data_.payload_alignment = payload_alignment;
     block_->data_.crc32 = crc32;
+    block_->data_.loan_pool.store(nullptr, std::memory_order_relaxed);
+    block_->data_.latest.store(nullptr, std::memory_order_relaxed);
+    block_->data_.stats.store(nullptr, std::memory_order_relaxed);
 
     if (multi_publisher)
     {
@@ -163,7 +169,8 @@ Topic::Topic(const char* name, TypeID::ID payload_type_id, size_t payload_size,
       block_->data_.busy.store(LockState::UNLOCKED, std::memory_order_release);
     }
 
-    domain->node_->data_.Insert(*block_, crc32);
+    domain->node_->data_.tree.Insert(*block_, crc32);
+    (void)domain->node_->data_.index.Insert(crc32, block_);
   }
 }
 
@@ -184,7 +191,8 @@ Topic::TopicHandle Topic::Find(const char* name, Domain* domain)
 
   auto crc32 = CRC32::Calculate(name, strlen(name));
 
-  return domain->node_->data_.Search<Block>(crc32);
+  auto* found = domain->node_->data_.index.Find(crc32);
+  return found != nullptr ? *found : nullptr;
 }
 
 Topic::TopicHandle Topic::WaitTopic(const char* name, uint32_t timeout, Domain* domain)
@@ -219,3 +227,69 @@ uint32_t Topic::GetKey() const
     return 0;
   }
 }
+
+ErrorCode Topic::UnregisterCallback(Callback& cb)
+{
+  LockFreeList::Node<CallbackBlock>* target = nullptr;
+  bool deferred = false;
+  (void)block_->data_.subers.ForeachNode<SuberBlock>(
+      [&](LockFreeList::Node<SuberBlock>& node)
+      {
+        if (node.data_.type == SuberType::DEFERRED_CALLBACK)
+        {
+          deferred = deferred ||
+                     reinterpret_cast<DeferredCallbackBlock&>(node.data_).cb == cb;
+        }
+        else if (node.data_.type == SuberType::CALLBACK &&
+                 reinterpret_cast<CallbackBlock&>(node.data_).cb == cb)
+        {
+          LockFreeList::BaseNode& base = node;
+          target = static_cast<LockFreeList::Node<CallbackBlock>*>(&base);
+          return ErrorCode::FAILED;
+        }
+        return ErrorCode::OK;
+      });
+  if (target == nullptr)
+  {
+    return deferred ? ErrorCode::NOT_SUPPORT : ErrorCode::NOT_FOUND;
+  }
+
+  std::atomic<bool> reclaimed = false;
+  target->data_.reclaimed = &reclaimed;
+  return RetireSubscriber(block_, *target, ReclaimCallbackNode, reclaimed);
+}
+
+void Topic::ReclaimCallbackNode(LockFreeList::BaseNode* node)
+{
+  auto* callback_node = static_cast<LockFreeList::Node<CallbackBlock>*>(node);
+  std::atomic<bool>* reclaimed = callback_node->data_.reclaimed;
+  callback_node->~Node<CallbackBlock>();
+  ::operator delete(callback_node, std::align_val_t(LibXR::CONCURRENCY_ALIGNMENT));
+  if (reclaimed != nullptr)
+  {
+    reclaimed->store(true, std::memory_order_release);
+  }
+}
+
+ErrorCode Topic::RetireSubscriber(TopicHandle topic, LockFreeList::BaseNode& node,
+                                  LockFreeList::Reclaimer reclaim,
+                                  std::atomic<bool>& reclaimed)
+{
+  const ErrorCode ans = topic->data_.subers.Retire(node, reclaim);
+  if (ans != ErrorCode::OK)
+  {
+    return ans;
+  }
+
+  // 发布线程可能优先级更低，睡眠而不是让出，保证它能跑完当前遍历。
+  // Publishers may run at a lower priority, so sleep rather than yield to let them
+  // finish their traversal.
+  while (!reclaimed.load(std::memory_order_acquire))
+  {
+    if (topic->data_.subers.Reclaim() == 0 && !reclaimed.load(std::memory_order_acquire))
+    {
+      Thread::Sleep(1);
+    }
+  }
+  return ErrorCode::OK;
+}
@@ -4,11 +4,14 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <type_traits>
 
 #include "libxr_cb.hpp"
 #include "libxr_def.hpp"
 #include "libxr_time.hpp"
 #include "libxr_type.hpp"
+#include "flat_hash_map.hpp"
 #include "lockfree_list.hpp"
 #include "mutex.hpp"
 #include "queue.hpp"
@@ -47,10 +50,25 @@ constexpr void CheckTopicPayload()
  * @brief 发布订阅主题 / Publish-subscribe topic
  *
  * 一个 `Topic` 表示一种精确类型的消息通道：它在每次发布时同步通知挂在上面的同步、
- * 异步、队列或回调订阅者，但自身不缓存最近一次消息。
+ * 异步、队列或回调订阅者；默认不缓存最近一次消息，需要时可用 `EnableLatest()` 按
+ * topic 打开最新值缓存。
  * One `Topic` represents one exact-typed message channel: it synchronously notifies
  * the attached synchronous, asynchronous, queued, or callback subscribers on each
- * publish, but does not cache the latest message itself.
+ * publish. It does not cache the latest message by default; `EnableLatest()` turns on
+ * a per-topic latest-value cache when needed.
+ *
+ * 每次发布先唤醒同步、异步、队列订阅者并把执行器回调入队，最后才执行内联回调，
+ * 因此这些快路径订阅者的延迟不受回调耗时影响。
+ * Each publish first wakes synchronous, asynchronous, and queued subscribers and
+ * enqueues executor callbacks, and runs inline callbacks last, so the latency seen by
+ * those fast-path subscribers does not depend on callback cost.
+ *
+ * 只有内联回调（`UnregisterCallback()`）和 `LoanQueuedSubscriber` 可以注销；同步、
+ * 异步、队列订阅者和执行器回调挂上后不能摘除，其订阅对象与缓冲区须与 topic 同寿命。
+ * Only inline callbacks (`UnregisterCallback()`) and `LoanQueuedSubscriber` can be
+ * detached. Synchronous, asynchronous, and queued subscribers and executor callbacks
+ * cannot be removed once attached, so their subscriber objects and buffers must live
+ * as long as the topic.
  */
 class Topic
 {
@@ -72,12 +90,19 @@ class Topic
    * @struct Block
    * @brief topic 运行时状态块 / Runtime state block of one topic
    *
-   * @note 当前 topic 自身不缓存最近一次消息值；这里只保存类型契约、名称键值、发布串行化
-   *       状态以及订阅链表。
-   *       The topic no longer caches the latest payload value itself; this block
-   *       keeps only the type contract, topic key, publish-serialization state,
-   *       and subscriber list.
+   * @note 这里保存类型契约、名称键值、发布串行化状态以及订阅链表；最新值缓存、出借池
+   *       和运行统计都是按需启用的可选部件。
+   *       This block keeps the type contract, topic key, publish-serialization state,
+   *       and subscriber list; the latest-value cache, loan pool, and runtime
+   *       statistics are optional parts enabled on demand.
    */
+  struct LoanSlot;
+  class LoanPool;
+  struct LatestStore;
+  template <typename Data>
+  struct LatestValue;
+  struct StatsStore;
+
   struct Block
   {
     std::atomic<LockState>
@@ -91,6 +116,13 @@ class Topic
                                  ///< alignment of this topic.
     uint32_t crc32;              ///< 主题名 CRC32 键。CRC32 key of the topic name.
     Mutex* mutex;  ///< 多发布者主题使用的互斥量。Mutex used by multi-publisher topics.
+    std::atomic<LoanPool*> loan_pool;  ///< 零拷贝发布使用的出借池，未启用时为空。Loan
+                                       ///< pool used by zero-copy publishes, null when
+                                       ///< disabled.
+    std::atomic<LatestStore*> latest;  ///< 最新值缓存，未启用时为空。Latest-value
+                                       ///< cache, null when disabled.
+    std::atomic<StatsStore*> stats;  ///< 运行统计，未启用时为空。Runtime statistics,
+                                     ///< null when disabled.
   };
 
 #ifndef __DOXYGEN__
@@ -108,15 +140,45 @@ class Topic
    */
   template <typename Data>
   class PackedData;
+
+  /**
+   * @class PackedDataCRC32C
+   * @brief 带固定头和尾 CRC32C 的打包消息对象 / Packed message object with fixed header
+   *        and trailing CRC32C
+   * @tparam Data 负载类型 / Payload type
+   */
+  template <typename Data>
+  class PackedDataCRC32C;
   static constexpr uint8_t PACKET_PREFIX =
       0x5A;  ///< 打包消息前缀字节。Packed-message prefix byte.
   static constexpr uint8_t PACKET_VERSION =
       0x01;  ///< 打包消息协议版本。Packed-message protocol version.
+  static constexpr uint8_t PACKET_VERSION_CRC32C =
+      0x02;  ///< 尾部改用 CRC32C 的协议版本。Protocol version with a trailing CRC32C.
+  static constexpr uint8_t PACKET_VERSION_BATCH =
+      0x03;  ///< 一帧装多条消息、尾部 CRC32C 的协议版本。Protocol version carrying
+             ///< several messages in one frame with a trailing CRC32C.
   static constexpr size_t PACK_BASE_SIZE =
       17;  ///< 固定非 payload 开销：16 字节头 + 1 字节尾 CRC8。Fixed non-payload
            ///< overhead: 16-byte header plus 1-byte trailing CRC8.
+  static constexpr size_t PACK_BASE_SIZE_CRC32C =
+      20;  ///< CRC32C 版本的非 payload 开销：16 字节头 + 4 字节尾 CRC32C。Non-payload
+           ///< overhead of the CRC32C version: 16-byte header plus 4-byte CRC32C.
 #endif
 
+  /**
+   * @brief 获取某个 packet 版本的非 payload 开销 / Get the non-payload overhead of one
+   *        packet version
+   * @param version packet 版本 / Packet version
+   * @return 非 payload 字节数 / Non-payload byte count
+   */
+  static constexpr size_t PackBaseSize(uint8_t version)
+  {
+    return version == PACKET_VERSION_CRC32C || version == PACKET_VERSION_BATCH
+               ? PACK_BASE_SIZE_CRC32C
+               : PACK_BASE_SIZE;
+  }
+
   /**
    * @typedef TopicHandle
    * @brief 指向一个 topic 运行时状态块的句柄 / Handle pointing to one topic runtime
@@ -212,7 +274,57 @@ class Topic
      */
     Domain(const char* name);
 
-    RBTree<uint32_t>::Node<RBTree<uint32_t>>*
+    /**
+     * @brief 按名称 CRC32 顺序遍历域内全部 topic / Visit every topic of the domain in
+     *        name-CRC32 order
+     * @tparam Func 可调用对象，签名为 `ErrorCode(Topic)` / Callable with signature
+     *         `ErrorCode(Topic)`
+     * @param func 对每个 topic 调用；返回非 `OK` 时提前结束 / Called for each topic;
+     *        returning anything other than `OK` stops the walk early
+     * @return 全部访问完返回 `ErrorCode::OK`，否则返回 `func` 的结果 / Returns
+     *         `ErrorCode::OK` after visiting every topic, otherwise the result of
+     *         `func`
+     * @note 遍历期间持有域表锁，`func` 里不能在同一个域创建 topic / The domain table
+     *       lock is held during the walk, so `func` must not create topics in the
+     *       same domain
+     */
+    template <typename Func>
+    ErrorCode Foreach(Func func)
+    {
+      return node_->data_.tree.Foreach<Block>(
+          [&](RBTree<uint32_t>::Node<Block>& node) { return func(Topic(&node)); });
+    }
+
+    /**
+     * @brief 为域内已创建的全部 topic 启用运行统计 / Enable runtime statistics on every
+     *        topic already created in the domain
+     * @return 操作结果错误码 / Error code
+     * @note 之后新建的 topic 不受影响 / Topics created afterwards are not affected
+     */
+    ErrorCode EnableStats();
+
+    /**
+     * @struct TopicTable
+     * @brief 域内 topic 表 / Topic table of one domain
+     *
+     * @note 红黑树持有 topic 节点；按名称查找走平铺哈希索引，不再沿树逐层追指针。
+     *       The red-black tree owns the topic nodes; lookups by name go through the
+     *       flat hash index instead of chasing pointers down the tree.
+     */
+    struct TopicTable
+    {
+      TopicTable()
+          : tree([](const uint32_t& a, const uint32_t& b) { return (a > b) - (a < b); })
+      {
+      }
+
+      RBTree<uint32_t> tree;  ///< 按名称 CRC32 存放的 topic 节点。Topic nodes keyed by
+                              ///< name CRC32.
+      FlatHashMap<TopicHandle> index;  ///< 名称 CRC32 到 topic 句柄的查找索引。Lookup
+                                       ///< index from name CRC32 to topic handle.
+    };
+
+    RBTree<uint32_t>::Node<TopicTable>*
         node_;  ///< 该域在全局域表里的节点。This domain's node inside the global domain
                 ///< tree.
   };
@@ -227,8 +339,55 @@ class Topic
     ASYNC,     ///< 异步本地缓冲型订阅者。Asynchronous local-buffer subscriber.
     QUEUE,     ///< 队列转发型订阅者。Queue-forwarding subscriber.
     CALLBACK,  ///< 回调执行型订阅者。Callback-executing subscriber.
+    LOAN_QUEUE,  ///< 出借槽位引用队列型订阅者。Loan-slot reference-queue subscriber.
+    DEFERRED_CALLBACK,  ///< 由执行器执行的回调订阅者。Callback subscriber run by an
+                        ///< executor.
   };
 
+  static constexpr size_t SUBER_TYPE_NUM =
+      static_cast<size_t>(SuberType::DEFERRED_CALLBACK) +
+      1;  ///< 订阅者种类个数，随最后一个枚举值变化。Number of subscriber kinds,
+          ///< following the last enumerator.
+  static constexpr size_t STATS_DISPATCH_BUCKETS =
+      10;  ///< 分发耗时直方图桶数。Bucket count of the dispatch-time histogram.
+
+  /**
+   * @struct TopicStats
+   * @brief 一个 topic 运行统计的快照 / Snapshot of the runtime statistics of one topic
+   *
+   * 分发耗时按微秒取 log2 分桶：第 0 桶不足 1 us，第 i 桶为 [2^(i-1), 2^i) us，最后
+   * 一桶收纳更长的分发。每次分发调用记一个样本，批量发布整批只记一次。
+   * Dispatch time is bucketed by log2 of microseconds: bucket 0 holds dispatches under
+   * 1 us, bucket i holds [2^(i-1), 2^i) us, and the last bucket takes everything
+   * longer. Each dispatch call is one sample, so a batch publish counts once.
+   */
+  struct TopicStats
+  {
+    uint32_t key;           ///< topic 名称 CRC32。CRC32 of the topic name.
+    uint32_t payload_size;  ///< payload 字节数。Payload size in bytes.
+    uint64_t published;     ///< 已发布消息数。Messages published.
+    uint64_t published_bytes;   ///< 已发布 payload 字节数。Payload bytes published.
+    uint64_t dispatches;        ///< 分发调用次数。Dispatch calls.
+    uint64_t dispatch_time_us;  ///< 分发累计耗时。Total dispatch time in us.
+    uint32_t dispatch_max_us;   ///< 单次分发最长耗时。Longest single dispatch in us.
+    uint32_t dispatch_histogram[STATS_DISPATCH_BUCKETS];  ///< 分发耗时直方图。Dispatch
+                                                           ///< time histogram.
+    uint64_t delivered[SUBER_TYPE_NUM];  ///< 按订阅者种类统计的投递次数，下标为
+                                         ///< `SuberType`，被过滤器拒绝或被满队列丢弃
+                                         ///< 的不计。Deliveries per subscriber kind,
+                                         ///< indexed by `SuberType`, excluding
+                                         ///< messages rejected by a filter or dropped
+                                         ///< by a full queue.
+    uint32_t subscribers[SUBER_TYPE_NUM];  ///< 当前挂接的各种类订阅者数。Subscribers
+                                           ///< currently attached per kind.
+  };
+
+  /**
+   * @class Filter
+   * @brief 订阅者侧的抽取与内容过滤器 / Subscriber-side decimation and content filter
+   */
+  class Filter;
+
   /**
    * @struct SuberBlock
    * @brief 所有订阅块共用的公共头 / Common header shared by all subscriber blocks
@@ -236,6 +395,9 @@ class Topic
   struct SuberBlock
   {
     SuberType type;  ///< 订阅块的具体种类。Concrete kind of this subscriber block.
+    std::atomic<Filter*> filter = nullptr;  ///< 投递前先过的过滤器，为空时全部接收。
+                                            ///< Filter applied before delivery; null
+                                            ///< accepts everything.
   };
 
   /**
@@ -276,6 +438,31 @@ class Topic
   template <typename Data>
   class ASyncSubscriber;
 
+  /**
+   * @enum QueueOverflowPolicy
+   * @brief 队列订阅者在队列满时的处理策略 / What a queued subscriber does when its
+   *        queue is full
+   */
+  enum class QueueOverflowPolicy : uint8_t
+  {
+    DROP_NEWEST,       ///< 丢弃本次发布。Drop the current publish.
+    OVERWRITE_OLDEST,  ///< 挤掉队头最旧的一条，仅支持 MPMC 队列。Evict the oldest
+                       ///< queued entry; MPMC queues only.
+    BLOCK,  ///< 等消费者腾出空间，超时后丢弃本次发布。Wait for the consumer to make
+            ///< room and drop the publish after the timeout.
+  };
+
+  /**
+   * @struct QueueStats
+   * @brief 队列订阅者的运行时计数 / Runtime counters of one queued subscriber
+   */
+  struct QueueStats
+  {
+    uint32_t dropped;  ///< 因队列满而丢掉的消息数。Messages lost to a full queue.
+    uint32_t high_watermark;  ///< 入队后观察到的最大队列深度。Largest queue depth seen
+                              ///< after a push.
+  };
+
   /**
    * @struct QueueBlock
    * @brief 队列订阅者挂在 topic 链表里的数据块 / Subscriber block used by one queued
@@ -303,6 +490,43 @@ class Topic
    */
   struct CallbackBlock;
 
+  /**
+   * @struct LoanQueueBlock
+   * @brief 引用队列订阅者挂在 topic 链表里的数据块 / Subscriber block used by one
+   *        reference-queue subscriber inside the topic list
+   */
+  struct LoanQueueBlock;
+
+  /**
+   * @class CallbackExecutor
+   * @brief 在工作线程上执行回调订阅者的执行器 / Executor that runs callback subscribers
+   *        on worker threads
+   */
+  class CallbackExecutor;
+
+  /**
+   * @struct DeferredCallbackBlock
+   * @brief 绑定到执行器的回调订阅块 / Callback subscriber block bound to an executor
+   */
+  struct DeferredCallbackBlock;
+
+  /**
+   * @class LoanQueuedSubscriber
+   * @brief 把出借槽位引用推入队列的订阅者 / Subscriber that pushes loan-slot references
+   *        into a queue
+   * @tparam Data 订阅的数据类型 / Subscribed data type
+   */
+  template <typename Data>
+  class LoanQueuedSubscriber;
+
+  /**
+   * @class LoanedData
+   * @brief 指向出借槽位的独占式句柄 / Move-only handle referring to one loaned slot
+   * @tparam Data payload 类型 / Payload type
+   */
+  template <typename Data>
+  class LoanedData;
+
   /**
    * @class Server
    * @brief 把字节流解析成 packet 并投递到 topic 的 parser / Parser that turns byte
@@ -310,12 +534,85 @@ class Topic
    */
   class Server;
 
+#ifndef __DOXYGEN__
+  /**
+   * @struct PackedBatchEntryHeader
+   * @brief 批量帧内单条消息的紧凑头 / Compact header of one message inside a batch
+   *        frame
+   */
+  struct PackedBatchEntryHeader;
+#endif
+
+  /**
+   * @class BatchPacker
+   * @brief 把多条消息攒进一个批量帧的打包器 / Packer accumulating several messages into
+   *        one batch frame
+   */
+  class BatchPacker;
+
   /**
    * @brief 注册一个回调订阅者 / Register one callback subscriber
    * @param cb 要注册的回调句柄 / Callback handle to register
    */
   void RegisterCallback(Callback& cb);
 
+  /**
+   * @brief 注册一个在执行器工作线程上运行的回调订阅者 / Register one callback
+   *        subscriber that runs on an executor worker thread
+   * @param cb 要注册的回调句柄 / Callback handle to register
+   * @param executor 执行回调的执行器 / Executor running the callback
+   * @param queue_depth 该回调可积压的消息数 / Messages this callback may queue
+   * @return 成功返回 `ErrorCode::OK`；所有工作线程都已绑满时返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::FULL` when every worker
+   *         is already bound to its limit
+   */
+  ErrorCode RegisterCallback(Callback& cb, CallbackExecutor& executor,
+                             size_t queue_depth = 8);
+
+  /**
+   * @brief 注册一个带过滤器的回调订阅者 / Register one callback subscriber behind a
+   *        filter
+   * @param cb 要注册的回调句柄 / Callback handle to register
+   * @param filter 决定哪些消息送进回调的过滤器 / Filter deciding which messages reach
+   *        the callback
+   */
+  void RegisterCallback(Callback& cb, Filter& filter);
+
+  /**
+   * @brief 注册一个带过滤器、在执行器上运行的回调订阅者 / Register one filtered
+   *        callback subscriber that runs on an executor
+   * @param cb 要注册的回调句柄 / Callback handle to register
+   * @param executor 执行回调的执行器 / Executor running the callback
+   * @param filter 决定哪些消息入队的过滤器 / Filter deciding which messages get queued
+   * @param queue_depth 该回调可积压的消息数 / Messages this callback may queue
+   * @return 成功返回 `ErrorCode::OK`；所有工作线程都已绑满时返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::FULL` when every worker
+   *         is already bound to its limit
+   */
+  ErrorCode RegisterCallback(Callback& cb, CallbackExecutor& executor, Filter& filter,
+                             size_t queue_depth = 8);
+
+  /**
+   * @brief 注销一个回调订阅者 / Unregister one callback subscriber
+   *
+   * 订阅块先从链表摘下，再推进订阅链表的宽限期直到它被回收；返回后不会再有发布者
+   * 运行该回调，调用方可以立即释放回调绑定的参数。会等待进行中的发布，不能在 ISR 或
+   * 本 topic 的回调里调用。
+   * The subscriber block is retired from the list first, then the list grace period
+   * is advanced until the block is reclaimed. On return no publisher can still be
+   * running the callback, so the caller may free its bound argument right away. Waits
+   * for in-flight publishes, so it must not be called from an ISR or from a callback
+   * of this topic.
+   *
+   * @param cb 注册时使用的回调句柄或其拷贝 / Callback handle used at registration, or a
+   *        copy of it
+   * @return 成功返回 `ErrorCode::OK`；未注册返回 `ErrorCode::NOT_FOUND`；通过执行器注册
+   *         的回调返回 `ErrorCode::NOT_SUPPORT` / `ErrorCode::OK` on success;
+   *         `ErrorCode::NOT_FOUND` when not registered; `ErrorCode::NOT_SUPPORT` for
+   *         callbacks registered through an executor
+   */
+  ErrorCode UnregisterCallback(Callback& cb);
+
   /**
    * @brief 读取当前时间戳 / Read the current timestamp
    * @return 当前时间戳 / Current timestamp
@@ -481,6 +778,256 @@ class Topic
     PublishTyped(data, timestamp, true, in_isr);
   }
 
+  /**
+   * @brief 在普通上下文里一次发布一批消息，全部取当前时间戳 / Publish a burst of
+   *        messages in normal context, all stamped with the current time
+   * @tparam Data payload 类型，可带 const / Payload type, may be const-qualified
+   * @tparam Extent span 的静态长度 / Static extent of the span
+   * @param data 按发布顺序排列的 payload / Payloads in publish order
+   *
+   * @note 整批只加一次锁、只遍历一次订阅链表；队列订阅者一次批量入队，其他订阅者
+   *       逐条收到，每个订阅者看到的顺序与 `data` 一致。`latest` 缓存只保留最后一条。
+   *       The whole burst takes the lock once and walks the subscriber list once;
+   *       queue subscribers enqueue it in one batch, other subscribers receive it
+   *       message by message, and every subscriber sees the order of `data`. The
+   *       `latest` cache keeps only the last message.
+   */
+  template <typename Data, size_t Extent>
+  void PublishBatch(std::span<Data, Extent> data)
+  {
+    PublishBatchTyped<std::remove_const_t<Data>>(data, nullptr, NowTimestamp(), false,
+                                                 false);
+  }
+
+  /**
+   * @brief 在普通上下文里按逐条时间戳发布一批消息 / Publish a burst of messages in
+   *        normal context with one timestamp per message
+   * @tparam Data payload 类型，可带 const / Payload type, may be const-qualified
+   * @tparam Extent span 的静态长度 / Static extent of the span
+   * @param data 按发布顺序排列的 payload / Payloads in publish order
+   * @param timestamps 与 `data` 一一对应的时间戳 / Timestamps matching `data` one to
+   *        one
+   */
+  template <typename Data, size_t Extent>
+  void PublishBatch(std::span<Data, Extent> data,
+                    std::span<const MicrosecondTimestamp> timestamps)
+  {
+    ASSERT(timestamps.size() == data.size());
+    PublishBatchTyped<std::remove_const_t<Data>>(data, timestamps.data(),
+                                                 MicrosecondTimestamp(), false, false);
+  }
+
+  /**
+   * @brief 在回调或 ISR 路径里一次发布一批消息，全部取当前时间戳 / Publish a burst of
+   *        messages from callback or ISR context, all stamped with the current time
+   * @tparam Data payload 类型，可带 const / Payload type, may be const-qualified
+   * @tparam Extent span 的静态长度 / Static extent of the span
+   * @param data 按发布顺序排列的 payload / Payloads in publish order
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   */
+  template <typename Data, size_t Extent>
+  void PublishBatchFromCallback(std::span<Data, Extent> data, bool in_isr)
+  {
+    PublishBatchTyped<std::remove_const_t<Data>>(data, nullptr, NowTimestamp(), true,
+                                                 in_isr);
+  }
+
+  /**
+   * @brief 在回调或 ISR 路径里按逐条时间戳发布一批消息 / Publish a burst of messages
+   *        from callback or ISR context with one timestamp per message
+   * @tparam Data payload 类型，可带 const / Payload type, may be const-qualified
+   * @tparam Extent span 的静态长度 / Static extent of the span
+   * @param data 按发布顺序排列的 payload / Payloads in publish order
+   * @param timestamps 与 `data` 一一对应的时间戳 / Timestamps matching `data` one to
+   *        one
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   */
+  template <typename Data, size_t Extent>
+  void PublishBatchFromCallback(std::span<Data, Extent> data,
+                                std::span<const MicrosecondTimestamp> timestamps,
+                                bool in_isr)
+  {
+    ASSERT(timestamps.size() == data.size());
+    PublishBatchTyped<std::remove_const_t<Data>>(data, timestamps.data(),
+                                                 MicrosecondTimestamp(), true, in_isr);
+  }
+
+  /**
+   * @brief 为该 topic 启用零拷贝出借池 / Enable the zero-copy loan pool of this topic
+   * @param slot_count 池内槽位个数 / Number of slots in the pool
+   * @return 操作结果错误码；已启用时直接返回 `ErrorCode::OK` / Error code; returns
+   *         `ErrorCode::OK` directly when the pool is already enabled
+   * @note 包含初始化期动态内存分配，应在开始发布前调用 / Contains initialization-time
+   *       dynamic allocation and should be called before publishing starts
+   */
+  ErrorCode EnableLoan(size_t slot_count);
+
+  /**
+   * @brief 为该 topic 启用最新值缓存 / Enable the latest-value cache of this topic
+   * @tparam Data payload 类型 / Payload type
+   * @return 操作结果错误码；已启用时直接返回 `ErrorCode::OK` / Error code; returns
+   *         `ErrorCode::OK` directly when the cache is already enabled
+   * @note 启用后每次发布额外写一次三槽快照，读者用 `GetLatest()` 按需取值，不必挂在
+   *       分发链表上。包含一次动态内存分配，可在发布进行中调用；启用前的发布不会被
+   *       缓存 /
+   *       Once enabled, each publish additionally writes one triple-slot snapshot, and
+   *       readers fetch on demand through `GetLatest()` without sitting on the
+   *       dispatch list. Contains one dynamic allocation and may be called while
+   *       publishing is under way; publishes before enabling are not cached
+   */
+  template <typename Data>
+  ErrorCode EnableLatest();
+
+  /**
+   * @brief 读取该 topic 最近一次发布的消息 / Read the most recently published message
+   *        of this topic
+   * @tparam Data payload 类型 / Payload type
+   * @param message 接收时间戳和 payload 副本的输出 / Output receiving the timestamp and
+   *        a payload copy
+   * @return 成功返回 `ErrorCode::OK`；未启用缓存返回 `ErrorCode::NOT_SUPPORT`；尚无
+   *         发布返回 `ErrorCode::EMPTY`；另一读者正在拷贝时返回 `ErrorCode::BUSY`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::NOT_SUPPORT` when the
+   *         cache is disabled; `ErrorCode::EMPTY` before the first publish;
+   *         `ErrorCode::BUSY` while another reader is copying
+   * @note 不阻塞发布者，也不等待其他读者，可在 ISR 中调用 / Never blocks publishers
+   *       nor waits for other readers, and may be called from ISR context
+   */
+  template <typename Data>
+  ErrorCode GetLatest(Message<Data>& message);
+
+  /**
+   * @brief 为该 topic 启用运行统计 / Enable runtime statistics of this topic
+   * @return 操作结果错误码；已启用时直接返回 `ErrorCode::OK` / Error code; returns
+   *         `ErrorCode::OK` directly when statistics are already enabled
+   * @note 启用后每次分发额外读两次时间戳并更新几个原子计数；未启用时发布路径只多一次
+   *       空指针判断。包含一次动态内存分配，可在发布进行中调用 /
+   *       Once enabled, each dispatch additionally reads the clock twice and updates
+   *       a few atomic counters; when disabled the publish path only pays one null
+   *       check. Contains one dynamic allocation and may be called while publishing
+   *       is under way
+   */
+  ErrorCode EnableStats();
+
+  /**
+   * @brief 读取该 topic 的运行统计 / Read the runtime statistics of this topic
+   * @param stats 接收快照的输出 / Output receiving the snapshot
+   * @return 成功返回 `ErrorCode::OK`；未启用统计返回 `ErrorCode::NOT_SUPPORT`，此时
+   *         仍会填好键值、payload 大小和订阅者数 / Returns `ErrorCode::OK` on success;
+   *         `ErrorCode::NOT_SUPPORT` when statistics are disabled, in which case the
+   *         key, payload size, and subscriber counts are still filled in
+   * @note 各计数分别读取，发布进行中取到的快照不保证彼此严格一致 / Counters are read one
+   *       by one, so a snapshot taken while publishing is not strictly consistent
+   *       across fields
+   */
+  ErrorCode GetStats(TopicStats& stats) const;
+
+  /**
+   * @brief 清零该 topic 的运行统计 / Clear the runtime statistics of this topic
+   * @return 成功返回 `ErrorCode::OK`；未启用统计返回 `ErrorCode::NOT_SUPPORT` /
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::NOT_SUPPORT` when
+   *         statistics are disabled
+   */
+  ErrorCode ResetStats();
+
+  /**
+   * @brief 打印域内 topic 统计的终端命令 / Terminal command printing the topic
+   *        statistics of one domain
+   *
+   * 不带参数时逐个 topic 打印计数；`enable` 为域内已有 topic 启用统计；`reset` 清零
+   * 全部计数。签名与 `RamFS::CreateFile()` 的可执行文件一致，可直接注册：
+   * Without arguments it prints the counters topic by topic; `enable` turns on
+   * statistics for the topics already in the domain; `reset` clears every counter.
+   * The signature matches executable files of `RamFS::CreateFile()`, so it can be
+   * registered directly:
+   * `RamFS::CreateFile<Topic::Domain*>("topic_stats", Topic::StatsCommand, &domain)`
+   * @param domain 目标域，为空时使用默认域 / Target domain, the default domain when
+   *        null
+   * @param argc 参数个数 / Argument count
+   * @param argv 参数数组，`argv[0]` 为命令名 / Argument array, `argv[0]` being the
+   *        command name
+   * @return 成功返回 0，参数错误返回 -1 / Returns 0 on success, -1 on bad arguments
+   */
+  static int StatsCommand(Domain* domain, int argc, char** argv);
+
+  /**
+   * @brief 从出借池借一个可写槽位 / Borrow one writable slot from the loan pool
+   * @tparam Data payload 类型 / Payload type
+   * @param data 接收槽位的句柄；原有引用会先被释放 / Handle receiving the slot; any
+   *        reference it held is released first
+   * @return 成功返回 `ErrorCode::OK`；未启用出借池返回 `ErrorCode::NOT_SUPPORT`；
+   *         池已耗尽返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::NOT_SUPPORT` when the
+   *         loan pool is disabled; `ErrorCode::EMPTY` when the pool is exhausted
+   */
+  template <typename Data>
+  ErrorCode Loan(LoanedData<Data>& data);
+
+  /**
+   * @brief 在普通上下文里发布一个出借槽位，并自动取当前时间戳 / Publish one loaned
+   *        slot in normal context and stamp it with the current time
+   * @tparam Data payload 类型 / Payload type
+   * @param data 由 `Loan()` 取得的句柄，发布后被清空 / Handle obtained from `Loan()`,
+   *        cleared after publishing
+   * @return 操作结果错误码 / Error code
+   * @note 异步订阅者和引用队列订阅者只持有槽位引用，不拷贝 payload；同步和回调订阅
+   *       者的行为与 `Publish()` 相同 /
+   *       Async and reference-queue subscribers only hold a slot reference without
+   *       copying the payload; sync and callback subscribers behave as with
+   *       `Publish()`
+   */
+  template <typename Data>
+  ErrorCode PublishLoan(LoanedData<Data>& data)
+  {
+    return PublishLoanTyped(data, NowTimestamp(), false, false);
+  }
+
+  /**
+   * @brief 在普通上下文里按指定时间戳发布一个出借槽位 / Publish one loaned slot in
+   *        normal context with an explicit timestamp
+   * @tparam Data payload 类型 / Payload type
+   * @param data 由 `Loan()` 取得的句柄，发布后被清空 / Handle obtained from `Loan()`,
+   *        cleared after publishing
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PublishLoan(LoanedData<Data>& data, MicrosecondTimestamp timestamp)
+  {
+    return PublishLoanTyped(data, timestamp, false, false);
+  }
+
+  /**
+   * @brief 在回调或 ISR 路径里发布一个出借槽位，并自动取当前时间戳 / Publish one
+   *        loaned slot from callback or ISR context and stamp it with the current time
+   * @tparam Data payload 类型 / Payload type
+   * @param data 由 `Loan()` 取得的句柄，发布后被清空 / Handle obtained from `Loan()`,
+   *        cleared after publishing
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PublishLoanFromCallback(LoanedData<Data>& data, bool in_isr)
+  {
+    return PublishLoanTyped(data, NowTimestamp(), true, in_isr);
+  }
+
+  /**
+   * @brief 在回调或 ISR 路径里按指定时间戳发布一个出借槽位 / Publish one loaned slot
+   *        from callback or ISR context with an explicit timestamp
+   * @tparam Data payload 类型 / Payload type
+   * @param data 由 `Loan()` 取得的句柄，发布后被清空 / Handle obtained from `Loan()`,
+   *        cleared after publishing
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PublishLoanFromCallback(LoanedData<Data>& data,
+                                    MicrosecondTimestamp timestamp, bool in_isr)
+  {
+    return PublishLoanTyped(data, timestamp, true, in_isr);
+  }
+
   /**
    * @brief 供 packet/server 路径按字节发布一条消息 / Publish one message from the
    *        packet/server path using bytes already arranged as the exact payload object
@@ -540,6 +1087,34 @@ class Topic
   ErrorCode PackData(const Data& data, PackedData<Data>& packet,
                      MicrosecondTimestamp timestamp);
 
+  /**
+   * @brief 将一个精确类型消息打包成尾部带 CRC32C 的 packet / Pack one exact-typed
+   *        message into one packet with a trailing CRC32C
+   * @tparam Data 负载类型 / Payload type
+   * @param data 待打包 payload / Payload to pack
+   * @param packet 输出 packet 对象 / Output packed message object
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PackData(const Data& data, PackedDataCRC32C<Data>& packet)
+  {
+    return PackData(data, packet, NowTimestamp());
+  }
+
+  /**
+   * @brief 将一个精确类型消息按指定时间戳打包成尾部带 CRC32C 的 packet / Pack one
+   *        exact-typed message into one packet with a trailing CRC32C and the given
+   *        timestamp
+   * @tparam Data 负载类型 / Payload type
+   * @param data 待打包 payload / Payload to pack
+   * @param packet 输出 packet 对象 / Output packed message object
+   * @param timestamp 指定时间戳 / Explicit timestamp
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PackData(const Data& data, PackedDataCRC32C<Data>& packet,
+                     MicrosecondTimestamp timestamp);
+
   /**
    * @brief 将一段 raw payload 按当前 topic 元数据打包成 packet / Pack a raw payload
    *        byte view into one packet using the current topic metadata and current
@@ -564,6 +1139,28 @@ class Topic
    */
   ErrorCode PackRaw(ConstRawData data, RawData packet, MicrosecondTimestamp timestamp)
   {
+    return PackRaw(data, packet, timestamp, PACKET_VERSION);
+  }
+
+  /**
+   * @brief 将一段 raw payload 按指定时间戳和 packet 版本打包 / Pack a raw payload byte
+   *        view with the given timestamp and packet version
+   * @param data 待打包 payload 字节 / Payload bytes to pack
+   * @param packet 输出 packet 缓冲区，至少 `PackBaseSize(version) + data.size_` 字节 /
+   *        Output packet buffer of at least `PackBaseSize(version) + data.size_` bytes
+   * @param timestamp 指定时间戳 / Explicit timestamp
+   * @param version `PACKET_VERSION` 或 `PACKET_VERSION_CRC32C` / `PACKET_VERSION` or
+   *        `PACKET_VERSION_CRC32C`
+   * @return 操作结果错误码 / Error code
+   */
+  ErrorCode PackRaw(ConstRawData data, RawData packet, MicrosecondTimestamp timestamp,
+                    uint8_t version)
+  {
+    if (version != PACKET_VERSION && version != PACKET_VERSION_CRC32C)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
     if (block_ == nullptr || data.addr_ == nullptr || packet.addr_ == nullptr)
     {
       return ErrorCode::PTR_NULL;
@@ -574,12 +1171,12 @@ class Topic
       return ErrorCode::SIZE_ERR;
     }
 
-    if (packet.size_ < PACK_BASE_SIZE + data.size_)
+    if (packet.size_ < PackBaseSize(version) + data.size_)
     {
       return ErrorCode::NO_BUFF;
     }
 
-    PackBytes(block_->data_.crc32, packet, timestamp, data);
+    PackBytes(block_->data_.crc32, packet, timestamp, data, version);
     return ErrorCode::OK;
   }
 
@@ -625,6 +1222,47 @@ class Topic
    */
   static Domain* EnsureDefaultDomain();
 
+  /**
+   * @brief 创建回调订阅块并挂到 topic 上 / Create a callback subscriber block and attach
+   *        it to the topic
+   * @param cb 要注册的回调句柄 / Callback handle to register
+   * @param filter 订阅块的过滤器，可为空 / Filter of the subscriber block, may be null
+   */
+  void AttachCallback(Callback& cb, Filter* filter);
+
+  /**
+   * @brief 创建执行器回调订阅块并挂到 topic 上 / Create an executor callback subscriber
+   *        block and attach it to the topic
+   * @param cb 要注册的回调句柄 / Callback handle to register
+   * @param executor 执行回调的执行器 / Executor running the callback
+   * @param queue_depth 该回调可积压的消息数 / Messages this callback may queue
+   * @param filter 订阅块的过滤器，可为空 / Filter of the subscriber block, may be null
+   * @return 操作结果错误码 / Error code
+   */
+  ErrorCode AttachCallback(Callback& cb, CallbackExecutor& executor, size_t queue_depth,
+                           Filter* filter);
+
+  /**
+   * @brief 宽限期结束后释放回调订阅块 / Free one callback subscriber block once its
+   *        grace period has ended
+   * @param node 被摘下的订阅链表节点 / Unlinked subscriber list node
+   */
+  static void ReclaimCallbackNode(LockFreeList::BaseNode* node);
+
+  /**
+   * @brief 把订阅块从 topic 摘下并等到它被回收 / Retire one subscriber block from the
+   *        topic and wait until it has been reclaimed
+   * @param topic 订阅块所在的 topic / Topic the block is attached to
+   * @param node 被摘下的订阅链表节点 / Subscriber list node to retire
+   * @param reclaim 回收函数，回收完成时必须置位 `reclaimed` / Reclaim function; it must
+   *        set `reclaimed` once it is done
+   * @param reclaimed 回收完成标志 / Reclaim-done flag
+   * @return 操作结果错误码 / Error code
+   */
+  static ErrorCode RetireSubscriber(TopicHandle topic, LockFreeList::BaseNode& node,
+                                    LockFreeList::Reclaimer reclaim,
+                                    std::atomic<bool>& reclaimed);
+
   /**
    * @brief 校验 server 侧字节发布前提 / Check the preconditions of one server-side byte
    *        publish
@@ -715,7 +1353,7 @@ class Topic
     }
 
     CheckPublishContract(block_, TypeID::GetID<Data>(), sizeof(Data), alignof(Data));
-    DispatchSubscribers(block_, timestamp, &data, from_callback, in_isr);
+    DispatchSubscribers(block_, timestamp, &data, nullptr, from_callback, in_isr);
 
     if (from_callback)
     {
@@ -727,6 +1365,109 @@ class Topic
     }
   }
 
+  /**
+   * @struct PublishBatchView
+   * @brief 一次批量发布的只读视图 / Read-only view of one batch publish
+   */
+  struct PublishBatchView
+  {
+    const uint8_t* payloads;  ///< 第一条 payload 地址。Address of the first payload.
+    size_t stride;      ///< 相邻 payload 的字节间距。Byte distance between payloads.
+    size_t count;       ///< 消息条数。Message count.
+    const MicrosecondTimestamp* timestamps;  ///< 逐条时间戳，空表示统一用
+                                             ///< `timestamp`。Per-message timestamps;
+                                             ///< null means `timestamp` for all.
+    MicrosecondTimestamp timestamp;  ///< 统一时间戳。Shared timestamp.
+
+    /**
+     * @brief 取第 `index` 条 payload / Get payload number `index`
+     * @param index 消息下标 / Message index
+     * @return payload 地址 / Payload address
+     *
+     * @note 分发路径沿用单条发布的 `void*` 接口，这里去掉 const；批量发布的回调
+     *       不得修改收到的 payload / The dispatch path shares the `void*` interface of
+     *       single publishes, so const is dropped here; callbacks must not modify
+     *       payloads received from a batch publish
+     */
+    void* Payload(size_t index) const
+    {
+      return const_cast<uint8_t*>(payloads + index * stride);
+    }
+
+    /**
+     * @brief 取第 `index` 条时间戳 / Get timestamp number `index`
+     * @param index 消息下标 / Message index
+     * @return 消息时间戳 / Message timestamp
+     */
+    MicrosecondTimestamp Timestamp(size_t index) const
+    {
+      return timestamps != nullptr ? timestamps[index] : timestamp;
+    }
+  };
+
+  /**
+   * @brief 批量发布入口的共享实现 / Shared implementation of batch publish entry points
+   * @tparam Data payload 类型 / Payload type
+   * @param data 按发布顺序排列的 payload / Payloads in publish order
+   * @param timestamps 逐条时间戳，或空 / Per-message timestamps, or null
+   * @param timestamp `timestamps` 为空时的统一时间戳 / Shared timestamp used when
+   *        `timestamps` is null
+   * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
+   *        path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   */
+  template <typename Data>
+  void PublishBatchTyped(std::span<const Data> data,
+                         const MicrosecondTimestamp* timestamps,
+                         MicrosecondTimestamp timestamp, bool from_callback, bool in_isr)
+  {
+    CheckTopicPayload<Data>();
+
+    if (data.empty())
+    {
+      return;
+    }
+
+    const PublishBatchView batch{reinterpret_cast<const uint8_t*>(data.data()),
+                                 sizeof(Data), data.size(), timestamps, timestamp};
+
+    if (from_callback)
+    {
+      LockFromCallback(block_);
+    }
+    else
+    {
+      Lock(block_);
+    }
+
+    CheckPublishContract(block_, TypeID::GetID<Data>(), sizeof(Data), alignof(Data));
+    DispatchSubscribersBatch(block_, batch, from_callback, in_isr);
+
+    if (from_callback)
+    {
+      UnlockFromCallback(block_);
+    }
+    else
+    {
+      Unlock(block_);
+    }
+  }
+
+  /**
+   * @brief 出借槽位发布入口的共享实现 / Shared implementation of loaned-slot publish
+   *        entry points
+   * @tparam Data payload 类型 / Payload type
+   * @param data 由 `Loan()` 取得的句柄 / Handle obtained from `Loan()`
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
+   *        path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 操作结果错误码 / Error code
+   */
+  template <typename Data>
+  ErrorCode PublishLoanTyped(LoanedData<Data>& data, MicrosecondTimestamp timestamp,
+                             bool from_callback, bool in_isr);
+
   /**
    * @brief 校验一次强类型发布的运行时契约 / Check the runtime contract of one typed
    *        publish
@@ -748,9 +1489,37 @@ class Topic
    * @param buffer 输出原始缓冲区 / Output raw buffer
    * @param timestamp 消息时间戳 / Message timestamp
    * @param data 待打包的 payload 字节 / Payload bytes to pack
+   * @param version packet 版本，决定尾部校验 / Packet version selecting the trailing
+   *        check
    */
   static void PackBytes(uint32_t topic_name_crc32, RawData buffer,
-                        MicrosecondTimestamp timestamp, ConstRawData data);
+                        MicrosecondTimestamp timestamp, ConstRawData data,
+                        uint8_t version = PACKET_VERSION);
+
+  /**
+   * @brief 为已经写好数据区的 packet 补上头部和尾部校验 / Fill in the header and
+   *        trailing check of a packet whose data area is already written
+   * @param topic_name_crc32 目标 topic 的 CRC32 键 / CRC32 key of the target topic
+   * @param buffer 输出原始缓冲区 / Output raw buffer
+   * @param timestamp 消息时间戳 / Message timestamp
+   * @param data_size 数据区字节数 / Data area size in bytes
+   * @param version packet 版本，决定尾部校验 / Packet version selecting the trailing
+   *        check
+   */
+  static void SealPacket(uint32_t topic_name_crc32, RawData buffer,
+                         MicrosecondTimestamp timestamp, size_t data_size,
+                         uint8_t version);
+
+  /**
+   * @brief 按 packet 版本校验整包尾部校验码 / Verify the trailing check of one whole
+   *        packet according to its version
+   * @param packet 从前缀到尾部校验码的完整 packet / Whole packet from prefix to the
+   *        trailing check
+   * @param size packet 字节数 / Packet size in bytes
+   * @param version packet 版本 / Packet version
+   * @return 校验通过返回 `true` / Returns `true` when the check passes
+   */
+  static bool VerifyPacket(const void* packet, size_t size, uint8_t version);
 
   /**
    * @brief 将一条消息分发给一个订阅块 / Dispatch one message to one subscriber block
@@ -758,26 +1527,57 @@ class Topic
    * @param timestamp 消息时间戳 / Message timestamp
    * @param payload_addr 本次发布 payload 地址 / Address of the payload object of the
    *        current publish
+   * @param loan 本次发布所在的出借槽位，普通发布为空 / Loan slot carrying this
+   *        publish, null for plain publishes
    * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
    *        path
    * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   * @return 消息被订阅者接收返回 `true`；被过滤掉或被满队列丢弃返回 `false` /
+   *         Returns `true` when the subscriber took the message, `false` when it was
+   *         filtered out or dropped by a full queue
    */
-  static void DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp,
-                                 void* payload_addr, bool from_callback, bool in_isr);
+  static bool DispatchSubscriber(SuberBlock& block, MicrosecondTimestamp timestamp,
+                                 void* payload_addr, LoanSlot* loan, bool from_callback,
+                                 bool in_isr);
 
   /**
    * @brief 将一条消息分发给一个 topic 上的全部订阅者 / Dispatch one message to all
    *        subscribers attached to one topic
+   *
+   * 先分发除内联回调以外的订阅者，再执行内联回调。
+   * Dispatches every subscriber except inline callbacks first, then runs inline
+   * callbacks.
    * @param topic 目标 topic 句柄 / Target topic handle
    * @param timestamp 消息时间戳 / Message timestamp
    * @param payload_addr 本次发布 payload 地址 / Address of the payload object of the
    *        current publish
+   * @param loan 本次发布所在的出借槽位，普通发布为空 / Loan slot carrying this
+   *        publish, null for plain publishes
    * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
    *        path
    * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
    */
   static void DispatchSubscribers(TopicHandle topic, MicrosecondTimestamp timestamp,
-                                  void* payload_addr, bool from_callback, bool in_isr);
+                                  void* payload_addr, LoanSlot* loan, bool from_callback,
+                                  bool in_isr);
+
+  /**
+   * @brief 把一批消息分发给 topic 的全部订阅者 / Dispatch a burst of messages to every
+   *        subscriber of the topic
+   *
+   * 与 `DispatchSubscribers()` 相同的两轮顺序，但每个订阅者一次处理整批：队列订阅者
+   * 走批量入队，其余订阅者逐条分发。
+   * Same two-pass order as `DispatchSubscribers()`, but each subscriber handles the
+   * whole burst at once: queue subscribers take the batch enqueue path and the rest
+   * are dispatched message by message.
+   * @param topic 目标 topic 句柄 / Target topic handle
+   * @param batch 本次批量发布 / Current batch publish
+   * @param from_callback 是否来自回调路径 / Whether this publish comes from callback
+   *        path
+   * @param in_isr 当前是否位于 ISR / Whether the current path is in ISR context
+   */
+  static void DispatchSubscribersBatch(TopicHandle topic, const PublishBatchView& batch,
+                                       bool from_callback, bool in_isr);
 
   /**
    * @brief `PublishBytesFromServer*()` 的共享实现 / Shared implementation behind
@@ -803,7 +1603,8 @@ class Topic
       Lock(block_);
     }
 
-    DispatchSubscribers(block_, timestamp, payload_addr, from_callback, in_isr);
+    DispatchSubscribers(block_, timestamp, payload_addr, nullptr, from_callback,
+                        in_isr);
 
     if (from_callback)
     {
@@ -817,9 +1618,16 @@ class Topic
 };
 }  // namespace LibXR
 
+#include "batch/batch.hpp"
+#include "executor/executor.hpp"
+#include "latest/latest.hpp"
+#include "loan/loan.hpp"
 #include "packet/packet.hpp"
 #include "server/server.hpp"
+#include "stats/stats.hpp"
 #include "subscriber/async.hpp"
 #include "subscriber/callback.hpp"
+#include "subscriber/filter.hpp"
+#include "subscriber/loan_queue.hpp"
 #include "subscriber/queue.hpp"
 #include "subscriber/sync.hpp"
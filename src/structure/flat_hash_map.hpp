@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "libxr_def.hpp"
+#include "mutex.hpp"
+
+namespace LibXR
+{
+/**
+ * @class FlatHashMap
+ * @brief 以 32 位键索引的开放寻址哈希表 / Open-addressing hash map indexed by 32-bit
+ *        keys
+ *
+ * 槽位连续存放在一块数组里，按线性探测查找，一次查找通常只碰一两条缓存行，适合
+ * CRC32 这类分布均匀的键。表容量为 2 的幂，装载因子超过一半时翻倍重建。
+ * Slots live in one contiguous array and are probed linearly, so a lookup usually
+ * touches only one or two cache lines, which suits evenly distributed keys such as
+ * CRC32. The capacity is a power of two and the table is rebuilt at twice the size
+ * once the load factor exceeds one half.
+ *
+ * @note 写入由内部互斥锁串行化；查找不加锁，可与写入并发。扩容后旧表不立即释放，
+ *       而是留到析构时统一回收，因此并发查找不会访问已释放内存。
+ *       Writers are serialized by an internal mutex; lookups take no lock and may run
+ *       concurrently with writers. Old tables are kept after a rebuild and only freed
+ *       on destruction, so concurrent lookups never touch freed memory.
+ * @note 不支持删除。Removal is not supported.
+ *
+ * @tparam Value 值类型，须可平凡拷贝 / Value type, must be trivially copyable
+ */
+template <typename Value>
+class FlatHashMap
+{
+  static_assert(std::is_trivially_copyable_v<Value>);
+
+ public:
+  /**
+   * @brief 构造哈希表 / Construct the hash map
+   * @param capacity 预计元素数，表按其两倍向上取 2 的幂分配 / Expected element count;
+   *        the table is allocated at twice that, rounded up to a power of two
+   *
+   * @note 包含动态内存分配。
+   *       Contains dynamic memory allocation.
+   */
+  explicit FlatHashMap(size_t capacity = 8) : table_(NewTable(SlotCountFor(capacity)))
+  {
+  }
+
+  ~FlatHashMap()
+  {
+    Table* table = table_.load(std::memory_order_relaxed);
+    while (table != nullptr)
+    {
+      Table* retired = table->retired;
+      delete[] table->slots;
+      delete table;
+      table = retired;
+    }
+  }
+
+  FlatHashMap(const FlatHashMap&) = delete;
+  FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+  /**
+   * @brief 插入一个键值对 / Insert one key-value pair
+   * @param key 键 / Key
+   * @param value 值 / Value
+   * @return 成功返回 `OK`，键已存在返回 `FAILED` / Returns `OK`, or `FAILED` when the
+   *         key already exists
+   */
+  ErrorCode Insert(uint32_t key, const Value& value)
+  {
+    mutex_.Lock();
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (FindSlot(table, key) != nullptr)
+    {
+      mutex_.Unlock();
+      return ErrorCode::FAILED;
+    }
+
+    if ((size_ + 1) * 2 > table->mask + 1)
+    {
+      table = Grow(table);
+    }
+
+    Place(table, key, value);
+    size_++;
+    mutex_.Unlock();
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按键查找 / Look up by key
+   * @param key 键 / Key
+   * @return 找到返回值指针，否则返回空 / Returns a pointer to the value, or null when
+   *         absent
+   *
+   * @note 返回的指针在哈希表生命周期内有效。
+   *       The returned pointer stays valid for the lifetime of the map.
+   */
+  const Value* Find(uint32_t key) const
+  {
+    const Slot* slot = FindSlot(table_.load(std::memory_order_acquire), key);
+    return slot != nullptr ? &slot->value : nullptr;
+  }
+
+  /**
+   * @brief 获取元素数量 / Get the element count
+   * @return 元素数量 / Element count
+   */
+  size_t Size() const { return size_; }
+
+  /**
+   * @brief 获取当前槽位数 / Get the current slot count
+   * @return 槽位数 / Slot count
+   */
+  size_t Capacity() const { return table_.load(std::memory_order_acquire)->mask + 1; }
+
+ private:
+  /**
+   * @struct Slot
+   * @brief 一个哈希槽 / One hash slot
+   */
+  struct Slot
+  {
+    std::atomic<bool> used = false;  ///< 槽位是否已写入。Whether the slot is filled.
+    uint32_t key = 0;                ///< 键。Key.
+    Value value{};                   ///< 值。Value.
+  };
+
+  /**
+   * @struct Table
+   * @brief 一代槽位数组 / One generation of the slot array
+   */
+  struct Table
+  {
+    Slot* slots;      ///< 槽位数组。Slot array.
+    size_t mask;      ///< 槽位数减一。Slot count minus one.
+    uint32_t shift;   ///< 乘法哈希的右移位数。Right shift of the multiplicative hash.
+    Table* retired;   ///< 被本表替换下来的旧表。Older table replaced by this one.
+  };
+
+  static size_t SlotCountFor(size_t capacity)
+  {
+    size_t slots = 8;
+    while (slots < capacity * 2)
+    {
+      slots <<= 1;
+    }
+    return slots;
+  }
+
+  static Table* NewTable(size_t slots)
+  {
+    uint32_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) < slots)
+    {
+      bits++;
+    }
+    return new Table{new Slot[slots], slots - 1, 32U - bits, nullptr};
+  }
+
+  static size_t Home(const Table* table, uint32_t key)
+  {
+    // Fibonacci 哈希把高位也搅进下标。Fibonacci hashing folds the high bits into the
+    // index as well.
+    return static_cast<size_t>((key * 0x9E3779B1U) >> table->shift);
+  }
+
+  static const Slot* FindSlot(const Table* table, uint32_t key)
+  {
+    for (size_t i = Home(table, key);; i = (i + 1) & table->mask)
+    {
+      const Slot& slot = table->slots[i];
+      if (!slot.used.load(std::memory_order_acquire))
+      {
+        return nullptr;
+      }
+      if (slot.key == key)
+      {
+        return &slot;
+      }
+    }
+  }
+
+  static void Place(Table* table, uint32_t key, const Value& value)
+  {
+    size_t i = Home(table, key);
+    while (table->slots[i].used.load(std::memory_order_relaxed))
+    {
+      i = (i + 1) & table->mask;
+    }
+    table->slots[i].key = key;
+    table->slots[i].value = value;
+    table->slots[i].used.store(true, std::memory_order_release);
+  }
+
+  Table* Grow(Table* old_table)
+  {
+    Table* table = NewTable((old_table->mask + 1) * 2);
+    for (size_t i = 0; i <= old_table->mask; i++)
+    {
+      const Slot& slot = old_table->slots[i];
+      if (slot.used.load(std::memory_order_relaxed))
+      {
+        Place(table, slot.key, slot.value);
+      }
+    }
+    table->retired = old_table;
+    table_.store(table, std::memory_order_release);
+    return table;
+  }
+
+  std::atomic<Table*> table_;  ///< 当前槽位表。Current slot table.
+  size_t size_ = 0;            ///< 元素数量。Element count.
+  LibXR::Mutex mutex_;         ///< 写入互斥锁。Writer mutex.
+};
+}  // namespace LibXR
@@ -44,7 +44,20 @@ class LatestSnapshot
    */
   void Store(const T& value) noexcept(std::is_nothrow_copy_assignable_v<T>)
   {
-    slots_[back_] = value;
+    StoreWith([&](T& slot) { slot = value; });
+  }
+
+  /**
+   * @brief Publish one value written in place.
+   *
+   * The writer fills the producer-owned back slot directly, which avoids building a
+   * temporary T when the value is assembled from several parts. The slot holds an older
+   * publication, so the writer must assign every field it relies on.
+   */
+  template <typename Writer>
+  void StoreWith(Writer&& writer)
+  {
+    writer(slots_[back_]);
 
     const uint32_t previous =
         state_.exchange(Pack(back_, true), std::memory_order_acq_rel);
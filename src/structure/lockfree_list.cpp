@@ -1,5 +1,7 @@
 #include "lockfree_list.hpp"
 
+#include "thread.hpp"
+
 using namespace LibXR;
 
 LockFreeList::BaseNode::BaseNode(size_t size) : size_(size) {}
@@ -13,6 +15,14 @@ LockFreeList::LockFreeList() noexcept : head_(0)
 
 LockFreeList::~LockFreeList()
 {
+  // 析构时不再有读者，未结束宽限期的节点可以直接回收。
+  // No reader survives destruction, so nodes still awaiting a grace period are
+  // reclaimed directly.
+  ReclaimChain(in_flight_);
+  ReclaimChain(pending_);
+  in_flight_ = nullptr;
+  pending_ = nullptr;
+
   for (auto pos = head_.next_.load(); pos != &head_;)
   {
     auto tmp = pos->next_.load();
@@ -34,8 +44,185 @@ void LockFreeList::Add(BaseNode& data)
       current_head, &data, std::memory_order_release, std::memory_order_acquire));
 }
 
+ErrorCode LockFreeList::Remove(BaseNode& data)
+{
+  LockWriter();
+  auto ans = Unlink(data);
+  if (ans == ErrorCode::OK)
+  {
+    data.reclaim_ = nullptr;
+    data.retired_next_ = pending_;
+    pending_ = &data;
+  }
+  UnlockWriter();
+
+  if (ans != ErrorCode::OK)
+  {
+    return ans;
+  }
+
+  // 回收时 next_ 被清空；等待期间不持锁，读者回调仍可调用 Retire()。
+  // Reclamation clears next_; the lock is not held while waiting, so reader callbacks
+  // may still call Retire().
+  while (true)
+  {
+    LockWriter();
+    AdvanceGracePeriod();
+    const bool reclaimed = data.next_.load(std::memory_order_relaxed) == nullptr;
+    UnlockWriter();
+    if (reclaimed)
+    {
+      return ErrorCode::OK;
+    }
+    Thread::Yield();
+  }
+}
+
+ErrorCode LockFreeList::Retire(BaseNode& data, Reclaimer reclaim)
+{
+  LockWriter();
+  auto ans = Unlink(data);
+  if (ans == ErrorCode::OK)
+  {
+    data.reclaim_ = reclaim;
+    data.retired_next_ = pending_;
+    pending_ = &data;
+    AdvanceGracePeriod();
+  }
+  UnlockWriter();
+  return ans;
+}
+
+size_t LockFreeList::Reclaim()
+{
+  if (!TryLockWriter())
+  {
+    return 0;
+  }
+  auto reclaimed = AdvanceGracePeriod();
+  UnlockWriter();
+  return reclaimed;
+}
+
+void LockFreeList::LockWriter()
+{
+  while (!TryLockWriter())
+  {
+    Thread::Yield();
+  }
+}
+
+bool LockFreeList::TryLockWriter()
+{
+  return !writer_.exchange(true, std::memory_order_acquire);
+}
+
+void LockFreeList::UnlockWriter() { writer_.store(false, std::memory_order_release); }
+
+ErrorCode LockFreeList::Unlink(BaseNode& data)
+{
+  // 修改方互斥，Add() 只改头指针，因此只有摘除首节点需要 CAS。
+  // Writers are mutually exclusive and Add() only touches the head pointer, so only
+  // unlinking the first node needs a CAS.
+  while (true)
+  {
+    BaseNode* prev = &head_;
+    BaseNode* pos = head_.next_.load(std::memory_order_acquire);
+    while (pos != &data && pos != &head_)
+    {
+      prev = pos;
+      pos = pos->next_.load(std::memory_order_acquire);
+    }
+
+    if (pos == &head_)
+    {
+      return ErrorCode::NOT_FOUND;
+    }
+
+    auto next = data.next_.load(std::memory_order_relaxed);
+    if (prev == &head_)
+    {
+      BaseNode* expected = &data;
+      if (!head_.next_.compare_exchange_strong(expected, next,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed))
+      {
+        continue;
+      }
+    }
+    else
+    {
+      prev->next_.store(next, std::memory_order_release);
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return ErrorCode::OK;
+  }
+}
+
+size_t LockFreeList::AdvanceGracePeriod()
+{
+  if (grace_phase_ == 0)
+  {
+    if (pending_ == nullptr)
+    {
+      return 0;
+    }
+    in_flight_ = pending_;
+    pending_ = nullptr;
+    epoch_.fetch_add(1, std::memory_order_relaxed);
+    grace_phase_ = 1;
+  }
+
+  // 新读者进入翻转后的纪元，旧纪元计数只减不增，依次等两个计数器归零。
+  // New readers enter the flipped epoch, so the old counter only drains; wait for
+  // both counters to reach zero in turn.
+  while (grace_phase_ != 0)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint32_t old_index = (epoch_.load(std::memory_order_relaxed) & 1U) ^ 1U;
+    if (readers_[old_index].load(std::memory_order_acquire) != 0)
+    {
+      return 0;
+    }
+
+    if (grace_phase_ == 1)
+    {
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+      grace_phase_ = 2;
+    }
+    else
+    {
+      grace_phase_ = 0;
+    }
+  }
+
+  auto reclaimed = ReclaimChain(in_flight_);
+  in_flight_ = nullptr;
+  return reclaimed;
+}
+
+size_t LockFreeList::ReclaimChain(BaseNode* chain)
+{
+  size_t reclaimed = 0;
+  while (chain != nullptr)
+  {
+    auto node = chain;
+    chain = node->retired_next_;
+    node->retired_next_ = nullptr;
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    if (node->reclaim_ != nullptr)
+    {
+      node->reclaim_(node);
+    }
+    ++reclaimed;
+  }
+  return reclaimed;
+}
+
 uint32_t LockFreeList::Size() noexcept
 {
+  ReadGuard guard(*this);
   uint32_t size = 0;
   for (auto pos = head_.next_.load(std::memory_order_acquire); pos != &head_;
        pos = pos->next_.load(std::memory_order_relaxed))
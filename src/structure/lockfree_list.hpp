@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "libxr_assert.hpp"
@@ -17,6 +19,22 @@ namespace LibXR
  * This class provides fundamental linked list operations,
  * including adding, deleting nodes, and traversing the list,
  * with thread-safety features.
+ *
+ * 遍历方只在进入和退出时各做一次原子计数，不会被添加或删除阻塞。删除分两步：先把节点
+ * 从链上摘下，再等两轮读者纪元都清空（宽限期）后才回收节点，因此正在遍历的读者仍可安全
+ * 地走过刚被摘下的节点。
+ * Traversals only touch one atomic counter on entry and exit and are never blocked by
+ * additions or removals. Removal has two steps: the node is unlinked first and only
+ * reclaimed after both reader epochs have drained (a grace period), so a reader still
+ * walking the list may safely step over a node that was just unlinked.
+ *
+ * @note 目前只有 `Topic` 的内联回调（`Topic::UnregisterCallback()`）和
+ *       `Topic::LoanQueuedSubscriber` 会删除节点。同步、异步、队列订阅者，执行器回调，
+ *       CAN 过滤器，Event 回调和 Timer 任务仍然只增不删，挂上后须与所在链表同寿命。
+ *       Only inline `Topic` callbacks (`Topic::UnregisterCallback()`) and
+ *       `Topic::LoanQueuedSubscriber` remove nodes today. Synchronous, asynchronous,
+ *       and queued subscribers, executor callbacks, CAN filters, Event callbacks, and
+ *       Timer tasks remain add-only and must live as long as the list they joined.
  */
 class LockFreeList
 {
@@ -46,8 +64,18 @@ class LockFreeList
     std::atomic<BaseNode*> next_ =
         nullptr;   ///< 指向下一个节点的原子指针。 Atomic pointer to the next node.
     size_t size_;  ///< 当前节点的数据大小（字节）。 Size of the current node (in bytes).
+    BaseNode* retired_next_ =
+        nullptr;  ///< 待回收链中的下一个节点。 Next node on the retired chain.
+    void (*reclaim_)(BaseNode*) =
+        nullptr;  ///< 宽限期结束后的回收函数。 Reclaim function run after the grace period.
   };
 
+  /**
+   * @brief 节点回收函数类型。
+   *        Node reclaim function type.
+   */
+  using Reclaimer = void (*)(BaseNode* node);
+
   /**
    * @brief 数据节点模板，继承自 `BaseNode`，用于存储具体数据类型。
    *        Template data node that inherits from `BaseNode` to store specific data types.
@@ -132,6 +160,72 @@ class LockFreeList
    */
   void Add(BaseNode& data);
 
+  /**
+   * @brief 从链表删除一个节点，并等待宽限期结束。
+   *        Removes a node from the list and waits for the grace period to end.
+   *
+   * 返回后已没有读者持有该节点，调用方可以立即销毁或重新添加它。会阻塞等待正在进行的
+   * 遍历，不能在 ISR 或本链表的 `Foreach()` 回调里调用；这些场景请用 `Retire()`。
+   * On return no reader holds the node any more, so the caller may destroy or re-add it
+   * right away. Blocks on in-flight traversals and must not be called from ISR context
+   * or from a `Foreach()` callback of this list; use `Retire()` there instead.
+   *
+   * @param data 要删除的节点。
+   *             The node to remove.
+   * @return 成功返回 `ErrorCode::OK`，节点不在链上返回 `ErrorCode::NOT_FOUND`。
+   *         Returns `ErrorCode::OK`, or `ErrorCode::NOT_FOUND` when the node is not
+   *         in the list.
+   */
+  ErrorCode Remove(BaseNode& data);
+
+  /**
+   * @brief 把节点从链表摘下，延迟到宽限期结束后再回收。
+   *        Unlinks a node and defers its reclamation until the grace period ends.
+   *
+   * 不等待读者，可在 `Foreach()` 回调中调用。宽限期由之后的 `Reclaim()`、`Retire()` 或
+   * `Remove()` 推进，结束时以节点指针调用 `reclaim`。
+   * Does not wait for readers and may be called from a `Foreach()` callback. Later
+   * `Reclaim()`, `Retire()`, or `Remove()` calls advance the grace period, and
+   * `reclaim` is called with the node once it ends.
+   *
+   * @param data 要删除的节点。
+   *             The node to remove.
+   * @param reclaim 回收函数，可为空。
+   *                Reclaim function, may be null.
+   * @return 成功返回 `ErrorCode::OK`，节点不在链上返回 `ErrorCode::NOT_FOUND`。
+   *         Returns `ErrorCode::OK`, or `ErrorCode::NOT_FOUND` when the node is not
+   *         in the list.
+   */
+  ErrorCode Retire(BaseNode& data, Reclaimer reclaim);
+
+  /**
+   * @brief 推进宽限期，回收已经没有读者的节点。
+   *        Advances the grace period and reclaims nodes no reader can hold any more.
+   *
+   * 从不阻塞；另一线程正在修改链表或仍有旧读者时直接返回。
+   * Never blocks; returns early while another thread is modifying the list or old
+   * readers are still inside.
+   *
+   * @return 本次回收的节点数。
+   *         Number of nodes reclaimed by this call.
+   */
+  size_t Reclaim();
+
+  /**
+   * @brief 以 `delete` 释放一个 `Node<Data>` 的回收函数。
+   *        Reclaim function that frees one `Node<Data>` with `delete`.
+   *
+   * @tparam Data 节点存储的数据类型。
+   *              The type of data stored in the node.
+   * @param node 要释放的节点。
+   *             The node to free.
+   */
+  template <typename Data>
+  static void DeleteNode(BaseNode* node)
+  {
+    delete static_cast<Node<Data>*>(node);
+  }
+
   /**
    * @brief 获取链表中的节点数量。
    *        Gets the number of nodes in the linked list.
@@ -159,6 +253,7 @@ class LockFreeList
   template <typename Data, typename Func, SizeLimitMode LimitMode = SizeLimitMode::MORE>
   ErrorCode Foreach(Func func)
   {
+    ReadGuard guard(*this);
     for (auto pos = head_.next_.load(std::memory_order_acquire); pos != &head_;
          pos = pos->next_.load(std::memory_order_relaxed))
     {
@@ -171,8 +266,80 @@ class LockFreeList
     return ErrorCode::OK;
   }
 
+  /**
+   * @brief 遍历链表中的每个节点本身，可用于挑出要 `Retire()` 的节点。
+   *        Iterates over the nodes themselves, e.g. to pick one to `Retire()`.
+   *
+   * @tparam Data 存储的数据类型。
+   *             The type of stored data.
+   * @tparam Func 回调函数类型，参数为 `Node<Data>&`。
+   *              The callback function type, taking `Node<Data>&`.
+   * @param func 需要应用于每个节点的回调函数。
+   *             The callback function to be applied to each node.
+   * @return 返回 `ErrorCode`，指示操作是否成功。
+   *         Returns `ErrorCode`, indicating whether the operation was successful.
+   */
+  template <typename Data, typename Func>
+  ErrorCode ForeachNode(Func func)
+  {
+    ReadGuard guard(*this);
+    for (auto pos = head_.next_.load(std::memory_order_acquire); pos != &head_;
+         pos = pos->next_.load(std::memory_order_relaxed))
+    {
+      if (auto res = func(*static_cast<Node<Data>*>(pos)); res != ErrorCode::OK)
+      {
+        return res;
+      }
+    }
+    return ErrorCode::OK;
+  }
+
  private:
+  /**
+   * @brief 读者临界区守卫，构造时登记到当前纪元，析构时注销。
+   *        Reader critical-section guard that registers with the current epoch on
+   *        construction and unregisters on destruction.
+   */
+  class ReadGuard
+  {
+   public:
+    explicit ReadGuard(LockFreeList& list)
+        : list_(list), index_(list.epoch_.load(std::memory_order_relaxed) & 1U)
+    {
+      list_.readers_[index_].fetch_add(1, std::memory_order_relaxed);
+      // 与 Unlink() 和 AdvanceGracePeriod() 中的全序栅栏配对。
+      // Pairs with the seq_cst fences in Unlink() and AdvanceGracePeriod().
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    ~ReadGuard() { list_.readers_[index_].fetch_sub(1, std::memory_order_release); }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+   private:
+    LockFreeList& list_;
+    uint32_t index_;
+  };
+
+  void LockWriter();
+  bool TryLockWriter();
+  void UnlockWriter();
+  ErrorCode Unlink(BaseNode& data);
+  size_t AdvanceGracePeriod();
+  static size_t ReclaimChain(BaseNode* chain);
+
   BaseNode head_;  ///< 链表头节点。 The head node of the list.
+  std::atomic<uint32_t> epoch_ = 0;  ///< 读者纪元，最低位选择计数器。 Reader epoch; the
+                                     ///< lowest bit selects the counter.
+  std::atomic<uint32_t> readers_[2] = {0, 0};  ///< 每个纪元内的读者数。 Readers inside
+                                               ///< each epoch.
+  std::atomic<bool> writer_ = false;  ///< 修改方互斥标志。 Writer exclusion flag.
+  BaseNode* pending_ = nullptr;    ///< 等待宽限期开始的节点。 Nodes awaiting a grace period.
+  BaseNode* in_flight_ = nullptr;  ///< 当前宽限期覆盖的节点。 Nodes covered by the
+                                   ///< current grace period.
+  uint8_t grace_phase_ = 0;  ///< 宽限期进度：0 空闲，1/2 等待旧纪元。 Grace-period
+                             ///< progress: 0 idle, 1/2 draining an old epoch.
 };
 
 }  // namespace LibXR
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "event_count.hpp"
+#include "libxr_def.hpp"
+#include "thread.hpp"
+
+namespace LibXR
+{
+/**
+ * @class BlockingQueue
+ * @brief 给无锁队列加上阻塞收发的适配器。
+ * @brief Adaptor that adds blocking push / pop to a lock-free queue.
+ *
+ * 包装 `SPSCQueue`、`CachedSPSCQueue` 或 `MPMCQueue`：队列空时消费者挂起，
+ * 队列满时生产者挂起，而不是用 `Thread::Sleep` 轮询或每条消息配一次
+ * `Semaphore::Post`。两侧各用一个 `EventCount`，只有确实有线程挂起时
+ * 才会发出唤醒；无人等待时每次收发只多一次原子自增。
+ * 生产者/消费者的并发约束与被包装的队列相同。
+ *
+ * Wraps `SPSCQueue`, `CachedSPSCQueue` or `MPMCQueue` so consumers park while the
+ * queue is empty and producers park while it is full, instead of polling with
+ * `Thread::Sleep` or pairing every message with a `Semaphore::Post`. Each side uses
+ * one `EventCount`, so a wakeup is only issued when a thread is actually parked; with
+ * nobody waiting, each transfer costs one extra atomic increment.
+ * Producer / consumer concurrency rules are those of the wrapped queue.
+ *
+ * @tparam Queue 被包装的强类型队列。 Wrapped typed queue.
+ */
+template <typename Queue>
+class BlockingQueue
+{
+ public:
+  using ValueType = typename Queue::ValueType;  ///< 队列元素类型。 Queue element type.
+
+  /**
+   * @brief 构造一个阻塞队列，参数原样转给被包装的队列。
+   * @brief Construct one blocking queue, forwarding arguments to the wrapped queue.
+   * @param args 被包装队列的构造参数。 Constructor arguments of the wrapped queue.
+   *
+   * @note 包含动态内存分配。 Contains dynamic memory allocation.
+   */
+  template <typename... Args>
+  explicit BlockingQueue(Args&&... args) : queue_(std::forward<Args>(args)...)
+  {
+  }
+
+  /**
+   * @brief 推入一个元素，队列满时挂起等待。
+   * @brief Push one element, parking while the queue is full.
+   * @param item 待入队元素。 Element to enqueue.
+   * @param timeout 超时时间（默认无限等待）。 Timeout period (default is infinite wait).
+   * @return 成功返回 `ErrorCode::OK`；超时返回 `ErrorCode::TIMEOUT`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::TIMEOUT` when
+   *         the timeout expires
+   */
+  ErrorCode Push(const ValueType& item, uint32_t timeout = UINT32_MAX)
+  {
+    return Transfer([&]() { return queue_.Push(item); }, not_full_, not_empty_, timeout);
+  }
+
+  /**
+   * @brief 弹出一个元素，队列空时挂起等待。
+   * @brief Pop one element, parking while the queue is empty.
+   * @param item 用于接收出队元素的引用。 Reference receiving the dequeued element.
+   * @param timeout 超时时间（默认无限等待）。 Timeout period (default is infinite wait).
+   * @return 成功返回 `ErrorCode::OK`；超时返回 `ErrorCode::TIMEOUT`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::TIMEOUT` when
+   *         the timeout expires
+   */
+  ErrorCode Pop(ValueType& item, uint32_t timeout = UINT32_MAX)
+  {
+    return Transfer([&]() { return queue_.Pop(item); }, not_empty_, not_full_, timeout);
+  }
+
+  /**
+   * @brief 从中断回调中推入一个元素，不会阻塞。
+   * @brief Push one element from an ISR or callback without blocking.
+   * @param item 待入队元素。 Element to enqueue.
+   * @param in_isr 是否在 ISR 中调用。 Whether it is called from an ISR.
+   * @return 被包装队列返回的操作结果。 Operation result of the wrapped queue.
+   */
+  ErrorCode PushFromCallback(const ValueType& item, bool in_isr)
+  {
+    const ErrorCode ans = queue_.Push(item);
+    if (ans == ErrorCode::OK)
+    {
+      not_empty_.NotifyFromCallback(in_isr);
+    }
+    return ans;
+  }
+
+  /**
+   * @brief 从中断回调中弹出一个元素，不会阻塞。
+   * @brief Pop one element from an ISR or callback without blocking.
+   * @param item 用于接收出队元素的引用。 Reference receiving the dequeued element.
+   * @param in_isr 是否在 ISR 中调用。 Whether it is called from an ISR.
+   * @return 被包装队列返回的操作结果。 Operation result of the wrapped queue.
+   */
+  ErrorCode PopFromCallback(ValueType& item, bool in_isr)
+  {
+    const ErrorCode ans = queue_.Pop(item);
+    if (ans == ErrorCode::OK)
+    {
+      not_full_.NotifyFromCallback(in_isr);
+    }
+    return ans;
+  }
+
+  /**
+   * @brief 获取当前元素数。 Get the current element count.
+   * @return 被包装队列的元素数。 Element count of the wrapped queue.
+   */
+  size_t Size() { return queue_.Size(); }
+
+  /**
+   * @brief 获取剩余可写槽位数。 Get the number of free slots.
+   * @return 被包装队列的剩余槽位数。 Free slots of the wrapped queue.
+   */
+  size_t EmptySize() { return queue_.EmptySize(); }
+
+  /**
+   * @brief 获取被包装的队列。 Get the wrapped queue.
+   * @return 被包装队列的引用。 Reference to the wrapped queue.
+   *
+   * @note 直接在底层队列上收发不会唤醒挂起的一方。
+   *       Transfers made directly on the wrapped queue do not wake the parked side.
+   */
+  Queue& Raw() { return queue_; }
+
+ private:
+  /**
+   * @brief 反复尝试一次收发，失败时挂在 `wait_on` 上，成功后通知 `notify`。
+   * @brief Retry one transfer, parking on `wait_on` while it fails and notifying
+   *        `notify` once it succeeds.
+   */
+  template <typename Operation>
+  ErrorCode Transfer(Operation&& operation, EventCount& wait_on, EventCount& notify,
+                     uint32_t timeout)
+  {
+    const uint32_t start_time = Thread::GetTime();
+    while (true)
+    {
+      if (operation() == ErrorCode::OK)
+      {
+        notify.NotifyOne();
+        return ErrorCode::OK;
+      }
+
+      // 取纪元后再试一次：这之后的任何通知都会让 Wait 立即返回。
+      // Retry after taking the epoch: any notification from here on makes Wait return
+      // immediately.
+      const EventCount::Key key = wait_on.PrepareWait();
+      if (operation() == ErrorCode::OK)
+      {
+        notify.NotifyOne();
+        return ErrorCode::OK;
+      }
+
+      uint32_t remaining = UINT32_MAX;
+      if (timeout != UINT32_MAX)
+      {
+        const uint32_t elapsed = static_cast<uint32_t>(Thread::GetTime() - start_time);
+        if (elapsed >= timeout)
+        {
+          return ErrorCode::TIMEOUT;
+        }
+        remaining = timeout - elapsed;
+      }
+
+      const ErrorCode ans = wait_on.Wait(key, remaining);
+      if (ans != ErrorCode::OK && ans != ErrorCode::TIMEOUT)
+      {
+        return ans;
+      }
+    }
+  }
+
+  Queue queue_;           ///< 被包装的队列。 Wrapped queue.
+  EventCount not_empty_;  ///< 消费者等待“非空”。 Consumers wait for "not empty".
+  EventCount not_full_;   ///< 生产者等待“非满”。 Producers wait for "not full".
+};
+}  // namespace LibXR
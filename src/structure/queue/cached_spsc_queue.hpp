@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+
+#include "cached_spsc_queue_base.hpp"
+#include "queue_typed_base.hpp"
+
+namespace LibXR
+{
+/**
+ * @class CachedSPSCQueue
+ * @brief 带索引缓存的 2 的幂容量单生产者单消费者无锁队列。
+ * @brief Power-of-two single-producer single-consumer lock-free queue with index
+ *        caches.
+ *
+ * 接口与 `SPSCQueue<Data>` 的基本收发部分一致，底层换成 `CachedSPSCQueueBase`。
+ * 适合生产者和消费者在不同核上高频交接的场景；容量会向上取到 2 的幂。
+ *
+ * Offers the same core push / pop interface as `SPSCQueue<Data>` on top of
+ * `CachedSPSCQueueBase`. Suited to high-rate handoff between a producer and a consumer
+ * on different cores; the capacity is rounded up to a power of two.
+ *
+ * @tparam Data 队列存储的数据类型。 Queue element type.
+ */
+template <typename Data>
+class CachedSPSCQueue final : public QueueTypedBase<CachedSPSCQueue<Data>, Data>,
+                              public CachedSPSCQueueBase
+{
+ public:
+  static_assert(alignof(Data) <= alignof(std::max_align_t),
+                "CachedSPSCQueue does not support over-aligned payload types");
+
+  using ValueType = Data;  ///< 队列元素类型。 Queue element type.
+  /// @brief 重新公开强类型出队接口。 Re-expose the typed pop interface.
+  using QueueTypedBase<CachedSPSCQueue<Data>, Data>::Pop;
+  /// @brief 重新公开强类型入队接口。 Re-expose the typed push interface.
+  using QueueTypedBase<CachedSPSCQueue<Data>, Data>::Push;
+
+  /**
+   * @brief 构造一个队列。
+   * @brief Construct one queue.
+   * @param length 最少容量，向上取到 2 的幂。 Minimum capacity, rounded up to a power
+   *        of two.
+   *
+   * @note 包含动态内存分配。 Contains dynamic memory allocation.
+   */
+  explicit CachedSPSCQueue(size_t length)
+      : CachedSPSCQueueBase(sizeof(Data), alignof(Data), length)
+  {
+  }
+
+  /**
+   * @brief 查看一个队头 payload 但不出队。
+   * @brief Peek one front payload without dequeuing it.
+   * @param item 用于接收 payload。 Receives the peeked payload.
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         the queue is empty
+   */
+  ErrorCode Peek(Data& item) { return CachedSPSCQueueBase::PeekBytes(&item); }
+
+  /**
+   * @brief 批量推入多个 payload。
+   * @brief Push multiple payloads into the queue.
+   * @param data payload 数组指针。 Pointer to the payload array.
+   * @param size payload 个数。 Number of payloads.
+   * @return 成功返回 `ErrorCode::OK`；队列满返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when
+   *         the queue is full
+   */
+  ErrorCode PushBatch(const Data* data, size_t size)
+  {
+    return CachedSPSCQueueBase::PushBatchBytes(data, size);
+  }
+
+  /**
+   * @brief 批量弹出多个 payload。
+   * @brief Pop multiple payloads from the queue.
+   * @param data 用于接收 payload 的数组。 Array receiving dequeued payloads.
+   * @param size payload 个数。 Number of payloads.
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         the queue does not contain enough payloads
+   */
+  ErrorCode PopBatch(Data* data, size_t size)
+  {
+    return CachedSPSCQueueBase::PopBatchBytes(data, size);
+  }
+
+  /**
+   * @brief 批量查看多个 payload 但不出队。
+   * @brief Peek multiple payloads without dequeuing them.
+   * @param data 用于接收 payload 的数组。 Array receiving peeked payloads.
+   * @param size payload 个数。 Number of payloads.
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         the queue does not contain enough payloads
+   */
+  ErrorCode PeekBatch(Data* data, size_t size)
+  {
+    return CachedSPSCQueueBase::PeekBatchBytes(data, size);
+  }
+};
+}  // namespace LibXR
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "libxr_def.hpp"
+#include "libxr_mem.hpp"
+
+namespace LibXR
+{
+/**
+ * @class CachedSPSCQueueBase
+ * @brief 带本地索引缓存的 2 的幂容量 SPSC 字节队列内核 / Power-of-two SPSC byte-queue
+ *        core with local index caches
+ *
+ * 与 `SPSCQueueBase` 的契约相同，但做了两处取舍：容量向上取到 2 的幂，`head_` /
+ * `tail_` 作为自由递增计数器，只在访问槽位时用掩码折回，省去逐元素取模和保留空槽；
+ * 生产者私有一份 `head_` 缓存、消费者私有一份 `tail_` 缓存，只有缓存显示队列满或空
+ * 时才重新读取对端索引，稳态下两端不再每次操作都去拉对方的缓存行。
+ *
+ * Same contract as `SPSCQueueBase` with two trade-offs: the capacity is rounded up to
+ * a power of two and `head_` / `tail_` are free-running counters folded back with a
+ * mask only when a slot is touched, which removes the per-element modulo and the
+ * reserved slot; and the producer keeps a private copy of `head_` while the consumer
+ * keeps a private copy of `tail_`, reloading the opposite index only when the cached
+ * value says the queue is full or empty, so in steady state neither side pulls the
+ * other's cache line on every operation.
+ *
+ * @note 容量会被向上取整，`MaxSize()` 返回取整后的值。
+ *       The capacity is rounded up and `MaxSize()` reports the rounded value.
+ */
+class alignas(LibXR::CONCURRENCY_ALIGNMENT) CachedSPSCQueueBase
+{
+ public:
+  using IndexType = size_t;  ///< 自由递增索引类型 / Free-running index type.
+
+  /**
+   * @brief 构造队列内核 / Construct the queue core
+   * @param element_size 单个 payload 的字节数 / Byte size of one payload
+   * @param element_align 单个 payload 的对齐要求 / Alignment requirement of one payload
+   * @param capacity 最少容量，向上取到 2 的幂 / Minimum capacity, rounded up to a power
+   *        of two
+   *
+   * @note 包含动态内存分配 / Contains dynamic memory allocation
+   */
+  CachedSPSCQueueBase(size_t element_size, size_t element_align, size_t capacity)
+      : element_size_(element_size),
+        payload_stride_(ComputeStride(element_size, element_align)),
+        capacity_(RoundCapacity(capacity)),
+        mask_(capacity_ - 1),
+        payloads_(static_cast<std::byte*>(
+            ::operator new[](MultiplyChecked(payload_stride_, capacity_),
+                             std::align_val_t(alignof(std::max_align_t)))))
+  {
+  }
+
+  /**
+   * @brief 析构队列内核 / Destroy the queue core
+   */
+  ~CachedSPSCQueueBase()
+  {
+    ::operator delete[](payloads_, std::align_val_t(alignof(std::max_align_t)));
+  }
+
+  CachedSPSCQueueBase(const CachedSPSCQueueBase&) = delete;
+  CachedSPSCQueueBase& operator=(const CachedSPSCQueueBase&) = delete;
+
+  /**
+   * @brief 按字节入队一个 payload / Enqueue one payload by bytes
+   * @param value 指向待入队 payload 的指针 / Pointer to the payload to enqueue
+   * @return 成功返回 `ErrorCode::OK`；队列满返回 `ErrorCode::FULL`；空指针返回
+   *         `ErrorCode::PTR_NULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when
+   *         the queue is full; returns `ErrorCode::PTR_NULL` when `value` is null
+   */
+  ErrorCode PushBytes(const void* value)
+  {
+    if (value == nullptr)
+    {
+      return ErrorCode::PTR_NULL;
+    }
+
+    const auto current_tail = tail_.load(std::memory_order_relaxed);
+    if (!ReserveProducer(current_tail, 1))
+    {
+      return ErrorCode::FULL;
+    }
+
+    LibXR::Memory::FastCopy(PayloadPtr(current_tail), value, element_size_);
+    tail_.store(current_tail + 1, std::memory_order_release);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按字节出队一个 payload；传空指针时仅丢弃队头元素
+   *        / Dequeue one payload by bytes; pass null to discard the front item only
+   * @param value 用于接收 payload 的缓冲区；传 `nullptr` 时仅丢弃
+   *        / Buffer that receives the payload; pass `nullptr` to discard only
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         the queue is empty
+   */
+  ErrorCode PopBytes(void* value = nullptr)
+  {
+    const auto current_head = head_.load(std::memory_order_relaxed);
+    if (!ReserveConsumer(current_head, 1))
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    if (value != nullptr)
+    {
+      LibXR::Memory::FastCopy(value, PayloadPtr(current_head), element_size_);
+    }
+
+    head_.store(current_head + 1, std::memory_order_release);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按字节查看一个队头 payload 但不出队 / Peek one front payload by bytes without
+   *        dequeuing it
+   * @param value 用于接收 payload 的缓冲区 / Buffer that receives the payload
+   * @return 成功返回 `ErrorCode::OK`；队列空返回 `ErrorCode::EMPTY`；空指针返回
+   *         `ErrorCode::PTR_NULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         the queue is empty; returns `ErrorCode::PTR_NULL` when `value` is null
+   */
+  ErrorCode PeekBytes(void* value)
+  {
+    if (value == nullptr)
+    {
+      return ErrorCode::PTR_NULL;
+    }
+
+    const auto current_head = head_.load(std::memory_order_relaxed);
+    if (!ReserveConsumer(current_head, 1))
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    LibXR::Memory::FastCopy(value, PayloadPtr(current_head), element_size_);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按字节批量入队多个 payload / Enqueue multiple payloads by bytes
+   * @param data 指向 payload 数组的字节指针 / Byte pointer to the payload array
+   * @param count payload 个数 / Number of payloads
+   * @return 成功返回 `ErrorCode::OK`；空间不足返回 `ErrorCode::FULL`；空指针返回
+   *         `ErrorCode::PTR_NULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when free
+   *         space is insufficient; returns `ErrorCode::PTR_NULL` when `data` is null
+   */
+  ErrorCode PushBatchBytes(const void* data, size_t count)
+  {
+    if (count == 0U)
+    {
+      return ErrorCode::OK;
+    }
+    if (data == nullptr)
+    {
+      return ErrorCode::PTR_NULL;
+    }
+
+    const auto current_tail = tail_.load(std::memory_order_relaxed);
+    if (!ReserveProducer(current_tail, count))
+    {
+      return ErrorCode::FULL;
+    }
+
+    CopyIn(current_tail, static_cast<const std::byte*>(data), count);
+    tail_.store(current_tail + count, std::memory_order_release);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按字节批量出队多个 payload / Dequeue multiple payloads by bytes
+   * @param data 用于接收 payload 的字节缓冲区；传 `nullptr` 时仅丢弃
+   *        / Byte buffer receiving payloads; pass `nullptr` to discard only
+   * @param count payload 个数 / Number of payloads
+   * @return 成功返回 `ErrorCode::OK`；元素不足返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         there are not enough payloads available
+   */
+  ErrorCode PopBatchBytes(void* data, size_t count)
+  {
+    if (count == 0U)
+    {
+      return ErrorCode::OK;
+    }
+
+    const auto current_head = head_.load(std::memory_order_relaxed);
+    if (!ReserveConsumer(current_head, count))
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    if (data != nullptr)
+    {
+      CopyOut(static_cast<std::byte*>(data), current_head, count);
+    }
+
+    head_.store(current_head + count, std::memory_order_release);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 按字节批量查看多个 payload 但不出队
+   *        / Peek multiple payloads by bytes without dequeuing them
+   * @param data 用于接收 payload 的字节缓冲区 / Byte buffer receiving payloads
+   * @param count payload 个数 / Number of payloads
+   * @return 成功返回 `ErrorCode::OK`；元素不足返回 `ErrorCode::EMPTY`；空指针返回
+   *         `ErrorCode::PTR_NULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         there are not enough payloads; returns `ErrorCode::PTR_NULL` when `data`
+   *         is null
+   */
+  ErrorCode PeekBatchBytes(void* data, size_t count)
+  {
+    if (count == 0U)
+    {
+      return ErrorCode::OK;
+    }
+    if (data == nullptr)
+    {
+      return ErrorCode::PTR_NULL;
+    }
+
+    const auto current_head = head_.load(std::memory_order_relaxed);
+    if (!ReserveConsumer(current_head, count))
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    CopyOut(static_cast<std::byte*>(data), current_head, count);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 重置队列状态 / Reset the queue state
+   *
+   * @note 只能在生产者和消费者都不活动时调用 / Only call while neither the producer
+   *       nor the consumer is active
+   */
+  void Reset()
+  {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    cached_head_ = 0;
+    cached_tail_ = 0;
+  }
+
+  /**
+   * @brief 获取当前已用元素数 / Get the current element count
+   * @return 当前元素个数 / Current number of stored payloads
+   */
+  size_t Size() const
+  {
+    const auto current_head = head_.load(std::memory_order_acquire);
+    const auto current_tail = tail_.load(std::memory_order_acquire);
+    const size_t used = current_tail - current_head;
+    return used > capacity_ ? capacity_ : used;
+  }
+
+  /**
+   * @brief 获取剩余空槽数 / Get the current free-slot count
+   * @return 当前空槽个数 / Current number of free slots
+   */
+  size_t EmptySize() const { return capacity_ - Size(); }
+
+  /**
+   * @brief 获取队列最大容量 / Get the maximum queue capacity
+   * @return 取整后的队列容量 / Rounded queue capacity
+   */
+  size_t MaxSize() const { return capacity_; }
+
+ private:
+  /**
+   * @brief 生产者确认还有 `count` 个空槽 / Producer check for `count` free slots
+   * @param current_tail 生产者当前索引 / Current producer index
+   * @param count 需要的槽位数 / Slots needed
+   * @return 空间足够返回 `true` / Returns `true` when there is enough room
+   *
+   * @note 先按缓存的 `head_` 判断，不够时才重新读取一次 / Checks against the cached
+   *       `head_` first and reloads it only when that is not enough
+   */
+  bool ReserveProducer(IndexType current_tail, size_t count)
+  {
+    if (capacity_ - (current_tail - cached_head_) >= count)
+    {
+      return true;
+    }
+    cached_head_ = head_.load(std::memory_order_acquire);
+    return capacity_ - (current_tail - cached_head_) >= count;
+  }
+
+  /**
+   * @brief 消费者确认至少有 `count` 个元素 / Consumer check for `count` stored
+   *        elements
+   * @param current_head 消费者当前索引 / Current consumer index
+   * @param count 需要的元素数 / Elements needed
+   * @return 元素足够返回 `true` / Returns `true` when enough elements are stored
+   *
+   * @note 先按缓存的 `tail_` 判断，不够时才重新读取一次 / Checks against the cached
+   *       `tail_` first and reloads it only when that is not enough
+   */
+  bool ReserveConsumer(IndexType current_head, size_t count)
+  {
+    if (cached_tail_ - current_head >= count)
+    {
+      return true;
+    }
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    return cached_tail_ - current_head >= count;
+  }
+
+  /**
+   * @brief 获取索引对应槽位的 payload 地址 / Get the payload address of an index
+   * @param index 自由递增索引 / Free-running index
+   * @return 槽位 payload 起始地址 / Slot payload base address
+   */
+  std::byte* PayloadPtr(IndexType index)
+  {
+    return payloads_ + (index & mask_) * payload_stride_;
+  }
+
+  /**
+   * @brief 把紧密排列的 payload 数组写入从 `first` 开始的槽位 / Write a packed payload
+   *        array into the slots starting at `first`
+   * @param first 起始自由递增索引 / First free-running index
+   * @param src 紧密排列的源 payload / Packed source payloads
+   * @param count payload 个数 / Number of payloads
+   *
+   * @note 步长等于 payload 大小时至多两段整块拷贝 / At most two bulk copies when the
+   *       stride equals the payload size
+   */
+  void CopyIn(IndexType first, const std::byte* src, size_t count)
+  {
+    if (payload_stride_ != element_size_)
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        LibXR::Memory::FastCopy(PayloadPtr(first + index), src + index * element_size_,
+                                element_size_);
+      }
+      return;
+    }
+
+    const size_t first_chunk = std::min(count, capacity_ - (first & mask_));
+    LibXR::Memory::FastCopy(PayloadPtr(first), src, first_chunk * element_size_);
+    if (count > first_chunk)
+    {
+      LibXR::Memory::FastCopy(payloads_, src + first_chunk * element_size_,
+                              (count - first_chunk) * element_size_);
+    }
+  }
+
+  /**
+   * @brief 把从 `first` 开始的槽位读成紧密排列的 payload 数组 / Read the slots starting
+   *        at `first` into a packed payload array
+   * @param dst 紧密排列的目标缓冲区 / Packed destination buffer
+   * @param first 起始自由递增索引 / First free-running index
+   * @param count payload 个数 / Number of payloads
+   */
+  void CopyOut(std::byte* dst, IndexType first, size_t count)
+  {
+    if (payload_stride_ != element_size_)
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        LibXR::Memory::FastCopy(dst + index * element_size_, PayloadPtr(first + index),
+                                element_size_);
+      }
+      return;
+    }
+
+    const size_t first_chunk = std::min(count, capacity_ - (first & mask_));
+    LibXR::Memory::FastCopy(dst, PayloadPtr(first), first_chunk * element_size_);
+    if (count > first_chunk)
+    {
+      LibXR::Memory::FastCopy(dst + first_chunk * element_size_, payloads_,
+                              (count - first_chunk) * element_size_);
+    }
+  }
+
+  /**
+   * @brief 把容量向上取到 2 的幂 / Round a capacity up to a power of two
+   * @param capacity 最少容量 / Minimum capacity
+   * @return 取整后的容量 / Rounded capacity
+   */
+  static size_t RoundCapacity(size_t capacity)
+  {
+    ASSERT(capacity > 0);
+    ASSERT(capacity <= (std::numeric_limits<size_t>::max() >> 1) + 1);
+    return std::bit_ceil(capacity);
+  }
+
+  /**
+   * @brief 按对齐计算槽位步长 / Compute the slot stride from an alignment
+   * @param element_size 单个 payload 的字节数 / Byte size of one payload
+   * @param element_align 单个 payload 的对齐要求 / Alignment of one payload
+   * @return 槽位步长 / Slot stride
+   */
+  static size_t ComputeStride(size_t element_size, size_t element_align)
+  {
+    ASSERT(element_size > 0);
+    ASSERT(element_align > 0);
+    ASSERT((element_align & (element_align - 1)) == 0);
+    ASSERT(element_size <= std::numeric_limits<size_t>::max() - (element_align - 1));
+    return (element_size + element_align - 1) / element_align * element_align;
+  }
+
+  /**
+   * @brief 安全地计算两个字节数的乘积 / Safely multiply two byte counts
+   * @param lhs 左操作数 / Left operand
+   * @param rhs 右操作数 / Right operand
+   * @return 乘积结果 / Product result
+   */
+  static size_t MultiplyChecked(size_t lhs, size_t rhs)
+  {
+    ASSERT(rhs == 0 || lhs <= std::numeric_limits<size_t>::max() / rhs);
+    return lhs * rhs;
+  }
+
+  const size_t element_size_;    ///< 单个 payload 的字节数。 Byte size of one payload.
+  const size_t payload_stride_;  ///< 相邻槽位之间的步长。 Byte stride between slots.
+  const size_t capacity_;        ///< 2 的幂容量。 Power-of-two capacity.
+  const size_t mask_;            ///< 槽位掩码。 Slot index mask.
+  std::byte* const payloads_;    ///< payload 字节缓冲区。 Byte buffer storing payloads.
+
+  alignas(LibXR::CONCURRENCY_ALIGNMENT) std::atomic<IndexType> tail_ =
+      0;                       ///< 下一个待入队的索引。 Next index to enqueue.
+  IndexType cached_head_ = 0;  ///< 生产者缓存的 `head_`。 Producer copy of `head_`.
+
+  alignas(LibXR::CONCURRENCY_ALIGNMENT) std::atomic<IndexType> head_ =
+      0;                       ///< 下一个待出队的索引。 Next index to dequeue.
+  IndexType cached_tail_ = 0;  ///< 消费者缓存的 `tail_`。 Consumer copy of `tail_`.
+};
+}  // namespace LibXR
@@ -44,9 +44,41 @@ class MPMCQueue final : public QueueTypedBase<MPMCQueue<Payload>, Payload>,
    * @brief 构造一个 MPMC 队列。
    * @brief Construct one MPMC queue.
    * @param capacity 队列容量。 Queue capacity.
+   * @param layout 槽序号布局。 Slot sequence layout.
    *
    * @note 包含动态内存分配。 Contains dynamic memory allocation.
    */
-  explicit MPMCQueue(size_t capacity) : MPMCQueueBase(sizeof(Payload), capacity) {}
+  explicit MPMCQueue(size_t capacity, CellLayout layout = CellLayout::PADDED)
+      : MPMCQueueBase(sizeof(Payload), capacity, layout)
+  {
+  }
+
+  /**
+   * @brief 批量推入多个 payload。
+   * @brief Push multiple payloads into the queue.
+   * @param data payload 数组指针。 Pointer to the payload array.
+   * @param size payload 个数。 Number of payloads.
+   * @return 成功返回 `ErrorCode::OK`；连续空槽不足返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when
+   *         there are not enough consecutive free slots
+   */
+  ErrorCode PushBatch(const Payload* data, size_t size)
+  {
+    return MPMCQueueBase::PushBatchBytes(data, size);
+  }
+
+  /**
+   * @brief 批量弹出多个 payload。
+   * @brief Pop multiple payloads from the queue.
+   * @param data 用于接收 payload 的数组。 Array receiving dequeued payloads.
+   * @param size payload 个数。 Number of payloads.
+   * @return 成功返回 `ErrorCode::OK`；连续就绪元素不足返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         there are not enough consecutive ready payloads
+   */
+  ErrorCode PopBatch(Payload* data, size_t size)
+  {
+    return MPMCQueueBase::PopBatchBytes(data, size);
+  }
 };
 }  // namespace LibXR
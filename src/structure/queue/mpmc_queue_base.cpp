@@ -11,11 +11,21 @@ namespace LibXR
  * @brief 构造字节队列内核 / Construct the byte-queue core
  * @param element_size 单个 payload 的字节数 / Byte size of one payload
  * @param capacity 队列容量 / Queue capacity
+ * @param layout 槽序号布局 / Slot sequence layout
  */
-MPMCQueueBase::MPMCQueueBase(size_t element_size, size_t capacity)
+MPMCQueueBase::MPMCQueueBase(size_t element_size, size_t capacity, CellLayout layout)
     : element_size_(element_size),
       capacity_(capacity),
-      payload_stride_(AlignUpChecked(element_size_, alignof(size_t))),
+      layout_(layout),
+      sequence_stride_(layout == CellLayout::PADDED
+                           ? AlignUpChecked(sizeof(std::atomic<SequenceType>),
+                                            LibXR::CONCURRENCY_ALIGNMENT)
+                           : AlignUpChecked(sizeof(std::atomic<SequenceType>) +
+                                                element_size,
+                                            alignof(std::atomic<SequenceType>))),
+      payload_stride_(layout == CellLayout::PADDED
+                          ? AlignUpChecked(element_size_, alignof(size_t))
+                          : sequence_stride_),
       sequences_(nullptr),
       payloads_(nullptr),
       head_(0),
@@ -25,16 +35,28 @@ MPMCQueueBase::MPMCQueueBase(size_t element_size, size_t capacity)
   REQUIRE(capacity_ > 1);
   REQUIRE(capacity_ <= static_cast<size_t>(std::numeric_limits<SequenceDiffType>::max()));
 
-  const size_t payload_bytes = MultiplyChecked(payload_stride_, capacity_);
-  sequences_ = new (std::align_val_t(alignof(SequenceCell))) SequenceCell[capacity_];
-
-  payloads_ = static_cast<std::byte*>(
-      ::operator new[](payload_bytes, std::align_val_t(PAYLOAD_ALLOC_ALIGN)));
+  const size_t sequence_bytes = MultiplyChecked(sequence_stride_, capacity_);
+  if (layout_ == CellLayout::PADDED)
+  {
+    sequences_ = static_cast<std::byte*>(::operator new[](
+        sequence_bytes, std::align_val_t(LibXR::CONCURRENCY_ALIGNMENT)));
+    payloads_ = static_cast<std::byte*>(
+        ::operator new[](MultiplyChecked(payload_stride_, capacity_),
+                         std::align_val_t(PAYLOAD_ALLOC_ALIGN)));
+  }
+  else
+  {
+    // 紧凑单元：序号在前，payload 紧随其后。Compact cell: the sequence first, the
+    // payload right after it.
+    sequences_ = static_cast<std::byte*>(
+        ::operator new[](sequence_bytes, std::align_val_t(PAYLOAD_ALLOC_ALIGN)));
+    payloads_ = sequences_ + sizeof(std::atomic<SequenceType>);
+  }
 
   for (size_t index = 0; index < capacity_; ++index)
   {
-    sequences_[index].value.store(static_cast<SequenceType>(index),
-                                  std::memory_order_relaxed);
+    new (sequences_ + index * sequence_stride_)
+        std::atomic<SequenceType>(static_cast<SequenceType>(index));
   }
 }
 
@@ -43,8 +65,15 @@ MPMCQueueBase::MPMCQueueBase(size_t element_size, size_t capacity)
  */
 MPMCQueueBase::~MPMCQueueBase()
 {
-  ::operator delete[](payloads_, std::align_val_t(PAYLOAD_ALLOC_ALIGN));
-  delete[] sequences_;
+  if (layout_ == CellLayout::PADDED)
+  {
+    ::operator delete[](payloads_, std::align_val_t(PAYLOAD_ALLOC_ALIGN));
+    ::operator delete[](sequences_, std::align_val_t(LibXR::CONCURRENCY_ALIGNMENT));
+  }
+  else
+  {
+    ::operator delete[](sequences_, std::align_val_t(PAYLOAD_ALLOC_ALIGN));
+  }
 }
 
 /**
@@ -62,8 +91,8 @@ ErrorCode MPMCQueueBase::PushBytes(const void* value)
 
   while (true)
   {
-    SequenceCell& slot = sequences_[position % capacity_];
-    const SequenceType sequence = slot.value.load(std::memory_order_acquire);
+    auto& slot = Sequence(position % capacity_);
+    const SequenceType sequence = slot.load(std::memory_order_acquire);
     const SequenceDiffType diff = static_cast<SequenceDiffType>(sequence - position);
 
     if (diff == 0)
@@ -72,7 +101,7 @@ ErrorCode MPMCQueueBase::PushBytes(const void* value)
                                       std::memory_order_relaxed))
       {
         LibXR::Memory::FastCopy(PayloadPtr(position % capacity_), value, element_size_);
-        slot.value.store(position + 1, std::memory_order_release);
+        slot.store(position + 1, std::memory_order_release);
         return ErrorCode::OK;
       }
       continue;
@@ -99,8 +128,8 @@ ErrorCode MPMCQueueBase::PopBytes(void* value)
 
   while (true)
   {
-    SequenceCell& slot = sequences_[position % capacity_];
-    const SequenceType sequence = slot.value.load(std::memory_order_acquire);
+    auto& slot = Sequence(position % capacity_);
+    const SequenceType sequence = slot.load(std::memory_order_acquire);
     const SequenceType expected_ready = position + 1;
     const SequenceDiffType diff =
         static_cast<SequenceDiffType>(sequence - expected_ready);
@@ -114,7 +143,7 @@ ErrorCode MPMCQueueBase::PopBytes(void* value)
         {
           LibXR::Memory::FastCopy(value, PayloadPtr(position % capacity_), element_size_);
         }
-        slot.value.store(position + static_cast<SequenceType>(capacity_),
+        slot.store(position + static_cast<SequenceType>(capacity_),
                          std::memory_order_release);
         return ErrorCode::OK;
       }
@@ -130,6 +159,158 @@ ErrorCode MPMCQueueBase::PopBytes(void* value)
   }
 }
 
+/**
+ * @brief 按字节批量入队多个 payload / Enqueue multiple payloads by bytes
+ * @param data 指向紧密排列的 payload 数组 / Pointer to the packed payload array
+ * @param count payload 个数 / Number of payloads
+ */
+ErrorCode MPMCQueueBase::PushBatchBytes(const void* data, size_t count)
+{
+  if (count == 0U)
+  {
+    return ErrorCode::OK;
+  }
+  if (data == nullptr)
+  {
+    return ErrorCode::PTR_NULL;
+  }
+  if (count > capacity_)
+  {
+    return ErrorCode::FULL;
+  }
+
+  SequenceType position = tail_.load(std::memory_order_relaxed);
+
+  while (true)
+  {
+    const ClaimState state = CheckRange(position, count, 0);
+    if (state == ClaimState::READY)
+    {
+      if (tail_.compare_exchange_weak(position, position + count,
+                                      std::memory_order_relaxed,
+                                      std::memory_order_relaxed))
+      {
+        CopyIn(position, static_cast<const std::byte*>(data), count);
+        for (size_t offset = 0; offset < count; ++offset)
+        {
+          const SequenceType slot_position = position + offset;
+          Sequence(slot_position % capacity_)
+              .store(slot_position + 1, std::memory_order_release);
+        }
+        return ErrorCode::OK;
+      }
+      continue;
+    }
+
+    if (state == ClaimState::BLOCKED)
+    {
+      return ErrorCode::FULL;
+    }
+
+    position = tail_.load(std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief 按字节批量出队多个 payload / Dequeue multiple payloads by bytes
+ * @param data 用于接收 payload 的紧密排列缓冲区；传 `nullptr` 时仅丢弃
+ *        / Packed buffer receiving the payloads; pass `nullptr` to discard only
+ * @param count payload 个数 / Number of payloads
+ */
+ErrorCode MPMCQueueBase::PopBatchBytes(void* data, size_t count)
+{
+  if (count == 0U)
+  {
+    return ErrorCode::OK;
+  }
+  if (count > capacity_)
+  {
+    return ErrorCode::EMPTY;
+  }
+
+  SequenceType position = head_.load(std::memory_order_relaxed);
+
+  while (true)
+  {
+    const ClaimState state = CheckRange(position, count, 1);
+    if (state == ClaimState::READY)
+    {
+      if (head_.compare_exchange_weak(position, position + count,
+                                      std::memory_order_relaxed,
+                                      std::memory_order_relaxed))
+      {
+        if (data != nullptr)
+        {
+          CopyOut(static_cast<std::byte*>(data), position, count);
+        }
+        for (size_t offset = 0; offset < count; ++offset)
+        {
+          const SequenceType slot_position = position + offset;
+          Sequence(slot_position % capacity_)
+              .store(slot_position + static_cast<SequenceType>(capacity_),
+                     std::memory_order_release);
+        }
+        return ErrorCode::OK;
+      }
+      continue;
+    }
+
+    if (state == ClaimState::BLOCKED)
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    position = head_.load(std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief 检查一段槽位能否整体认领 / Check whether a range of slots can be claimed as a
+ *        whole
+ * @param position 起始逻辑位置 / First logical position
+ * @param count 槽位个数 / Number of slots
+ * @param ready_offset 就绪序号相对位置的偏移，入队为 0、出队为 1 / Offset of the
+ *        ready sequence from the position, 0 for enqueue and 1 for dequeue
+ *
+ * @note 就绪的槽位只能由持有对应位置的一方改写，而位置要先经过这里之后的那次 CAS
+ *       才能被认领，所以检查通过且 CAS 成功时整段槽位都归调用方所有。
+ *       A ready slot can only be rewritten by whoever owns its position, and that
+ *       position can only be claimed through the CAS that follows this check, so once
+ *       the check passes and the CAS succeeds the whole range belongs to the caller.
+ */
+MPMCQueueBase::ClaimState MPMCQueueBase::CheckRange(SequenceType position, size_t count,
+                                                    SequenceType ready_offset)
+{
+  for (size_t offset = 0; offset < count; ++offset)
+  {
+    const SequenceType slot_position = position + offset;
+    const SequenceType sequence =
+        Sequence(slot_position % capacity_).load(std::memory_order_acquire);
+    const SequenceDiffType diff =
+        static_cast<SequenceDiffType>(sequence - (slot_position + ready_offset));
+    if (diff < 0)
+    {
+      return ClaimState::BLOCKED;
+    }
+    if (diff > 0)
+    {
+      return ClaimState::STALE;
+    }
+  }
+  return ClaimState::READY;
+}
+
+/**
+ * @brief 获取序号和 payload 存储占用的字节数 / Get the bytes taken by sequence and
+ *        payload storage
+ */
+size_t MPMCQueueBase::StorageBytes() const
+{
+  const size_t sequence_bytes = sequence_stride_ * capacity_;
+  return layout_ == CellLayout::PADDED ? sequence_bytes + payload_stride_ * capacity_
+                                       : sequence_bytes;
+}
+
 /**
  * @brief 获取并发快照下的当前元素数 / Get the current approximate element count
  * @return 并发快照下的元素数，范围被钳在 `[0, MaxSize()]`
@@ -144,6 +325,16 @@ size_t MPMCQueueBase::Size() const
   return (used <= capacity_) ? used : capacity_;
 }
 
+/**
+ * @brief 获取指定槽位的序号 / Get the sequence of one slot
+ * @param index 槽位下标 / Slot index
+ */
+std::atomic<MPMCQueueBase::SequenceType>& MPMCQueueBase::Sequence(size_t index)
+{
+  return *std::launder(reinterpret_cast<std::atomic<SequenceType>*>(
+      sequences_ + index * sequence_stride_));
+}
+
 /**
  * @brief 获取指定槽位 payload 起始地址 / Get the payload base address of one slot
  * @param index 槽位下标 / Slot index
@@ -163,6 +354,68 @@ const void* MPMCQueueBase::PayloadPtr(size_t index) const
   return payloads_ + index * payload_stride_;
 }
 
+/**
+ * @brief 把紧密排列的 payload 写入从 `position` 起的槽位 / Copy packed payloads into
+ *        the slots starting at `position`
+ * @param position 起始逻辑位置 / First logical position
+ * @param src 紧密排列的源 payload / Packed source payloads
+ * @param count payload 个数 / Number of payloads
+ *
+ * @note payload 槽位紧密相邻时按环形回绕拆成至多两段整块拷贝 / When payload slots are
+ *       packed back to back the copy is split at the ring wrap into at most two bulk
+ *       copies
+ */
+void MPMCQueueBase::CopyIn(SequenceType position, const std::byte* src, size_t count)
+{
+  const size_t first = position % capacity_;
+  if (payload_stride_ != element_size_)
+  {
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+      LibXR::Memory::FastCopy(PayloadPtr((first + offset) % capacity_),
+                              src + offset * element_size_, element_size_);
+    }
+    return;
+  }
+
+  const size_t first_chunk = std::min(count, capacity_ - first);
+  LibXR::Memory::FastCopy(PayloadPtr(first), src, first_chunk * element_size_);
+  if (count > first_chunk)
+  {
+    LibXR::Memory::FastCopy(PayloadPtr(0), src + first_chunk * element_size_,
+                            (count - first_chunk) * element_size_);
+  }
+}
+
+/**
+ * @brief 把从 `position` 起的槽位读成紧密排列的 payload / Copy the slots starting at
+ *        `position` out as packed payloads
+ * @param dst 紧密排列的目标缓冲区 / Packed destination buffer
+ * @param position 起始逻辑位置 / First logical position
+ * @param count payload 个数 / Number of payloads
+ */
+void MPMCQueueBase::CopyOut(std::byte* dst, SequenceType position, size_t count) const
+{
+  const size_t first = position % capacity_;
+  if (payload_stride_ != element_size_)
+  {
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+      LibXR::Memory::FastCopy(dst + offset * element_size_,
+                              PayloadPtr((first + offset) % capacity_), element_size_);
+    }
+    return;
+  }
+
+  const size_t first_chunk = std::min(count, capacity_ - first);
+  LibXR::Memory::FastCopy(dst, PayloadPtr(first), first_chunk * element_size_);
+  if (count > first_chunk)
+  {
+    LibXR::Memory::FastCopy(dst + first_chunk * element_size_, PayloadPtr(0),
+                            (count - first_chunk) * element_size_);
+  }
+}
+
 /**
  * @brief 向上对齐到指定粒度 / Align one byte count upward to the target granularity
  * @param value 待对齐字节数 / Byte count to align
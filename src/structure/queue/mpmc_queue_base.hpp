@@ -24,6 +24,14 @@ namespace LibXR
  * non-template implementation so different payload types do not each instantiate
  * a full copy of the lock-free protocol. It only moves fixed-size, word-aligned
  * byte payloads; type semantics are handled by thin wrappers above it.
+ *
+ * 槽序号有两种布局：默认的 `PADDED` 把每个序号单独填满一条缓存行，竞争最小；
+ * `COMPACT` 把序号和 payload 放进同一个紧凑单元，占用大幅下降，代价是相邻槽位的
+ * 序号可能共享缓存行。
+ * Slot sequences come in two layouts: the default `PADDED` gives every sequence its
+ * own cache line for the least contention, while `COMPACT` packs the sequence and the
+ * payload into one tight cell for a far smaller footprint, at the cost of neighbouring
+ * slots possibly sharing a cache line.
  */
 class MPMCQueueBase
 {
@@ -34,12 +42,25 @@ class MPMCQueueBase
       std::make_signed_t<SequenceType>;  ///< 序号差值判定类型 / Signed type used for
                                          ///< sequence-delta checks.
 
+  /**
+   * @enum CellLayout
+   * @brief 槽序号的存放方式 / How slot sequences are stored
+   */
+  enum class CellLayout : uint8_t
+  {
+    PADDED,   ///< 序号独占缓存行 / Each sequence owns a cache line
+    COMPACT,  ///< 序号与 payload 同处一个紧凑单元 / Sequence and payload share one
+              ///< tight cell
+  };
+
   /**
    * @brief 构造一个字节队列内核 / Construct one byte-queue core
    * @param element_size 单个 payload 的字节数 / Byte size of one payload
    * @param capacity 队列容量 / Queue capacity
+   * @param layout 槽序号布局 / Slot sequence layout
    */
-  MPMCQueueBase(size_t element_size, size_t capacity);
+  MPMCQueueBase(size_t element_size, size_t capacity,
+                CellLayout layout = CellLayout::PADDED);
   /**
    * @brief 析构字节队列内核 / Destroy the byte-queue core
    */
@@ -65,6 +86,37 @@ class MPMCQueueBase
    */
   ErrorCode PopBytes(void* value = nullptr);
 
+  /**
+   * @brief 按字节批量入队多个 payload / Enqueue multiple payloads by bytes
+   * @param data 指向紧密排列的 payload 数组 / Pointer to the packed payload array
+   * @param count payload 个数 / Number of payloads
+   * @return 成功返回 `ErrorCode::OK`；连续空槽不足返回 `ErrorCode::FULL`；空指针返回
+   *         `ErrorCode::PTR_NULL`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::FULL` when there are not
+   *         enough consecutive free slots; `ErrorCode::PTR_NULL` when `data` is null
+   *
+   * @note 一次 CAS 认领 `count` 个连续位置，要么全部入队，要么一个都不入队；同批
+   *       payload 在队列中保持相邻。
+   *       One CAS claims `count` consecutive positions, so either the whole batch is
+   *       enqueued or none of it is; the batch stays contiguous in the queue.
+   */
+  ErrorCode PushBatchBytes(const void* data, size_t count);
+
+  /**
+   * @brief 按字节批量出队多个 payload / Dequeue multiple payloads by bytes
+   * @param data 用于接收 payload 的紧密排列缓冲区；传 `nullptr` 时仅丢弃
+   *        / Packed buffer receiving the payloads; pass `nullptr` to discard only
+   * @param count payload 个数 / Number of payloads
+   * @return 成功返回 `ErrorCode::OK`；连续就绪元素不足返回 `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when
+   *         there are not enough consecutive ready payloads
+   *
+   * @note 一次 CAS 认领 `count` 个连续位置，要么全部出队，要么一个都不出队。
+   *       One CAS claims `count` consecutive positions, so either the whole batch is
+   *       dequeued or none of it is.
+   */
+  ErrorCode PopBatchBytes(void* data, size_t count);
+
   /**
    * @brief 获取队列最大容量 / Get the maximum queue capacity
    * @return 队列容量 / Queue capacity
@@ -94,20 +146,44 @@ class MPMCQueueBase
    * @return 单个 payload 的字节数 / Byte size of one payload
    */
   [[nodiscard]] size_t ElementSize() const { return element_size_; }
+  /**
+   * @brief 获取槽序号布局 / Get the slot sequence layout
+   * @return 构造时选定的布局 / Layout chosen at construction
+   */
+  [[nodiscard]] CellLayout Layout() const { return layout_; }
+  /**
+   * @brief 获取序号和 payload 存储占用的字节数 / Get the bytes taken by sequence and
+   *        payload storage
+   * @return 两块存储的总字节数 / Total bytes of both storage blocks
+   */
+  [[nodiscard]] size_t StorageBytes() const;
 
  private:
-  /// @brief 每个逻辑槽对应的序号单元。 Sequence cell for one logical slot.
-  struct alignas(LibXR::CONCURRENCY_ALIGNMENT) SequenceCell
+  /// @brief 槽位认领检查结果。 Result of checking a range of slots for a claim.
+  enum class ClaimState : uint8_t
   {
-    std::atomic<SequenceType>
-        value;  ///< 当前槽的逻辑序号。 Current logical sequence of the slot.
+    READY,    ///< 全部槽位就绪。 Every slot is ready.
+    BLOCKED,  ///< 有槽位尚未轮到。 Some slot is not ready yet.
+    STALE,    ///< 起始位置已被别人认领。 The start position was already claimed.
   };
 
+  /// @brief 获取指定槽位的序号。 Get the sequence of one slot.
+  [[nodiscard]] std::atomic<SequenceType>& Sequence(size_t index);
+  /// @brief 检查从 `position` 起的 `count` 个槽位是否都处于期望序号。 Check that the
+  /// `count` slots starting at `position` all hold the expected sequence.
+  [[nodiscard]] ClaimState CheckRange(SequenceType position, size_t count,
+                                      SequenceType ready_offset);
   /// @brief 获取指定槽位 payload 起始地址。 Get the payload base address of one slot.
   [[nodiscard]] void* PayloadPtr(size_t index);
   /// @brief 获取指定槽位 payload 起始地址（只读）。 Get the payload base address of one
   /// slot (const).
   [[nodiscard]] const void* PayloadPtr(size_t index) const;
+  /// @brief 把紧密排列的 payload 写入从 `position` 起的槽位。 Copy packed payloads into
+  /// the slots starting at `position`.
+  void CopyIn(SequenceType position, const std::byte* src, size_t count);
+  /// @brief 把从 `position` 起的槽位读成紧密排列的 payload。 Copy the slots starting at
+  /// `position` out as packed payloads.
+  void CopyOut(std::byte* dst, SequenceType position, size_t count) const;
   /// @brief 安全地向上对齐字节数。 Safely align one byte count upward.
   [[nodiscard]] static size_t AlignUpChecked(size_t value, size_t align);
   /// @brief 安全地计算乘积。 Safely multiply two size values.
@@ -128,12 +204,17 @@ class MPMCQueueBase
   /// @brief 禁止移动赋值。 Non-move-assignable.
   MPMCQueueBase& operator=(MPMCQueueBase&&);
 
-  const size_t element_size_;    ///< 单个 payload 的字节数。 Byte size of one payload.
-  const size_t capacity_;        ///< 队列容量。 Queue capacity.
-  const size_t payload_stride_;  ///< 相邻 payload 槽位之间的步长。 Byte stride between
-                                 ///< adjacent payload slots.
-  SequenceCell* sequences_;      ///< 槽序号数组。 Array of per-slot sequence cells.
-  std::byte* payloads_;          ///< payload 字节缓冲区。 Byte buffer storing payloads.
+  const size_t element_size_;     ///< 单个 payload 的字节数。 Byte size of one payload.
+  const size_t capacity_;         ///< 队列容量。 Queue capacity.
+  const CellLayout layout_;       ///< 槽序号布局。 Slot sequence layout.
+  const size_t sequence_stride_;  ///< 相邻槽序号之间的步长。 Byte stride between
+                                  ///< adjacent slot sequences.
+  const size_t payload_stride_;   ///< 相邻 payload 槽位之间的步长。 Byte stride between
+                                  ///< adjacent payload slots.
+  std::byte* sequences_;  ///< 首个槽序号地址；紧凑布局下也是整块存储起点。 Address of
+                          ///< the first slot sequence, also the storage base in the
+                          ///< compact layout.
+  std::byte* payloads_;   ///< 首个 payload 地址。 Address of the first payload.
 
   alignas(LibXR::CONCURRENCY_ALIGNMENT) std::atomic<
       SequenceType> head_;  ///< 下一个待出队的逻辑位置。 Next logical dequeue position.
@@ -5,13 +5,17 @@
  * @brief 队列模块聚合入口。
  * @brief Aggregate entry of the queue module.
  *
- * 该头文件聚合 LibXR 当前公开的三种强类型队列：普通 FIFO、SPSC 和 MPMC。
- * 调用方若只需要统一引入队列族，可直接包含本头文件。
- * This header aggregates the three currently public typed queues in LibXR:
- * the ordinary FIFO queue, SPSC queue, and MPMC queue.
- * Callers may include this file directly when they want one uniform queue-family entry.
+ * 该头文件聚合 LibXR 当前公开的强类型队列：普通 FIFO、SPSC、带索引缓存的
+ * 2 的幂 SPSC、MPMC 和工作窃取双端队列。调用方若只需要统一引入队列族，可直接
+ * 包含本头文件。
+ * This header aggregates the currently public typed queues in LibXR: the ordinary
+ * FIFO queue, SPSC queue, power-of-two SPSC queue with index caches, MPMC queue, and
+ * work-stealing deque. Callers may include this file directly when they want one
+ * uniform queue-family entry.
  */
 
 #include "basic_queue.hpp"
+#include "cached_spsc_queue.hpp"
 #include "mpmc_queue.hpp"
 #include "spsc_queue.hpp"
+#include "work_stealing_deque.hpp"
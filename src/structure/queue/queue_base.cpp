@@ -112,6 +112,11 @@ ErrorCode QueueBase::PushBatchBytes(const void* data, size_t size)
     return ErrorCode::FULL;
   }
 
+  if (size == 0)
+  {
+    return ErrorCode::OK;
+  }
+
   auto tmp = reinterpret_cast<const uint8_t*>(data);
 
   size_t first_part = LibXR::min(size, length_ - tail_);
@@ -200,13 +200,7 @@ class alignas(LibXR::CONCURRENCY_ALIGNMENT) SPSCQueueBase
       return ErrorCode::FULL;
     }
 
-    const auto* src = static_cast<const std::byte*>(data);
-    for (size_t index = 0; index < count; ++index)
-    {
-      LibXR::Memory::FastCopy(PayloadPtr((current_tail + index) % capacity),
-                              src + index * element_size_, element_size_);
-    }
-
+    CopyIn(current_tail, static_cast<const std::byte*>(data), count);
     tail_.store((current_tail + count) % capacity, std::memory_order_release);
     return ErrorCode::OK;
   }
@@ -295,15 +289,9 @@ class alignas(LibXR::CONCURRENCY_ALIGNMENT) SPSCQueueBase
       return ErrorCode::EMPTY;
     }
 
-    auto* dst = static_cast<std::byte*>(data);
-    if (dst != nullptr)
+    if (data != nullptr)
     {
-      for (size_t index = 0; index < count; ++index)
-      {
-        LibXR::Memory::FastCopy(dst + index * element_size_,
-                                PayloadPtr((current_head + index) % capacity),
-                                element_size_);
-      }
+      CopyOut(static_cast<std::byte*>(data), current_head, count);
     }
 
     head_.store((current_head + count) % capacity, std::memory_order_release);
@@ -399,13 +387,7 @@ class alignas(LibXR::CONCURRENCY_ALIGNMENT) SPSCQueueBase
       return ErrorCode::EMPTY;
     }
 
-    auto* dst = static_cast<std::byte*>(data);
-    for (size_t index = 0; index < count; ++index)
-    {
-      LibXR::Memory::FastCopy(dst + index * element_size_,
-                              PayloadPtr((current_head + index) % capacity),
-                              element_size_);
-    }
+    CopyOut(static_cast<std::byte*>(data), current_head, count);
     return ErrorCode::OK;
   }
 
@@ -478,6 +460,69 @@ class alignas(LibXR::CONCURRENCY_ALIGNMENT) SPSCQueueBase
    */
   IndexType Increment(IndexType index) const { return (index + 1) % RingCapacity(); }
 
+  /**
+   * @brief 把紧密排列的 payload 数组写入从 `first` 开始的槽位 / Write a packed payload
+   *        array into the slots starting at `first`
+   * @param first 起始槽位下标 / First slot index
+   * @param src 紧密排列的源 payload / Packed source payloads
+   * @param count payload 个数，调用方已确认空间足够 / Number of payloads, already
+   *        checked against free space by the caller
+   *
+   * @note 槽位步长等于 payload 大小时按环形回绕拆成至多两段整块拷贝，否则逐个拷贝 /
+   *       When the slot stride equals the payload size the copy is split at the ring
+   *       wrap into at most two bulk copies, otherwise payloads are copied one by one
+   */
+  void CopyIn(IndexType first, const std::byte* src, size_t count)
+  {
+    if (payload_stride_ != element_size_)
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        LibXR::Memory::FastCopy(PayloadPtr((first + index) % RingCapacity()),
+                                src + index * element_size_, element_size_);
+      }
+      return;
+    }
+
+    const size_t first_chunk = std::min(count, RingCapacity() - first);
+    LibXR::Memory::FastCopy(PayloadPtr(first), src, first_chunk * element_size_);
+    if (count > first_chunk)
+    {
+      LibXR::Memory::FastCopy(PayloadPtr(0), src + first_chunk * element_size_,
+                              (count - first_chunk) * element_size_);
+    }
+  }
+
+  /**
+   * @brief 把从 `first` 开始的槽位读成紧密排列的 payload 数组 / Read the slots starting
+   *        at `first` into a packed payload array
+   * @param dst 紧密排列的目标缓冲区 / Packed destination buffer
+   * @param first 起始槽位下标 / First slot index
+   * @param count payload 个数，调用方已确认元素足够 / Number of payloads, already
+   *        checked against the stored count by the caller
+   */
+  void CopyOut(std::byte* dst, IndexType first, size_t count) const
+  {
+    if (payload_stride_ != element_size_)
+    {
+      for (size_t index = 0; index < count; ++index)
+      {
+        LibXR::Memory::FastCopy(dst + index * element_size_,
+                                PayloadPtr((first + index) % RingCapacity()),
+                                element_size_);
+      }
+      return;
+    }
+
+    const size_t first_chunk = std::min(count, RingCapacity() - first);
+    LibXR::Memory::FastCopy(dst, PayloadPtr(first), first_chunk * element_size_);
+    if (count > first_chunk)
+    {
+      LibXR::Memory::FastCopy(dst + first_chunk * element_size_, PayloadPtr(0),
+                              (count - first_chunk) * element_size_);
+    }
+  }
+
   /// @brief 禁止拷贝构造。 Non-copyable.
   SPSCQueueBase(const SPSCQueueBase&);
   /// @brief 禁止拷贝赋值。 Non-copy-assignable.
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "libxr_def.hpp"
+
+namespace LibXR
+{
+/**
+ * @class WorkStealingDeque
+ * @brief 定长 Chase-Lev 工作窃取双端队列。
+ * @brief Fixed-capacity Chase-Lev work-stealing deque.
+ *
+ * 拥有者线程在底端 `Push` / `Pop`（后进先出，缓存更热），其他线程在顶端 `Steal`
+ * （先进先出，取走最早、通常也最大的任务）。拥有者在没有竞争时只做普通读写加一次
+ * 栅栏，只有队列只剩最后一个元素时才需要 CAS。容量固定为 2 的幂，不会扩容。
+ *
+ * The owner thread pushes and pops at the bottom (LIFO, cache-warm) while other
+ * threads steal from the top (FIFO, taking the oldest and usually largest task).
+ * Without contention the owner only does plain loads / stores plus one fence; a CAS is
+ * needed only when a single element is left. The capacity is a fixed power of two and
+ * never grows.
+ *
+ * @tparam Data 元素类型，须能无锁原子读写（通常是指针）。 Element type; must be
+ *         lock-free atomic (usually a pointer).
+ */
+template <typename Data>
+class WorkStealingDeque
+{
+  static_assert(std::is_trivially_copyable_v<Data>,
+                "WorkStealingDeque requires trivially copyable elements");
+  static_assert(std::atomic<Data>::is_always_lock_free,
+                "WorkStealingDeque requires lock-free atomic elements");
+
+  using IndexType = int64_t;  ///< 有符号逻辑位置。 Signed logical position.
+
+ public:
+  using ValueType = Data;  ///< 队列元素类型。 Queue element type.
+
+  /**
+   * @brief 构造一个双端队列。
+   * @brief Construct one deque.
+   * @param capacity 最少容量，向上取到 2 的幂。 Minimum capacity, rounded up to a
+   *        power of two.
+   *
+   * @note 包含动态内存分配。 Contains dynamic memory allocation.
+   */
+  explicit WorkStealingDeque(size_t capacity)
+      : capacity_(std::bit_ceil(capacity < 1 ? size_t{1} : capacity)),
+        mask_(capacity_ - 1),
+        slots_(new std::atomic<Data>[capacity_]),
+        top_(0),
+        bottom_(0)
+  {
+  }
+
+  ~WorkStealingDeque() { delete[] slots_; }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * @brief 在底端压入一个元素，仅限拥有者线程调用。
+   * @brief Push one element at the bottom; owner thread only.
+   * @param item 待压入元素。 Element to push.
+   * @return 成功返回 `ErrorCode::OK`；已满返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when full
+   */
+  ErrorCode Push(Data item)
+  {
+    const IndexType bottom = bottom_.load(std::memory_order_relaxed);
+    const IndexType top = top_.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<IndexType>(capacity_))
+    {
+      return ErrorCode::FULL;
+    }
+
+    slots_[static_cast<size_t>(bottom) & mask_].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 从底端弹出一个元素，仅限拥有者线程调用。
+   * @brief Pop one element from the bottom; owner thread only.
+   * @param item 用于接收元素。 Receives the popped element.
+   * @return 成功返回 `ErrorCode::OK`；为空或最后一个元素被窃取返回
+   *         `ErrorCode::EMPTY`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::EMPTY` when the
+   *         deque is empty or its last element was stolen
+   */
+  ErrorCode Pop(Data& item)
+  {
+    const IndexType bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    IndexType top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return ErrorCode::EMPTY;
+    }
+
+    item = slots_[static_cast<size_t>(bottom) & mask_].load(std::memory_order_relaxed);
+    if (top != bottom)
+    {
+      return ErrorCode::OK;
+    }
+
+    // 只剩最后一个元素时与窃取方竞争顶端。
+    // With a single element left, race the thieves for the top.
+    const bool won = top_.compare_exchange_strong(
+        top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won ? ErrorCode::OK : ErrorCode::EMPTY;
+  }
+
+  /**
+   * @brief 从顶端窃取一个元素，任意线程可调用。
+   * @brief Steal one element from the top; callable from any thread.
+   * @param item 用于接收元素。 Receives the stolen element.
+   * @return 成功返回 `ErrorCode::OK`；为空返回 `ErrorCode::EMPTY`；与其他线程竞争
+   *         失败返回 `ErrorCode::BUSY`
+   *         Returns `ErrorCode::OK` on success; `ErrorCode::EMPTY` when empty;
+   *         `ErrorCode::BUSY` when another thread won the race
+   */
+  ErrorCode Steal(Data& item)
+  {
+    IndexType top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const IndexType bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+      return ErrorCode::EMPTY;
+    }
+
+    item = slots_[static_cast<size_t>(top) & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+    {
+      return ErrorCode::BUSY;
+    }
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 获取当前元素数（并发快照）。 Get the current element count (concurrent
+   *        snapshot).
+   */
+  [[nodiscard]] size_t Size() const
+  {
+    const IndexType top = top_.load(std::memory_order_acquire);
+    const IndexType bottom = bottom_.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+  }
+
+  /**
+   * @brief 获取队列容量。 Get the deque capacity.
+   */
+  [[nodiscard]] size_t MaxSize() const { return capacity_; }
+
+ private:
+  const size_t capacity_;     ///< 2 的幂容量。 Power-of-two capacity.
+  const size_t mask_;         ///< 下标掩码。 Index mask.
+  std::atomic<Data>* slots_;  ///< 环形槽位。 Ring slots.
+
+  alignas(LibXR::CONCURRENCY_ALIGNMENT) std::atomic<IndexType> top_;  ///< 窃取端。 Top.
+  alignas(
+      LibXR::CONCURRENCY_ALIGNMENT) std::atomic<IndexType> bottom_;  ///< 拥有端。 Bottom.
+};
+}  // namespace LibXR
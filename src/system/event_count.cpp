@@ -0,0 +1,85 @@
+#include "event_count.hpp"
+
+#if !defined(LIBXR_SYSTEM_linux)
+
+using namespace LibXR;
+
+// 通用实现：等待者挂在信号量上。通知方每摘走一个登记就补一个令牌，等待者要么自己
+// 撤销登记，要么收下恰好一个令牌，因此信号量里不会残留多余令牌。
+// Generic implementation: waiters park on a semaphore. A notifier posts one token for
+// every registration it removes, and a waiter either withdraws its own registration or
+// consumes exactly one token, so no stale tokens are left behind.
+
+EventCount::EventCount() : epoch_(0), parked_(0), parking_(0) {}
+
+ErrorCode EventCount::Wait(Key key, uint32_t timeout)
+{
+  parked_.fetch_add(1, std::memory_order_seq_cst);
+
+  ErrorCode ans = ErrorCode::OK;
+  bool has_token = false;
+  if (epoch_.load(std::memory_order_seq_cst) == key)
+  {
+    ans = parking_.Wait(timeout);
+    has_token = ans == ErrorCode::OK;
+  }
+
+  if (!has_token)
+  {
+    uint32_t parked = parked_.load(std::memory_order_acquire);
+    while (parked > 0 &&
+           !parked_.compare_exchange_weak(parked, parked - 1, std::memory_order_acq_rel,
+                                          std::memory_order_acquire))
+    {
+    }
+    if (parked == 0)
+    {
+      // 登记已被通知方摘走，对应的令牌即将到达。
+      // A notifier already took this registration; its token is about to arrive.
+      (void)parking_.Wait();
+      ans = ErrorCode::OK;
+    }
+  }
+
+  return ans;
+}
+
+void EventCount::NotifyOne() { Notify(1, false, false); }
+
+void EventCount::NotifyAll() { Notify(UINT32_MAX, false, false); }
+
+void EventCount::NotifyFromCallback(bool in_isr) { Notify(1, true, in_isr); }
+
+void EventCount::NotifyAllFromCallback(bool in_isr) { Notify(UINT32_MAX, true, in_isr); }
+
+void EventCount::Notify(uint32_t count, bool in_callback, bool in_isr)
+{
+  epoch_.fetch_add(EPOCH_STEP, std::memory_order_seq_cst);
+
+  uint32_t parked = parked_.load(std::memory_order_seq_cst);
+  uint32_t taken = 0;
+  while (parked > 0)
+  {
+    taken = parked < count ? parked : count;
+    if (parked_.compare_exchange_weak(parked, parked - taken, std::memory_order_acq_rel,
+                                      std::memory_order_acquire))
+    {
+      break;
+    }
+    taken = 0;
+  }
+
+  for (uint32_t index = 0; index < taken; ++index)
+  {
+    if (in_callback)
+    {
+      parking_.PostFromCallback(in_isr);
+    }
+    else
+    {
+      parking_.Post();
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "libxr_def.hpp"
+#include "libxr_system.hpp"
+
+#if !defined(LIBXR_SYSTEM_linux)
+#include "semaphore.hpp"
+#endif
+
+namespace LibXR
+{
+
+/**
+ * @brief  事件计数器，为无锁结构提供“条件不满足时休眠”的能力
+ *         Event count that lets lock-free structures sleep until a condition may hold
+ *
+ * @details
+ * 等待方先用 `PrepareWait()` 取得当前纪元，再检查自己的条件（例如尝试出队）；
+ * 条件仍不满足时调用 `Wait()`，只要期间有人调用过 `Notify*()` 就会立即返回。
+ * 通知方只在确实有线程挂起时才发出唤醒，没有等待者时通知只是一次原子更新。
+ * Linux 上直接在纪元字上使用 futex，并用最低位标记“有线程睡下”：只有清掉该位的
+ * 那次通知才发起系统调用，等待者醒来之前的后续通知都不再进入内核。
+ * 其余平台用内部 `Semaphore` 挂起等待者。
+ *
+ * A waiter first takes the current epoch with `PrepareWait()`, then re-checks its
+ * own condition (for example by trying to dequeue). If the condition still fails it
+ * calls `Wait()`, which returns as soon as any `Notify*()` happened in between.
+ * Notifiers only issue a wakeup when a thread is actually parked; with no waiter a
+ * notification is a single atomic update. On Linux the epoch word is used as a futex
+ * directly and its lowest bit marks "someone went to sleep": only the notification
+ * that clears the bit enters the kernel, later ones before the waiters wake up do not.
+ * Other platforms park waiters on an internal `Semaphore`.
+ */
+class EventCount
+{
+ public:
+  using Key = uint32_t;  ///< 等待纪元 Wait epoch
+
+  /**
+   * @brief  构造一个事件计数器
+   *         Constructs an event count
+   */
+  EventCount();
+
+  /**
+   * @brief  记录当前纪元，准备等待
+   *         Records the current epoch before waiting
+   * @return 传给 `Wait()` 的纪元 Epoch to pass to `Wait()`
+   */
+  Key PrepareWait() const { return epoch_.load(std::memory_order_seq_cst) & ~SLEEPING; }
+
+  /**
+   * @brief  等待纪元离开 `key`
+   *         Waits until the epoch moves past `key`
+   * @param  key `PrepareWait()` 返回的纪元 Epoch returned by `PrepareWait()`
+   * @param  timeout 超时时间（默认无限等待） Timeout period (default is infinite wait)
+   * @return 操作结果 ErrorCode indicating success or timeout
+   *
+   * @details
+   * 返回 `ErrorCode::OK` 只表示期间发生过通知，调用方需要重新检查自己的条件。
+   * 超时语义与 `Semaphore::Wait` 一致。
+   *
+   * Returning `ErrorCode::OK` only means a notification happened in between; the
+   * caller must re-check its own condition. Timeouts behave like `Semaphore::Wait`.
+   */
+  ErrorCode Wait(Key key, uint32_t timeout = UINT32_MAX);
+
+  /**
+   * @brief  推进纪元并唤醒至少一个挂起的等待者
+   *         Advances the epoch and wakes at least one parked waiter
+   *
+   * @details
+   * Linux 上清掉睡眠标记时会唤醒全部睡下的等待者，未抢到条件的会重新挂起。
+   * On Linux clearing the sleeping mark wakes every sleeping waiter; those that lose
+   * the race for the condition simply park again.
+   */
+  void NotifyOne();
+
+  /**
+   * @brief  推进纪元并唤醒全部挂起的等待者
+   *         Advances the epoch and wakes every parked waiter
+   */
+  void NotifyAll();
+
+  /**
+   * @brief  从中断回调中推进纪元并唤醒一个等待者
+   *         Advances the epoch and wakes one waiter from an ISR or callback
+   * @param  in_isr 是否在 ISR（中断服务例程）中调用 Whether it is called from an ISR
+   */
+  void NotifyFromCallback(bool in_isr);
+
+  /**
+   * @brief  从中断回调中推进纪元并唤醒全部等待者
+   *         Advances the epoch and wakes every waiter from an ISR or callback
+   * @param  in_isr 是否在 ISR（中断服务例程）中调用 Whether it is called from an ISR
+   */
+  void NotifyAllFromCallback(bool in_isr);
+
+  /**
+   * @brief  获取当前挂起的等待者数量
+   *         Gets the number of currently parked waiters
+   * @return 等待者数量 Number of parked waiters
+   */
+  uint32_t Waiters() const { return parked_.load(std::memory_order_acquire); }
+
+ private:
+  static constexpr uint32_t SLEEPING = 1U;    ///< 睡眠标记位 Sleeping-waiter bit
+  static constexpr uint32_t EPOCH_STEP = 2U;  ///< 纪元步长 Epoch step per notify
+
+  /// @brief 推进纪元并唤醒至多 `count` 个等待者。 Advance the epoch and wake up to
+  /// `count` waiters.
+  void Notify(uint32_t count, bool in_callback, bool in_isr);
+
+  std::atomic<uint32_t> epoch_;   ///< 通知纪元 Notification epoch
+  std::atomic<uint32_t> parked_;  ///< 挂起的等待者数量 Number of parked waiters
+#if !defined(LIBXR_SYSTEM_linux)
+  Semaphore parking_;  ///< 等待者挂起用的信号量 Semaphore waiters park on
+#endif
+};
+
+}  // namespace LibXR
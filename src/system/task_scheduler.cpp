@@ -0,0 +1,281 @@
+#include "task_scheduler.hpp"
+
+#include <new>
+
+using namespace LibXR;
+
+namespace
+{
+// 当前线程所属的调度器与工作线程下标。
+// Scheduler and worker index of the calling thread.
+thread_local const TaskScheduler* current_scheduler = nullptr;
+thread_local uint32_t current_worker = TaskScheduler::ANY_WORKER;
+}  // namespace
+
+TaskScheduler::TaskScheduler(uint32_t worker_count, size_t task_capacity,
+                             size_t stack_depth, Thread::Priority priority)
+    : worker_count_(worker_count),
+      tasks_(new Task[task_capacity]),
+      free_tasks_(task_capacity),
+      injected_(task_capacity),
+      workers_(static_cast<Worker*>(::operator new[](sizeof(Worker) * worker_count))),
+      stolen_(0)
+{
+  ASSERT(worker_count_ > 0);
+  ASSERT(task_capacity > 1);
+
+  for (size_t index = 0; index < task_capacity; ++index)
+  {
+    const ErrorCode ans = free_tasks_.Push(&tasks_[index]);
+    UNUSED(ans);
+    ASSERT(ans == ErrorCode::OK);
+  }
+
+  // 每个队列都能容纳全部任务槽，入队因此不会失败。
+  // Every queue can hold all task slots, so enqueueing never fails.
+  for (uint32_t index = 0; index < worker_count_; ++index)
+  {
+    new (&workers_[index]) Worker(this, index, task_capacity);
+  }
+  for (uint32_t index = 0; index < worker_count_; ++index)
+  {
+    workers_[index].thread.Create(&workers_[index], WorkerMain, "task_worker",
+                                  stack_depth, priority);
+  }
+}
+
+ErrorCode TaskScheduler::Submit(Job job, uint32_t affinity)
+{
+  Task* task = nullptr;
+  if (free_tasks_.Pop(task) != ErrorCode::OK)
+  {
+    return ErrorCode::FULL;
+  }
+  task->job = job;
+  task->range = nullptr;
+  return Enqueue(task, affinity, false, false);
+}
+
+ErrorCode TaskScheduler::SubmitFromCallback(Job job, bool in_isr, uint32_t affinity)
+{
+  Task* task = nullptr;
+  if (free_tasks_.Pop(task) != ErrorCode::OK)
+  {
+    return ErrorCode::FULL;
+  }
+  task->job = job;
+  task->range = nullptr;
+  return Enqueue(task, affinity, true, in_isr);
+}
+
+uint32_t TaskScheduler::CurrentWorker() const
+{
+  return current_scheduler == this ? current_worker : ANY_WORKER;
+}
+
+ErrorCode TaskScheduler::Enqueue(Task* task, uint32_t affinity, bool in_callback,
+                                 bool in_isr)
+{
+  ErrorCode ans = ErrorCode::OK;
+  if (affinity != ANY_WORKER)
+  {
+    ASSERT(affinity < worker_count_);
+    ans = workers_[affinity].inbox.Push(task);
+  }
+  else if (!in_callback && current_scheduler == this)
+  {
+    ans = workers_[current_worker].deque.Push(task);
+  }
+  else
+  {
+    ans = injected_.Push(task);
+  }
+  ASSERT(ans == ErrorCode::OK);
+
+  // 带亲和的任务必须叫醒目标线程本身，而不是任意一个空闲线程。
+  // A job with affinity has to wake its target worker, not just any idle one.
+  if (affinity != ANY_WORKER)
+  {
+    in_callback ? work_.NotifyAllFromCallback(in_isr) : work_.NotifyAll();
+  }
+  else
+  {
+    in_callback ? work_.NotifyFromCallback(in_isr) : work_.NotifyOne();
+  }
+  return ans;
+}
+
+TaskScheduler::Task* TaskScheduler::FindTask(Worker* self)
+{
+  Task* task = nullptr;
+  if (self != nullptr && (self->deque.Pop(task) == ErrorCode::OK ||
+                          self->inbox.Pop(task) == ErrorCode::OK))
+  {
+    return task;
+  }
+  if (injected_.Pop(task) == ErrorCode::OK)
+  {
+    return task;
+  }
+
+  // 从下一个线程开始轮询，避免所有窃取方都盯着 0 号线程。
+  // Start from the next worker so thieves do not all hammer worker 0.
+  const uint32_t start = (self != nullptr) ? self->index + 1 : 0;
+  for (uint32_t offset = 0; offset < worker_count_; ++offset)
+  {
+    Worker& victim = workers_[(start + offset) % worker_count_];
+    if (&victim == self)
+    {
+      continue;
+    }
+    ErrorCode ans = victim.deque.Steal(task);
+    while (ans == ErrorCode::BUSY)
+    {
+      ans = victim.deque.Steal(task);
+    }
+    if (ans == ErrorCode::OK)
+    {
+      stolen_.fetch_add(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+
+  // 亲和只是偏好：目标线程正忙时，其他空闲线程才帮忙清它的收件箱。
+  // Affinity is only a preference: other idle workers drain an inbox only while its
+  // owner is busy running a job.
+  for (uint32_t offset = 0; offset < worker_count_; ++offset)
+  {
+    Worker& victim = workers_[(start + offset) % worker_count_];
+    if (&victim != self && victim.busy.load(std::memory_order_acquire) &&
+        victim.inbox.Pop(task) == ErrorCode::OK)
+    {
+      stolen_.fetch_add(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void TaskScheduler::Execute(Task* task)
+{
+  // 先把内容取出再归还任务槽，任务内部继续提交时就有槽可用。
+  // Copy the contents out and recycle the slot first, so the job itself can submit
+  // more work.
+  const Job job = task->job;
+  RangeBlock* range = task->range;
+  task->job = Job();
+  const ErrorCode ans = free_tasks_.Push(task);
+  UNUSED(ans);
+  ASSERT(ans == ErrorCode::OK);
+
+  if (range == nullptr)
+  {
+    job.Run(false, this);
+    return;
+  }
+
+  DrainRange(*range);
+  // 这是对区间块的最后一次访问；之后调用者可能立即返回并销毁它。
+  // This is the last access to the range block; the caller may return and destroy it
+  // right after.
+  range->pending.fetch_sub(1, std::memory_order_acq_rel);
+  completion_.NotifyAll();
+}
+
+void TaskScheduler::DrainRange(RangeBlock& block)
+{
+  while (true)
+  {
+    const size_t chunk_begin =
+        block.next.fetch_add(block.grain, std::memory_order_relaxed);
+    if (chunk_begin >= block.end)
+    {
+      return;
+    }
+    const size_t chunk_end =
+        (block.end - chunk_begin > block.grain) ? chunk_begin + block.grain : block.end;
+    block.run(block.context, chunk_begin, chunk_end);
+  }
+}
+
+void TaskScheduler::RunRange(RangeBlock& block)
+{
+  const size_t begin = block.next.load(std::memory_order_relaxed);
+  if (begin >= block.end)
+  {
+    return;
+  }
+
+  // 调用者自己算一份，其余块最多分给每个工作线程一个辅助任务。
+  // The caller takes one share; the rest is offered as at most one helper per worker.
+  const size_t chunks = (block.end - begin + block.grain - 1) / block.grain;
+  const size_t helpers = (chunks - 1 < worker_count_) ? chunks - 1 : worker_count_;
+  for (size_t index = 0; index < helpers; ++index)
+  {
+    Task* task = nullptr;
+    if (free_tasks_.Pop(task) != ErrorCode::OK)
+    {
+      break;
+    }
+    task->range = &block;
+    block.pending.fetch_add(1, std::memory_order_relaxed);
+    (void)Enqueue(task, ANY_WORKER, false, false);
+  }
+
+  DrainRange(block);
+
+  // 块已经领完，只需等尚未结束的辅助任务；等待时帮忙执行其他任务，
+  // 保证辅助任务排在本线程后面时也能推进。
+  // Every chunk is claimed; only wait for helpers still pending, running other tasks
+  // meanwhile so progress is made even if a helper is queued behind this thread.
+  Worker* self = (current_scheduler == this) ? &workers_[current_worker] : nullptr;
+  while (block.pending.load(std::memory_order_acquire) != 0)
+  {
+    Task* task = FindTask(self);
+    if (task != nullptr)
+    {
+      Execute(task);
+      continue;
+    }
+
+    const EventCount::Key key = completion_.PrepareWait();
+    if (block.pending.load(std::memory_order_acquire) == 0)
+    {
+      break;
+    }
+    (void)completion_.Wait(key);
+  }
+}
+
+void TaskScheduler::WorkerMain(Worker* worker)
+{
+  TaskScheduler* scheduler = worker->owner;
+  current_scheduler = scheduler;
+  current_worker = worker->index;
+
+  while (true)
+  {
+    Task* task = scheduler->FindTask(worker);
+    if (task != nullptr)
+    {
+      worker->busy.store(true, std::memory_order_release);
+      scheduler->Execute(task);
+      worker->busy.store(false, std::memory_order_release);
+      continue;
+    }
+
+    // 取纪元后再找一次，之后的任何提交都会让 Wait 立即返回。
+    // Look once more after taking the epoch; any later submission makes Wait return
+    // immediately.
+    const EventCount::Key key = scheduler->work_.PrepareWait();
+    task = scheduler->FindTask(worker);
+    if (task != nullptr)
+    {
+      worker->busy.store(true, std::memory_order_release);
+      scheduler->Execute(task);
+      worker->busy.store(false, std::memory_order_release);
+      continue;
+    }
+    (void)scheduler->work_.Wait(key);
+  }
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "event_count.hpp"
+#include "libxr_cb.hpp"
+#include "libxr_def.hpp"
+#include "mpmc_queue.hpp"
+#include "thread.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace LibXR
+{
+
+/**
+ * @brief 工作窃取任务调度器。
+ *        Work-stealing task scheduler.
+ *
+ * 与 `ASync` 一样持有常驻工作线程、执行 `Callback` 任务，但不再是“一个线程一个任务”：
+ * 每个工作线程有自己的 Chase-Lev 双端队列，空闲线程从别人的队列顶端窃取任务，
+ * 因此 CPU 密集的流水线阶段可以随核数扩展。任务可以从任意线程或回调上下文提交；
+ * 工作线程内提交的任务进入自己的队列，其他来源进入共享注入队列，带亲和提示的任务
+ * 进入目标线程的收件箱。空闲线程挂在 `EventCount` 上，没有空闲线程时提交不会进入内核。
+ *
+ * Like `ASync` it owns permanent worker threads that run `Callback` jobs, but it is no
+ * longer "one thread, one job": every worker owns a Chase-Lev deque and idle workers
+ * steal from the top of other deques, so CPU-heavy pipeline stages scale with the core
+ * count. Jobs may be submitted from any thread or callback context; jobs submitted on
+ * a worker go to its own deque, other sources use a shared injection queue, and jobs
+ * with an affinity hint go to the target worker's inbox. Idle workers park on an
+ * `EventCount`, so submitting never enters the kernel while no worker is idle.
+ *
+ * @note 工作线程常驻，调度器对象应与程序同寿命。
+ *       Worker threads are permanent, so the scheduler must live as long as the
+ *       program.
+ */
+class TaskScheduler
+{
+ public:
+  using Job = LibXR::Callback<TaskScheduler*>;  ///< 任务回调 Job callback
+
+  static constexpr uint32_t ANY_WORKER =
+      UINT32_MAX;  ///< 不指定工作线程 No worker preference
+
+  /**
+   * @brief 构造调度器并启动工作线程。
+   *        Constructs the scheduler and starts its worker threads.
+   *
+   * @param worker_count 工作线程数。 Number of worker threads.
+   * @param task_capacity 同时在途的最大任务数。 Maximum number of in-flight tasks.
+   * @param stack_depth 线程栈深度。 Stack depth of each worker.
+   * @param priority 线程优先级。 Priority of each worker.
+   *
+   * @note 包含动态内存分配。 Contains dynamic memory allocation.
+   */
+  TaskScheduler(uint32_t worker_count, size_t task_capacity, size_t stack_depth,
+                Thread::Priority priority);
+
+  /**
+   * @brief 提交一个任务。
+   *        Submits one job.
+   *
+   * @param job 需要执行的回调任务。 The callback job to be executed.
+   * @param affinity 偏好的工作线程下标，`ANY_WORKER` 表示不指定。该线程空闲时一定由
+   *        它执行，它正忙时其他空闲线程可以代劳。 Preferred worker index, or
+   *        `ANY_WORKER`. The job runs on that worker whenever it is idle; while it is
+   *        busy, other idle workers may take the job over.
+   * @return 成功返回 `ErrorCode::OK`；在途任务已满返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when the
+   *         in-flight task limit is reached
+   */
+  ErrorCode Submit(Job job, uint32_t affinity = ANY_WORKER);
+
+  /**
+   * @brief 在回调环境中提交一个任务。
+   *        Submits one job from a callback environment.
+   *
+   * @param job 需要执行的回调任务。 The callback job to be executed.
+   * @param in_isr 是否在中断上下文中调用。 Whether it is called from an ISR.
+   * @param affinity 偏好的工作线程下标。 Preferred worker index.
+   * @return 成功返回 `ErrorCode::OK`；在途任务已满返回 `ErrorCode::FULL`
+   *         Returns `ErrorCode::OK` on success; returns `ErrorCode::FULL` when the
+   *         in-flight task limit is reached
+   */
+  ErrorCode SubmitFromCallback(Job job, bool in_isr, uint32_t affinity = ANY_WORKER);
+
+  /**
+   * @brief 把区间 `[begin, end)` 按 `grain` 切块并行执行，全部完成后返回。
+   *        Runs `[begin, end)` in parallel in chunks of `grain` and returns once every
+   *        chunk has finished.
+   *
+   * @param begin 起始下标。 First index.
+   * @param end 结束下标（不含）。 One past the last index.
+   * @param grain 每块的下标数，0 视为 1。 Indices per chunk; 0 is treated as 1.
+   * @param body 形如 `void(ArgType, size_t begin, size_t end)` 的函数。 Function of
+   *        shape `void(ArgType, size_t begin, size_t end)`.
+   * @param arg 传给 `body` 的绑定参数。 Bound argument passed to `body`.
+   *
+   * @details
+   * 调用线程自己也参与执行；等待期间它会顺手执行其他待处理任务，所以可以在任务
+   * 内部嵌套调用。在途任务不足时剩余块全部由调用线程完成。不可在 ISR 中调用。
+   *
+   * The calling thread takes part as well, and while waiting it runs other pending
+   * tasks, so nested calls from inside a job are fine. When the in-flight task limit
+   * is reached the calling thread simply runs the remaining chunks itself. Must not be
+   * called from an ISR.
+   */
+  template <typename ArgType, typename CallableType>
+  void ParallelFor(size_t begin, size_t end, size_t grain, CallableType body,
+                   ArgType arg)
+  {
+    using BodyType = void (*)(ArgType, size_t, size_t);
+    struct Context
+    {
+      BodyType body;
+      ArgType arg;
+    } context{static_cast<BodyType>(body), arg};
+
+    RangeBlock block(
+        [](void* context_ptr, size_t chunk_begin, size_t chunk_end)
+        {
+          auto* ctx = static_cast<Context*>(context_ptr);
+          ctx->body(ctx->arg, chunk_begin, chunk_end);
+        },
+        &context, begin, end, grain);
+    RunRange(block);
+  }
+
+  /**
+   * @brief 获取工作线程数。 Gets the number of worker threads.
+   */
+  [[nodiscard]] uint32_t WorkerCount() const { return worker_count_; }
+
+  /**
+   * @brief 获取当前线程在本调度器中的工作线程下标。
+   *        Gets the worker index of the calling thread in this scheduler.
+   * @return 工作线程下标；不是本调度器的工作线程时返回 `ANY_WORKER`
+   *         Worker index, or `ANY_WORKER` when the caller is not one of its workers
+   */
+  [[nodiscard]] uint32_t CurrentWorker() const;
+
+  /**
+   * @brief 获取累计被窃取的任务数。 Gets the total number of stolen tasks.
+   */
+  [[nodiscard]] uint64_t StolenCount() const
+  {
+    return stolen_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 获取当前可用的任务槽数（并发快照）。
+   *        Gets the number of free task slots (concurrent snapshot).
+   */
+  [[nodiscard]] size_t FreeTaskCount() const { return free_tasks_.Size(); }
+
+ private:
+  /// @brief 一次 `ParallelFor` 的共享状态，位于调用者栈上。 Shared state of one
+  /// `ParallelFor` call, living on the caller's stack.
+  struct RangeBlock
+  {
+    using RunType = void (*)(void*, size_t, size_t);
+
+    RangeBlock(RunType run_in, void* context_in, size_t begin, size_t end_in,
+               size_t grain_in)
+        : run(run_in),
+          context(context_in),
+          end(end_in),
+          grain(grain_in == 0 ? 1 : grain_in),
+          next(begin),
+          pending(0)
+    {
+    }
+
+    RunType run;                   ///< 类型擦除后的区间函数 Erased range body
+    void* context;                 ///< 区间函数上下文 Range body context
+    const size_t end;              ///< 结束下标 One past the last index
+    const size_t grain;            ///< 每块下标数 Indices per chunk
+    std::atomic<size_t> next;      ///< 下一块起点 Start of the next chunk
+    std::atomic<uint32_t> pending;  ///< 未结束的辅助任务 Helper tasks still pending
+  };
+
+  /// @brief 任务槽；普通任务或 `ParallelFor` 辅助任务。 Task slot holding either a
+  /// job or a `ParallelFor` helper.
+  struct Task
+  {
+    Job job;                       ///< 普通任务 Plain job
+    RangeBlock* range = nullptr;   ///< 辅助任务所属区间 Range of a helper task
+  };
+
+  /// @brief 单个工作线程的状态。 State of one worker thread.
+  struct Worker
+  {
+    Worker(TaskScheduler* owner_in, uint32_t index_in, size_t capacity)
+        : owner(owner_in),
+          index(index_in),
+          deque(capacity),
+          inbox(capacity),
+          busy(false)
+    {
+    }
+
+    TaskScheduler* owner;            ///< 所属调度器 Owning scheduler
+    const uint32_t index;            ///< 工作线程下标 Worker index
+    WorkStealingDeque<Task*> deque;  ///< 本线程的工作队列 Own work deque
+    MPMCQueue<Task*> inbox;          ///< 亲和任务收件箱 Inbox for affinity jobs
+    std::atomic<bool> busy;          ///< 正在执行任务 Currently running a job
+    Thread thread;                   ///< 工作线程 Worker thread
+  };
+
+  /// @brief 工作线程主循环。 Worker main loop.
+  static void WorkerMain(Worker* worker);
+
+  /// @brief 提交一个已填好的任务槽。 Enqueue one filled task slot.
+  ErrorCode Enqueue(Task* task, uint32_t affinity, bool in_callback, bool in_isr);
+  /// @brief 按本地、注入、窃取的顺序找一个任务。 Find one task: local first, then the
+  /// injection queue, then stealing.
+  Task* FindTask(Worker* self);
+  /// @brief 执行并回收一个任务槽。 Run and recycle one task slot.
+  void Execute(Task* task);
+  /// @brief 反复领取区间块直到取完。 Claim range chunks until none are left.
+  static void DrainRange(RangeBlock& block);
+  /// @brief `ParallelFor` 的非模板主体。 Non-template body of `ParallelFor`.
+  void RunRange(RangeBlock& block);
+
+  const uint32_t worker_count_;    ///< 工作线程数 Number of workers
+  Task* tasks_;                    ///< 任务槽数组 Task slot array
+  MPMCQueue<Task*> free_tasks_;    ///< 空闲任务槽 Free task slots
+  MPMCQueue<Task*> injected_;      ///< 外部提交的任务 Jobs submitted from outside
+  Worker* workers_;                ///< 工作线程状态数组 Worker state array
+  EventCount work_;                ///< 空闲工作线程等待新任务 Idle workers wait here
+  EventCount completion_;          ///< `ParallelFor` 等待辅助任务 Range waiters
+  std::atomic<uint64_t> stolen_;   ///< 累计窃取数 Total stolen tasks
+};
+
+}  // namespace LibXR
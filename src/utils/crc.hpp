@@ -253,6 +253,105 @@ class CRC32
   }
 };
 
+/**
+ * @class CRC32C
+ * @brief 32 位 Castagnoli 循环冗余校验（CRC-32C）计算类 / CRC-32C (Castagnoli) checksum
+ *        computation class
+ *
+ * 使用标准 CRC-32C 参数（反射多项式 0x82F63B78，初值和结果异或均为 0xFFFFFFFF）。
+ * 目标支持 SSE4.2 或 ARMv8 CRC 扩展时走硬件指令，否则走 slice-by-8 查表；查找表在编译期
+ * 生成，放在只读数据段。
+ * Uses the standard CRC-32C parameters (reflected polynomial 0x82F63B78, initial value
+ * and final XOR both 0xFFFFFFFF). Targets with SSE4.2 or the ARMv8 CRC extension use
+ * the hardware instructions; others fall back to slice-by-8 tables, which are
+ * generated at compile time and live in read-only data.
+ */
+class CRC32C
+{
+ public:
+  /**
+   * @struct Table
+   * @brief slice-by-8 查找表 / Slice-by-8 lookup tables
+   */
+  struct Table
+  {
+    uint32_t value[8][256];  ///< 8 张 256 项查找表 / Eight 256-entry tables
+  };
+
+  static const Table TABLE;  ///< CRC32C 查找表 / CRC32C lookup tables
+
+ private:
+  static constexpr uint32_t INIT = 0xFFFFFFFF;  ///< CRC32C 初始值 / CRC32C initial value
+  static constexpr uint32_t POLY =
+      0x82F63B78;  ///< 反射多项式 / Reflected polynomial
+
+  /**
+   * @brief 生成 slice-by-8 查找表 / Generates the slice-by-8 lookup tables
+   * @return 查找表 / Lookup tables
+   */
+  static constexpr Table GenerateTable()
+  {
+    Table table = {};
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; ++j)
+      {
+        crc = (crc & 1U) ? (crc >> 1) ^ POLY : crc >> 1;
+      }
+      table.value[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+      for (int slice = 1; slice < 8; ++slice)
+      {
+        const uint32_t prev = table.value[slice - 1][i];
+        table.value[slice][i] = (prev >> 8) ^ table.value[0][prev & 0xff];
+      }
+    }
+    return table;
+  }
+
+ public:
+  CRC32C() {}
+
+  /**
+   * @brief 计算数据的 CRC32C 校验码 / Computes the CRC32C checksum for the given data
+   * @param raw 输入数据指针 / Pointer to input data
+   * @param len 数据长度 / Length of the data
+   * @return 计算得到的 CRC32C 值 / Computed CRC32C value
+   */
+  static uint32_t Calculate(const void* raw, size_t len);
+
+  /**
+   * @brief 验证数据的 CRC32C 校验码 / Verifies the CRC32C checksum of the given data
+   * @param raw 输入数据指针，末尾 4 字节为小端 CRC32C / Pointer to input data whose
+   *        last 4 bytes hold the little-endian CRC32C
+   * @param len 数据长度 / Length of the data
+   * @return 校验成功返回 `true`，否则返回 `false` /
+   *         Returns `true` if the checksum is valid, otherwise returns `false`
+   */
+  static bool Verify(const void* raw, size_t len)
+  {
+    const uint8_t* buf = reinterpret_cast<const uint8_t*>(raw);
+    if (len < sizeof(uint32_t) + 1)
+    {
+      return false;
+    }
+
+    const uint8_t* tail = buf + len - sizeof(uint32_t);
+    const uint32_t actual = static_cast<uint32_t>(tail[0]) |
+                            static_cast<uint32_t>(tail[1]) << 8 |
+                            static_cast<uint32_t>(tail[2]) << 16 |
+                            static_cast<uint32_t>(tail[3]) << 24;
+    return Calculate(buf, len - sizeof(uint32_t)) == actual;
+  }
+};
+
+inline constexpr CRC32C::Table CRC32C::TABLE = CRC32C::GenerateTable();
+
 /**
  * @class CRC64
  * @brief 64 位循环冗余校验（CRC-64）计算类 / CRC-64 checksum computation class
@@ -1,5 +1,11 @@
 #include "crc.hpp"
 
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
 uint8_t LibXR::CRC8::Calculate(const void* raw, size_t len)
 {
   const uint8_t* buf = reinterpret_cast<const uint8_t*>(raw);
@@ -48,6 +54,57 @@ uint32_t LibXR::CRC32::Calculate(const void* raw, size_t len)
   return crc;
 }
 
+uint32_t LibXR::CRC32C::Calculate(const void* raw, size_t len)
+{
+  const uint8_t* buf = reinterpret_cast<const uint8_t*>(raw);
+  uint32_t crc = INIT;
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+  for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), buf += sizeof(uint64_t))
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, buf, sizeof(word));
+    crc = static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+  }
+  while (len--)
+  {
+    crc = _mm_crc32_u8(crc, *buf++);
+  }
+#elif defined(__ARM_FEATURE_CRC32) && defined(__aarch64__)
+  for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), buf += sizeof(uint64_t))
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, buf, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+  while (len--)
+  {
+    crc = __crc32cb(crc, *buf++);
+  }
+#else
+  const auto& tab = TABLE.value;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t), buf += sizeof(uint64_t))
+  {
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    std::memcpy(&lo, buf, sizeof(lo));
+    std::memcpy(&hi, buf + sizeof(lo), sizeof(hi));
+    lo ^= crc;
+    crc = tab[7][lo & 0xff] ^ tab[6][(lo >> 8) & 0xff] ^ tab[5][(lo >> 16) & 0xff] ^
+          tab[4][lo >> 24] ^ tab[3][hi & 0xff] ^ tab[2][(hi >> 8) & 0xff] ^
+          tab[1][(hi >> 16) & 0xff] ^ tab[0][hi >> 24];
+  }
+#endif
+  while (len--)
+  {
+    crc = tab[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+  }
+#endif
+
+  return crc ^ INIT;
+}
+
 uint64_t LibXR::CRC64::Calculate(const void* raw, size_t len)
 {
   const uint8_t* buf = reinterpret_cast<const uint8_t*>(raw);
@@ -0,0 +1,114 @@
+#include "event_count.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+
+#include "monotonic_time.hpp"
+
+using namespace LibXR;
+
+namespace
+{
+
+int FutexWait(std::atomic<uint32_t>* word, uint32_t expected,
+              const struct timespec* timeout)
+{
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+                                  FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0));
+}
+
+int FutexWake(std::atomic<uint32_t>* word, int count)
+{
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+                                  FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0));
+}
+
+}  // namespace
+
+EventCount::EventCount() : epoch_(0), parked_(0) {}
+
+ErrorCode EventCount::Wait(Key key, uint32_t timeout)
+{
+  const uint64_t deadline_ms =
+      (timeout == UINT32_MAX) ? UINT64_MAX : (MonotonicTime::NowMilliseconds() + timeout);
+
+  parked_.fetch_add(1, std::memory_order_relaxed);
+
+  ErrorCode ans = ErrorCode::OK;
+  uint32_t current = epoch_.load(std::memory_order_seq_cst);
+  while ((current & ~SLEEPING) == key)
+  {
+    // 睡下之前先在纪元字上打标记；通知方只有看到标记才会进入内核。
+    // Mark the epoch word before sleeping; notifiers only enter the kernel when they
+    // see the mark.
+    if ((current & SLEEPING) == 0U &&
+        !epoch_.compare_exchange_weak(current, current | SLEEPING,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_seq_cst))
+    {
+      continue;
+    }
+    current |= SLEEPING;
+
+    timespec ts = {};
+    timespec* ts_ptr = nullptr;
+    if (timeout != UINT32_MAX)
+    {
+      const uint32_t remaining_ms = MonotonicTime::RemainingMilliseconds(deadline_ms);
+      if (remaining_ms == 0)
+      {
+        ans = ErrorCode::TIMEOUT;
+        break;
+      }
+      ts = MonotonicTime::RelativeFromMilliseconds(remaining_ms);
+      ts_ptr = &ts;
+    }
+
+    const int result = FutexWait(&epoch_, current, ts_ptr);
+    if (result != 0 && errno != EAGAIN && errno != EINTR)
+    {
+      ans = (errno == ETIMEDOUT) ? ErrorCode::TIMEOUT : ErrorCode::FAILED;
+      break;
+    }
+    current = epoch_.load(std::memory_order_seq_cst);
+  }
+
+  parked_.fetch_sub(1, std::memory_order_relaxed);
+  return ans;
+}
+
+void EventCount::NotifyOne() { Notify(1, false, false); }
+
+void EventCount::NotifyAll() { Notify(UINT32_MAX, false, false); }
+
+void EventCount::NotifyFromCallback(bool in_isr) { Notify(1, true, in_isr); }
+
+void EventCount::NotifyAllFromCallback(bool in_isr) { Notify(UINT32_MAX, true, in_isr); }
+
+void EventCount::Notify(uint32_t count, bool in_callback, bool in_isr)
+{
+  UNUSED(count);
+  UNUSED(in_callback);
+  UNUSED(in_isr);
+
+  // 推进纪元并清掉睡眠标记。清掉标记的一方负责唤醒全部睡下的等待者，否则被留下的
+  // 等待者将无人再唤醒。
+  // Advance the epoch and clear the sleeping mark. Whoever clears the mark must wake
+  // every sleeper, otherwise a sleeper left behind would never be woken again.
+  uint32_t current = epoch_.load(std::memory_order_seq_cst);
+  while (!epoch_.compare_exchange_weak(current, (current & ~SLEEPING) + EPOCH_STEP,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_seq_cst))
+  {
+  }
+
+  if ((current & SLEEPING) != 0U)
+  {
+    (void)FutexWake(&epoch_, INT_MAX);
+  }
+}
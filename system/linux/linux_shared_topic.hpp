@@ -4,4 +4,6 @@
 // clang-format off
 #include "monotonic_time.hpp"
 #include "linux_shared_topic_impl.hpp"
+#include "linux_topic_bag.hpp"
+#include "linux_topic_bridge.hpp"
 // clang-format on
@@ -4,13 +4,18 @@
 
 #include <fcntl.h>
 #include <linux/futex.h>
+#include <pthread.h>
 #include <signal.h>
 #include <sys/mman.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
+#include <sys/un.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
@@ -21,6 +26,7 @@
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -43,6 +49,32 @@ enum class LinuxSharedSubscriberMode : uint8_t
   BALANCE_RR = 2,  ///< 参与 RR 负载均衡组。Participate in the RR balanced group.
 };
 
+/**
+ * @enum LinuxSharedWaitStrategy
+ * @brief 订阅者等待新消息的方式。How subscribers wait for new messages.
+ */
+enum class LinuxSharedWaitStrategy : uint8_t
+{
+  FUTEX = 0,            ///< 直接在 futex 上休眠。Sleep on the futex right away.
+  SPIN_THEN_FUTEX = 1,  ///< 先自旋 `spin_count` 次再休眠。Spin `spin_count` times, then
+                        ///< sleep.
+  BUSY_POLL = 2,        ///< 始终自旋轮询，不进入内核。Always spin-poll without entering
+                        ///< the kernel.
+};
+
+/// 变长模式下最多可配置的槽位规格数。Maximum number of size classes in variable-size mode.
+constexpr uint32_t LINUX_SHARED_SIZE_CLASS_NUM = 4;
+
+/**
+ * @struct LinuxSharedSizeClass
+ * @brief 变长模式下的一档槽位规格。One slot size class in variable-size mode.
+ */
+struct LinuxSharedSizeClass
+{
+  uint32_t capacity = 0;  ///< 每槽位可容纳的元素数。Elements each slot can hold.
+  uint32_t slot_num = 0;  ///< 该档槽位数。Number of slots in this class.
+};
+
 /**
  * @struct LinuxSharedTopicConfig
  * @brief Linux 共享 Topic 的创建配置。Creation config for Linux shared topics.
@@ -53,6 +85,18 @@ struct LinuxSharedTopicConfig
   uint32_t subscriber_num = 8;  ///< 最大订阅者数量。Maximum number of subscribers.
   uint32_t queue_num =
       64;  ///< 每订阅者描述符队列长度。Descriptor queue length per subscriber.
+  bool multi_publisher =
+      false;  ///< 是否允许多个进程同时发布。Whether multiple processes may publish.
+  uint32_t publisher_num =
+      8;  ///< 多发布者模式下的最大发布者数量。Maximum publishers in multi-publisher mode.
+  /// 变长模式槽位规格，按容量升序填写；全部为空时按 `slot_num` 使用单元素定长槽位。
+  /// Variable-size slot classes in ascending capacity order; when all are empty the
+  /// topic uses `slot_num` fixed single-element slots.
+  std::array<LinuxSharedSizeClass, LINUX_SHARED_SIZE_CLASS_NUM> size_classes = {};
+  LinuxSharedWaitStrategy wait_strategy =
+      LinuxSharedWaitStrategy::FUTEX;  ///< 订阅者等待方式。Subscriber wait strategy.
+  uint32_t spin_count =
+      4096;  ///< `SPIN_THEN_FUTEX` 的自旋次数。Spin iterations for `SPIN_THEN_FUTEX`.
 };
 
 /**
@@ -67,6 +111,34 @@ struct LinuxSharedTopicConfig
  * `Webots` system configuration it still reuses this implementation, but timeout behavior
  * follows the `Webots` system time model.
  *
+ * 开启 `LinuxSharedTopicConfig::multi_publisher` 后，其他进程用相同配置构造时会附着到
+ * 已有共享段并登记为发布者；发布过程由共享段内的 robust mutex 串行化，死亡发布者
+ * 持有的未发布槽位和中断的发布都会被回收。
+ * With `LinuxSharedTopicConfig::multi_publisher` enabled, other processes constructing
+ * the topic with the same config attach to the existing segment and register as
+ * publishers; publishing is serialized by a robust mutex inside the segment, and both
+ * unpublished slots held by a dead publisher and interrupted publishes are reclaimed.
+ *
+ * 配置 `LinuxSharedTopicConfig::size_classes` 后进入变长模式：每条消息是若干个连续的
+ * `TopicData` 元素，按所需长度从容量最小且有空闲的规格中取槽位，共享内存只按各规格
+ * 实际容量预留。例如 `LinuxSharedTopic<uint8_t>` 可承载从几百字节到数 MB 的消息。
+ * Configuring `LinuxSharedTopicConfig::size_classes` enables variable-size mode: each
+ * message is a run of contiguous `TopicData` elements, slots are taken from the smallest
+ * class with room for the requested length, and shared memory is reserved only for the
+ * capacity of each class. For example, `LinuxSharedTopic<uint8_t>` can carry messages
+ * from a few hundred bytes up to several MB.
+ *
+ * 订阅者可通过 `Subscriber::EnableNotify()` 取得一个可 poll 的描述符，从而让一个
+ * reactor 线程用 `epoll_wait` 同时等待多个共享 Topic、socket 和定时器。
+ * Subscribers can obtain a pollable descriptor through `Subscriber::EnableNotify()`, so
+ * one reactor thread can `epoll_wait` across many shared topics, sockets, and timers.
+ *
+ * `LinuxSharedTopicConfig::wait_strategy` 决定订阅者在 futex 上休眠、先自旋再休眠，
+ * 还是始终忙轮询；发布者只在确有订阅者休眠时才调用 `FUTEX_WAKE`。
+ * `LinuxSharedTopicConfig::wait_strategy` selects whether subscribers sleep on the
+ * futex, spin first and then sleep, or always busy-poll; the publisher only issues
+ * `FUTEX_WAKE` when a subscriber is actually parked.
+ *
  * @tparam TopicData 话题数据类型，必须为平凡可拷贝类型。Topic data type, must be
  * trivially copyable.
  */
@@ -92,6 +164,24 @@ class LinuxSharedTopic : public Topic
   using Data = SharedData;
   static constexpr const char* DEFAULT_DOMAIN_NAME = "libxr_def_domain";
 
+  /**
+   * @struct BatchItem
+   * @brief 批量接收得到的一条消息。One message obtained by a batch receive.
+   *
+   * 指针在订阅者下一次 `WaitBatch()`、`ReleaseBatch()` 或 `Reset()` 之前保持有效。
+   * The pointer stays valid until the subscriber's next `WaitBatch()`, `ReleaseBatch()`,
+   * or `Reset()`.
+   */
+  struct BatchItem
+  {
+    const TopicData* data = nullptr;  ///< 消息数据。Message payload.
+    uint32_t size = 0;                ///< 消息元素个数。Message element count.
+    uint64_t sequence = 0;            ///< 消息序号。Message sequence number.
+    MicrosecondTimestamp timestamp;   ///< 消息时间戳。Message timestamp.
+    uint32_t origin = 0;              ///< 发布者设置的来源标记。Origin tag set by the
+                                      ///< publisher.
+  };
+
   /**
    * @class Subscriber
    * @brief 同步订阅者，用于从共享 Topic 中等待并读取消息。
@@ -188,6 +278,7 @@ class LinuxSharedTopic : public Topic
       current_slot_index_ = other.current_slot_index_;
       current_sequence_ = other.current_sequence_;
       current_timestamp_ = other.current_timestamp_;
+      notify_fd_ = other.notify_fd_;
 
       other.topic_ = nullptr;
       other.owned_topic_ = nullptr;
@@ -195,6 +286,7 @@ class LinuxSharedTopic : public Topic
       other.current_slot_index_ = INVALID_INDEX;
       other.current_sequence_ = 0;
       other.current_timestamp_ = MicrosecondTimestamp();
+      other.notify_fd_ = -1;
       return *this;
     }
 
@@ -313,6 +405,159 @@ class LinuxSharedTopic : public Topic
       }
     }
 
+    /**
+     * @brief 等待并一次取出多条消息。Wait for and take several messages at once.
+     * @param items 输出数组，其长度即本次最多取出的条数。Output array; its length is the
+     * maximum number of messages taken.
+     * @param count 实际取出的条数。Number of messages actually taken.
+     * @param timeout_ms 超时时间，默认无限等待。Timeout in milliseconds, default is wait
+     * forever.
+     * @return 错误码。Error code indicating the wait result.
+     *
+     * 一次 CAS 认领队列中已就绪的多个描述符，并一次性扣减就绪计数；取出的槽位会一直
+     * 持有到下一次 `WaitBatch()` 或 `ReleaseBatch()`，再集中释放。持有的槽位登记在
+     * 共享段中，订阅进程崩溃后仍能被回收。
+     * One CAS claims several ready descriptors and the ready count is consumed in one
+     * step; the slots stay held until the next `WaitBatch()` or `ReleaseBatch()` and are
+     * released together. Held slots are recorded in the shared segment, so they are
+     * still reclaimed if the subscriber process crashes.
+     */
+    ErrorCode WaitBatch(std::span<BatchItem> items, uint32_t& count,
+                        uint32_t timeout_ms = UINT32_MAX)
+    {
+      count = 0;
+      ReleaseBatch();
+
+      if (!Valid())
+      {
+        return ErrorCode::STATE_ERR;
+      }
+      if (items.empty())
+      {
+        return ErrorCode::ARG_ERR;
+      }
+
+      const uint32_t max_count = static_cast<uint32_t>(
+          std::min<size_t>(items.size(), topic_->queue_capacity_ - 1U));
+      const uint64_t deadline_ms =
+          (timeout_ms == UINT32_MAX) ? 0 : (NowMonotonicMs() + timeout_ms);
+
+      while (true)
+      {
+        count = topic_->TryPopBatch(subscriber_index_, items.data(), max_count);
+        if (count != 0)
+        {
+          return ErrorCode::OK;
+        }
+
+        uint32_t wait_ms = UINT32_MAX;
+        if (timeout_ms != UINT32_MAX)
+        {
+          const uint64_t now_ms = NowMonotonicMs();
+          if (now_ms >= deadline_ms)
+          {
+            return ErrorCode::TIMEOUT;
+          }
+          wait_ms = static_cast<uint32_t>(deadline_ms - now_ms);
+        }
+
+        const ErrorCode wait_ans =
+            topic_->WaitReady(topic_->subscribers_[subscriber_index_], wait_ms);
+        if (wait_ans == ErrorCode::OK)
+        {
+          continue;
+        }
+        return wait_ans;
+      }
+    }
+
+    /**
+     * @brief 释放上一次 `WaitBatch()` 持有的全部槽位。Release every slot held by the last
+     * `WaitBatch()`.
+     */
+    void ReleaseBatch()
+    {
+      if (!Valid())
+      {
+        return;
+      }
+      topic_->ReleaseHeldBatch(subscriber_index_);
+    }
+
+    /**
+     * @brief 开启可 poll 的就绪通知。Enable a pollable readiness notification.
+     * @return 错误码。Error code indicating the result.
+     *
+     * 开启后 `GetNotifyFd()` 返回的描述符在有新消息时变为可读。通知是边沿式的：
+     * 描述符可读后应先调用 `RearmNotify()`，再用 `Wait(data, 0)` 取完全部消息，
+     * 直到返回 `TIMEOUT`。开启前已入队的消息不会触发通知，开启后应先取一次队列。
+     * Once enabled, the descriptor returned by `GetNotifyFd()` becomes readable when new
+     * messages arrive. The notification is edge-style: after the descriptor turns
+     * readable, call `RearmNotify()` first, then drain every message with
+     * `Wait(data, 0)` until it returns `TIMEOUT`. Messages queued before enabling do not
+     * trigger a notification, so drain the queue once right after enabling.
+     */
+    ErrorCode EnableNotify()
+    {
+      if (!Valid())
+      {
+        return ErrorCode::STATE_ERR;
+      }
+      if (notify_fd_ >= 0)
+      {
+        return ErrorCode::OK;
+      }
+
+      const int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+      {
+        return ErrorCode::INIT_ERR;
+      }
+
+      sockaddr_un addr = {};
+      const socklen_t addr_len =
+          BuildNotifyAddress(topic_->name_key_, subscriber_index_, addr);
+      if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), addr_len) != 0)
+      {
+        close(fd);
+        return ErrorCode::INIT_ERR;
+      }
+
+      notify_fd_ = fd;
+      RearmNotify();
+      return ErrorCode::OK;
+    }
+
+    /**
+     * @brief 获取就绪通知描述符。Get the readiness notification descriptor.
+     * @return 描述符；未开启通知时返回 -1。Descriptor, or -1 if notification is off.
+     */
+    int GetNotifyFd() const { return notify_fd_; }
+
+    /**
+     * @brief 清空已到达的通知并重新挂起。Drain delivered notifications and re-arm.
+     *
+     * 重新挂起之后到达的消息一定会再次触发通知，因此挂起后必须取完队列。
+     * Any message arriving after re-arming triggers a new notification, so the queue must
+     * be drained after re-arming.
+     */
+    void RearmNotify()
+    {
+      if (!Valid() || notify_fd_ < 0)
+      {
+        return;
+      }
+
+      uint8_t token = 0;
+      while (recv(notify_fd_, &token, sizeof(token), MSG_DONTWAIT) > 0)
+      {
+      }
+
+      topic_->subscribers_[subscriber_index_].notify_armed.store(
+          1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
     /**
      * @brief 获取当前持有的消息数据指针。Get the pointer to the currently held payload.
      * @return 当前消息指针；若未持有消息则返回 nullptr。
@@ -325,7 +570,21 @@ class LinuxSharedTopic : public Topic
         return nullptr;
       }
 
-      return &topic_->payloads_[current_slot_index_];
+      return topic_->SlotPayload(current_slot_index_);
+    }
+
+    /**
+     * @brief 获取当前消息的元素个数。Get the element count of the current message.
+     * @return 元素个数；未持有消息时返回 0。Element count, or 0 if none is held.
+     */
+    uint32_t GetSize() const
+    {
+      if (!Valid() || current_slot_index_ == INVALID_INDEX)
+      {
+        return 0;
+      }
+
+      return topic_->slots_[current_slot_index_].size;
     }
 
     /**
@@ -402,6 +661,13 @@ class LinuxSharedTopic : public Topic
       }
 
       topic_->UnregisterBalancedSubscriber(subscriber_index_);
+      topic_->subscribers_[subscriber_index_].notify_armed.store(
+          0, std::memory_order_release);
+      if (notify_fd_ >= 0)
+      {
+        close(notify_fd_);
+        notify_fd_ = -1;
+      }
       topic_->subscribers_[subscriber_index_].active.store(0, std::memory_order_release);
       topic_->subscribers_[subscriber_index_].owner_pid.store(0,
                                                               std::memory_order_release);
@@ -415,6 +681,7 @@ class LinuxSharedTopic : public Topic
       }
 
       Release();
+      topic_->ReleaseHeldBatch(subscriber_index_);
 
       topic_ = nullptr;
       delete owned_topic_;
@@ -456,6 +723,9 @@ class LinuxSharedTopic : public Topic
           topic.subscribers_[i].owner_starttime.store(topic.self_identity_.starttime,
                                                       std::memory_order_release);
           topic.subscribers_[i].held_slot.store(INVALID_INDEX, std::memory_order_release);
+          topic.subscribers_[i].notify_armed.store(0, std::memory_order_release);
+          topic.subscribers_[i].held_batch_count.store(0, std::memory_order_release);
+          topic.subscribers_[i].parked_waiters.store(0, std::memory_order_release);
           topic.subscribers_[i].mode.store(static_cast<uint32_t>(mode),
                                            std::memory_order_release);
           if (mode == LinuxSharedSubscriberMode::BALANCE_RR)
@@ -490,6 +760,7 @@ class LinuxSharedTopic : public Topic
     uint32_t current_slot_index_ = INVALID_INDEX;
     uint64_t current_sequence_ = 0;
     MicrosecondTimestamp current_timestamp_;
+    int notify_fd_ = -1;
   };
 
   /**
@@ -584,7 +855,7 @@ class LinuxSharedTopic : public Topic
       {
         return nullptr;
       }
-      return &topic_->payloads_[slot_index_];
+      return topic_->SlotPayload(slot_index_);
     }
 
     /**
@@ -598,7 +869,85 @@ class LinuxSharedTopic : public Topic
       {
         return nullptr;
       }
-      return &topic_->payloads_[slot_index_];
+      return topic_->SlotPayload(slot_index_);
+    }
+
+    /**
+     * @brief 获取消息元素个数。Get the element count of the message.
+     * @return 元素个数；句柄无效时返回 0。Element count, or 0 if the handle is invalid.
+     */
+    uint32_t GetSize() const
+    {
+      if (!Valid())
+      {
+        return 0;
+      }
+      return topic_->slots_[slot_index_].size;
+    }
+
+    /**
+     * @brief 获取槽位可容纳的元素个数。Get the element capacity of the slot.
+     * @return 槽位容量；句柄无效时返回 0。Slot capacity, or 0 if the handle is invalid.
+     */
+    uint32_t GetCapacity() const
+    {
+      if (!Valid())
+      {
+        return 0;
+      }
+      return topic_->slots_[slot_index_].capacity;
+    }
+
+    /**
+     * @brief 发布前调整消息元素个数。Adjust the message element count before publishing.
+     * @param size 新的元素个数，范围为 1 到 `GetCapacity()`。New element count in the
+     * range 1 to `GetCapacity()`.
+     * @return 错误码。Error code indicating the result.
+     */
+    ErrorCode SetSize(uint32_t size)
+    {
+      if (!Valid() || state_ != SharedDataState::PUBLISHER)
+      {
+        return ErrorCode::STATE_ERR;
+      }
+      if (size == 0 || size > topic_->slots_[slot_index_].capacity)
+      {
+        return ErrorCode::ARG_ERR;
+      }
+      topic_->slots_[slot_index_].size = size;
+      return ErrorCode::OK;
+    }
+
+    /**
+     * @brief 发布前设置来源标记。Set the origin tag before publishing.
+     * @param origin 来源标记，0 表示未标记。Origin tag, 0 means untagged.
+     * @return 错误码。Error code indicating the result.
+     *
+     * 标记随槽位一起交给订阅者，转发组件可据此认出自己发出的消息，避免回环。
+     * The tag travels with the slot to subscribers, so forwarding components can
+     * recognize their own messages and avoid loops.
+     */
+    ErrorCode SetOrigin(uint32_t origin)
+    {
+      if (!Valid() || state_ != SharedDataState::PUBLISHER)
+      {
+        return ErrorCode::STATE_ERR;
+      }
+      topic_->slots_[slot_index_].origin = origin;
+      return ErrorCode::OK;
+    }
+
+    /**
+     * @brief 获取来源标记。Get the origin tag.
+     * @return 来源标记；句柄无效时返回 0。Origin tag, or 0 if the handle is invalid.
+     */
+    uint32_t GetOrigin() const
+    {
+      if (!Valid())
+      {
+        return 0;
+      }
+      return topic_->slots_[slot_index_].origin;
     }
 
     /**
@@ -767,7 +1116,17 @@ class LinuxSharedTopic : public Topic
    * @param data 输出句柄。Output payload handle.
    * @return 错误码。Error code indicating the acquisition result.
    */
-  ErrorCode CreateData(SharedData& data)
+  ErrorCode CreateData(SharedData& data) { return CreateData(data, 1U); }
+
+  /**
+   * @brief 为发布者申请一个至少容纳 `size` 个元素的槽位。Acquire a publisher slot that
+   * holds at least `size` elements.
+   * @param data 输出句柄。Output payload handle.
+   * @param size 消息元素个数。Message element count.
+   * @return 错误码；超出最大规格时返回 `ARG_ERR`。Error code; `ARG_ERR` when the size
+   * exceeds the largest class.
+   */
+  ErrorCode CreateData(SharedData& data, uint32_t size)
   {
     if (!Valid())
     {
@@ -781,21 +1140,34 @@ class LinuxSharedTopic : public Topic
 
     data.Reset();
 
+    if (size == 0 || size > MaxSlotCapacity())
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
     uint32_t slot_index = INVALID_INDEX;
-    ErrorCode pop_ans = PopFreeSlot(slot_index);
+    ErrorCode pop_ans = PopFreeSlotFor(size, slot_index);
     if (pop_ans != ErrorCode::OK)
     {
       ScavengeDeadSubscribers();
-      pop_ans = PopFreeSlot(slot_index);
+      if (multi_publisher_)
+      {
+        ScavengeDeadPublishers();
+      }
+      pop_ans = PopFreeSlotFor(size, slot_index);
       if (pop_ans != ErrorCode::OK)
       {
         return pop_ans;
       }
     }
 
+    // 多发布者模式下记录槽位归属，发布者死亡后由存活进程回收。
+    slots_[slot_index].owner_publisher.store(publisher_index_, std::memory_order_release);
     slots_[slot_index].refcount.store(0, std::memory_order_release);
     slots_[slot_index].sequence.store(0, std::memory_order_release);
     slots_[slot_index].timestamp_us = 0;
+    slots_[slot_index].size = size;
+    slots_[slot_index].origin = 0;
 
     data.topic_ = this;
     data.slot_index_ = slot_index;
@@ -836,6 +1208,38 @@ class LinuxSharedTopic : public Topic
     return Publish(topic_data, timestamp);
   }
 
+  /**
+   * @brief 复制一段连续元素并发布。Copy a run of contiguous elements and publish it.
+   * @param data 元素起始地址。Pointer to the first element.
+   * @param size 元素个数。Element count.
+   * @return 错误码。Error code indicating the publish result.
+   */
+  ErrorCode Publish(const TopicData* data, uint32_t size)
+  {
+    SharedData topic_data;
+    const ErrorCode acquire_ans = CreateData(topic_data, size);
+    if (acquire_ans != ErrorCode::OK)
+    {
+      return acquire_ans;
+    }
+
+    std::copy_n(data, size, topic_data.GetData());
+    return Publish(topic_data);
+  }
+
+  ErrorCode Publish(const TopicData* data, uint32_t size, MicrosecondTimestamp timestamp)
+  {
+    SharedData topic_data;
+    const ErrorCode acquire_ans = CreateData(topic_data, size);
+    if (acquire_ans != ErrorCode::OK)
+    {
+      return acquire_ans;
+    }
+
+    std::copy_n(data, size, topic_data.GetData());
+    return Publish(topic_data, timestamp);
+  }
+
   /**
    * @brief 发布一个已申请好的 payload 句柄。Publish a pre-acquired payload handle.
    */
@@ -868,6 +1272,12 @@ class LinuxSharedTopic : public Topic
     return header_->publish_failures.load(std::memory_order_acquire);
   }
 
+  /**
+   * @brief 获取共享段使用的订阅者等待方式。Get the subscriber wait strategy of the
+   * segment.
+   */
+  LinuxSharedWaitStrategy GetWaitStrategy() const { return wait_strategy_; }
+
   /**
    * @brief 删除对应的共享内存对象。Remove the backing shared-memory object.
    * @param topic_name 主题名称。Topic name.
@@ -902,6 +1312,16 @@ class LinuxSharedTopic : public Topic
   }
 
  private:
+  // 每档规格占据一段连续的槽位和空闲环区间，各自维护 MPMC 空闲环的头尾。
+  struct alignas(LibXR::CONCURRENCY_ALIGNMENT) SizeClassControl
+  {
+    uint32_t capacity = 0;
+    uint32_t slot_begin = 0;
+    uint32_t slot_count = 0;
+    std::atomic<uint64_t> free_queue_head;
+    std::atomic<uint64_t> free_queue_tail;
+  };
+
   struct alignas(LibXR::CONCURRENCY_ALIGNMENT) SharedHeader
   {
     uint64_t magic = 0;
@@ -913,20 +1333,43 @@ class LinuxSharedTopic : public Topic
     uint32_t subscriber_capacity = 0;
     uint32_t queue_capacity = 0;
     uint32_t topic_name_len = 0;
+    uint32_t publisher_capacity = 0;
+    uint32_t multi_publisher = 0;
+    uint32_t size_class_count = 0;
+    uint32_t wait_strategy = 0;
+    uint32_t spin_count = 0;
+    uint64_t payload_capacity = 0;
     std::atomic<uint32_t> init_state;
     std::atomic<uint32_t> publisher_pid;
     std::atomic<uint64_t> publisher_starttime;
-    std::atomic<uint64_t> free_queue_head;
-    std::atomic<uint64_t> free_queue_tail;
+    SizeClassControl size_classes[LINUX_SHARED_SIZE_CLASS_NUM];
     std::atomic<uint64_t> next_sequence;
     std::atomic<uint64_t> publish_failures;
+    pthread_mutex_t publish_mutex;
+    // 多发布者模式下进行中发布的恢复日志，只在持有 publish_mutex 时写入。
+    std::atomic<uint32_t> inflight_slot;
+    std::atomic<uint32_t> inflight_tail;
+    std::atomic<uint64_t> inflight_state;
   };
 
   struct alignas(LibXR::CONCURRENCY_ALIGNMENT) SlotControl
   {
     std::atomic<uint32_t> refcount;
+    std::atomic<uint32_t> owner_publisher;
     std::atomic<uint64_t> sequence;
     uint64_t timestamp_us;
+    uint64_t payload_offset;
+    uint32_t size_class;
+    uint32_t capacity;
+    uint32_t size;
+    uint32_t origin;
+  };
+
+  struct alignas(LibXR::CONCURRENCY_ALIGNMENT) PublisherControl
+  {
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> owner_pid;
+    std::atomic<uint64_t> owner_starttime;
   };
 
   struct alignas(16) FreeSlotCell
@@ -954,6 +1397,9 @@ class LinuxSharedTopic : public Topic
     std::atomic<uint32_t> owner_pid;
     std::atomic<uint64_t> owner_starttime;
     std::atomic<uint32_t> held_slot;
+    std::atomic<uint32_t> notify_armed;
+    std::atomic<uint32_t> held_batch_count;
+    std::atomic<uint32_t> parked_waiters;
   };
 
   struct alignas(LibXR::CONCURRENCY_ALIGNMENT) BalancedGroupControl
@@ -968,9 +1414,13 @@ class LinuxSharedTopic : public Topic
   };
 
   static constexpr uint64_t MAGIC = 0x4c58524950435348ULL;
-  static constexpr uint32_t VERSION = 2;
+  static constexpr uint32_t VERSION = 8;
   static constexpr uint32_t INIT_READY = 1;
   static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+  static constexpr uint32_t PUBLISHER_FREE = 0;
+  static constexpr uint32_t PUBLISHER_ACTIVE = 1;
+  static constexpr uint32_t PUBLISHER_RECLAIMING = 2;
+  static constexpr uint32_t BUSY_POLL_CLOCK_INTERVAL = 1024;
 
   static uint32_t ResolveDomainKey(const char* domain_name)
   {
@@ -1095,14 +1545,29 @@ class LinuxSharedTopic : public Topic
                                     FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0));
   }
 
-  static size_t ComputeSharedBytes(uint32_t slot_count, uint32_t subscriber_capacity,
-                                   uint32_t queue_capacity, uint32_t topic_name_len)
+  static void CpuRelax()
   {
-    size_t offset = 0;
-    offset = AlignUp(offset, alignof(SharedHeader));
-    offset += sizeof(SharedHeader);
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+  }
 
+  static size_t PublisherTableOffset(uint32_t topic_name_len)
+  {
+    size_t offset = AlignUp(0, alignof(SharedHeader));
+    offset += sizeof(SharedHeader);
     offset += static_cast<size_t>(topic_name_len) + 1U;
+    return AlignUp(offset, alignof(PublisherControl));
+  }
+
+  static size_t ComputeSharedBytes(uint32_t slot_count, uint32_t subscriber_capacity,
+                                   uint32_t queue_capacity, uint32_t topic_name_len,
+                                   uint32_t publisher_capacity, uint64_t payload_capacity)
+  {
+    size_t offset = PublisherTableOffset(topic_name_len);
+    offset += sizeof(PublisherControl) * publisher_capacity;
 
     offset = AlignUp(offset, alignof(SlotControl));
     offset += sizeof(SlotControl) * slot_count;
@@ -1122,8 +1587,11 @@ class LinuxSharedTopic : public Topic
     offset = AlignUp(offset, alignof(Descriptor));
     offset += sizeof(Descriptor) * subscriber_capacity * queue_capacity;
 
+    offset = AlignUp(offset, alignof(uint32_t));
+    offset += sizeof(uint32_t) * subscriber_capacity * queue_capacity;
+
     offset = AlignUp(offset, alignof(TopicData));
-    offset += sizeof(TopicData) * slot_count;
+    offset += sizeof(TopicData) * payload_capacity;
     return offset;
   }
 
@@ -1136,7 +1604,10 @@ class LinuxSharedTopic : public Topic
     offset += sizeof(SharedHeader);
 
     topic_name_ptr_ = reinterpret_cast<char*>(base_ + offset);
-    offset += static_cast<size_t>(header_->topic_name_len) + 1U;
+
+    offset = PublisherTableOffset(header_->topic_name_len);
+    publishers_ = reinterpret_cast<PublisherControl*>(base_ + offset);
+    offset += sizeof(PublisherControl) * publisher_capacity_;
 
     offset = AlignUp(offset, alignof(SlotControl));
     slots_ = reinterpret_cast<SlotControl*>(base_ + offset);
@@ -1162,6 +1633,10 @@ class LinuxSharedTopic : public Topic
     descriptors_ = reinterpret_cast<Descriptor*>(base_ + offset);
     offset += sizeof(Descriptor) * subscriber_capacity_ * queue_capacity_;
 
+    offset = AlignUp(offset, alignof(uint32_t));
+    held_batches_ = reinterpret_cast<uint32_t*>(base_ + offset);
+    offset += sizeof(uint32_t) * subscriber_capacity_ * queue_capacity_;
+
     offset = AlignUp(offset, alignof(TopicData));
     payloads_ = reinterpret_cast<TopicData*>(base_ + offset);
   }
@@ -1189,14 +1664,29 @@ class LinuxSharedTopic : public Topic
 
   ErrorCode InitializeLayout()
   {
-    if (config_.slot_num == 0 || config_.subscriber_num == 0 || config_.queue_num < 2)
+    if (config_.subscriber_num == 0 || config_.queue_num < 2 ||
+        (config_.multi_publisher && config_.publisher_num == 0) ||
+        config_.wait_strategy > LinuxSharedWaitStrategy::BUSY_POLL)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    std::array<LinuxSharedSizeClass, LINUX_SHARED_SIZE_CLASS_NUM> size_classes = {};
+    uint32_t size_class_count = 0;
+    uint32_t slot_count = 0;
+    uint64_t payload_capacity = 0;
+    if (!ResolveSizeClasses(size_classes, size_class_count, slot_count,
+                            payload_capacity))
     {
       return ErrorCode::ARG_ERR;
     }
 
+    const uint32_t publisher_capacity =
+        config_.multi_publisher ? config_.publisher_num : 0U;
     const size_t bytes =
-        ComputeSharedBytes(config_.slot_num, config_.subscriber_num, config_.queue_num,
-                           static_cast<uint32_t>(topic_name_.size()));
+        ComputeSharedBytes(slot_count, config_.subscriber_num, config_.queue_num,
+                           static_cast<uint32_t>(topic_name_.size()), publisher_capacity,
+                           payload_capacity);
 
     if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
     {
@@ -1218,9 +1708,13 @@ class LinuxSharedTopic : public Topic
     }
 
     base_ = static_cast<uint8_t*>(mapping_);
-    slot_count_ = config_.slot_num;
+    slot_count_ = slot_count;
     subscriber_capacity_ = config_.subscriber_num;
     queue_capacity_ = config_.queue_num;
+    publisher_capacity_ = publisher_capacity;
+    multi_publisher_ = config_.multi_publisher;
+    wait_strategy_ = config_.wait_strategy;
+    spin_count_ = config_.spin_count;
     header_ = reinterpret_cast<SharedHeader*>(base_ + AlignUp(0, alignof(SharedHeader)));
     header_->topic_name_len = static_cast<uint32_t>(topic_name_.size());
     SetupPointers();
@@ -1233,39 +1727,101 @@ class LinuxSharedTopic : public Topic
     header_->slot_count = slot_count_;
     header_->subscriber_capacity = subscriber_capacity_;
     header_->queue_capacity = queue_capacity_;
+    header_->publisher_capacity = publisher_capacity_;
+    header_->multi_publisher = multi_publisher_ ? 1U : 0U;
     std::memcpy(topic_name_ptr_, topic_name_.c_str(), topic_name_.size() + 1U);
     header_->publisher_pid.store(self_identity_.pid, std::memory_order_release);
     header_->publisher_starttime.store(self_identity_.starttime,
                                        std::memory_order_release);
-    header_->free_queue_head.store(0, std::memory_order_release);
-    header_->free_queue_tail.store(slot_count_, std::memory_order_release);
+    header_->size_class_count = size_class_count;
+    header_->wait_strategy = static_cast<uint32_t>(wait_strategy_);
+    header_->spin_count = spin_count_;
+    header_->payload_capacity = payload_capacity;
     header_->next_sequence.store(0, std::memory_order_release);
     header_->publish_failures.store(0, std::memory_order_release);
+    header_->inflight_slot.store(INVALID_INDEX, std::memory_order_release);
+    header_->inflight_tail.store(0, std::memory_order_release);
+    header_->inflight_state.store(PackInflightState(0, INVALID_INDEX),
+                                  std::memory_order_release);
 
-    for (uint32_t i = 0; i < slot_count_; ++i)
+    if (multi_publisher_)
     {
-      slots_[i].refcount.store(0, std::memory_order_release);
-      slots_[i].sequence.store(0, std::memory_order_release);
-      slots_[i].timestamp_us = 0;
-      std::construct_at(&payloads_[i], TopicData{});
-      free_slots_[i].slot_index = i;
-      free_slots_[i].sequence.store(static_cast<uint64_t>(i) + 1U,
-                                    std::memory_order_release);
+      pthread_mutexattr_t attr;
+      if (pthread_mutexattr_init(&attr) != 0)
+      {
+        return ErrorCode::INIT_ERR;
+      }
+      const bool attr_ok =
+          pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) == 0 &&
+          pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST) == 0;
+      const bool init_ok =
+          attr_ok && pthread_mutex_init(&header_->publish_mutex, &attr) == 0;
+      pthread_mutexattr_destroy(&attr);
+      if (!init_ok)
+      {
+        return ErrorCode::INIT_ERR;
+      }
+
+      for (uint32_t i = 0; i < publisher_capacity_; ++i)
+      {
+        publishers_[i].state.store(PUBLISHER_FREE, std::memory_order_release);
+        publishers_[i].owner_pid.store(0, std::memory_order_release);
+        publishers_[i].owner_starttime.store(0, std::memory_order_release);
+      }
     }
 
-    for (uint32_t i = 0; i < subscriber_capacity_; ++i)
+    uint32_t slot_begin = 0;
+    uint64_t payload_offset = 0;
+    for (uint32_t class_index = 0; class_index < size_class_count; ++class_index)
     {
-      subscribers_[i].active.store(0, std::memory_order_release);
-      subscribers_[i].mode.store(
-          static_cast<uint32_t>(LinuxSharedSubscriberMode::BROADCAST_FULL),
-          std::memory_order_release);
-      subscribers_[i].queue_head.store(0, std::memory_order_release);
-      subscribers_[i].queue_tail.store(0, std::memory_order_release);
+      const LinuxSharedSizeClass& size_class = size_classes[class_index];
+      SizeClassControl& control = header_->size_classes[class_index];
+      control.capacity = size_class.capacity;
+      control.slot_begin = slot_begin;
+      control.slot_count = size_class.slot_num;
+      control.free_queue_head.store(0, std::memory_order_release);
+      control.free_queue_tail.store(size_class.slot_num, std::memory_order_release);
+
+      for (uint32_t j = 0; j < size_class.slot_num; ++j)
+      {
+        const uint32_t i = slot_begin + j;
+        slots_[i].refcount.store(0, std::memory_order_release);
+        slots_[i].owner_publisher.store(INVALID_INDEX, std::memory_order_release);
+        slots_[i].sequence.store(0, std::memory_order_release);
+        slots_[i].timestamp_us = 0;
+        slots_[i].payload_offset = payload_offset;
+        slots_[i].size_class = class_index;
+        slots_[i].capacity = size_class.capacity;
+        slots_[i].size = 0;
+        slots_[i].origin = 0;
+        for (uint32_t k = 0; k < size_class.capacity; ++k)
+        {
+          std::construct_at(&payloads_[payload_offset + k], TopicData{});
+        }
+        payload_offset += size_class.capacity;
+        free_slots_[i].slot_index = i;
+        free_slots_[i].sequence.store(static_cast<uint64_t>(j) + 1U,
+                                      std::memory_order_release);
+      }
+      slot_begin += size_class.slot_num;
+    }
+
+    for (uint32_t i = 0; i < subscriber_capacity_; ++i)
+    {
+      subscribers_[i].active.store(0, std::memory_order_release);
+      subscribers_[i].mode.store(
+          static_cast<uint32_t>(LinuxSharedSubscriberMode::BROADCAST_FULL),
+          std::memory_order_release);
+      subscribers_[i].queue_head.store(0, std::memory_order_release);
+      subscribers_[i].queue_tail.store(0, std::memory_order_release);
       subscribers_[i].ready_sem_count.store(0, std::memory_order_release);
       subscribers_[i].dropped_messages.store(0, std::memory_order_release);
       subscribers_[i].owner_pid.store(0, std::memory_order_release);
       subscribers_[i].owner_starttime.store(0, std::memory_order_release);
       subscribers_[i].held_slot.store(INVALID_INDEX, std::memory_order_release);
+      subscribers_[i].notify_armed.store(0, std::memory_order_release);
+      subscribers_[i].held_batch_count.store(0, std::memory_order_release);
+      subscribers_[i].parked_waiters.store(0, std::memory_order_release);
       balanced_members_[i].store(INVALID_INDEX, std::memory_order_release);
     }
 
@@ -1277,6 +1833,11 @@ class LinuxSharedTopic : public Topic
       descriptors_[i] = Descriptor{};
     }
 
+    if (multi_publisher_ && RegisterPublisher() != ErrorCode::OK)
+    {
+      return ErrorCode::INIT_ERR;
+    }
+
     header_->init_state.store(INIT_READY, std::memory_order_release);
     return ErrorCode::OK;
   }
@@ -1314,11 +1875,45 @@ class LinuxSharedTopic : public Topic
     slot_count_ = header_->slot_count;
     subscriber_capacity_ = header_->subscriber_capacity;
     queue_capacity_ = header_->queue_capacity;
+    publisher_capacity_ = header_->publisher_capacity;
+    multi_publisher_ = header_->multi_publisher != 0;
+    if (header_->wait_strategy >
+        static_cast<uint32_t>(LinuxSharedWaitStrategy::BUSY_POLL))
+    {
+      return ErrorCode::CHECK_ERR;
+    }
+    wait_strategy_ = static_cast<LinuxSharedWaitStrategy>(header_->wait_strategy);
+    spin_count_ = header_->spin_count;
+    if (!SizeClassesConsistent() ||
+        mapping_size_ < ComputeSharedBytes(slot_count_, subscriber_capacity_,
+                                           queue_capacity_, header_->topic_name_len,
+                                           publisher_capacity_,
+                                           header_->payload_capacity))
+    {
+      return ErrorCode::CHECK_ERR;
+    }
     SetupPointers();
     if (!HeaderMatchesIdentity())
     {
       return ErrorCode::CHECK_ERR;
     }
+
+    if (publisher_)
+    {
+      // 只有多发布者共享段允许后来的发布者加入。
+      if (!multi_publisher_)
+      {
+        return ErrorCode::BUSY;
+      }
+
+      ErrorCode register_ans = RegisterPublisher();
+      if (register_ans == ErrorCode::FULL)
+      {
+        ScavengeDeadPublishers();
+        register_ans = RegisterPublisher();
+      }
+      return register_ans;
+    }
     return ErrorCode::OK;
   }
 
@@ -1381,6 +1976,10 @@ class LinuxSharedTopic : public Topic
         {
           reclaim = !ProcessAlive(publisher_identity);
         }
+        else if (header->multi_publisher != 0)
+        {
+          reclaim = !AnyPublisherAlive(header, base, mapping_size);
+        }
         else if (!ProcessAlive(publisher_identity))
         {
           reclaim = true;
@@ -1407,6 +2006,7 @@ class LinuxSharedTopic : public Topic
 
     if (create_)
     {
+      bool join_existing = false;
       for (int attempt = 0; attempt < 2; ++attempt)
       {
         fd_ = shm_open(shm_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
@@ -1415,10 +2015,27 @@ class LinuxSharedTopic : public Topic
           break;
         }
 
-        if (errno != EEXIST || !TryReclaimStaleSegment())
+        if (errno != EEXIST)
         {
           break;
         }
+
+        if (TryReclaimStaleSegment())
+        {
+          continue;
+        }
+
+        if (config_.multi_publisher)
+        {
+          fd_ = shm_open(shm_name_.c_str(), O_RDWR, 0600);
+          if (fd_ >= 0)
+          {
+            join_existing = true;
+            break;
+          }
+          errno = EEXIST;
+        }
+        break;
       }
 
       if (fd_ < 0)
@@ -1427,7 +2044,7 @@ class LinuxSharedTopic : public Topic
         return;
       }
 
-      open_status_ = InitializeLayout();
+      open_status_ = join_existing ? AttachLayout() : InitializeLayout();
     }
     else
     {
@@ -1452,6 +2069,21 @@ class LinuxSharedTopic : public Topic
 
   void Close()
   {
+    if (publisher_index_ != INVALID_INDEX && publishers_ != nullptr)
+    {
+      PublisherControl& control = publishers_[publisher_index_];
+      control.owner_pid.store(0, std::memory_order_release);
+      control.owner_starttime.store(0, std::memory_order_release);
+      control.state.store(PUBLISHER_FREE, std::memory_order_release);
+      publisher_index_ = INVALID_INDEX;
+    }
+
+    if (notify_socket_ >= 0)
+    {
+      close(notify_socket_);
+      notify_socket_ = -1;
+    }
+
     if (mapping_ != nullptr)
     {
       munmap(mapping_, mapping_size_);
@@ -1461,9 +2093,11 @@ class LinuxSharedTopic : public Topic
     base_ = nullptr;
     header_ = nullptr;
     slots_ = nullptr;
+    publishers_ = nullptr;
     subscribers_ = nullptr;
     free_slots_ = nullptr;
     descriptors_ = nullptr;
+    held_batches_ = nullptr;
     payloads_ = nullptr;
     mapping_size_ = 0;
     open_ok_ = false;
@@ -1482,6 +2116,11 @@ class LinuxSharedTopic : public Topic
     return descriptors_ + static_cast<size_t>(subscriber_index) * queue_capacity_;
   }
 
+  uint32_t* HeldBatch(uint32_t subscriber_index) const
+  {
+    return held_batches_ + static_cast<size_t>(subscriber_index) * queue_capacity_;
+  }
+
   static bool ProcessAlive(const ProcessIdentity& identity)
   {
     ProcessIdentity current = {};
@@ -1500,6 +2139,19 @@ class LinuxSharedTopic : public Topic
       return false;
     }
 
+    if (multi_publisher_)
+    {
+      if (publisher_index_ == INVALID_INDEX)
+      {
+        return false;
+      }
+      const PublisherControl& control = publishers_[publisher_index_];
+      return control.state.load(std::memory_order_acquire) == PUBLISHER_ACTIVE &&
+             control.owner_pid.load(std::memory_order_acquire) == self_identity_.pid &&
+             control.owner_starttime.load(std::memory_order_acquire) ==
+                 self_identity_.starttime;
+    }
+
     const ProcessIdentity owner = {
         header_->publisher_pid.load(std::memory_order_acquire),
         header_->publisher_starttime.load(std::memory_order_acquire),
@@ -1615,6 +2267,7 @@ class LinuxSharedTopic : public Topic
 
     subscribers_[subscriber_index].owner_pid.store(0, std::memory_order_release);
     subscribers_[subscriber_index].owner_starttime.store(0, std::memory_order_release);
+    subscribers_[subscriber_index].notify_armed.store(0, std::memory_order_release);
     subscribers_[subscriber_index].mode.store(
         static_cast<uint32_t>(LinuxSharedSubscriberMode::BROADCAST_FULL),
         std::memory_order_release);
@@ -1626,6 +2279,8 @@ class LinuxSharedTopic : public Topic
       ReleaseSlot(held_slot);
     }
 
+    ReleaseHeldBatch(subscriber_index);
+
     Descriptor desc = {};
     while (TryPopDescriptor(subscriber_index, desc) == ErrorCode::OK)
     {
@@ -1637,17 +2292,37 @@ class LinuxSharedTopic : public Topic
 
   static void PostReady(SubscriberControl& control)
   {
-    control.ready_sem_count.fetch_add(1, std::memory_order_release);
-    FutexWake(&control.ready_sem_count);
+    // 与 WaitReady() 中的 parked_waiters 自增配对（均为 seq_cst）：若这里读到 0，
+    // 订阅者随后的 FUTEX_WAIT 必然看到非零计数而立即返回，因此可以省掉这次系统调用。
+    control.ready_sem_count.fetch_add(1, std::memory_order_seq_cst);
+    if (control.parked_waiters.load(std::memory_order_seq_cst) != 0)
+    {
+      FutexWake(&control.ready_sem_count);
+    }
   }
 
-  static void ConsumeReady(SubscriberControl& control)
+  void ConsumeReady(SubscriberControl& control, uint32_t count = 1U)
   {
-    const uint32_t prev = control.ready_sem_count.fetch_sub(1, std::memory_order_acq_rel);
-    ASSERT(prev > 0);
+    // 单发布者的就绪计数先于描述符公开，见 PushDescriptor()。
+    if (!multi_publisher_)
+    {
+      const uint32_t prev =
+          control.ready_sem_count.fetch_sub(count, std::memory_order_acq_rel);
+      UNUSED(prev);
+      ASSERT(prev >= count);
+      return;
+    }
+
+    // 被中断的多发布者发布可能已推入描述符但尚未 PostReady，这里不让计数下溢。
+    uint32_t prev = control.ready_sem_count.load(std::memory_order_acquire);
+    while (prev != 0 && !control.ready_sem_count.compare_exchange_weak(
+                            prev, prev > count ? prev - count : 0U,
+                            std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+    }
   }
 
-  static ErrorCode WaitReady(SubscriberControl& control, uint32_t timeout_ms)
+  ErrorCode WaitReady(SubscriberControl& control, uint32_t timeout_ms)
   {
     if (control.ready_sem_count.load(std::memory_order_acquire) != 0)
     {
@@ -1657,6 +2332,26 @@ class LinuxSharedTopic : public Topic
     const bool infinite_wait = (timeout_ms == UINT32_MAX);
     const uint64_t deadline_ms = infinite_wait ? 0 : (NowMonotonicMs() + timeout_ms);
 
+    if (wait_strategy_ != LinuxSharedWaitStrategy::FUTEX)
+    {
+      const bool busy_poll = (wait_strategy_ == LinuxSharedWaitStrategy::BUSY_POLL);
+      for (uint32_t spin = 1; busy_poll || spin <= spin_count_; ++spin)
+      {
+        if (control.ready_sem_count.load(std::memory_order_acquire) != 0)
+        {
+          return ErrorCode::OK;
+        }
+        CpuRelax();
+
+        // 忙轮询不进入内核，每隔一段自旋检查一次截止时间。
+        if (busy_poll && !infinite_wait && (spin % BUSY_POLL_CLOCK_INTERVAL) == 0 &&
+            MonotonicTime::RemainingMilliseconds(deadline_ms) == 0)
+        {
+          return ErrorCode::TIMEOUT;
+        }
+      }
+    }
+
     while (true)
     {
       if (control.ready_sem_count.load(std::memory_order_acquire) != 0)
@@ -1676,13 +2371,16 @@ class LinuxSharedTopic : public Topic
 
       wait_ms = MonotonicTime::WaitSliceMilliseconds(wait_ms);
 
+      control.parked_waiters.fetch_add(1, std::memory_order_seq_cst);
       const int futex_ans = FutexWait(&control.ready_sem_count, 0, wait_ms);
-      if (futex_ans == 0 || errno == EAGAIN || errno == EINTR)
+      const int futex_errno = errno;
+      control.parked_waiters.fetch_sub(1, std::memory_order_release);
+      if (futex_ans == 0 || futex_errno == EAGAIN || futex_errno == EINTR)
       {
         continue;
       }
 
-      if (errno == ETIMEDOUT)
+      if (futex_errno == ETIMEDOUT)
       {
         if (infinite_wait)
         {
@@ -1739,8 +2437,60 @@ class LinuxSharedTopic : public Topic
     const uint32_t tail = control.queue_tail.load(std::memory_order_relaxed);
     ring[tail] = descriptor;
     const uint32_t next_tail = (tail + 1U) % queue_capacity_;
-    control.queue_tail.store(next_tail, std::memory_order_release);
-    PostReady(control);
+    // 单发布者先记就绪再公开描述符，就绪计数因此不少于队列中的描述符数，
+    // ConsumeReady() 可以断言不下溢。多发布者的发布可能在两步之间被打断，先记就绪会
+    // 留下永远取不到描述符的计数，所以保持原顺序，由消费侧钳位。
+    if (!multi_publisher_)
+    {
+      PostReady(control);
+      control.queue_tail.store(next_tail, std::memory_order_release);
+    }
+    else
+    {
+      control.queue_tail.store(next_tail, std::memory_order_release);
+      PostReady(control);
+    }
+    NotifySubscriber(subscriber_index);
+  }
+
+  static socklen_t BuildNotifyAddress(uint64_t name_key, uint32_t subscriber_index,
+                                      sockaddr_un& addr)
+  {
+    // 使用抽象命名空间，进程退出后地址随 socket 自动释放，不留文件系统残留。
+    addr.sun_family = AF_UNIX;
+    const int name_len =
+        std::snprintf(addr.sun_path + 1, sizeof(addr.sun_path) - 1U,
+                      "libxr_shm_%016" PRIx64 "_%" PRIu32, name_key, subscriber_index);
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1U +
+                                  static_cast<size_t>(name_len));
+  }
+
+  void NotifySubscriber(uint32_t subscriber_index)
+  {
+    SubscriberControl& control = subscribers_[subscriber_index];
+
+    // 与 RearmNotify() 的 fence 配对：要么订阅者重新挂起后看到新描述符，要么这里看到挂起。
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (control.notify_armed.load(std::memory_order_relaxed) == 0 ||
+        control.notify_armed.exchange(0, std::memory_order_acq_rel) == 0)
+    {
+      return;
+    }
+
+    if (notify_socket_ < 0)
+    {
+      notify_socket_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (notify_socket_ < 0)
+      {
+        return;
+      }
+    }
+
+    sockaddr_un addr = {};
+    const socklen_t addr_len = BuildNotifyAddress(name_key_, subscriber_index, addr);
+    const uint8_t token = 1;
+    (void)sendto(notify_socket_, &token, sizeof(token), MSG_DONTWAIT | MSG_NOSIGNAL,
+                 reinterpret_cast<const sockaddr*>(&addr), addr_len);
   }
 
   ErrorCode TryPopDescriptor(uint32_t subscriber_index, Descriptor& descriptor)
@@ -1768,6 +2518,67 @@ class LinuxSharedTopic : public Topic
     }
   }
 
+  uint32_t TryPopBatch(uint32_t subscriber_index, BatchItem* items, uint32_t max_count)
+  {
+    SubscriberControl& control = subscribers_[subscriber_index];
+    Descriptor* ring = DescriptorRing(subscriber_index);
+    uint32_t* held = HeldBatch(subscriber_index);
+
+    while (true)
+    {
+      uint32_t head = control.queue_head.load(std::memory_order_relaxed);
+      const uint32_t tail = control.queue_tail.load(std::memory_order_acquire);
+      const uint32_t available = (tail + queue_capacity_ - head) % queue_capacity_;
+      if (available == 0)
+      {
+        return 0;
+      }
+
+      const uint32_t count = std::min(available, max_count);
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        const Descriptor& descriptor = ring[(head + i) % queue_capacity_];
+        held[i] = descriptor.slot_index;
+        items[i].sequence = descriptor.sequence;
+      }
+
+      // 登记长度只能在 CAS 成功后写入：提前写入时 CAS 失败的槽位仍留在队列里，
+      // 崩溃回收会把它们释放两次。代价是 CAS 与下面这次写入之间崩溃会泄漏整批槽位，
+      // 与单条 Wait() 在出队和 HoldSlot() 之间泄漏一个槽位是同一类窗口。
+      const uint32_t next_head = (head + count) % queue_capacity_;
+      if (control.queue_head.compare_exchange_weak(
+              head, next_head, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        control.held_batch_count.store(count, std::memory_order_release);
+        ConsumeReady(control, count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          items[i].data = SlotPayload(held[i]);
+          items[i].size = slots_[held[i]].size;
+          items[i].timestamp = SlotTimestamp(held[i]);
+          items[i].origin = slots_[held[i]].origin;
+        }
+        return count;
+      }
+    }
+  }
+
+  void ReleaseHeldBatch(uint32_t subscriber_index)
+  {
+    SubscriberControl& control = subscribers_[subscriber_index];
+    const uint32_t* held = HeldBatch(subscriber_index);
+
+    // 由尾向头逐个缩短登记长度再释放，释放过程中崩溃最多泄漏一个槽位而不会重复释放。
+    // 认领时的泄漏窗口见 TryPopBatch()。
+    uint32_t count = control.held_batch_count.load(std::memory_order_acquire);
+    while (count != 0)
+    {
+      --count;
+      control.held_batch_count.store(count, std::memory_order_release);
+      ReleaseSlot(held[count]);
+    }
+  }
+
   ErrorCode DropDescriptor(uint32_t subscriber_index)
   {
     SubscriberControl& control = subscribers_[subscriber_index];
@@ -1795,22 +2606,128 @@ class LinuxSharedTopic : public Topic
     }
   }
 
-  ErrorCode PopFreeSlot(uint32_t& slot_index)
+  bool ResolveSizeClasses(
+      std::array<LinuxSharedSizeClass, LINUX_SHARED_SIZE_CLASS_NUM>& size_classes,
+      uint32_t& size_class_count, uint32_t& slot_count, uint64_t& payload_capacity) const
+  {
+    size_class_count = 0;
+    for (const LinuxSharedSizeClass& size_class : config_.size_classes)
+    {
+      if (size_class.slot_num == 0)
+      {
+        break;
+      }
+      if (size_class.capacity == 0 ||
+          (size_class_count > 0 &&
+           size_class.capacity <= size_classes[size_class_count - 1U].capacity))
+      {
+        return false;
+      }
+      size_classes[size_class_count++] = size_class;
+    }
+
+    for (uint32_t i = size_class_count; i < LINUX_SHARED_SIZE_CLASS_NUM; ++i)
+    {
+      if (config_.size_classes[i].slot_num != 0)
+      {
+        return false;
+      }
+    }
+
+    if (size_class_count == 0)
+    {
+      // 未配置规格时退化为原有的单元素定长槽位。
+      size_classes[0] = {1U, config_.slot_num};
+      size_class_count = 1;
+    }
+
+    uint64_t total_slots = 0;
+    payload_capacity = 0;
+    for (uint32_t i = 0; i < size_class_count; ++i)
+    {
+      total_slots += size_classes[i].slot_num;
+      payload_capacity +=
+          static_cast<uint64_t>(size_classes[i].capacity) * size_classes[i].slot_num;
+    }
+    if (total_slots == 0 || total_slots >= INVALID_INDEX)
+    {
+      return false;
+    }
+
+    slot_count = static_cast<uint32_t>(total_slots);
+    return true;
+  }
+
+  bool SizeClassesConsistent() const
+  {
+    const uint32_t size_class_count = header_->size_class_count;
+    if (size_class_count == 0 || size_class_count > LINUX_SHARED_SIZE_CLASS_NUM)
+    {
+      return false;
+    }
+
+    uint64_t slot_begin = 0;
+    uint64_t payload_capacity = 0;
+    for (uint32_t i = 0; i < size_class_count; ++i)
+    {
+      const SizeClassControl& control = header_->size_classes[i];
+      if (control.slot_begin != slot_begin || control.slot_count == 0)
+      {
+        return false;
+      }
+      slot_begin += control.slot_count;
+      payload_capacity += static_cast<uint64_t>(control.capacity) * control.slot_count;
+    }
+    return slot_begin == slot_count_ && payload_capacity == header_->payload_capacity;
+  }
+
+  uint32_t MaxSlotCapacity() const
+  {
+    return header_->size_classes[header_->size_class_count - 1U].capacity;
+  }
+
+  TopicData* SlotPayload(uint32_t slot_index) const
+  {
+    return payloads_ + slots_[slot_index].payload_offset;
+  }
+
+  ErrorCode PopFreeSlotFor(uint32_t size, uint32_t& slot_index)
+  {
+    // 优先取容量最小的合适规格，该档耗尽时向更大的规格借用。
+    ErrorCode pop_ans = ErrorCode::FULL;
+    for (uint32_t i = 0; i < header_->size_class_count; ++i)
+    {
+      if (header_->size_classes[i].capacity < size)
+      {
+        continue;
+      }
+      pop_ans = PopFreeSlot(header_->size_classes[i], slot_index);
+      if (pop_ans == ErrorCode::OK)
+      {
+        break;
+      }
+    }
+    return pop_ans;
+  }
+
+  ErrorCode PopFreeSlot(SizeClassControl& control, uint32_t& slot_index)
   {
+    FreeSlotCell* cells = free_slots_ + control.slot_begin;
+    const uint32_t cell_count = control.slot_count;
     while (true)
     {
-      uint64_t head = header_->free_queue_head.load(std::memory_order_relaxed);
-      FreeSlotCell& cell = free_slots_[head % slot_count_];
+      uint64_t head = control.free_queue_head.load(std::memory_order_relaxed);
+      FreeSlotCell& cell = cells[head % cell_count];
       const uint64_t seq = cell.sequence.load(std::memory_order_acquire);
       const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(head + 1U);
 
       if (diff == 0)
       {
-        if (header_->free_queue_head.compare_exchange_weak(
+        if (control.free_queue_head.compare_exchange_weak(
                 head, head + 1U, std::memory_order_acq_rel, std::memory_order_relaxed))
         {
           slot_index = cell.slot_index;
-          cell.sequence.store(head + slot_count_, std::memory_order_release);
+          cell.sequence.store(head + cell_count, std::memory_order_release);
           return ErrorCode::OK;
         }
       }
@@ -1823,19 +2740,24 @@ class LinuxSharedTopic : public Topic
 
   void RecycleSlot(uint32_t slot_index)
   {
+    slots_[slot_index].owner_publisher.store(INVALID_INDEX, std::memory_order_release);
     slots_[slot_index].sequence.store(0, std::memory_order_release);
     slots_[slot_index].timestamp_us = 0;
+    slots_[slot_index].size = 0;
 
+    SizeClassControl& control = header_->size_classes[slots_[slot_index].size_class];
+    FreeSlotCell* cells = free_slots_ + control.slot_begin;
+    const uint32_t cell_count = control.slot_count;
     while (true)
     {
-      uint64_t tail = header_->free_queue_tail.load(std::memory_order_relaxed);
-      FreeSlotCell& cell = free_slots_[tail % slot_count_];
+      uint64_t tail = control.free_queue_tail.load(std::memory_order_relaxed);
+      FreeSlotCell& cell = cells[tail % cell_count];
       const uint64_t seq = cell.sequence.load(std::memory_order_acquire);
       const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(tail);
 
       if (diff == 0)
       {
-        if (header_->free_queue_tail.compare_exchange_weak(
+        if (control.free_queue_tail.compare_exchange_weak(
                 tail, tail + 1U, std::memory_order_acq_rel, std::memory_order_relaxed))
         {
           cell.slot_index = slot_index;
@@ -1857,6 +2779,186 @@ class LinuxSharedTopic : public Topic
     }
   }
 
+  static uint64_t PackInflightState(uint32_t pending_refs, uint32_t target)
+  {
+    return (static_cast<uint64_t>(pending_refs) << 32U) | target;
+  }
+
+  void PushTrackedDescriptor(uint32_t subscriber_index, const Descriptor& descriptor,
+                             uint32_t& pending_refs)
+  {
+    if (!multi_publisher_)
+    {
+      PushDescriptor(subscriber_index, descriptor);
+      return;
+    }
+
+    // 推送前记下目标队列尾，恢复时据此判断这次推送是否已经落地。
+    header_->inflight_tail.store(
+        subscribers_[subscriber_index].queue_tail.load(std::memory_order_relaxed),
+        std::memory_order_release);
+    header_->inflight_state.store(PackInflightState(pending_refs, subscriber_index),
+                                  std::memory_order_release);
+    PushDescriptor(subscriber_index, descriptor);
+    --pending_refs;
+    header_->inflight_state.store(PackInflightState(pending_refs, INVALID_INDEX),
+                                  std::memory_order_release);
+  }
+
+  void RecoverInterruptedPublish()
+  {
+    const uint32_t slot_index = header_->inflight_slot.load(std::memory_order_acquire);
+    if (slot_index == INVALID_INDEX || slot_index >= slot_count_)
+    {
+      return;
+    }
+
+    const uint64_t state = header_->inflight_state.load(std::memory_order_acquire);
+    uint32_t pending_refs = static_cast<uint32_t>(state >> 32U);
+    const uint32_t target = static_cast<uint32_t>(state);
+    if (target != INVALID_INDEX && target < subscriber_capacity_ &&
+        subscribers_[target].queue_tail.load(std::memory_order_acquire) !=
+            header_->inflight_tail.load(std::memory_order_acquire))
+    {
+      --pending_refs;
+    }
+
+    header_->inflight_slot.store(INVALID_INDEX, std::memory_order_release);
+    slots_[slot_index].owner_publisher.store(INVALID_INDEX, std::memory_order_release);
+    for (uint32_t i = 0; i < pending_refs; ++i)
+    {
+      ReleaseSlot(slot_index);
+    }
+  }
+
+  ErrorCode LockPublish()
+  {
+    const int lock_ans = pthread_mutex_lock(&header_->publish_mutex);
+    if (lock_ans == 0)
+    {
+      return ErrorCode::OK;
+    }
+
+    if (lock_ans == EOWNERDEAD)
+    {
+      // 上一个持锁发布者在发布中途退出，先补完它留下的引用计数再恢复锁。
+      RecoverInterruptedPublish();
+      pthread_mutex_consistent(&header_->publish_mutex);
+      return ErrorCode::OK;
+    }
+
+    return ErrorCode::FAILED;
+  }
+
+  void UnlockPublish() { pthread_mutex_unlock(&header_->publish_mutex); }
+
+  ErrorCode RegisterPublisher()
+  {
+    if (self_identity_.starttime == 0)
+    {
+      return ErrorCode::STATE_ERR;
+    }
+
+    for (uint32_t i = 0; i < publisher_capacity_; ++i)
+    {
+      uint32_t expected = PUBLISHER_FREE;
+      if (publishers_[i].state.compare_exchange_strong(expected, PUBLISHER_ACTIVE,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed))
+      {
+        publishers_[i].owner_pid.store(self_identity_.pid, std::memory_order_release);
+        publishers_[i].owner_starttime.store(self_identity_.starttime,
+                                             std::memory_order_release);
+        publisher_index_ = i;
+        return ErrorCode::OK;
+      }
+    }
+    return ErrorCode::FULL;
+  }
+
+  void ScavengeDeadPublishers()
+  {
+    for (uint32_t i = 0; i < publisher_capacity_; ++i)
+    {
+      if (i == publisher_index_ ||
+          publishers_[i].state.load(std::memory_order_acquire) != PUBLISHER_ACTIVE)
+      {
+        continue;
+      }
+
+      const ProcessIdentity owner_identity = {
+          publishers_[i].owner_pid.load(std::memory_order_acquire),
+          publishers_[i].owner_starttime.load(std::memory_order_acquire),
+      };
+      if (owner_identity.pid == 0 || ProcessAlive(owner_identity))
+      {
+        continue;
+      }
+
+      ReclaimPublisher(i);
+    }
+  }
+
+  void ReclaimPublisher(uint32_t publisher_index)
+  {
+    uint32_t expected = PUBLISHER_ACTIVE;
+    if (!publishers_[publisher_index].state.compare_exchange_strong(
+            expected, PUBLISHER_RECLAIMING, std::memory_order_acq_rel,
+            std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    // 持锁扫描：若死亡发布者正持有发布锁，LockPublish() 会先回收它中断的发布。
+    if (LockPublish() == ErrorCode::OK)
+    {
+      for (uint32_t i = 0; i < slot_count_; ++i)
+      {
+        uint32_t owner = publisher_index;
+        if (slots_[i].owner_publisher.compare_exchange_strong(
+                owner, INVALID_INDEX, std::memory_order_acq_rel,
+                std::memory_order_relaxed))
+        {
+          RecycleSlot(i);
+        }
+      }
+      UnlockPublish();
+    }
+
+    publishers_[publisher_index].owner_pid.store(0, std::memory_order_release);
+    publishers_[publisher_index].owner_starttime.store(0, std::memory_order_release);
+    publishers_[publisher_index].state.store(PUBLISHER_FREE, std::memory_order_release);
+  }
+
+  static bool AnyPublisherAlive(const SharedHeader* header, const uint8_t* base,
+                                size_t mapping_size)
+  {
+    const size_t offset = PublisherTableOffset(header->topic_name_len);
+    const size_t table_bytes = sizeof(PublisherControl) * header->publisher_capacity;
+    if (offset > mapping_size || table_bytes > mapping_size - offset)
+    {
+      return false;
+    }
+
+    const auto* publishers = reinterpret_cast<const PublisherControl*>(base + offset);
+    for (uint32_t i = 0; i < header->publisher_capacity; ++i)
+    {
+      if (publishers[i].state.load(std::memory_order_acquire) == PUBLISHER_FREE)
+      {
+        continue;
+      }
+      const ProcessIdentity owner_identity = {
+          publishers[i].owner_pid.load(std::memory_order_acquire),
+          publishers[i].owner_starttime.load(std::memory_order_acquire),
+      };
+      if (owner_identity.pid == 0 || ProcessAlive(owner_identity))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
   template <bool HAS_TIMESTAMP>
   ErrorCode PublishData(SharedData& data,
                         MicrosecondTimestamp timestamp = MicrosecondTimestamp())
@@ -1866,6 +2968,26 @@ class LinuxSharedTopic : public Topic
       return ErrorCode::STATE_ERR;
     }
 
+    if (!multi_publisher_)
+    {
+      return DispatchData<HAS_TIMESTAMP>(data, timestamp);
+    }
+
+    const ErrorCode lock_ans = LockPublish();
+    if (lock_ans != ErrorCode::OK)
+    {
+      data.Reset();
+      return lock_ans;
+    }
+
+    const ErrorCode publish_ans = DispatchData<HAS_TIMESTAMP>(data, timestamp);
+    UnlockPublish();
+    return publish_ans;
+  }
+
+  template <bool HAS_TIMESTAMP>
+  ErrorCode DispatchData(SharedData& data, MicrosecondTimestamp timestamp)
+  {
     uint32_t active_count = 0;
     uint32_t balanced_target = INVALID_INDEX;
     bool has_balanced_subscriber = false;
@@ -1951,7 +3073,17 @@ class LinuxSharedTopic : public Topic
     slot.timestamp_us = ToSharedTimestamp(timestamp);
     slot.sequence.store(sequence, std::memory_order_release);
 
+    if (multi_publisher_)
+    {
+      // 先写恢复日志再放弃槽位归属，任何时刻发布者死亡都能被恰好回收一次。
+      header_->inflight_state.store(PackInflightState(active_count, INVALID_INDEX),
+                                    std::memory_order_release);
+      header_->inflight_slot.store(data.slot_index_, std::memory_order_release);
+      slot.owner_publisher.store(INVALID_INDEX, std::memory_order_release);
+    }
+
     const Descriptor descriptor = {data.slot_index_, 0U, sequence};
+    uint32_t pending_refs = active_count;
     for (uint32_t i = 0; i < subscriber_capacity_; ++i)
     {
       if (subscribers_[i].active.load(std::memory_order_acquire) == 0)
@@ -1964,12 +3096,17 @@ class LinuxSharedTopic : public Topic
       {
         continue;
       }
-      PushDescriptor(i, descriptor);
+      PushTrackedDescriptor(i, descriptor, pending_refs);
     }
 
     if (balanced_target != INVALID_INDEX)
     {
-      PushDescriptor(balanced_target, descriptor);
+      PushTrackedDescriptor(balanced_target, descriptor, pending_refs);
+    }
+
+    if (multi_publisher_)
+    {
+      header_->inflight_slot.store(INVALID_INDEX, std::memory_order_release);
     }
 
     data.topic_ = nullptr;
@@ -1993,17 +3130,25 @@ class LinuxSharedTopic : public Topic
 
   SharedHeader* header_ = nullptr;
   char* topic_name_ptr_ = nullptr;
+  PublisherControl* publishers_ = nullptr;
   SlotControl* slots_ = nullptr;
   SubscriberControl* subscribers_ = nullptr;
   BalancedGroupControl* balanced_group_ = nullptr;
   std::atomic<uint32_t>* balanced_members_ = nullptr;
   FreeSlotCell* free_slots_ = nullptr;
   Descriptor* descriptors_ = nullptr;
+  uint32_t* held_batches_ = nullptr;
   TopicData* payloads_ = nullptr;
 
   uint32_t slot_count_ = 0;
   uint32_t subscriber_capacity_ = 0;
   uint32_t queue_capacity_ = 0;
+  uint32_t publisher_capacity_ = 0;
+  uint32_t publisher_index_ = INVALID_INDEX;
+  bool multi_publisher_ = false;
+  int notify_socket_ = -1;
+  LinuxSharedWaitStrategy wait_strategy_ = LinuxSharedWaitStrategy::FUTEX;
+  uint32_t spin_count_ = 0;
 
   bool open_ok_ = false;
   ErrorCode open_status_ = ErrorCode::STATE_ERR;
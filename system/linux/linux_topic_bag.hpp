@@ -0,0 +1,1082 @@
+#pragma once
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "crc.hpp"
+#include "libxr_def.hpp"
+#include "message.hpp"
+#include "spsc_queue_base.hpp"
+#include "thread.hpp"
+
+namespace LibXR
+{
+
+/**
+ * @struct LinuxTopicBagEntry
+ * @brief 录制文件中一条消息的索引项。Index entry of one message in a bag file.
+ */
+struct LinuxTopicBagEntry
+{
+  uint32_t topic_crc32 = 0;   ///< 主题名 CRC32，与 `Topic::GetKey()` 一致。Topic-name
+                              ///< CRC32, identical to `Topic::GetKey()`.
+  uint32_t size = 0;          ///< payload 字节数。Payload size in bytes.
+  uint64_t timestamp_us = 0;  ///< 原始消息时间戳。Original message timestamp.
+  uint64_t sequence = 0;      ///< 录制源内的消息序号。Message sequence within its source.
+  uint64_t offset = 0;        ///< 记录在文件中的偏移。Record offset in the file.
+};
+
+/**
+ * @class LinuxTopicBagWriter
+ * @brief 基于内存映射的追加式录制文件写入器。Memory-mapped append-only bag file writer.
+ *
+ * 文件由固定文件头、按 16 字节对齐的消息记录和关闭时追加的索引组成。映射区按
+ * `chunk_bytes` 成块预分配并通过 `mremap` 增长，追加一条消息只是一次内存拷贝。
+ * 文件头里的 `data_end` 在每条记录写完后更新，进程异常退出时读取器可以按记录重建索引。
+ *
+ * The file consists of a fixed header, 16-byte aligned message records, and an index
+ * appended on close. The mapping is preallocated in `chunk_bytes` blocks and grown with
+ * `mremap`, so appending a message is a single memory copy. `data_end` in the header is
+ * updated after each record, so a reader can rebuild the index from records if the
+ * process exits abnormally.
+ */
+class LinuxTopicBagWriter
+{
+ public:
+  static constexpr size_t DEFAULT_CHUNK_BYTES = 64U * 1024U * 1024U;
+
+  /**
+   * @brief 创建或截断录制文件。Create or truncate a bag file.
+   * @param path 文件路径。File path.
+   * @param chunk_bytes 每次扩展映射的字节数。Bytes added per mapping extension.
+   */
+  explicit LinuxTopicBagWriter(const char* path,
+                               size_t chunk_bytes = DEFAULT_CHUNK_BYTES)
+  {
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    chunk_bytes_ = AlignUp(std::max(chunk_bytes, page_size), page_size);
+
+    fd_ = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+    {
+      error_ = ErrorCode::INIT_ERR;
+      return;
+    }
+
+    error_ = Reserve(sizeof(FileHeader));
+    if (error_ != ErrorCode::OK)
+    {
+      Release();
+      (void)TruncateAndClose(0);
+      return;
+    }
+
+    FileHeader* header = Header();
+    std::memcpy(header->magic, FILE_MAGIC, sizeof(header->magic));
+    header->version = VERSION;
+    header->header_size = sizeof(FileHeader);
+    header->data_end = sizeof(FileHeader);
+    end_ = sizeof(FileHeader);
+  }
+
+  ~LinuxTopicBagWriter() { (void)Close(); }
+
+  LinuxTopicBagWriter(const LinuxTopicBagWriter&) = delete;
+  LinuxTopicBagWriter& operator=(const LinuxTopicBagWriter&) = delete;
+
+  /**
+   * @brief 检查写入器是否可用。Check whether the writer is usable.
+   */
+  bool Valid() const { return base_ != nullptr; }
+
+  /**
+   * @brief 获取打开失败原因。Get the open failure reason.
+   */
+  ErrorCode GetError() const { return error_; }
+
+  /**
+   * @brief 追加一条消息。Append one message.
+   * @param topic_crc32 主题名 CRC32。Topic-name CRC32.
+   * @param timestamp 消息时间戳。Message timestamp.
+   * @param sequence 消息序号。Message sequence.
+   * @param payload payload 字节。Payload bytes.
+   * @return 错误码；磁盘空间不足时返回 `NO_MEM`。Error code; `NO_MEM` when disk space
+   * runs out.
+   */
+  ErrorCode Append(uint32_t topic_crc32, MicrosecondTimestamp timestamp,
+                   uint64_t sequence, ConstRawData payload)
+  {
+    if (!Valid())
+    {
+      return ErrorCode::STATE_ERR;
+    }
+    if (payload.size_ > UINT32_MAX || (payload.size_ != 0 && payload.addr_ == nullptr))
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    const size_t record_bytes =
+        AlignUp(sizeof(RecordHeader) + payload.size_, RECORD_ALIGN);
+    const ErrorCode reserve_ans = Reserve(end_ + record_bytes);
+    if (reserve_ans != ErrorCode::OK)
+    {
+      return reserve_ans;
+    }
+
+    auto* record = reinterpret_cast<RecordHeader*>(base_ + end_);
+    record->magic = RECORD_MAGIC;
+    record->topic_crc32 = topic_crc32;
+    record->size = static_cast<uint32_t>(payload.size_);
+    record->reserved = 0;
+    record->timestamp_us = static_cast<uint64_t>(timestamp);
+    record->sequence = sequence;
+    if (payload.size_ != 0)
+    {
+      std::memcpy(record + 1, payload.addr_, payload.size_);
+    }
+
+    index_.push_back({topic_crc32, static_cast<uint32_t>(payload.size_),
+                      record->timestamp_us, sequence, end_});
+    end_ += record_bytes;
+    const uint64_t record_count =
+        record_count_.fetch_add(1, std::memory_order_relaxed) + 1U;
+
+    FileHeader* header = Header();
+    header->record_count = record_count;
+    header->data_end = end_;
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 写入索引并关闭文件；可重复调用。Write the index and close the file; safe to
+   * call repeatedly.
+   */
+  ErrorCode Close()
+  {
+    if (!Valid())
+    {
+      return error_;
+    }
+
+    const size_t index_bytes = index_.size() * sizeof(LinuxTopicBagEntry);
+    ErrorCode ans = Reserve(end_ + index_bytes);
+    if (ans == ErrorCode::OK)
+    {
+      if (index_bytes != 0)
+      {
+        std::memcpy(base_ + end_, index_.data(), index_bytes);
+      }
+      FileHeader* header = Header();
+      header->index_offset = end_;
+      header->index_count = index_.size();
+    }
+
+    const size_t file_bytes = (ans == ErrorCode::OK) ? end_ + index_bytes : end_;
+    Release();
+    index_.clear();
+    index_.shrink_to_fit();
+    const ErrorCode close_ans = TruncateAndClose(file_bytes);
+    error_ = (ans != ErrorCode::OK) ? ans : close_ans;
+    return error_;
+  }
+
+  /**
+   * @brief 获取已追加消息数。Get the number of appended messages.
+   */
+  uint64_t GetRecordNum() const { return record_count_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 获取已写入的记录区字节数。Get the bytes written to the record area.
+   */
+  uint64_t GetBytes() const { return end_; }
+
+ private:
+  friend class LinuxTopicBagReader;
+
+  static constexpr char FILE_MAGIC[8] = {'L', 'X', 'R', 'B', 'A', 'G', '\0', '\0'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint32_t RECORD_MAGIC = 0x43455242U;  // "BREC"
+  static constexpr size_t RECORD_ALIGN = 16;
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t record_count;
+    uint64_t data_end;
+    uint64_t index_offset;
+    uint64_t index_count;
+    uint64_t reserved[2];
+  };
+
+  struct RecordHeader
+  {
+    uint32_t magic;
+    uint32_t topic_crc32;
+    uint32_t size;
+    uint32_t reserved;
+    uint64_t timestamp_us;
+    uint64_t sequence;
+  };
+
+  static_assert(sizeof(FileHeader) % RECORD_ALIGN == 0);
+  static_assert(sizeof(RecordHeader) % RECORD_ALIGN == 0);
+
+  static size_t AlignUp(size_t value, size_t align)
+  {
+    return (value + align - 1U) / align * align;
+  }
+
+  FileHeader* Header() { return reinterpret_cast<FileHeader*>(base_); }
+
+  ErrorCode Reserve(size_t bytes)
+  {
+    if (bytes <= mapped_)
+    {
+      return ErrorCode::OK;
+    }
+
+    const size_t new_size = AlignUp(bytes, chunk_bytes_);
+    const int alloc_ans = posix_fallocate(fd_, static_cast<off_t>(mapped_),
+                                          static_cast<off_t>(new_size - mapped_));
+    if (alloc_ans == ENOSPC)
+    {
+      return ErrorCode::NO_MEM;
+    }
+    // 不支持预分配的文件系统退回稀疏扩展。Fall back to a sparse extension on file
+    // systems without preallocation.
+    if (alloc_ans != 0 && ftruncate(fd_, static_cast<off_t>(new_size)) != 0)
+    {
+      return ErrorCode::FAILED;
+    }
+
+    void* mapping =
+        (base_ == nullptr)
+            ? mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+            : mremap(base_, mapped_, new_size, MREMAP_MAYMOVE);
+    if (mapping == MAP_FAILED)
+    {
+      return ErrorCode::NO_MEM;
+    }
+
+    base_ = static_cast<uint8_t*>(mapping);
+    mapped_ = new_size;
+    return ErrorCode::OK;
+  }
+
+  void Release()
+  {
+    if (base_ != nullptr)
+    {
+      munmap(base_, mapped_);
+      base_ = nullptr;
+      mapped_ = 0;
+    }
+  }
+
+  ErrorCode TruncateAndClose(size_t file_bytes)
+  {
+    ErrorCode ans = ErrorCode::OK;
+    if (fd_ >= 0)
+    {
+      if (ftruncate(fd_, static_cast<off_t>(file_bytes)) != 0)
+      {
+        ans = ErrorCode::FAILED;
+      }
+      close(fd_);
+      fd_ = -1;
+    }
+    return ans;
+  }
+
+  int fd_ = -1;
+  uint8_t* base_ = nullptr;
+  size_t mapped_ = 0;
+  size_t end_ = 0;
+  std::atomic<uint64_t> record_count_ = 0;
+  size_t chunk_bytes_ = DEFAULT_CHUNK_BYTES;
+  ErrorCode error_ = ErrorCode::OK;
+  std::vector<LinuxTopicBagEntry> index_;
+};
+
+/**
+ * @class LinuxTopicBagReader
+ * @brief 录制文件只读访问器。Read-only accessor for bag files.
+ *
+ * 文件以私有写时复制方式映射，回放时可以直接把 payload 地址交给订阅者而不修改文件。
+ * 未正常关闭的文件没有索引，读取器按 `data_end` 之前的记录重建索引。
+ *
+ * The file is mapped private copy-on-write, so replay can hand payload addresses to
+ * subscribers directly without modifying the file. Files that were not closed cleanly
+ * have no index, and the reader rebuilds it from the records before `data_end`.
+ */
+class LinuxTopicBagReader
+{
+ public:
+  /**
+   * @brief 打开录制文件。Open a bag file.
+   * @param path 文件路径。File path.
+   */
+  explicit LinuxTopicBagReader(const char* path)
+  {
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+      error_ = ErrorCode::NOT_FOUND;
+      return;
+    }
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader))
+    {
+      close(fd);
+      error_ = ErrorCode::CHECK_ERR;
+      return;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      size_ = 0;
+      error_ = ErrorCode::NO_MEM;
+      return;
+    }
+    base_ = static_cast<uint8_t*>(mapping);
+
+    error_ = LoadIndex();
+    if (error_ != ErrorCode::OK)
+    {
+      munmap(base_, size_);
+      base_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  ~LinuxTopicBagReader()
+  {
+    if (base_ != nullptr)
+    {
+      munmap(base_, size_);
+    }
+  }
+
+  LinuxTopicBagReader(const LinuxTopicBagReader&) = delete;
+  LinuxTopicBagReader& operator=(const LinuxTopicBagReader&) = delete;
+
+  /**
+   * @brief 检查文件是否成功打开。Check whether the file opened successfully.
+   */
+  bool Valid() const { return base_ != nullptr; }
+
+  /**
+   * @brief 获取打开失败原因。Get the open failure reason.
+   */
+  ErrorCode GetError() const { return error_; }
+
+  /**
+   * @brief 索引是否取自正常关闭文件且逐项校验通过；否则索引由逐条扫描记录重建。
+   * Whether the index came from a cleanly closed file and every entry passed
+   * validation; otherwise it was rebuilt by scanning the records.
+   */
+  bool Complete() const { return complete_; }
+
+  /**
+   * @brief 获取消息条数。Get the number of messages.
+   */
+  size_t Size() const { return index_.size(); }
+
+  /**
+   * @brief 获取第 `index` 条消息的索引项（文件顺序）。Get the index entry of message
+   * `index` in file order.
+   */
+  const LinuxTopicBagEntry& Entry(size_t index) const
+  {
+    ASSERT(index < index_.size());
+    return index_[index];
+  }
+
+  /**
+   * @brief 获取第 `index` 条消息的 payload，16 字节对齐。Get the payload of message
+   * `index`, 16-byte aligned.
+   */
+  ConstRawData Payload(size_t index) const
+  {
+    const LinuxTopicBagEntry& entry = Entry(index);
+    return ConstRawData(base_ + entry.offset + sizeof(RecordHeader), entry.size);
+  }
+
+ private:
+  using FileHeader = LinuxTopicBagWriter::FileHeader;
+  using RecordHeader = LinuxTopicBagWriter::RecordHeader;
+
+  ErrorCode LoadIndex()
+  {
+    const auto* header = reinterpret_cast<const FileHeader*>(base_);
+    if (std::memcmp(header->magic, LinuxTopicBagWriter::FILE_MAGIC,
+                    sizeof(header->magic)) != 0 ||
+        header->version != LinuxTopicBagWriter::VERSION ||
+        header->header_size != sizeof(FileHeader))
+    {
+      return ErrorCode::CHECK_ERR;
+    }
+
+    const uint64_t index_count = header->index_count;
+    if (header->index_offset != 0 && header->index_offset <= size_ &&
+        index_count <= (size_ - header->index_offset) / sizeof(LinuxTopicBagEntry))
+    {
+      index_.resize(index_count);
+      if (index_count != 0)
+      {
+        std::memcpy(index_.data(), base_ + header->index_offset,
+                    index_count * sizeof(LinuxTopicBagEntry));
+      }
+      // 索引项之后会被直接用来寻址，任何一项越界或对不上记录都改走逐条扫描。
+      // Index entries are used for addressing directly, so any entry that is out of
+      // range or does not match its record falls back to the record scan.
+      complete_ = std::all_of(index_.begin(), index_.end(),
+                              [&](const LinuxTopicBagEntry& entry)
+                              { return EntryValid(entry, header->index_offset); });
+      if (complete_)
+      {
+        return ErrorCode::OK;
+      }
+      index_.clear();
+    }
+
+    const size_t data_end = std::min<size_t>(header->data_end, size_);
+    size_t offset = sizeof(FileHeader);
+    while (offset + sizeof(RecordHeader) <= data_end)
+    {
+      const auto* record = reinterpret_cast<const RecordHeader*>(base_ + offset);
+      const size_t record_bytes = LinuxTopicBagWriter::AlignUp(
+          sizeof(RecordHeader) + record->size, LinuxTopicBagWriter::RECORD_ALIGN);
+      if (record->magic != LinuxTopicBagWriter::RECORD_MAGIC ||
+          record_bytes > data_end - offset)
+      {
+        break;
+      }
+      index_.push_back({record->topic_crc32, record->size, record->timestamp_us,
+                        record->sequence, offset});
+      offset += record_bytes;
+    }
+    return ErrorCode::OK;
+  }
+
+  bool EntryValid(const LinuxTopicBagEntry& entry, uint64_t data_end) const
+  {
+    if (entry.offset < sizeof(FileHeader) || entry.offset > data_end ||
+        entry.offset % LinuxTopicBagWriter::RECORD_ALIGN != 0 ||
+        data_end - entry.offset < sizeof(RecordHeader) ||
+        entry.size > data_end - entry.offset - sizeof(RecordHeader))
+    {
+      return false;
+    }
+    const auto* record = reinterpret_cast<const RecordHeader*>(base_ + entry.offset);
+    return record->magic == LinuxTopicBagWriter::RECORD_MAGIC &&
+           record->size == entry.size;
+  }
+
+  uint8_t* base_ = nullptr;
+  size_t size_ = 0;
+  bool complete_ = false;
+  ErrorCode error_ = ErrorCode::OK;
+  std::vector<LinuxTopicBagEntry> index_;
+};
+
+/**
+ * @class LinuxTopicBagRecorder
+ * @brief 把一组共享 Topic 和进程内 Topic 录制到文件。Record a set of shared topics and
+ * in-process topics to a bag file.
+ *
+ * 共享 Topic 以 `BROADCAST_DROP_OLD` 订阅者接入并批量取出，进程内 Topic 通过回调把
+ * 消息拷入单生产者队列；两种接入都不会阻塞发布者，跟不上时丢弃的消息计入
+ * `GetDroppedNum()`。录制线程在空闲时通过就绪通知描述符等待共享 Topic。
+ *
+ * Shared topics are attached as `BROADCAST_DROP_OLD` subscribers and drained in
+ * batches; in-process topics copy messages into a single-producer queue from a
+ * callback. Neither path blocks publishers, and messages dropped while the recorder
+ * falls behind are counted by `GetDroppedNum()`. While idle, the recording thread waits
+ * for shared topics on their readiness notification descriptors.
+ *
+ * @note 关闭时进程内 Topic 的回调会被注销，录制器可以随后安全销毁。
+ *       Closing unregisters the in-process topic callbacks, so the recorder may be
+ *       destroyed safely afterwards.
+ */
+class LinuxTopicBagRecorder
+{
+ public:
+  static constexpr uint32_t DEFAULT_BATCH_SIZE = 32;
+  static constexpr size_t DEFAULT_QUEUE_DEPTH = 256;
+
+  /**
+   * @brief 创建录制器和录制文件。Create the recorder and its bag file.
+   * @param path 文件路径。File path.
+   * @param chunk_bytes 写入器每次扩展映射的字节数。Bytes per writer mapping extension.
+   */
+  explicit LinuxTopicBagRecorder(
+      const char* path, size_t chunk_bytes = LinuxTopicBagWriter::DEFAULT_CHUNK_BYTES)
+      : writer_(path, chunk_bytes)
+  {
+  }
+
+  ~LinuxTopicBagRecorder() { (void)Close(); }
+
+  LinuxTopicBagRecorder(const LinuxTopicBagRecorder&) = delete;
+  LinuxTopicBagRecorder& operator=(const LinuxTopicBagRecorder&) = delete;
+
+  /**
+   * @brief 检查录制文件是否可写。Check whether the bag file is writable.
+   */
+  bool Valid() const { return writer_.Valid(); }
+
+  /**
+   * @brief 录制一个已存在的共享 Topic。Record an existing shared topic.
+   * @param topic_name 主题名称。Topic name.
+   * @param batch_size 每次批量取出的最大消息数。Maximum messages per batch.
+   * @return 错误码；主题不存在或订阅者已满时返回 `NOT_FOUND`。Error code; `NOT_FOUND`
+   * when the topic does not exist or has no free subscriber entry.
+   */
+  template <typename Data>
+  ErrorCode AddSharedTopic(const char* topic_name,
+                           uint32_t batch_size = DEFAULT_BATCH_SIZE)
+  {
+    if (!Valid() || running_.load(std::memory_order_acquire))
+    {
+      return ErrorCode::STATE_ERR;
+    }
+    if (topic_name == nullptr || batch_size == 0)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    auto source = std::make_unique<SharedSource<Data>>(topic_name, batch_size);
+    const ErrorCode ans = source->Init();
+    if (ans != ErrorCode::OK)
+    {
+      return ans;
+    }
+    sources_.push_back(std::move(source));
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 录制一个进程内 Topic。Record an in-process topic.
+   * @param topic 目标 Topic。Target topic.
+   * @param queue_depth 发布路径与录制线程之间的队列深度。Queue depth between the
+   * publish path and the recording thread.
+   */
+  ErrorCode AddTopic(Topic topic, size_t queue_depth = DEFAULT_QUEUE_DEPTH)
+  {
+    if (!Valid() || running_.load(std::memory_order_acquire))
+    {
+      return ErrorCode::STATE_ERR;
+    }
+    if (static_cast<Topic::TopicHandle>(topic) == nullptr || queue_depth == 0)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    sources_.push_back(std::make_unique<TopicSource>(topic, queue_depth, dropped_));
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 把所有录制源当前积压的消息写入文件。Write every message currently pending
+   * in all sources to the file.
+   * @return 本次写入的消息数。Number of messages written by this call.
+   * @note 录制线程运行时由线程调用。Called by the recording thread while it runs.
+   */
+  size_t Poll()
+  {
+    size_t written = 0;
+    for (auto& source : sources_)
+    {
+      written += source->Drain(writer_, dropped_);
+    }
+    return written;
+  }
+
+  /**
+   * @brief 启动后台录制线程。Start the background recording thread.
+   * @param priority 线程优先级。Thread priority.
+   */
+  ErrorCode Start(Thread::Priority priority = Thread::Priority::HIGH)
+  {
+    if (!Valid() || running_.load(std::memory_order_acquire))
+    {
+      return ErrorCode::STATE_ERR;
+    }
+
+    poll_fds_.clear();
+    for (auto& source : sources_)
+    {
+      if (source->NotifyFd() >= 0)
+      {
+        poll_fds_.push_back({source->NotifyFd(), POLLIN, 0});
+      }
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_.Create<LinuxTopicBagRecorder*>(this, ThreadMain, "bag_recorder", 64 * 1024,
+                                           priority);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 停止后台录制线程并写完积压消息。Stop the background thread and flush pending
+   * messages.
+   */
+  ErrorCode Stop()
+  {
+    if (!running_.exchange(false, std::memory_order_acq_rel))
+    {
+      return ErrorCode::OK;
+    }
+    return thread_.Join();
+  }
+
+  /**
+   * @brief 停止录制、断开所有录制源并关闭文件。Stop recording, detach every source, and
+   * close the file.
+   */
+  ErrorCode Close()
+  {
+    (void)Stop();
+    for (auto& source : sources_)
+    {
+      source->Detach();
+    }
+    (void)Poll();
+    sources_.clear();
+    return writer_.Close();
+  }
+
+  /**
+   * @brief 获取已写入文件的消息数。Get the number of messages written to the file.
+   */
+  uint64_t GetRecordNum() const { return writer_.GetRecordNum(); }
+
+  /**
+   * @brief 获取因录制跟不上或写入失败而丢弃的消息数。Get the number of messages dropped
+   * because the recorder fell behind or a write failed.
+   */
+  uint64_t GetDroppedNum() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr int IDLE_WAIT_MS = 1;
+
+  class Source
+  {
+   public:
+    virtual ~Source() = default;
+    virtual size_t Drain(LinuxTopicBagWriter& writer,
+                         std::atomic<uint64_t>& dropped) = 0;
+    virtual int NotifyFd() const { return -1; }
+    virtual void Arm() {}
+    virtual void Detach() {}
+  };
+
+  template <typename Data>
+  class SharedSource : public Source
+  {
+   public:
+    using SharedTopic = LinuxSharedTopic<Data>;
+
+    SharedSource(const char* topic_name, uint32_t batch_size)
+        : subscriber_(topic_name, LinuxSharedSubscriberMode::BROADCAST_DROP_OLD),
+          topic_crc32_(CRC32::Calculate(topic_name, strlen(topic_name))),
+          items_(batch_size)
+    {
+    }
+
+    ErrorCode Init()
+    {
+      if (!subscriber_.Valid())
+      {
+        return ErrorCode::NOT_FOUND;
+      }
+      return subscriber_.EnableNotify();
+    }
+
+    size_t Drain(LinuxTopicBagWriter& writer, std::atomic<uint64_t>& dropped) override
+    {
+      size_t written = 0;
+      uint32_t count = 0;
+      while (subscriber_.WaitBatch(items_, count, 0) == ErrorCode::OK)
+      {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          const auto& item = items_[i];
+          const ConstRawData payload(item.data, item.size * sizeof(Data));
+          if (writer.Append(topic_crc32_, item.timestamp, item.sequence, payload) ==
+              ErrorCode::OK)
+          {
+            ++written;
+          }
+          else
+          {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+        if (count < items_.size())
+        {
+          break;
+        }
+      }
+      subscriber_.ReleaseBatch();
+
+      // 丢最旧模式下被覆盖的消息由共享订阅者自己计数。
+      // Messages overwritten in drop-old mode are counted by the shared subscriber.
+      const uint64_t drop_num = subscriber_.GetDropNum();
+      dropped.fetch_add(drop_num - reported_drop_num_, std::memory_order_relaxed);
+      reported_drop_num_ = drop_num;
+      return written;
+    }
+
+    int NotifyFd() const override { return subscriber_.GetNotifyFd(); }
+
+    void Arm() override { subscriber_.RearmNotify(); }
+
+   private:
+    typename SharedTopic::SyncSubscriber subscriber_;
+    uint32_t topic_crc32_ = 0;
+    uint64_t reported_drop_num_ = 0;
+    std::vector<typename SharedTopic::BatchItem> items_;
+  };
+
+  class TopicSource : public Source
+  {
+   public:
+    TopicSource(Topic topic, size_t queue_depth, std::atomic<uint64_t>& dropped)
+        : topic_(topic),
+          topic_crc32_(topic.GetKey()),
+          payload_size_(topic.PayloadSize()),
+          queue_(sizeof(uint64_t) + payload_size_, queue_depth),
+          dropped_(dropped),
+          callback_(Topic::Callback::Create(OnPublish, this))
+    {
+      topic_.RegisterCallback(callback_);
+      attached_ = true;
+    }
+
+    ~TopicSource() override { Detach(); }
+
+    size_t Drain(LinuxTopicBagWriter& writer, std::atomic<uint64_t>& dropped) override
+    {
+      const size_t pending = queue_.Size();
+      size_t written = 0;
+      (void)queue_.PopBytesWithReader(
+          pending,
+          [&](const void* chunk, size_t count)
+          {
+            const auto* element = static_cast<const uint8_t*>(chunk);
+            const size_t stride = sizeof(uint64_t) + payload_size_;
+            for (size_t i = 0; i < count; ++i, element += stride)
+            {
+              uint64_t timestamp_us = 0;
+              std::memcpy(&timestamp_us, element, sizeof(timestamp_us));
+              const ConstRawData payload(element + sizeof(uint64_t), payload_size_);
+              if (writer.Append(topic_crc32_, MicrosecondTimestamp(timestamp_us),
+                                ++sequence_, payload) == ErrorCode::OK)
+              {
+                ++written;
+              }
+              else
+              {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+            return ErrorCode::OK;
+          });
+      return written;
+    }
+
+    void Detach() override
+    {
+      if (!attached_)
+      {
+        return;
+      }
+      // 注销返回后不会再有发布者进入 OnPublish。
+      // Once unregistering returns no publisher can enter OnPublish any more.
+      (void)topic_.UnregisterCallback(callback_);
+      attached_ = false;
+    }
+
+   private:
+    static void OnPublish(bool, TopicSource* self, Topic::RawMessageView message)
+    {
+      const ErrorCode ans = self->queue_.PushBytesWithWriter(
+          1,
+          [&](void* element, size_t)
+          {
+            const uint64_t timestamp_us = static_cast<uint64_t>(message.timestamp);
+            auto* bytes = static_cast<uint8_t*>(element);
+            std::memcpy(bytes, &timestamp_us, sizeof(timestamp_us));
+            std::memcpy(bytes + sizeof(timestamp_us), message.payload.addr_,
+                        message.payload.size_);
+            return ErrorCode::OK;
+          });
+      if (ans != ErrorCode::OK)
+      {
+        self->dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    Topic topic_;
+    uint32_t topic_crc32_ = 0;
+    size_t payload_size_ = 0;
+    uint64_t sequence_ = 0;
+    SPSCQueueBase queue_;
+    std::atomic<uint64_t>& dropped_;
+    Topic::Callback callback_;
+    bool attached_ = false;
+  };
+
+  static void ThreadMain(LinuxTopicBagRecorder* self)
+  {
+    while (self->running_.load(std::memory_order_acquire))
+    {
+      if (self->Poll() != 0)
+      {
+        continue;
+      }
+
+      // 先挂起通知再取一次，避免挂起前到达的消息被错过。
+      for (auto& source : self->sources_)
+      {
+        source->Arm();
+      }
+      if (self->Poll() != 0)
+      {
+        continue;
+      }
+
+      if (self->poll_fds_.empty())
+      {
+        Thread::Sleep(IDLE_WAIT_MS);
+      }
+      else
+      {
+        (void)poll(self->poll_fds_.data(), self->poll_fds_.size(), IDLE_WAIT_MS);
+      }
+    }
+    (void)self->Poll();
+  }
+
+  LinuxTopicBagWriter writer_;
+  std::vector<std::unique_ptr<Source>> sources_;
+  std::vector<pollfd> poll_fds_;
+  std::atomic<bool> running_{false};
+  std::atomic<uint64_t> dropped_{0};
+  Thread thread_;
+};
+
+/**
+ * @class LinuxTopicBagPlayer
+ * @brief 按原始时间间隔回放录制文件。Replay a bag file with its original timing.
+ *
+ * 消息按时间戳排序后依次发布到按主题 CRC32 注册的目标；`rate` 为回放倍速，
+ * 小于等于 0 时不做节拍控制，尽快发布。
+ *
+ * Messages are sorted by timestamp and published in turn to targets registered by topic
+ * CRC32; `rate` is the playback speed factor, and values not greater than 0 disable
+ * pacing and publish as fast as possible.
+ */
+class LinuxTopicBagPlayer
+{
+ public:
+  /**
+   * @brief 基于已打开的录制文件构造回放器。Construct a player over an opened bag file.
+   * @param reader 录制文件读取器，需比回放器存活更久。Bag reader that must outlive the
+   * player.
+   */
+  explicit LinuxTopicBagPlayer(const LinuxTopicBagReader& reader) : reader_(reader) {}
+
+  /**
+   * @brief 把某主题的消息回放到共享 Topic。Replay one topic's messages into a shared
+   * topic.
+   * @param topic_name 录制时的主题名称。Topic name used when recording.
+   * @param publisher 发布者模式打开的共享 Topic。Shared topic opened as publisher.
+   */
+  template <typename Data>
+  ErrorCode AddSharedTopic(const char* topic_name, LinuxSharedTopic<Data>& publisher)
+  {
+    if (topic_name == nullptr || !publisher.Valid())
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    targets_.push_back({CRC32::Calculate(topic_name, strlen(topic_name)), &publisher,
+                        [](void* context, MicrosecondTimestamp timestamp,
+                           ConstRawData payload)
+                        {
+                          if (payload.size_ == 0 || payload.size_ % sizeof(Data) != 0)
+                          {
+                            return ErrorCode::SIZE_ERR;
+                          }
+                          return static_cast<LinuxSharedTopic<Data>*>(context)->Publish(
+                              static_cast<const Data*>(payload.addr_),
+                              static_cast<uint32_t>(payload.size_ / sizeof(Data)),
+                              timestamp);
+                        }});
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 把同名主题的消息回放到进程内 Topic。Replay messages of the same-named topic
+   * into an in-process topic.
+   */
+  ErrorCode AddTopic(Topic topic)
+  {
+    Topic::TopicHandle handle = topic;
+    if (handle == nullptr)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    targets_.push_back({topic.GetKey(), handle,
+                        [](void* context, MicrosecondTimestamp timestamp,
+                           ConstRawData payload)
+                        {
+                          Topic target(static_cast<Topic::TopicHandle>(context));
+                          if (payload.size_ != target.PayloadSize())
+                          {
+                            return ErrorCode::SIZE_ERR;
+                          }
+                          if (reinterpret_cast<uintptr_t>(payload.addr_) %
+                                  target.PayloadAlignment() !=
+                              0)
+                          {
+                            return ErrorCode::NOT_SUPPORT;
+                          }
+                          target.PublishBytesFromServer(const_cast<void*>(payload.addr_),
+                                                        payload.size_, timestamp);
+                          return ErrorCode::OK;
+                        }});
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 回放整个文件。Replay the whole file.
+   * @param rate 回放倍速。Playback speed factor.
+   * @return 错误码。Error code.
+   */
+  ErrorCode Play(double rate = 1.0)
+  {
+    if (!reader_.Valid())
+    {
+      return ErrorCode::STATE_ERR;
+    }
+
+    std::vector<uint32_t> order(reader_.Size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t lhs, uint32_t rhs)
+                     {
+                       return reader_.Entry(lhs).timestamp_us <
+                              reader_.Entry(rhs).timestamp_us;
+                     });
+
+    const uint64_t wall_start_us = MonotonicTime::NowMicroseconds();
+    const uint64_t bag_start_us =
+        order.empty() ? 0 : reader_.Entry(order[0]).timestamp_us;
+
+    for (const uint32_t index : order)
+    {
+      const LinuxTopicBagEntry& entry = reader_.Entry(index);
+      if (rate > 0.0)
+      {
+        const uint64_t due_us =
+            wall_start_us +
+            static_cast<uint64_t>(static_cast<double>(entry.timestamp_us - bag_start_us) /
+                                  rate);
+        SleepUntil(due_us);
+      }
+
+      const Target* target = FindTarget(entry.topic_crc32);
+      if (target == nullptr ||
+          target->publish(target->context, MicrosecondTimestamp(entry.timestamp_us),
+                          reader_.Payload(index)) != ErrorCode::OK)
+      {
+        ++skipped_;
+        continue;
+      }
+      ++published_;
+    }
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 获取已回放的消息数。Get the number of replayed messages.
+   */
+  uint64_t GetPublishedNum() const { return published_; }
+
+  /**
+   * @brief 获取因无目标或发布失败而跳过的消息数。Get the number of messages skipped
+   * because no target matched or publishing failed.
+   */
+  uint64_t GetSkippedNum() const { return skipped_; }
+
+ private:
+  struct Target
+  {
+    uint32_t topic_crc32;
+    void* context;
+    ErrorCode (*publish)(void* context, MicrosecondTimestamp timestamp,
+                         ConstRawData payload);
+  };
+
+  const Target* FindTarget(uint32_t topic_crc32) const
+  {
+    for (const auto& target : targets_)
+    {
+      if (target.topic_crc32 == topic_crc32)
+      {
+        return &target;
+      }
+    }
+    return nullptr;
+  }
+
+  static void SleepUntil(uint64_t due_us)
+  {
+    const uint64_t now_us = MonotonicTime::NowMicroseconds();
+    if (due_us <= now_us)
+    {
+      return;
+    }
+    const uint64_t wait_us = due_us - now_us;
+    timespec ts = {};
+    ts.tv_sec = static_cast<time_t>(wait_us / 1000000ULL);
+    ts.tv_nsec = static_cast<long>(wait_us % 1000000ULL) * 1000L;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+  }
+
+  const LinuxTopicBagReader& reader_;
+  std::vector<Target> targets_;
+  uint64_t published_ = 0;
+  uint64_t skipped_ = 0;
+};
+
+}  // namespace LibXR
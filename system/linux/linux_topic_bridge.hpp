@@ -0,0 +1,526 @@
+#pragma once
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "libxr_def.hpp"
+#include "message.hpp"
+#include "thread.hpp"
+
+namespace LibXR
+{
+
+/**
+ * @struct LinuxTopicBridgeStats
+ * @brief 桥接器吞吐计数快照。Throughput counter snapshot of a topic bridge.
+ */
+struct LinuxTopicBridgeStats
+{
+  uint64_t exported = 0;        ///< 写入共享内存的消息数。Messages written to shared
+                                ///< memory.
+  uint64_t exported_bytes = 0;  ///< 写入共享内存的 payload 字节数。Payload bytes written
+                                ///< to shared memory.
+  uint64_t imported = 0;        ///< 发布到进程内 Topic 的消息数。Messages published to
+                                ///< in-process topics.
+  uint64_t imported_bytes = 0;  ///< 发布到进程内 Topic 的 payload 字节数。Payload bytes
+                                ///< published to in-process topics.
+  uint64_t export_failed = 0;   ///< 没拿到共享槽位或共享订阅者队列满而导出失败的消息数。
+                                ///< Messages that failed to export because no shared
+                                ///< slot was free or a shared subscriber queue was full.
+  uint64_t import_dropped = 0;  ///< 桥接器跟不上或元素个数不符而丢掉的共享消息数。
+                                ///< Shared messages dropped because the bridge fell
+                                ///< behind or the element count did not match.
+  uint64_t loop_suppressed = 0;  ///< 为防止回环而没有转发的消息数。Messages not
+                                 ///< forwarded to prevent a loop.
+};
+
+/**
+ * @class LinuxTopicBridge
+ * @brief 在一个 `Topic::Domain` 的进程内 Topic 与同域共享 Topic 之间转发消息。Forward
+ * messages between the in-process topics of one `Topic::Domain` and the shared topics
+ * of the same domain.
+ *
+ * 导出方向在进程内 Topic 上挂回调，用 `CreateData()` 取共享槽位后把 payload 直接写进
+ * 槽位再发布，每条消息只拷贝一次。导入方向以 `BROADCAST_DROP_OLD` 订阅者接入共享
+ * Topic，由桥接线程批量取出后用 `PublishBatch()` 发布到进程内 Topic。
+ * The export direction hooks a callback onto the in-process topic, takes a shared slot
+ * with `CreateData()`, writes the payload straight into it, and publishes it, so each
+ * message is copied once. The import direction attaches a `BROADCAST_DROP_OLD`
+ * subscriber to the shared topic; the bridge thread drains it in batches and publishes
+ * into the in-process topic with `PublishBatch()`.
+ *
+ * 防环规则：导出的消息带上本桥接器的来源标记，导入时跳过自己发出的消息；任何桥接器
+ * 导入时发布到进程内 Topic 的消息都不会再从同一 Topic 导出。因此同一 Topic 在多个进程
+ * 里都做双向镜像时，每条消息在每个进程里只出现一次；导入回调里同步发布的其他 Topic
+ * 照常导出。
+ * Loop rules: exported messages carry this bridge's origin tag and the import side
+ * skips its own messages; messages that any bridge publishes into an in-process topic
+ * while importing are never exported again from that same topic. So when one topic is
+ * mirrored both ways in several processes, each message shows up exactly once in every
+ * process, while other topics published synchronously from import callbacks are still
+ * exported.
+ *
+ * @note 共享 Topic 以进程内域的名称 CRC32 作为域键，只有同名域才会互通。多个进程同时
+ *       导出同一 Topic 时，`config` 需开启 `multi_publisher`。
+ *       Shared topics use the CRC32 of the in-process domain name as their domain key,
+ *       so only domains with the same name are connected. When several processes export
+ *       the same topic, `config` must enable `multi_publisher`.
+ * @note 关闭时导出回调会从进程内 Topic 注销并释放。
+ *       Closing unregisters the export callbacks from the in-process topics and frees
+ *       them.
+ */
+class LinuxTopicBridge
+{
+ public:
+  static constexpr uint32_t DEFAULT_BATCH_SIZE = 32;
+
+  /**
+   * @brief 创建桥接器。Create the bridge.
+   * @param domain 进程内 Topic 所在的域，需比桥接器存活更久。Domain of the in-process
+   * topics; must outlive the bridge.
+   * @param config 导出方向创建共享 Topic 时使用的配置。Config used when the export
+   * direction creates shared topics.
+   */
+  explicit LinuxTopicBridge(Topic::Domain& domain,
+                            const LinuxSharedTopicConfig& config = {})
+      : domain_(domain), config_(config), origin_(NextOrigin())
+  {
+  }
+
+  ~LinuxTopicBridge() { (void)Close(); }
+
+  LinuxTopicBridge(const LinuxTopicBridge&) = delete;
+  LinuxTopicBridge& operator=(const LinuxTopicBridge&) = delete;
+
+  /**
+   * @brief 把进程内 Topic 导出到共享内存。Export an in-process topic to shared memory.
+   * @param topic_name 主题名称；进程内 Topic 不存在时按 `Data` 创建。Topic name; the
+   * in-process topic is created with `Data` when missing.
+   * @return 错误码；共享 Topic 打不开时返回其打开错误。Error code; the shared topic's
+   * open error when it cannot be opened.
+   */
+  template <typename Data>
+  ErrorCode Export(const char* topic_name)
+  {
+    return AddRoute<Data>(topic_name, true, false, DEFAULT_BATCH_SIZE);
+  }
+
+  /**
+   * @brief 把已存在的共享 Topic 导入进程内。Import an existing shared topic into the
+   * process.
+   * @param topic_name 主题名称。Topic name.
+   * @param batch_size 每次批量取出的最大消息数。Maximum messages per batch.
+   * @return 错误码；共享 Topic 不存在或订阅者已满时返回 `NOT_FOUND`。Error code;
+   * `NOT_FOUND` when the shared topic does not exist or has no free subscriber entry.
+   */
+  template <typename Data>
+  ErrorCode Import(const char* topic_name, uint32_t batch_size = DEFAULT_BATCH_SIZE)
+  {
+    return AddRoute<Data>(topic_name, false, true, batch_size);
+  }
+
+  /**
+   * @brief 双向镜像一个 Topic。Mirror one topic in both directions.
+   * @param topic_name 主题名称。Topic name.
+   * @param batch_size 导入方向每次批量取出的最大消息数。Maximum messages per import
+   * batch.
+   * @return 错误码。Error code.
+   */
+  template <typename Data>
+  ErrorCode Mirror(const char* topic_name, uint32_t batch_size = DEFAULT_BATCH_SIZE)
+  {
+    return AddRoute<Data>(topic_name, true, true, batch_size);
+  }
+
+  /**
+   * @brief 把所有导入方向当前积压的消息发布到进程内。Publish every message currently
+   * pending on all import directions into the process.
+   * @return 本次处理的共享消息数。Number of shared messages handled by this call.
+   * @note 桥接线程运行时由线程调用。Called by the bridge thread while it runs.
+   */
+  size_t Poll()
+  {
+    size_t handled = 0;
+    for (auto& route : routes_)
+    {
+      handled += route->Drain(counters_);
+    }
+    return handled;
+  }
+
+  /**
+   * @brief 启动后台桥接线程。Start the background bridge thread.
+   * @param priority 线程优先级。Thread priority.
+   */
+  ErrorCode Start(Thread::Priority priority = Thread::Priority::HIGH)
+  {
+    if (running_.load(std::memory_order_acquire))
+    {
+      return ErrorCode::STATE_ERR;
+    }
+
+    poll_fds_.clear();
+    for (auto& route : routes_)
+    {
+      if (route->NotifyFd() >= 0)
+      {
+        poll_fds_.push_back({route->NotifyFd(), POLLIN, 0});
+      }
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_.Create<LinuxTopicBridge*>(this, ThreadMain, "topic_bridge", 64 * 1024,
+                                      priority);
+    return ErrorCode::OK;
+  }
+
+  /**
+   * @brief 停止后台桥接线程。Stop the background bridge thread.
+   */
+  ErrorCode Stop()
+  {
+    if (!running_.exchange(false, std::memory_order_acq_rel))
+    {
+      return ErrorCode::OK;
+    }
+    return thread_.Join();
+  }
+
+  /**
+   * @brief 停止桥接并断开所有路由。Stop bridging and detach every route.
+   */
+  ErrorCode Close()
+  {
+    const ErrorCode ans = Stop();
+    for (auto& route : routes_)
+    {
+      route->Detach();
+    }
+    routes_.clear();
+    return ans;
+  }
+
+  /**
+   * @brief 获取本桥接器写入共享槽位的来源标记。Get the origin tag this bridge writes
+   * into shared slots.
+   */
+  uint32_t GetOrigin() const { return origin_; }
+
+  /**
+   * @brief 读取吞吐计数。Read the throughput counters.
+   * @return 当前计数快照。Current counter snapshot.
+   */
+  LinuxTopicBridgeStats GetStats() const
+  {
+    LinuxTopicBridgeStats stats;
+    stats.exported = counters_.exported.load(std::memory_order_relaxed);
+    stats.exported_bytes = counters_.exported_bytes.load(std::memory_order_relaxed);
+    stats.imported = counters_.imported.load(std::memory_order_relaxed);
+    stats.imported_bytes = counters_.imported_bytes.load(std::memory_order_relaxed);
+    stats.export_failed = counters_.export_failed.load(std::memory_order_relaxed);
+    stats.import_dropped = counters_.import_dropped.load(std::memory_order_relaxed);
+    stats.loop_suppressed = counters_.loop_suppressed.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  static constexpr int IDLE_WAIT_MS = 1;
+
+  struct Counters
+  {
+    std::atomic<uint64_t> exported{0};
+    std::atomic<uint64_t> exported_bytes{0};
+    std::atomic<uint64_t> imported{0};
+    std::atomic<uint64_t> imported_bytes{0};
+    std::atomic<uint64_t> export_failed{0};
+    std::atomic<uint64_t> import_dropped{0};
+    std::atomic<uint64_t> loop_suppressed{0};
+  };
+
+  class Route
+  {
+   public:
+    virtual ~Route() = default;
+    virtual size_t Drain(Counters& counters) = 0;
+    virtual int NotifyFd() const { return -1; }
+    virtual void Arm() {}
+    virtual void Detach() {}
+  };
+
+  // 导出回调的绑定参数；回调注销后才释放。
+  template <typename Data>
+  struct ExportTap
+  {
+    Topic::TopicHandle topic = nullptr;
+    LinuxSharedTopic<Data>* shared = nullptr;
+    Counters* counters = nullptr;
+    uint32_t origin = 0;
+  };
+
+  template <typename Data>
+  class SharedRoute : public Route
+  {
+   public:
+    using SharedTopic = LinuxSharedTopic<Data>;
+
+    SharedRoute(Topic topic, std::unique_ptr<SharedTopic> shared, uint32_t batch_size,
+                uint32_t origin)
+        : topic_(topic),
+          shared_(std::move(shared)),
+          origin_(origin),
+          items_(batch_size),
+          values_(batch_size),
+          timestamps_(batch_size)
+    {
+    }
+
+    ~SharedRoute() override { Detach(); }
+
+    ErrorCode Init(bool export_dir, bool import_dir, Counters& counters)
+    {
+      if (import_dir)
+      {
+        subscriber_ = typename SharedTopic::SyncSubscriber(
+            *shared_, LinuxSharedSubscriberMode::BROADCAST_DROP_OLD);
+        if (!subscriber_.Valid())
+        {
+          return ErrorCode::NOT_FOUND;
+        }
+        const ErrorCode ans = subscriber_.EnableNotify();
+        if (ans != ErrorCode::OK)
+        {
+          return ans;
+        }
+      }
+
+      if (export_dir)
+      {
+        tap_ = new ExportTap<Data>;
+        tap_->topic = topic_;
+        tap_->shared = shared_.get();
+        tap_->counters = &counters;
+        tap_->origin = origin_;
+        callback_ = Topic::Callback::Create(OnPublish, tap_);
+        topic_.RegisterCallback(callback_);
+      }
+      return ErrorCode::OK;
+    }
+
+    size_t Drain(Counters& counters) override
+    {
+      if (!subscriber_.Valid())
+      {
+        return 0;
+      }
+
+      size_t handled = 0;
+      uint32_t count = 0;
+      while (subscriber_.WaitBatch(items_, count, 0) == ErrorCode::OK)
+      {
+        size_t forward = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          const auto& item = items_[i];
+          if (item.origin == origin_)
+          {
+            counters.loop_suppressed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+          }
+          if (item.size != 1U)
+          {
+            counters.import_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+          }
+          values_[forward] = *item.data;
+          timestamps_[forward] = item.timestamp;
+          ++forward;
+        }
+        subscriber_.ReleaseBatch();
+
+        if (forward != 0)
+        {
+          // 只标记本 Topic：导入回调里同步发布的其他 Topic 仍要导出。
+          // Mark only this topic: other topics published synchronously from import
+          // callbacks must still be exported.
+          importing_ = topic_;
+          topic_.PublishBatch(
+              std::span<Data>(values_.data(), forward),
+              std::span<const MicrosecondTimestamp>(timestamps_.data(), forward));
+          importing_ = nullptr;
+          counters.imported.fetch_add(forward, std::memory_order_relaxed);
+          counters.imported_bytes.fetch_add(forward * sizeof(Data),
+                                            std::memory_order_relaxed);
+        }
+
+        handled += count;
+        if (count < items_.size())
+        {
+          break;
+        }
+      }
+
+      // 丢最旧模式下被覆盖的消息由共享订阅者自己计数。
+      // Messages overwritten in drop-old mode are counted by the shared subscriber.
+      const uint64_t drop_num = subscriber_.GetDropNum();
+      counters.import_dropped.fetch_add(drop_num - reported_drop_num_,
+                                        std::memory_order_relaxed);
+      reported_drop_num_ = drop_num;
+      return handled;
+    }
+
+    int NotifyFd() const override { return subscriber_.GetNotifyFd(); }
+
+    void Arm() override { subscriber_.RearmNotify(); }
+
+    void Detach() override
+    {
+      if (tap_ == nullptr)
+      {
+        return;
+      }
+      // 注销返回后不会再有发布者持有 tap_，可以直接释放。
+      // Once unregistering returns no publisher can still hold tap_, so free it.
+      (void)topic_.UnregisterCallback(callback_);
+      delete tap_;
+      tap_ = nullptr;
+    }
+
+   private:
+    static void OnPublish(bool, ExportTap<Data>* tap,
+                          const Topic::MessageView<Data>& message)
+    {
+      Counters& counters = *tap->counters;
+      if (importing_ == tap->topic)
+      {
+        counters.loop_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      typename SharedTopic::Data data;
+      ErrorCode ans = tap->shared->CreateData(data);
+      if (ans == ErrorCode::OK)
+      {
+        *data.GetData() = *message.data;
+        (void)data.SetOrigin(tap->origin);
+        ans = tap->shared->Publish(data, message.timestamp);
+      }
+      if (ans == ErrorCode::OK)
+      {
+        counters.exported.fetch_add(1, std::memory_order_relaxed);
+        counters.exported_bytes.fetch_add(sizeof(Data), std::memory_order_relaxed);
+      }
+      else
+      {
+        counters.export_failed.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    Topic topic_;
+    std::unique_ptr<SharedTopic> shared_;
+    uint32_t origin_ = 0;
+    typename SharedTopic::SyncSubscriber subscriber_;
+    uint64_t reported_drop_num_ = 0;
+    std::vector<typename SharedTopic::BatchItem> items_;
+    std::vector<Data> values_;
+    std::vector<MicrosecondTimestamp> timestamps_;
+    ExportTap<Data>* tap_ = nullptr;
+    Topic::Callback callback_;
+  };
+
+  template <typename Data>
+  ErrorCode AddRoute(const char* topic_name, bool export_dir, bool import_dir,
+                     uint32_t batch_size)
+  {
+    if (running_.load(std::memory_order_acquire))
+    {
+      return ErrorCode::STATE_ERR;
+    }
+    if (topic_name == nullptr || batch_size == 0)
+    {
+      return ErrorCode::ARG_ERR;
+    }
+
+    Topic topic(Topic::FindOrCreate<Data>(topic_name, &domain_));
+    auto shared = export_dir
+                      ? std::make_unique<LinuxSharedTopic<Data>>(topic_name, domain_,
+                                                                 config_)
+                      : std::make_unique<LinuxSharedTopic<Data>>(topic_name, domain_);
+    if (!shared->Valid())
+    {
+      return export_dir ? shared->GetError() : ErrorCode::NOT_FOUND;
+    }
+
+    auto route = std::make_unique<SharedRoute<Data>>(topic, std::move(shared),
+                                                     batch_size, origin_);
+    const ErrorCode ans = route->Init(export_dir, import_dir, counters_);
+    if (ans != ErrorCode::OK)
+    {
+      return ans;
+    }
+    routes_.push_back(std::move(route));
+    return ErrorCode::OK;
+  }
+
+  static uint32_t NextOrigin()
+  {
+    // 低 22 位放进程号，高 10 位放进程内序号；0 留给未标记的消息。
+    // The low 22 bits hold the process id and the high 10 bits an in-process counter;
+    // 0 stays reserved for untagged messages.
+    static std::atomic<uint32_t> next{0};
+    const uint32_t index = next.fetch_add(1, std::memory_order_relaxed) + 1U;
+    return (static_cast<uint32_t>(getpid()) & 0x3FFFFFU) | (index << 22U);
+  }
+
+  static void ThreadMain(LinuxTopicBridge* self)
+  {
+    while (self->running_.load(std::memory_order_acquire))
+    {
+      if (self->Poll() != 0)
+      {
+        continue;
+      }
+
+      // 先挂起通知再取一次，避免挂起前到达的消息被错过。
+      for (auto& route : self->routes_)
+      {
+        route->Arm();
+      }
+      if (self->Poll() != 0)
+      {
+        continue;
+      }
+
+      if (self->poll_fds_.empty())
+      {
+        Thread::Sleep(IDLE_WAIT_MS);
+      }
+      else
+      {
+        (void)poll(self->poll_fds_.data(), self->poll_fds_.size(), IDLE_WAIT_MS);
+      }
+    }
+    (void)self->Poll();
+  }
+
+  /// 当前线程正在把导入消息发布进去的 Topic，没有则为空。Topic the current thread is
+  /// publishing imported messages into, or null.
+  static inline thread_local Topic::TopicHandle importing_ = nullptr;
+
+  Topic::Domain& domain_;
+  LinuxSharedTopicConfig config_;
+  uint32_t origin_ = 0;
+  std::vector<std::unique_ptr<Route>> routes_;
+  std::vector<pollfd> poll_fds_;
+  std::atomic<bool> running_{false};
+  Counters counters_;
+  Thread thread_;
+};
+
+}  // namespace LibXR
@@ -4,4 +4,5 @@
 // clang-format off
 #include "monotonic_time.hpp"
 #include "../linux/linux_shared_topic_impl.hpp"
+#include "../linux/linux_topic_bag.hpp"
 // clang-format on
@@ -3,6 +3,8 @@
  * @brief message packet 头部编码与解析子测试。 Split test unit for message packet header
  * encoding and parsing.
  */
+#include <cstring>
+
 #include "message_packet_test_common.hpp"
 
 namespace
@@ -116,6 +118,318 @@ void TestPacketHeaderAndServerParse()
          LibXR::ErrorCode::PTR_NULL);
 }
 
+/**
+ * @brief 测试项函数 `TestPacketServerInPlaceParse`。 Test-item function
+ * `TestPacketServerInPlaceParse`.
+ * @details 测试内容：验证一块输入里的多条完整包就地发布，跨块残包仍由暂存队列接上。
+ * Verify several complete packets in one input chunk are published in place, while a
+ * packet straddling chunks is still completed through the staging queue.
+ *          测试原理：payload 对齐时订阅者拿到的地址应直接落在输入缓冲区内。 When the
+ * payload is aligned, the address seen by the subscriber should fall inside the input
+ * buffer itself.
+ */
+void TestPacketServerInPlaceParse()
+{
+  constexpr size_t PACKET_SIZE = LibXR::Topic::PACK_BASE_SIZE + sizeof(double);
+
+  auto domain = LibXR::Topic::Domain("message_packet_domain");
+  auto topic = LibXR::Topic::CreateTopic<double>("message_packet_inplace_tp", &domain);
+
+  static double rx_values[6] = {};
+  static const void* rx_addrs[6] = {};
+  static size_t rx_count = 0;
+  auto msg_cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, double& data)
+      {
+        rx_values[rx_count] = data;
+        rx_addrs[rx_count] = &data;
+        rx_count++;
+      },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(msg_cb);
+
+  LibXR::Topic::Server topic_server(64);
+  topic_server.Register(topic);
+
+  // 布局：垃圾(8) + 包0 + 包1 + 垃圾(3) + 包2 + 包3 的前 5 字节。
+  // Layout: garbage(8) + packet0 + packet1 + garbage(3) + packet2 + first 5 bytes of
+  // packet3.
+  alignas(8) uint8_t stream[8 + PACKET_SIZE * 4 + 3] = {};
+  const double values[4] = {1.5, 2.5, 3.5, 4.5};
+  size_t offsets[4] = {8, 8 + PACKET_SIZE, 8 + PACKET_SIZE * 2 + 3,
+                       8 + PACKET_SIZE * 3 + 3};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    ASSERT(topic.PackRaw(LibXR::ConstRawData(values[i]),
+                         LibXR::RawData(stream + offsets[i], PACKET_SIZE),
+                         LibXR::MicrosecondTimestamp(i)) == LibXR::ErrorCode::OK);
+  }
+  std::memset(stream + 8 + PACKET_SIZE * 2, 0xEE, 3);
+
+  const size_t first_chunk = offsets[3] + 5;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(stream, first_chunk)) == 3);
+  ASSERT(rx_count == 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    ASSERT(rx_values[i] == values[i]);
+  }
+
+  // 包0 的 payload 在偏移 24，按 double 对齐，应直接指向输入。
+  // The payload of packet0 sits at offset 24, aligned for double, so it should point
+  // straight into the input.
+  ASSERT(rx_addrs[0] == stream + offsets[0] + sizeof(LibXR::Topic::PackedDataHeader));
+
+  ASSERT(topic_server.ParseData(
+             LibXR::ConstRawData(stream + first_chunk, sizeof(stream) - first_chunk)) ==
+         1);
+  ASSERT(rx_count == 4);
+  ASSERT(rx_values[3] == values[3]);
+
+  // 整块恰好解析完时不能留下暂存状态，后续调用仍走原地路径。
+  // A chunk parsed exactly to its end must leave no staged state behind, so later
+  // calls still take the in-place path.
+  for (size_t round = 0; round < 2; ++round)
+  {
+    const LibXR::ConstRawData packet(stream + offsets[0], PACKET_SIZE);
+    ASSERT(topic_server.ParseData(packet) == 1);
+    ASSERT(rx_count == 5 + round);
+    ASSERT(rx_addrs[4 + round] ==
+           stream + offsets[0] + sizeof(LibXR::Topic::PackedDataHeader));
+  }
+}
+
+/**
+ * @brief 测试项函数 `TestPacketCRC32CVersion`。 Test-item function
+ * `TestPacketCRC32CVersion`.
+ * @details 测试内容：验证 CRC32C 版本 packet 的编码、整块与分块解析以及 payload 损坏丢弃。
+ * Verify encoding of CRC32C-version packets, whole and split parsing, and dropping on
+ * payload corruption.
+ *          测试原理：同一个 server 按头部版本字段区分尾部校验，两种版本可以混在一条流里。
+ * One server tells trailing checks apart by the header version field, so both versions
+ * may share one stream.
+ */
+void TestPacketCRC32CVersion()
+{
+  constexpr size_t PACKET_SIZE = LibXR::Topic::PACK_BASE_SIZE_CRC32C + sizeof(double);
+  static_assert(sizeof(LibXR::Topic::PackedDataCRC32C<double>) == PACKET_SIZE);
+  static_assert(LibXR::Topic::PackBaseSize(LibXR::Topic::PACKET_VERSION_CRC32C) ==
+                PACKET_SIZE - sizeof(double));
+
+  auto domain = LibXR::Topic::Domain("message_packet_domain");
+  auto topic = LibXR::Topic::CreateTopic<double>("message_packet_crc32c_tp", &domain);
+
+  static double rx_value = 0.0;
+  static size_t rx_count = 0;
+  auto msg_cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, double& data)
+      {
+        rx_value = data;
+        rx_count++;
+      },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(msg_cb);
+
+  LibXR::Topic::Server topic_server(128);
+  topic_server.Register(topic);
+
+  LibXR::Topic::PackedDataCRC32C<double> packed_data;
+  const double value0 = 12.25;
+  ASSERT(topic.PackData(value0, packed_data, LibXR::MicrosecondTimestamp(7)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packed_data.raw.header_.version == LibXR::Topic::PACKET_VERSION_CRC32C);
+  ASSERT(LibXR::CRC32C::Verify(&packed_data, PACKET_SIZE));
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packed_data)) == 1);
+  ASSERT(rx_value == value0);
+
+  auto* packet = reinterpret_cast<uint8_t*>(&packed_data);
+  rx_value = -1.0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packet, PACKET_SIZE - 2)) == 0);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packet + PACKET_SIZE - 2, 2)) == 1);
+  ASSERT(rx_value == value0);
+
+  // 同一条流里混入 CRC8 版本 packet。Mix a CRC8-version packet into the same stream.
+  uint8_t stream[PACKET_SIZE + LibXR::Topic::PACK_BASE_SIZE + sizeof(double)] = {};
+  const double value1 = 24.5;
+  std::memcpy(stream, &packed_data, PACKET_SIZE);
+  ASSERT(topic.PackRaw(LibXR::ConstRawData(value1),
+                       LibXR::RawData(stream + PACKET_SIZE, sizeof(stream) - PACKET_SIZE),
+                       LibXR::MicrosecondTimestamp(8)) == LibXR::ErrorCode::OK);
+  rx_count = 0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(stream, sizeof(stream))) == 2);
+  ASSERT(rx_count == 2);
+  ASSERT(rx_value == value1);
+
+  packed_data.raw.data_[3] ^= 0x10;
+  rx_count = 0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packed_data)) == 0);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packet, 5)) == 0);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(packet + 5, PACKET_SIZE - 5)) == 0);
+  ASSERT(rx_count == 0);
+
+  uint8_t raw_packet[PACKET_SIZE] = {};
+  ASSERT(topic.PackRaw(LibXR::ConstRawData(value1),
+                       LibXR::RawData(raw_packet, PACKET_SIZE - 1),
+                       LibXR::MicrosecondTimestamp(9),
+                       LibXR::Topic::PACKET_VERSION_CRC32C) == LibXR::ErrorCode::NO_BUFF);
+  ASSERT(topic.PackRaw(LibXR::ConstRawData(value1),
+                       LibXR::RawData(raw_packet, PACKET_SIZE),
+                       LibXR::MicrosecondTimestamp(9), 0x7F) == LibXR::ErrorCode::ARG_ERR);
+  ASSERT(topic.PackRaw(LibXR::ConstRawData(value1),
+                       LibXR::RawData(raw_packet, PACKET_SIZE),
+                       LibXR::MicrosecondTimestamp(9),
+                       LibXR::Topic::PACKET_VERSION_CRC32C) == LibXR::ErrorCode::OK);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(raw_packet, PACKET_SIZE)) == 1);
+  ASSERT(rx_value == value1);
+}
+
+/**
+ * @brief 测试项函数 `TestPacketBatchFrame`。 Test-item function `TestPacketBatchFrame`.
+ * @details 测试内容：验证批量帧的条目编码、按大小和期限刷出、整帧与分块解析、未注册
+ * topic 跳过以及整帧损坏丢弃。 Verify batch-frame entry encoding, size- and
+ * deadline-driven flushing, whole and split parsing, skipping unregistered topics, and
+ * dropping a corrupted frame.
+ *          测试原理：多个 topic 的消息共用一个帧头和 CRC32C，server 校验整帧后按条目头
+ * 逐条发布。 Messages of several topics share one frame header and CRC32C, and the
+ * server verifies the whole frame before publishing entry by entry.
+ */
+void TestPacketBatchFrame()
+{
+  static_assert(LibXR::Topic::PackBaseSize(LibXR::Topic::PACKET_VERSION_BATCH) ==
+                LibXR::Topic::PACK_BASE_SIZE_CRC32C);
+
+  auto domain = LibXR::Topic::Domain("message_packet_domain");
+  auto topic_f64 = LibXR::Topic::CreateTopic<double>("message_packet_batch_f64", &domain);
+  auto topic_u8 = LibXR::Topic::CreateTopic<uint8_t>("message_packet_batch_u8", &domain);
+  auto topic_lost =
+      LibXR::Topic::CreateTopic<uint8_t>("message_packet_batch_lost", &domain);
+
+  static double rx_f64 = 0.0;
+  static uint8_t rx_u8 = 0;
+  static size_t rx_count = 0;
+  auto f64_cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, double& data)
+      {
+        rx_f64 = data;
+        rx_count++;
+      },
+      reinterpret_cast<void*>(0));
+  auto u8_cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, uint8_t& data)
+      {
+        rx_u8 = data;
+        rx_count++;
+      },
+      reinterpret_cast<void*>(0));
+  topic_f64.RegisterCallback(f64_cb);
+  topic_u8.RegisterCallback(u8_cb);
+
+  LibXR::Topic::Server topic_server(128);
+  topic_server.Register(topic_f64);
+  topic_server.Register(topic_u8);
+
+  static uint8_t frame[128] = {};
+  static size_t frame_size = 0;
+  static size_t frame_num = 0;
+  auto on_flush = LibXR::Topic::BatchPacker::FlushCallback::Create(
+      [](bool, void*, LibXR::ConstRawData data)
+      {
+        ASSERT(data.size_ <= sizeof(frame));
+        std::memcpy(frame, data.addr_, data.size_);
+        frame_size = data.size_;
+        frame_num++;
+      },
+      reinterpret_cast<void*>(0));
+
+  constexpr size_t ENTRY = LibXR::Topic::BatchPacker::ENTRY_HEADER_SIZE;
+  constexpr size_t FRAME_SIZE = LibXR::Topic::PACK_BASE_SIZE_CRC32C + 3 * ENTRY +
+                                2 * sizeof(double) + sizeof(uint8_t);
+
+  LibXR::Topic::BatchPacker packer(128, on_flush);
+  ASSERT(packer.Flush() == LibXR::ErrorCode::EMPTY);
+  ASSERT(packer.Add(topic_f64, 1.5, LibXR::MicrosecondTimestamp(1000)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packer.Add(topic_u8, uint8_t(7), LibXR::MicrosecondTimestamp(990)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packer.Add(topic_f64, 2.5, LibXR::MicrosecondTimestamp(1040)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packer.AddRaw(topic_f64, LibXR::ConstRawData(rx_u8),
+                       LibXR::MicrosecondTimestamp(1050)) == LibXR::ErrorCode::SIZE_ERR);
+  ASSERT(packer.EntryCount() == 3);
+  ASSERT(packer.Size() == FRAME_SIZE);
+  ASSERT(frame_num == 0);
+  ASSERT(packer.Flush() == LibXR::ErrorCode::OK);
+  ASSERT(frame_num == 1 && frame_size == FRAME_SIZE);
+  ASSERT(packer.EntryCount() == 0 && packer.Size() == 0);
+
+  const auto* header = reinterpret_cast<const LibXR::Topic::PackedDataHeader*>(frame);
+  ASSERT(header->version == LibXR::Topic::PACKET_VERSION_BATCH);
+  ASSERT(header->GetDataLen() == FRAME_SIZE - LibXR::Topic::PACK_BASE_SIZE_CRC32C);
+  ASSERT(TimestampUs(header->GetTimestamp()) == 1000);
+  ASSERT(LibXR::CRC32C::Verify(frame, FRAME_SIZE));
+  const auto* second = reinterpret_cast<const LibXR::Topic::PackedBatchEntryHeader*>(
+      frame + sizeof(LibXR::Topic::PackedDataHeader) + ENTRY + sizeof(double));
+  ASSERT(second->GetDataLen() == sizeof(uint8_t));
+  ASSERT(second->GetTimestampDelta() == -10);
+
+  rx_count = 0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, FRAME_SIZE)) == 3);
+  ASSERT(rx_count == 3 && rx_f64 == 2.5 && rx_u8 == 7);
+
+  // 分块喂入走暂存路径。Feeding in chunks takes the staged path.
+  rx_count = 0;
+  rx_f64 = 0.0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, 21)) == 0);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame + 21, FRAME_SIZE - 21)) == 3);
+  ASSERT(rx_count == 3 && rx_f64 == 2.5);
+
+  // 按大小刷出，未注册 topic 的条目被跳过。Size-driven flush; entries of unregistered
+  // topics are skipped.
+  LibXR::Topic::BatchPacker small_packer(48, on_flush, 40);
+  frame_num = 0;
+  ASSERT(small_packer.Add(topic_lost, uint8_t(1), LibXR::MicrosecondTimestamp(5)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(small_packer.Add(topic_u8, uint8_t(9), LibXR::MicrosecondTimestamp(6)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(frame_num == 1 && small_packer.EntryCount() == 0);
+  rx_count = 0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, frame_size)) == 1);
+  ASSERT(rx_count == 1 && rx_u8 == 9);
+
+  // 放不下时先刷出旧帧。A frame that cannot take the next entry is flushed first.
+  ASSERT(small_packer.Add(topic_f64, 3.5, LibXR::MicrosecondTimestamp(7)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(small_packer.Add(topic_f64, 4.5, LibXR::MicrosecondTimestamp(8)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(frame_num == 2 && small_packer.EntryCount() == 1);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, frame_size)) == 1);
+  ASSERT(rx_f64 == 3.5);
+
+  // 按期限刷出。Deadline-driven flush.
+  LibXR::Topic::BatchPacker timed_packer(128, on_flush, 0, 1);
+  ASSERT(timed_packer.Add(topic_u8, uint8_t(3), LibXR::MicrosecondTimestamp(9)) ==
+         LibXR::ErrorCode::OK);
+  const auto begin = TimestampUs(LibXR::Topic::NowTimestamp());
+  while (TimestampUs(LibXR::Topic::NowTimestamp()) - begin < 2)
+  {
+  }
+  ASSERT(timed_packer.Poll() == LibXR::ErrorCode::OK);
+  ASSERT(timed_packer.Poll() == LibXR::ErrorCode::EMPTY);
+  ASSERT(frame_num == 3);
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, frame_size)) == 1);
+  ASSERT(rx_u8 == 3);
+
+  // 整帧损坏时一条都不发布。A corrupted frame publishes nothing.
+  ASSERT(packer.Add(topic_u8, uint8_t(4), LibXR::MicrosecondTimestamp(10)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packer.Add(topic_u8, uint8_t(5), LibXR::MicrosecondTimestamp(11)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(packer.Flush() == LibXR::ErrorCode::OK);
+  frame[frame_size - 6] ^= 0x01;
+  rx_count = 0;
+  ASSERT(topic_server.ParseData(LibXR::ConstRawData(frame, frame_size)) == 0);
+  ASSERT(rx_count == 0);
+}
+
 }  // namespace
 
 /**
@@ -127,4 +441,10 @@ void TestPacketHeaderAndServerParse()
  * Split parsing, validation-failure, and alignment-compatibility semantics into separate
  * files to reduce packet-test complexity.
  */
-void RunMessagePacketParseTests() { TestPacketHeaderAndServerParse(); }
+void RunMessagePacketParseTests()
+{
+  TestPacketHeaderAndServerParse();
+  TestPacketServerInPlaceParse();
+  TestPacketCRC32CVersion();
+  TestPacketBatchFrame();
+}
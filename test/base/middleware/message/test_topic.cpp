@@ -4,14 +4,29 @@
  * @details 测试项目：
  *          1. 聚合分发 fan-out 子场景。
  *          2. 聚合可变 payload 与队列背压子场景。
+ *          3. 聚合出借槽位零拷贝发布子场景。
+ *          4. 聚合最新值缓存子场景。
+ *          5. 聚合回调执行器与分发优先级子场景。
+ *          6. 聚合运行统计子场景。
+ *          7. 聚合订阅者过滤器子场景。
  *          Test items:
  *          1. Aggregate dispatch fan-out sub-scenarios.
  *          2. Aggregate mutable-payload and queue-backpressure sub-scenarios.
+ *          3. Aggregate loaned-slot zero-copy publish sub-scenarios.
+ *          4. Aggregate latest-value cache sub-scenarios.
+ *          5. Aggregate callback executor and dispatch-priority sub-scenarios.
+ *          6. Aggregate runtime-statistics sub-scenarios.
+ *          7. Aggregate subscriber-filter sub-scenarios.
  */
 #include "topic_test_common.hpp"
 
 void RunTopicDispatchTests();
 void RunTopicMutationTests();
+void RunTopicLoanTests();
+void RunTopicLatestTests();
+void RunTopicExecutorTests();
+void RunTopicStatsTests();
+void RunTopicFilterTests();
 
 /**
  * @brief 测试入口函数 `test_message_topic`。 Test entry function `test_message_topic`.
@@ -25,4 +40,9 @@ void test_message_topic()
   // Test coverage: execute the test items listed in this file header in sequence.
   RunTopicDispatchTests();
   RunTopicMutationTests();
+  RunTopicLoanTests();
+  RunTopicLatestTests();
+  RunTopicExecutorTests();
+  RunTopicStatsTests();
+  RunTopicFilterTests();
 }
@@ -7,12 +7,17 @@
  *          2. callback-context 发布保持时间戳和 ISR 语义。
  *          3. raw payload 视图回调不参与业务 payload TypeID 匹配。
  *          4. 非平凡 payload 的 typed 传输。
+ *          5. 批量发布保持每个订阅者的顺序与时间戳。
+ *          6. 注销回调后不再投递，其余回调不受影响。
  *          Test items:
  *          1. Fan-out to async, queued, and callback subscribers.
  *          2. Callback-context publish preserves timestamp and ISR semantics.
  *          3. Raw payload view callbacks do not participate in business payload
  *             TypeID matching.
  *          4. Typed delivery of non-trivial payloads.
+ *          5. Batch publish keeps per-subscriber order and timestamps.
+ *          6. An unregistered callback receives nothing more while the others keep
+ *             receiving.
  */
 #include "topic_test_common.hpp"
 
@@ -194,6 +199,135 @@ void TestTopicSubscriberDispatch()
   ASSERT(raw_mutable_arg_size == sizeof(double));
 }
 
+/**
+ * @brief 测试项函数 `TestTopicPublishBatch`。 Test-item function
+ * `TestTopicPublishBatch`.
+ * @details 测试内容：验证批量发布对队列、带时间戳队列、MPMC 队列、callback 和
+ * `latest` 缓存的投递结果，只读 span 同样可以发布。 Verify what batch publishes deliver
+ * to plain, timestamped, and MPMC queues, callbacks, and the `latest` cache, and that a
+ * span of const payloads publishes too.
+ *          测试原理：发布一批比 SPSC 队列容量更多的消息，检查放得下的前缀按序入队、
+ * 其余计为丢弃，callback 逐条收到全部消息。 Publish a burst larger than the SPSC queue,
+ * then check that the prefix that fits is enqueued in order, the rest counts as
+ * dropped, and callbacks see every message.
+ */
+void TestTopicPublishBatch()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_batch_domain");
+  auto topic = LibXR::Topic::CreateTopic<int>("message_topic_batch_tp", &domain);
+  ASSERT(topic.EnableLatest<int>() == LibXR::ErrorCode::OK);
+
+  LibXR::SPSCQueue<int> plain_queue(4);
+  auto plain_suber = LibXR::Topic::QueuedSubscriber(topic, plain_queue);
+  LibXR::SPSCQueue<LibXR::Topic::Message<int>> timed_queue(8);
+  auto timed_suber = LibXR::Topic::QueuedSubscriber(topic, timed_queue);
+  LibXR::MPMCQueue<int> shared_queue(8);
+  auto shared_suber = LibXR::Topic::QueuedSubscriber(topic, shared_queue);
+  UNUSED(timed_suber);
+  UNUSED(shared_suber);
+
+  static int cb_sum = 0;
+  static int cb_count = 0;
+  static uint64_t cb_last_timestamp = 0;
+  auto cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, LibXR::MicrosecondTimestamp timestamp, int& data)
+      {
+        cb_sum += data;
+        cb_count++;
+        cb_last_timestamp = TimestampUs(timestamp);
+      },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(cb);
+
+  int burst[6] = {10, 11, 12, 13, 14, 15};
+  LibXR::MicrosecondTimestamp stamps[6];
+  for (size_t i = 0; i < 6; ++i)
+  {
+    stamps[i] = LibXR::MicrosecondTimestamp(500 + i);
+  }
+  topic.PublishBatch(std::span(burst),
+                     std::span<const LibXR::MicrosecondTimestamp>(stamps));
+
+  ASSERT(cb_count == 6 && cb_sum == 75 && cb_last_timestamp == 505);
+
+  auto stats = plain_suber.GetStats();
+  ASSERT(stats.dropped == 2 && stats.high_watermark == 4);
+  for (int expected = 10; expected < 14; ++expected)
+  {
+    int value = 0;
+    ASSERT(plain_queue.Pop(value) == LibXR::ErrorCode::OK && value == expected);
+  }
+
+  for (size_t i = 0; i < 6; ++i)
+  {
+    LibXR::Topic::Message<int> message{};
+    ASSERT(timed_queue.Pop(message) == LibXR::ErrorCode::OK);
+    ASSERT(message.data == burst[i] && TimestampUs(message.timestamp) == 500 + i);
+  }
+
+  for (int expected = 10; expected < 16; ++expected)
+  {
+    int value = 0;
+    ASSERT(shared_queue.Pop(value) == LibXR::ErrorCode::OK && value == expected);
+  }
+
+  LibXR::Topic::Message<int> latest{};
+  ASSERT(topic.GetLatest(latest) == LibXR::ErrorCode::OK);
+  ASSERT(latest.data == 15 && TimestampUs(latest.timestamp) == 505);
+
+  const int const_burst[2] = {20, 21};
+  topic.PublishBatch(std::span(const_burst));
+  ASSERT(cb_count == 8 && cb_sum == 116);
+  ASSERT(topic.GetLatest(latest) == LibXR::ErrorCode::OK && latest.data == 21);
+
+  int empty_burst[1] = {0};
+  topic.PublishBatchFromCallback(std::span(empty_burst).first(0), false);
+  ASSERT(cb_count == 8);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicUnregisterCallback`。 Test-item function
+ * `TestTopicUnregisterCallback`.
+ * @details 测试内容：注销一个回调后它不再收到消息，同 topic 的其他回调照常收到。
+ * After one callback is unregistered it receives nothing more, while other callbacks on
+ * the same topic still do.
+ *          测试原理：注销按回调块匹配，用注册句柄的拷贝也能找到；重复注销返回未找到。
+ * Unregistering matches by callback block, so a copy of the registered handle finds it;
+ * a second unregister reports not found.
+ */
+void TestTopicUnregisterCallback()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_unregister_domain");
+  auto topic = LibXR::Topic::CreateTopic<int>("message_topic_unregister_tp", &domain);
+
+  static int counts[2] = {};
+  auto first = LibXR::Topic::Callback::Create(
+      [](bool, int* count, int&) { ++*count; }, &counts[0]);
+  auto second = LibXR::Topic::Callback::Create(
+      [](bool, int* count, int&) { ++*count; }, &counts[1]);
+  topic.RegisterCallback(first);
+  topic.RegisterCallback(second);
+
+  int value = 1;
+  topic.Publish(value);
+  ASSERT(counts[0] == 1 && counts[1] == 1);
+
+  LibXR::Topic::Callback first_copy = first;
+  ASSERT(topic.UnregisterCallback(first_copy) == LibXR::ErrorCode::OK);
+  topic.Publish(value);
+  ASSERT(counts[0] == 1 && counts[1] == 2);
+  ASSERT(topic.UnregisterCallback(first) == LibXR::ErrorCode::NOT_FOUND);
+
+  // 注销后可以重新注册。It may be registered again after unregistering.
+  topic.RegisterCallback(first);
+  topic.Publish(value);
+  ASSERT(counts[0] == 2 && counts[1] == 3);
+  ASSERT(topic.UnregisterCallback(first) == LibXR::ErrorCode::OK);
+  ASSERT(topic.UnregisterCallback(second) == LibXR::ErrorCode::OK);
+  topic.Publish(value);
+  ASSERT(counts[0] == 2 && counts[1] == 3);
+}
+
 }  // namespace
 
 /**
@@ -203,4 +337,9 @@ void TestTopicSubscriberDispatch()
  * payload/丢包场景缠在一起。 Group fan-out and timestamp semantics away from
  * mutable-payload and drop scenarios.
  */
-void RunTopicDispatchTests() { TestTopicSubscriberDispatch(); }
+void RunTopicDispatchTests()
+{
+  TestTopicSubscriberDispatch();
+  TestTopicPublishBatch();
+  TestTopicUnregisterCallback();
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_topic_executor.cpp
+ * @brief 类型化 `Topic` 回调执行器子测试。 Split test unit for the typed `Topic`
+ * callback executor.
+ * @details 测试项目：
+ *          1. 执行器回调按发布顺序执行，且不在发布线程上执行。
+ *          2. 快路径订阅者先于内联回调收到消息。
+ *          3. 执行器回调阻塞时发布不等待，队列满时按条计数丢弃。
+ *          4. 所有工作线程绑满后，执行器回调注册返回 FULL。
+ *          Test items:
+ *          1. Executor callbacks run in publish order and never on the publishing
+ *             thread.
+ *          2. Fast-path subscribers receive a message before inline callbacks run.
+ *          3. Publishing does not wait for a blocked executor callback, and messages
+ *             beyond a full queue are counted as drops.
+ *          4. Executor callback registration returns FULL once every worker is full.
+ */
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "topic_test_common.hpp"
+
+namespace
+{
+
+/**
+ * @brief 辅助函数 `WaitUntil`。 Helper function `WaitUntil`.
+ * @details 测试内容：轮询等待条件成立，超时则断言失败。 Poll until the condition holds
+ * and fail the assertion on timeout.
+ *          测试原理：执行器在独立线程上运行，结果只能异步观察。 The executor runs on
+ * its own threads, so results can only be observed asynchronously.
+ */
+template <typename Predicate>
+void WaitUntil(Predicate predicate)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate())
+  {
+    ASSERT(std::chrono::steady_clock::now() < deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+/**
+ * @brief 辅助函数 `SharedExecutor`。 Helper function `SharedExecutor`.
+ * @details 测试内容：提供本文件共用的长期执行器。 Provide the long-lived executor
+ * shared by this file.
+ *          测试原理：执行器按设计不销毁，除容量测试外各场景共用这一个。 Executors are
+ * never destroyed by design, so every scenario except the capacity test shares this
+ * one.
+ */
+LibXR::Topic::CallbackExecutor& SharedExecutor()
+{
+  static auto* executor = new LibXR::Topic::CallbackExecutor(2);
+  return *executor;
+}
+
+/**
+ * @struct OrderProbe
+ * @brief 记录一个执行器回调收到的序号与线程 / Records the sequence numbers and thread
+ *        seen by one executor callback
+ */
+struct OrderProbe
+{
+  std::atomic<uint32_t> count{0};
+  uint32_t last = 0;
+  bool ordered = true;
+  std::thread::id publisher;
+  bool off_publisher = true;
+};
+
+/**
+ * @brief 测试项函数 `TestTopicExecutorOrdering`。 Test-item function
+ * `TestTopicExecutorOrdering`.
+ * @details 测试内容：验证两个执行器回调都按发布顺序完整收到消息。 Verify two executor
+ * callbacks both receive every message in publish order.
+ *          测试原理：队列深度覆盖全部发布，因此不应有丢弃。 The queue depth covers every
+ * publish, so nothing should be dropped.
+ */
+void TestTopicExecutorOrdering()
+{
+  constexpr uint32_t PUBLISH_COUNT = 1000;
+
+  auto& executor = SharedExecutor();
+  const auto dropped_before = executor.GetDroppedNum();
+  auto domain = LibXR::Topic::Domain("message_topic_executor_domain");
+  auto topic = LibXR::Topic::CreateTopic<uint32_t>("executor_order_tp", &domain);
+
+  static OrderProbe probes[2];
+  for (auto& probe : probes)
+  {
+    probe.publisher = std::this_thread::get_id();
+    auto cb = LibXR::Topic::Callback::Create(
+        [](bool in_isr, OrderProbe* probe, LibXR::MicrosecondTimestamp timestamp,
+           uint32_t& data)
+        {
+          ASSERT(!in_isr);
+          probe->ordered = probe->ordered && data == probe->last + 1 &&
+                           TimestampUs(timestamp) == data;
+          probe->off_publisher =
+              probe->off_publisher && std::this_thread::get_id() != probe->publisher;
+          probe->last = data;
+          probe->count.fetch_add(1, std::memory_order_release);
+        },
+        &probe);
+    topic.RegisterCallback(cb, executor, PUBLISH_COUNT);
+  }
+
+  for (uint32_t seq = 1; seq <= PUBLISH_COUNT; ++seq)
+  {
+    topic.Publish(seq, LibXR::MicrosecondTimestamp(seq));
+  }
+
+  for (auto& probe : probes)
+  {
+    WaitUntil([&]()
+              { return probe.count.load(std::memory_order_acquire) == PUBLISH_COUNT; });
+    ASSERT(probe.ordered);
+    ASSERT(probe.off_publisher);
+    ASSERT(probe.last == PUBLISH_COUNT);
+  }
+  ASSERT(executor.GetDroppedNum() == dropped_before);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicExecutorFastPathFirst`。 Test-item function
+ * `TestTopicExecutorFastPathFirst`.
+ * @details 测试内容：验证内联回调执行时队列订阅者已经收到本条消息。 Verify the queued
+ * subscriber already holds the message when inline callbacks run.
+ *          测试原理：回调分别注册在队列订阅者之前和之后，两种链表顺序都要满足。
+ * Callbacks are registered both before and after the queued subscriber, so both list
+ * orders are covered.
+ */
+void TestTopicExecutorFastPathFirst()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_executor_domain");
+  auto topic = LibXR::Topic::CreateTopic<uint32_t>("executor_priority_tp", &domain);
+
+  static LibXR::SPSCQueue<uint32_t> queue(8);
+  static uint32_t runs = 0;
+  auto check = [](bool, LibXR::SPSCQueue<uint32_t>* queue, uint32_t& data)
+  {
+    ASSERT(queue->Size() == data);
+    ++runs;
+  };
+
+  auto before = LibXR::Topic::Callback::Create(check, &queue);
+  topic.RegisterCallback(before);
+  auto queue_suber = LibXR::Topic::QueuedSubscriber(topic, queue);
+  UNUSED(queue_suber);
+  auto after = LibXR::Topic::Callback::Create(check, &queue);
+  topic.RegisterCallback(after);
+
+  for (uint32_t seq = 1; seq <= 3; ++seq)
+  {
+    topic.Publish(seq);
+  }
+  ASSERT(runs == 6);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicExecutorBackpressure`。 Test-item function
+ * `TestTopicExecutorBackpressure`.
+ * @details 测试内容：回调阻塞时发布仍立即返回，超出队列深度的消息被计为丢弃。 Publishes
+ * return immediately while the callback is blocked, and messages beyond the queue depth
+ * are counted as drops.
+ *          测试原理：正在执行的消息在回调返回前仍占用队列槽位，因此接收条数恰好等于
+ * 队列深度。 The running message keeps its queue slot until the callback returns, so
+ * the accepted count equals the queue depth exactly.
+ */
+void TestTopicExecutorBackpressure()
+{
+  constexpr uint32_t QUEUE_DEPTH = 4;
+  constexpr uint32_t PUBLISH_COUNT = 10;
+
+  auto& executor = SharedExecutor();
+  const auto dropped_before = executor.GetDroppedNum();
+  auto domain = LibXR::Topic::Domain("message_topic_executor_domain");
+  auto topic = LibXR::Topic::CreateTopic<uint32_t>("executor_backpressure_tp", &domain);
+
+  static std::atomic<bool> gate{false};
+  static std::atomic<uint32_t> runs{0};
+  auto slow = LibXR::Topic::Callback::Create(
+      [](bool, void*, uint32_t&)
+      {
+        while (!gate.load(std::memory_order_acquire))
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        runs.fetch_add(1, std::memory_order_release);
+      },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(slow, executor, QUEUE_DEPTH);
+
+  LibXR::SPSCQueue<uint32_t> queue(PUBLISH_COUNT);
+  auto queue_suber = LibXR::Topic::QueuedSubscriber(topic, queue);
+  UNUSED(queue_suber);
+
+  for (uint32_t seq = 1; seq <= PUBLISH_COUNT; ++seq)
+  {
+    topic.Publish(seq);
+  }
+  ASSERT(queue.Size() == PUBLISH_COUNT);
+  ASSERT(runs.load() == 0);
+  ASSERT(executor.GetDroppedNum() - dropped_before == PUBLISH_COUNT - QUEUE_DEPTH);
+
+  gate.store(true, std::memory_order_release);
+  WaitUntil([]() { return runs.load(std::memory_order_acquire) == QUEUE_DEPTH; });
+
+  uint32_t last = PUBLISH_COUNT + 1;
+  topic.Publish(last);
+  WaitUntil([]() { return runs.load(std::memory_order_acquire) == QUEUE_DEPTH + 1; });
+  ASSERT(executor.GetDroppedNum() - dropped_before == PUBLISH_COUNT - QUEUE_DEPTH);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicExecutorCapacity`。 Test-item function
+ * `TestTopicExecutorCapacity`.
+ * @details 测试内容：验证绑定数达到上限后注册被拒绝，已注册的回调照常执行。 Verify
+ * registration is rejected once the binding limit is reached, while callbacks already
+ * registered keep running.
+ *          测试原理：唯一的工作线程绑满两个回调后，第三个注册无处可放。 Once the only
+ * worker holds two callbacks, a third registration has nowhere to go.
+ */
+void TestTopicExecutorCapacity()
+{
+  static auto* executor = new LibXR::Topic::CallbackExecutor(1, 2);
+  auto domain = LibXR::Topic::Domain("message_topic_executor_domain");
+  auto topic = LibXR::Topic::CreateTopic<uint32_t>("executor_capacity_tp", &domain);
+
+  static std::atomic<uint32_t> runs{0};
+  auto cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, uint32_t&) { runs.fetch_add(1, std::memory_order_release); },
+      reinterpret_cast<void*>(0));
+  ASSERT(topic.RegisterCallback(cb, *executor) == LibXR::ErrorCode::OK);
+  ASSERT(topic.RegisterCallback(cb, *executor) == LibXR::ErrorCode::OK);
+  ASSERT(topic.RegisterCallback(cb, *executor) == LibXR::ErrorCode::FULL);
+
+  uint32_t value = 1;
+  topic.Publish(value);
+  WaitUntil([]() { return runs.load(std::memory_order_acquire) == 2; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT(runs.load(std::memory_order_acquire) == 2);
+}
+
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunTopicExecutorTests`。 Test-item function
+ * `RunTopicExecutorTests`.
+ * @details 测试内容：执行类型化 `Topic` 回调执行器子场景。 Execute typed `Topic`
+ * callback executor sub-scenarios. 测试原理：把顺序、优先级、背压和容量契约单独成组。
+ * Group the ordering, priority, backpressure, and capacity contracts separately.
+ */
+void RunTopicExecutorTests()
+{
+  TestTopicExecutorOrdering();
+  TestTopicExecutorFastPathFirst();
+  TestTopicExecutorBackpressure();
+  TestTopicExecutorCapacity();
+}
@@ -0,0 +1,196 @@
+/**
+ * @file test_topic_filter.cpp
+ * @brief 类型化 `Topic` 订阅者过滤器子测试。 Split test unit for typed `Topic`
+ * subscriber filters.
+ * @details 测试项目：
+ *          1. 按计数抽取、按时间戳限速和内容谓词分别作用于各自的订阅者，被拒绝的消息
+ *             不进队列、不进回调，也不计入统计投递数。
+ *          2. 批量发布对带过滤器的队列逐条判定，未过滤的订阅者照常整批收到；清除过滤器
+ *             后恢复全部投递。
+ *          Test items:
+ *          1. Count decimation, timestamp throttling, and content predicates each act
+ *             on their own subscriber; rejected messages never reach a queue or a
+ *             callback and are not counted as deliveries.
+ *          2. Batch publishes judge filtered queues message by message while
+ *             unfiltered subscribers still get the whole batch; clearing the filter
+ *             restores full delivery.
+ */
+#include <span>
+
+#include "topic_test_common.hpp"
+
+namespace
+{
+
+/**
+ * @brief 辅助函数 `IsEven`。 Helper function `IsEven`.
+ * @details 测试内容：放行偶数 payload 并记录被询问的次数。 Accept even payloads and
+ * record how many times the predicate was asked.
+ *          测试原理：询问次数证明谓词在投递之前运行。 The call count proves the
+ * predicate runs before delivery.
+ */
+bool IsEven(int* calls, const int& value)
+{
+  (*calls)++;
+  return value % 2 == 0;
+}
+
+/**
+ * @brief 辅助函数 `AfterStamp`。 Helper function `AfterStamp`.
+ * @details 测试内容：只放行时间戳不早于阈值的消息。 Accept only messages stamped at or
+ * after a threshold.
+ *          测试原理：覆盖带时间戳的谓词签名。 Cover the timestamped predicate
+ * signature.
+ */
+bool AfterStamp(const uint64_t* threshold_us, LibXR::MicrosecondTimestamp timestamp,
+                const int&)
+{
+  return static_cast<uint64_t>(timestamp) >= *threshold_us;
+}
+
+/**
+ * @brief 测试项函数 `TestTopicFilterKinds`。 Test-item function
+ * `TestTopicFilterKinds`.
+ * @details 测试内容：验证抽取、限速、谓词三种过滤方式与统计计数。 Verify decimation,
+ * throttling, predicates, and the delivery counters.
+ *          测试原理：同一 topic 上挂多个带不同过滤器的订阅者，逐条发布带时间戳的消息后
+ * 比对各自收到的内容。 Attach several subscribers with different filters to one topic,
+ * publish timestamped messages one by one, then compare what each one received.
+ */
+void TestTopicFilterKinds()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_filter_domain");
+  auto topic = LibXR::Topic::CreateTopic<int>("filter_kinds_tp", &domain);
+  ASSERT(topic.EnableStats() == LibXR::ErrorCode::OK);
+
+  LibXR::SPSCQueue<int> decimated_queue(16);
+  auto decimated_suber = LibXR::Topic::QueuedSubscriber(topic, decimated_queue);
+  LibXR::Topic::Filter decimate;
+  decimate.Decimate(3);
+  decimated_suber.SetFilter(decimate);
+
+  LibXR::SPSCQueue<LibXR::Topic::Message<int>> throttled_queue(16);
+  auto throttled_suber = LibXR::Topic::QueuedSubscriber(topic, throttled_queue);
+  LibXR::Topic::Filter throttle;
+  throttle.Throttle(250);
+  throttled_suber.SetFilter(throttle);
+
+  static int even_calls = 0;
+  LibXR::Topic::Filter even;
+  even.Where(IsEven, &even_calls);
+  ASSERT(even.PayloadTypeID() == LibXR::TypeID::GetID<int>());
+  static int cb_count = 0;
+  static int cb_last = -1;
+  auto cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, int& value)
+      {
+        ASSERT(value % 2 == 0);
+        cb_count++;
+        cb_last = value;
+      },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(cb, even);
+
+  static uint64_t threshold_us = 700;
+  LibXR::Topic::Filter late;
+  late.Where(AfterStamp, &threshold_us);
+  auto async_suber = LibXR::Topic::ASyncSubscriber<int>(topic);
+  async_suber.SetFilter(late);
+  async_suber.StartWaiting();
+
+  for (int value = 0; value < 9; ++value)
+  {
+    topic.Publish(value, LibXR::MicrosecondTimestamp(100 * static_cast<uint64_t>(value)));
+    if (value == 6)
+    {
+      ASSERT(!async_suber.Available());
+    }
+  }
+
+  ASSERT(decimated_queue.Size() == 3);
+  for (int expected : {0, 3, 6})
+  {
+    int value = -1;
+    ASSERT(decimated_queue.Pop(value) == LibXR::ErrorCode::OK && value == expected);
+  }
+  ASSERT(decimate.Rejected() == 6);
+
+  ASSERT(throttled_queue.Size() == 3);
+  for (uint64_t expected_us : {0, 300, 600})
+  {
+    LibXR::Topic::Message<int> message;
+    ASSERT(throttled_queue.Pop(message) == LibXR::ErrorCode::OK);
+    ASSERT(TimestampUs(message.timestamp) == expected_us);
+  }
+  ASSERT(throttle.Rejected() == 6);
+
+  ASSERT(even_calls == 9 && cb_count == 5 && cb_last == 8);
+  ASSERT(even.Rejected() == 4);
+
+  ASSERT(async_suber.Available() && async_suber.GetData() == 7);
+  ASSERT(late.Rejected() == 7);
+
+  LibXR::Topic::TopicStats stats;
+  ASSERT(topic.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(stats.published == 9);
+  ASSERT(stats.delivered[static_cast<size_t>(LibXR::Topic::SuberType::QUEUE)] == 6);
+  ASSERT(stats.delivered[static_cast<size_t>(LibXR::Topic::SuberType::CALLBACK)] == 5);
+  ASSERT(stats.delivered[static_cast<size_t>(LibXR::Topic::SuberType::ASYNC)] == 2);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicFilterBatch`。 Test-item function
+ * `TestTopicFilterBatch`.
+ * @details 测试内容：验证批量发布下的过滤以及清除过滤器。 Verify filtering on batch
+ * publishes and clearing a filter.
+ *          测试原理：一个带抽取过滤器的队列和一个普通队列同时订阅，批量发布后比对两者的
+ * 内容，再清除过滤器重发一次。 Subscribe one decimated queue and one plain queue, compare
+ * both after a batch publish, then clear the filter and publish again.
+ */
+void TestTopicFilterBatch()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_filter_batch_domain");
+  auto topic = LibXR::Topic::CreateTopic<int>("filter_batch_tp", &domain);
+
+  LibXR::SPSCQueue<int> filtered_queue(16);
+  auto filtered_suber = LibXR::Topic::QueuedSubscriber(topic, filtered_queue);
+  LibXR::SPSCQueue<int> plain_queue(16);
+  auto plain_suber = LibXR::Topic::QueuedSubscriber(topic, plain_queue);
+  UNUSED(plain_suber);
+
+  LibXR::Topic::Filter filter;
+  filter.Decimate(2);
+  filtered_suber.SetFilter(filter);
+
+  int burst[6] = {10, 11, 12, 13, 14, 15};
+  topic.PublishBatch(std::span(burst));
+
+  ASSERT(plain_queue.Size() == 6);
+  ASSERT(filtered_queue.Size() == 3);
+  for (int expected : {10, 12, 14})
+  {
+    int value = -1;
+    ASSERT(filtered_queue.Pop(value) == LibXR::ErrorCode::OK && value == expected);
+  }
+  ASSERT(filter.Rejected() == 3);
+  ASSERT(filtered_suber.GetStats().dropped == 0);
+
+  filtered_suber.ClearFilter();
+  topic.PublishBatch(std::span(burst));
+  ASSERT(filtered_queue.Size() == 6);
+  ASSERT(filter.Rejected() == 3);
+}
+
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunTopicFilterTests`。 Test-item function `RunTopicFilterTests`.
+ * @details 测试内容：执行类型化 `Topic` 订阅者过滤器子场景。 Execute typed `Topic`
+ * subscriber-filter sub-scenarios. 测试原理：把单条发布与批量发布的过滤分开成组。
+ * Group filtering on single and batch publishes separately.
+ */
+void RunTopicFilterTests()
+{
+  TestTopicFilterKinds();
+  TestTopicFilterBatch();
+}
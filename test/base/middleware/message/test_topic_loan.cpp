@@ -0,0 +1,207 @@
+/**
+ * @file test_topic_loan.cpp
+ * @brief 类型化 `Topic` 出借槽位零拷贝发布子测试。 Split test unit for typed `Topic`
+ * loaned-slot zero-copy publish scenarios.
+ * @details 测试项目：
+ *          1. 出借发布时 async 与引用队列订阅者共享同一槽位，async 读取时拷出，
+ *             最后释放者归还槽位。
+ *          2. 普通发布经引用队列订阅者时借槽拷贝一次，出借池耗尽时报告 `EMPTY`。
+ *          3. 引用队列订阅者析构或被移动赋值覆盖时注销并归还排队槽位。
+ *          Test items:
+ *          1. Loaned publishes share one slot across async and reference-queue
+ *             subscribers, async copies it out on read, and the last releaser
+ *             returns the slot.
+ *          2. Plain publishes borrow and copy once for reference-queue subscribers,
+ *             and an exhausted loan pool reports `EMPTY`.
+ *          3. Destroying or move-assigning over a reference-queue subscriber
+ *             unregisters it and returns its queued slots.
+ */
+#include <utility>
+
+#include "topic_test_common.hpp"
+
+namespace
+{
+
+/**
+ * @brief 测试项函数 `TestTopicLoanSharedSlot`。 Test-item function
+ * `TestTopicLoanSharedSlot`.
+ * @details 测试内容：执行当前辅助测试项对应的具体场景与断言。 Execute the concrete
+ * scenario and assertions for the current helper-scoped test item.
+ *          测试原理：把一个可单独说明的测试项目拆成独立函数，便于定位失败点并复用场景。
+ * Split one explainable test item into an independent function so failures and reused
+ * scenarios stay easy to locate.
+ */
+void TestTopicLoanSharedSlot()
+{
+  // 测试内容：验证出借发布不拷贝 payload，且引用计数归零后槽位回到池中。
+  // Test coverage: verify loaned publishes do not copy the payload and the slot
+  // returns to the pool once its reference count drops to zero.
+  auto domain = LibXR::Topic::Domain("message_topic_loan_domain");
+  auto topic = LibXR::Topic::CreateTopic<WideAlignedPayload>("loan_shared_tp", &domain);
+
+  LibXR::Topic::LoanedData<WideAlignedPayload> loaned;
+  ASSERT(topic.Loan(loaned) == LibXR::ErrorCode::NOT_SUPPORT);
+  ASSERT(topic.EnableLoan(3) == LibXR::ErrorCode::OK);
+  auto pool = LibXR::Topic::TopicHandle(topic)->data_.loan_pool.load();
+  ASSERT(pool != nullptr);
+  ASSERT(pool->SlotCount() == 3);
+
+  auto async_suber = LibXR::Topic::ASyncSubscriber<WideAlignedPayload>(topic);
+  auto ref_suber_a = LibXR::Topic::LoanQueuedSubscriber<WideAlignedPayload>(topic, 4);
+  auto ref_suber_b = LibXR::Topic::LoanQueuedSubscriber<WideAlignedPayload>(topic, 4);
+
+  static const WideAlignedPayload* cb_addr = nullptr;
+  auto cb = LibXR::Topic::Callback::Create(
+      [](bool, void*, WideAlignedPayload& data) { cb_addr = &data; },
+      reinterpret_cast<void*>(0));
+  topic.RegisterCallback(cb);
+
+  ASSERT(topic.Loan(loaned) == LibXR::ErrorCode::OK);
+  auto* slot_addr = loaned.GetData();
+  ASSERT(reinterpret_cast<uintptr_t>(slot_addr) % alignof(WideAlignedPayload) == 0);
+  loaned->left = 0x1122334455667788ULL;
+  loaned->right = 0x99aabbccddeeff00ULL;
+  ASSERT(pool->FreeCount() == 2);
+
+  async_suber.StartWaiting();
+  const LibXR::MicrosecondTimestamp timestamp0(4242);
+  ASSERT(topic.PublishLoan(loaned, timestamp0) == LibXR::ErrorCode::OK);
+  ASSERT(!loaned.Valid());
+  ASSERT(cb_addr == slot_addr);
+
+  ASSERT(async_suber.Available());
+  ASSERT(pool->FreeCount() == 2);
+  const auto& async_data = async_suber.GetData();
+  ASSERT(&async_data != slot_addr);
+  ASSERT(async_data.left == 0x1122334455667788ULL);
+  ASSERT(async_data.right == 0x99aabbccddeeff00ULL);
+  ASSERT(TimestampUs(async_suber.GetTimestamp()) == TimestampUs(timestamp0));
+
+  LibXR::Topic::LoanedData<WideAlignedPayload> ref_a;
+  LibXR::Topic::LoanedData<WideAlignedPayload> ref_b;
+  ASSERT(ref_suber_a.Pop(ref_a) == LibXR::ErrorCode::OK);
+  ASSERT(ref_suber_b.Pop(ref_b) == LibXR::ErrorCode::OK);
+  ASSERT(ref_a.GetData() == slot_addr);
+  ASSERT(ref_b.GetData() == slot_addr);
+  ASSERT(ref_a->left == 0x1122334455667788ULL);
+  ASSERT(TimestampUs(ref_b.GetTimestamp()) == TimestampUs(timestamp0));
+  ASSERT(ref_suber_a.Pop(ref_a) == LibXR::ErrorCode::EMPTY);
+  ASSERT(ref_a.Valid());
+
+  ref_a.Reset();
+  ref_b.Reset();
+  ASSERT(pool->FreeCount() == 3);
+
+  LibXR::Topic::LoanedData<WideAlignedPayload> unused;
+  ASSERT(topic.PublishLoan(unused) == LibXR::ErrorCode::PTR_NULL);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicLoanPlainPublishAndExhaustion`。 Test-item function
+ * `TestTopicLoanPlainPublishAndExhaustion`.
+ * @details 测试内容：执行当前辅助测试项对应的具体场景与断言。 Execute the concrete
+ * scenario and assertions for the current helper-scoped test item.
+ *          测试原理：把一个可单独说明的测试项目拆成独立函数，便于定位失败点并复用场景。
+ * Split one explainable test item into an independent function so failures and reused
+ * scenarios stay easy to locate.
+ */
+void TestTopicLoanPlainPublishAndExhaustion()
+{
+  // 测试内容：验证普通发布仍能送达引用队列订阅者，以及池耗尽时的借出与丢弃契约。
+  // Test coverage: verify plain publishes still reach reference-queue subscribers,
+  // plus the loan and drop contract once the pool is exhausted.
+  auto domain = LibXR::Topic::Domain("message_topic_loan_domain");
+  auto topic = LibXR::Topic::CreateTopic<PrefixIntPayload>("loan_plain_tp", &domain);
+  ASSERT(topic.EnableLoan(2) == LibXR::ErrorCode::OK);
+  auto pool = LibXR::Topic::TopicHandle(topic)->data_.loan_pool.load();
+
+  auto ref_suber = LibXR::Topic::LoanQueuedSubscriber<PrefixIntPayload>(topic, 4);
+
+  PrefixIntPayload plain{17, 0};
+  topic.Publish(plain, LibXR::MicrosecondTimestamp(100));
+  ASSERT(ref_suber.Size() == 1);
+  ASSERT(pool->FreeCount() == 1);
+
+  LibXR::Topic::LoanedData<PrefixIntPayload> held;
+  ASSERT(topic.Loan(held) == LibXR::ErrorCode::OK);
+  ASSERT(pool->FreeCount() == 0);
+
+  LibXR::Topic::LoanedData<PrefixIntPayload> extra;
+  ASSERT(topic.Loan(extra) == LibXR::ErrorCode::EMPTY);
+
+  PrefixIntPayload dropped{99, 0};
+  topic.Publish(dropped, LibXR::MicrosecondTimestamp(200));
+  ASSERT(ref_suber.Size() == 1);
+
+  LibXR::Topic::LoanedData<PrefixIntPayload> received;
+  ASSERT(ref_suber.Pop(received) == LibXR::ErrorCode::OK);
+  ASSERT(received->value == 17);
+  ASSERT(TimestampUs(received.GetTimestamp()) == 100);
+
+  held->value = 23;
+  ASSERT(topic.PublishLoan(held, LibXR::MicrosecondTimestamp(300)) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(ref_suber.Pop(received) == LibXR::ErrorCode::OK);
+  ASSERT(received->value == 23);
+  ASSERT(pool->FreeCount() == 1);
+
+  received.Reset();
+  ASSERT(pool->FreeCount() == 2);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicLoanQueueRelease`。 Test-item function
+ * `TestTopicLoanQueueRelease`.
+ * @details 测试内容：验证引用队列订阅者析构和被移动赋值覆盖时归还排队槽位。 Verify
+ * that destroying or move-assigning over a reference-queue subscriber returns its
+ * queued slots.
+ *          测试原理：让排队引用占住出借池，再比较订阅者离开前后的空闲槽位数，并确认
+ * 之后的发布不再借槽。 Let queued references pin the loan pool, compare the free slot
+ * count before and after the subscriber goes away, and check that later publishes
+ * borrow nothing.
+ */
+void TestTopicLoanQueueRelease()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_loan_domain");
+  auto topic = LibXR::Topic::CreateTopic<PrefixIntPayload>("loan_release_tp", &domain);
+  ASSERT(topic.EnableLoan(4) == LibXR::ErrorCode::OK);
+  auto pool = LibXR::Topic::TopicHandle(topic)->data_.loan_pool.load();
+
+  PrefixIntPayload payload{1, 0};
+  {
+    auto ref_suber = LibXR::Topic::LoanQueuedSubscriber<PrefixIntPayload>(topic, 4);
+    topic.Publish(payload);
+    topic.Publish(payload);
+    ASSERT(pool->FreeCount() == 2);
+  }
+  ASSERT(pool->FreeCount() == 4);
+  topic.Publish(payload);
+  ASSERT(pool->FreeCount() == 4);
+
+  auto first = LibXR::Topic::LoanQueuedSubscriber<PrefixIntPayload>(topic, 4);
+  topic.Publish(payload);
+  ASSERT(pool->FreeCount() == 3);
+  auto second = LibXR::Topic::LoanQueuedSubscriber<PrefixIntPayload>(topic, 4);
+  first = std::move(second);
+  ASSERT(pool->FreeCount() == 4);
+  topic.Publish(payload);
+  ASSERT(first.Size() == 1);
+  ASSERT(pool->FreeCount() == 3);
+}
+
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunTopicLoanTests`。 Test-item function `RunTopicLoanTests`.
+ * @details 测试内容：执行类型化 `Topic` 出借槽位发布子场景。 Execute typed `Topic`
+ * loaned-slot publish sub-scenarios. 测试原理：把槽位共享、引用计数归还和池耗尽单独
+ * 成组，聚焦零拷贝发布契约。 Group slot sharing, reference-count return, and pool
+ * exhaustion around the zero-copy publish contract.
+ */
+void RunTopicLoanTests()
+{
+  TestTopicLoanSharedSlot();
+  TestTopicLoanPlainPublishAndExhaustion();
+  TestTopicLoanQueueRelease();
+}
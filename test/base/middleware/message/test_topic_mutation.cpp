@@ -5,10 +5,14 @@
  * @details 测试项目：
  *          1. 可变 callback 订阅者能修改调用者可见 payload。
  *          2. 队列订阅者满载时会丢弃后续发布。
+ *          3. 队列订阅者的溢出策略与丢包/最大深度计数。
  *          Test items:
  *          1. Mutable callback subscribers can modify the caller-visible payload.
  *          2. Queued subscribers drop later publishes when the queue is full.
+ *          3. Overflow policies and drop/high-watermark counters of queued subscribers.
  */
+#include <atomic>
+
 #include "topic_test_common.hpp"
 
 namespace
@@ -61,6 +65,104 @@ void TestTopicMutationAndQueueDrop()
   ASSERT(drop_queue.Pop(dropped_message) == LibXR::ErrorCode::EMPTY);
 }
 
+/**
+ * @brief 测试项函数 `TestTopicQueueOverflowPolicies`。 Test-item function
+ * `TestTopicQueueOverflowPolicies`.
+ * @details 测试内容：验证 `DROP_NEWEST`、`OVERWRITE_OLDEST`、`BLOCK` 三种溢出策略的
+ * 保留内容和计数。 Verify what the `DROP_NEWEST`, `OVERWRITE_OLDEST`, and `BLOCK`
+ * overflow policies keep, and how they count.
+ *          测试原理：先把队列灌满再多发布两次，对比队内剩余消息与 `GetStats()`。
+ * Fill the queue, publish twice more, and compare the remaining entries with
+ * `GetStats()`.
+ */
+void TestTopicQueueOverflowPolicies()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_mutation_domain");
+
+  auto drop_topic = LibXR::Topic::CreateTopic<int>("queue_policy_drop_tp", &domain);
+  LibXR::SPSCQueue<int> drop_queue(2);
+  auto drop_suber = LibXR::Topic::QueuedSubscriber(drop_topic, drop_queue);
+  for (int i = 0; i < 4; ++i)
+  {
+    drop_topic.Publish(i, LibXR::MicrosecondTimestamp(100 + i));
+  }
+  auto stats = drop_suber.GetStats();
+  ASSERT(stats.dropped == 2 && stats.high_watermark == 2);
+  int value = -1;
+  ASSERT(drop_queue.Pop(value) == LibXR::ErrorCode::OK && value == 0);
+  drop_suber.ResetStats();
+  ASSERT(drop_suber.GetStats().dropped == 0);
+
+  auto overwrite_topic =
+      LibXR::Topic::CreateTopic<int>("queue_policy_overwrite_tp", &domain);
+  LibXR::MPMCQueue<LibXR::Topic::Message<int>> overwrite_queue(2);
+  auto overwrite_suber =
+      LibXR::Topic::QueuedSubscriber(overwrite_topic, overwrite_queue,
+                                     LibXR::Topic::QueueOverflowPolicy::OVERWRITE_OLDEST);
+  for (int i = 0; i < 4; ++i)
+  {
+    overwrite_topic.Publish(i, LibXR::MicrosecondTimestamp(200 + i));
+  }
+  stats = overwrite_suber.GetStats();
+  ASSERT(stats.dropped == 2 && stats.high_watermark == 2);
+  LibXR::Topic::Message<int> message{};
+  ASSERT(overwrite_queue.Pop(message) == LibXR::ErrorCode::OK);
+  ASSERT(message.data == 2 && TimestampUs(message.timestamp) == 202);
+  ASSERT(overwrite_queue.Pop(message) == LibXR::ErrorCode::OK && message.data == 3);
+
+  auto block_topic = LibXR::Topic::CreateTopic<int>("queue_policy_block_tp", &domain);
+  LibXR::SPSCQueue<int> block_queue(1);
+  auto block_suber = LibXR::Topic::QueuedSubscriber(
+      block_topic, block_queue, LibXR::Topic::QueueOverflowPolicy::BLOCK, 2);
+  int first = 1;
+  int second = 2;
+  block_topic.Publish(first, LibXR::MicrosecondTimestamp(300));
+  const uint32_t start = LibXR::Thread::GetTime();
+  block_topic.Publish(second, LibXR::MicrosecondTimestamp(301));
+  ASSERT(LibXR::Thread::GetTime() - start >= 2);
+  ASSERT(block_suber.GetStats().dropped == 1);
+  // 回调路径不能阻塞，满队列时直接丢。Callback paths cannot block and drop at once.
+  block_topic.PublishFromCallback(second, LibXR::MicrosecondTimestamp(302), false);
+  ASSERT(block_suber.GetStats().dropped == 2);
+  ASSERT(block_queue.Pop(value) == LibXR::ErrorCode::OK && value == first);
+
+  // 低优先级消费者经 `Pop()` 取数，会把挂起的 `BLOCK` 发布者立即唤醒。
+  // A lower-priority consumer popping through `Pop()` wakes the parked `BLOCK`
+  // publisher right away.
+  auto wake_topic = LibXR::Topic::CreateTopic<int>("queue_policy_block_wake_tp", &domain);
+  LibXR::SPSCQueue<int> wake_queue(1);
+  auto wake_suber = LibXR::Topic::QueuedSubscriber(
+      wake_topic, wake_queue, LibXR::Topic::QueueOverflowPolicy::BLOCK, 1000);
+  struct WakeArg
+  {
+    LibXR::Topic::QueuedSubscriber* suber;
+    std::atomic<int>* popped;
+  };
+  std::atomic<int> popped = -1;
+  wake_topic.Publish(first, LibXR::MicrosecondTimestamp(400));
+  LibXR::Thread consumer;
+  consumer.Create<WakeArg>(
+      WakeArg{&wake_suber, &popped},
+      [](WakeArg arg)
+      {
+        LibXR::Thread::Sleep(5);
+        int item = -1;
+        ASSERT(arg.suber->Pop(item) == LibXR::ErrorCode::OK);
+        arg.popped->store(item, std::memory_order_release);
+      },
+      "block_wake", 1024, LibXR::Thread::Priority::LOW);
+  const uint32_t wake_start = LibXR::Thread::GetTime();
+  wake_topic.Publish(second, LibXR::MicrosecondTimestamp(401));
+  ASSERT(LibXR::Thread::GetTime() - wake_start < 500);
+  ASSERT(wake_suber.GetStats().dropped == 0);
+  while (popped.load(std::memory_order_acquire) == -1)
+  {
+    LibXR::Thread::Sleep(1);
+  }
+  ASSERT(popped.load(std::memory_order_acquire) == first);
+  ASSERT(wake_suber.Pop(value) == LibXR::ErrorCode::OK && value == second);
+}
+
 }  // namespace
 
 /**
@@ -70,4 +172,8 @@ void TestTopicMutationAndQueueDrop()
  * 回写和背压丢弃单独成组，聚焦订阅者副作用契约。 Group payload writeback and
  * backpressure-drop behavior around subscriber side-effect contracts.
  */
-void RunTopicMutationTests() { TestTopicMutationAndQueueDrop(); }
+void RunTopicMutationTests()
+{
+  TestTopicMutationAndQueueDrop();
+  TestTopicQueueOverflowPolicies();
+}
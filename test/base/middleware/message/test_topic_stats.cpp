@@ -0,0 +1,193 @@
+/**
+ * @file test_topic_stats.cpp
+ * @brief 类型化 `Topic` 运行统计子测试。 Split test unit for typed `Topic` runtime
+ * statistics.
+ * @details 测试项目：
+ *          1. 未启用时只报告键值、大小和订阅者数；启用后单条与批量发布都计入发布数、
+ *             字节数、分发次数和各种类订阅者投递数，清零后归零；满队列丢弃的不算投递。
+ *          2. 域遍历访问全部 topic，域级启用和终端命令作用于整个域。
+ *          Test items:
+ *          1. When disabled only the key, size, and subscriber counts are reported;
+ *             once enabled, single and batch publishes both count toward publishes,
+ *             bytes, dispatch calls, and per-kind deliveries, and a reset clears them.
+ *             Messages a full queue drops are not counted as deliveries.
+ *          2. Domain enumeration visits every topic, and domain-wide enabling and the
+ *             terminal command act on the whole domain.
+ */
+#include <span>
+
+#include "topic_test_common.hpp"
+
+namespace
+{
+
+/**
+ * @brief 辅助函数 `SubscriberIndex`。 Helper function `SubscriberIndex`.
+ * @details 测试内容：把订阅者种类换成统计数组下标。 Turn a subscriber kind into a
+ * statistics array index.
+ *          测试原理：与实现使用相同的下标约定。 Use the same indexing convention as the
+ * implementation.
+ */
+size_t SubscriberIndex(LibXR::Topic::SuberType type) { return static_cast<size_t>(type); }
+
+/**
+ * @brief 测试项函数 `TestTopicStatsCounters`。 Test-item function
+ * `TestTopicStatsCounters`.
+ * @details 测试内容：验证统计的启用、计数、快照和清零契约。 Verify the enable, count,
+ * snapshot, and reset contract of topic statistics.
+ *          测试原理：挂一个队列订阅者和一个回调，混合单条与批量发布后比对计数。 Attach
+ * one queued subscriber and one callback, mix single and batch publishes, then compare
+ * the counters.
+ */
+void TestTopicStatsCounters()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_stats_domain");
+  auto topic = LibXR::Topic::CreateTopic<int>("stats_counter_tp", &domain);
+
+  LibXR::SPSCQueue<int> queue(16);
+  auto queue_suber = LibXR::Topic::QueuedSubscriber(topic, queue);
+  UNUSED(queue_suber);
+  static int cb_count = 0;
+  auto cb = LibXR::Topic::Callback::Create([](bool, void*, int&) { cb_count++; },
+                                           reinterpret_cast<void*>(0));
+  topic.RegisterCallback(cb);
+
+  LibXR::Topic::TopicStats stats;
+  ASSERT(topic.GetStats(stats) == LibXR::ErrorCode::NOT_SUPPORT);
+  ASSERT(stats.key == topic.GetKey());
+  ASSERT(stats.payload_size == sizeof(int));
+  ASSERT(stats.published == 0);
+  ASSERT(stats.subscribers[SubscriberIndex(LibXR::Topic::SuberType::QUEUE)] == 1);
+  ASSERT(stats.subscribers[SubscriberIndex(LibXR::Topic::SuberType::CALLBACK)] == 1);
+  ASSERT(topic.ResetStats() == LibXR::ErrorCode::NOT_SUPPORT);
+
+  int before = 1;
+  topic.Publish(before);
+
+  ASSERT(topic.EnableStats() == LibXR::ErrorCode::OK);
+  auto store = LibXR::Topic::TopicHandle(topic)->data_.stats.load();
+  ASSERT(store != nullptr);
+  ASSERT(topic.EnableStats() == LibXR::ErrorCode::OK);
+  ASSERT(LibXR::Topic::TopicHandle(topic)->data_.stats.load() == store);
+
+  for (int value = 0; value < 3; ++value)
+  {
+    topic.Publish(value);
+  }
+  int burst[4] = {3, 4, 5, 6};
+  topic.PublishBatch(std::span(burst));
+  ASSERT(cb_count == 8);
+
+  ASSERT(topic.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(stats.published == 7);
+  ASSERT(stats.published_bytes == 7 * sizeof(int));
+  ASSERT(stats.dispatches == 4);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::QUEUE)] == 7);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::CALLBACK)] == 7);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::SYNC)] == 0);
+
+  uint64_t samples = 0;
+  for (uint32_t bucket : stats.dispatch_histogram)
+  {
+    samples += bucket;
+  }
+  ASSERT(samples == stats.dispatches);
+
+  ASSERT(topic.ResetStats() == LibXR::ErrorCode::OK);
+  ASSERT(topic.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(stats.published == 0 && stats.published_bytes == 0);
+  ASSERT(stats.dispatches == 0 && stats.dispatch_max_us == 0);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::QUEUE)] == 0);
+  ASSERT(stats.subscribers[SubscriberIndex(LibXR::Topic::SuberType::QUEUE)] == 1);
+
+  // 队列放不下的那部分批量消息不算投递。The part of a burst that does not fit in the
+  // queue is not counted as delivered.
+  const size_t room = queue.EmptySize();
+  int overflow[16] = {};
+  topic.PublishBatch(std::span(overflow));
+  ASSERT(topic.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(room < 16);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::QUEUE)] == room);
+  ASSERT(stats.delivered[SubscriberIndex(LibXR::Topic::SuberType::CALLBACK)] == 16);
+}
+
+/**
+ * @brief 测试项函数 `TestTopicStatsDomain`。 Test-item function
+ * `TestTopicStatsDomain`.
+ * @details 测试内容：验证域遍历、域级启用和终端命令。 Verify domain enumeration,
+ * domain-wide enabling, and the terminal command.
+ *          测试原理：命令输出依赖 STDIO 绑定，这里只检查返回值和它对计数的作用。 The
+ * command output depends on the STDIO binding, so only its return value and its effect
+ * on the counters are checked here.
+ */
+void TestTopicStatsDomain()
+{
+  auto domain = LibXR::Topic::Domain("message_topic_stats_walk_domain");
+  auto first = LibXR::Topic::CreateTopic<int>("stats_walk_a", &domain);
+  auto second = LibXR::Topic::CreateTopic<double>("stats_walk_b", &domain);
+
+  size_t visited = 0;
+  bool saw_first = false;
+  bool saw_second = false;
+  ASSERT(domain.Foreach(
+             [&](LibXR::Topic topic)
+             {
+               visited++;
+               saw_first = saw_first || topic.GetKey() == first.GetKey();
+               saw_second = saw_second || topic.GetKey() == second.GetKey();
+               return LibXR::ErrorCode::OK;
+             }) == LibXR::ErrorCode::OK);
+  ASSERT(visited == 2 && saw_first && saw_second);
+
+  visited = 0;
+  ASSERT(domain.Foreach(
+             [&](LibXR::Topic)
+             {
+               visited++;
+               return LibXR::ErrorCode::FAILED;
+             }) == LibXR::ErrorCode::FAILED);
+  ASSERT(visited == 1);
+
+  char name[] = "topic_stats";
+  char enable[] = "enable";
+  char reset[] = "reset";
+  char bogus[] = "bogus";
+  char* enable_argv[] = {name, enable};
+  ASSERT(LibXR::Topic::StatsCommand(&domain, 2, enable_argv) == 0);
+
+  LibXR::Topic::TopicStats stats;
+  ASSERT(first.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(second.GetStats(stats) == LibXR::ErrorCode::OK);
+
+  int value = 7;
+  first.Publish(value);
+  double other = 1.5;
+  second.Publish(other);
+  ASSERT(second.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(stats.published == 1 && stats.published_bytes == sizeof(double));
+
+  char* dump_argv[] = {name};
+  ASSERT(LibXR::Topic::StatsCommand(&domain, 1, dump_argv) == 0);
+
+  char* reset_argv[] = {name, reset};
+  ASSERT(LibXR::Topic::StatsCommand(&domain, 2, reset_argv) == 0);
+  ASSERT(first.GetStats(stats) == LibXR::ErrorCode::OK);
+  ASSERT(stats.published == 0);
+
+  char* bogus_argv[] = {name, bogus};
+  ASSERT(LibXR::Topic::StatsCommand(&domain, 2, bogus_argv) == -1);
+}
+
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunTopicStatsTests`。 Test-item function `RunTopicStatsTests`.
+ * @details 测试内容：执行类型化 `Topic` 运行统计子场景。 Execute typed `Topic` runtime
+ * statistics sub-scenarios. 测试原理：把单 topic 计数与域级遍历分开成组。 Group
+ * per-topic counters and domain-wide enumeration separately.
+ */
+void RunTopicStatsTests()
+{
+  TestTopicStatsCounters();
+  TestTopicStatsDomain();
+}
@@ -0,0 +1,173 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "libxr.hpp"
+#include "libxr_def.hpp"
+#include "test.hpp"
+
+namespace
+{
+using SPSCBlocking = LibXR::BlockingQueue<LibXR::SPSCQueue<uint32_t>>;
+using MPMCBlocking = LibXR::BlockingQueue<LibXR::MPMCQueue<uint32_t>>;
+
+struct WorkerArg
+{
+  MPMCBlocking* queue;
+  uint32_t begin;
+  uint32_t count;
+  std::atomic<uint64_t>* sum;
+  std::atomic<uint32_t>* failures;
+};
+
+void ProducerTask(WorkerArg arg)
+{
+  for (uint32_t value = arg.begin; value < arg.begin + arg.count; ++value)
+  {
+    if (arg.queue->Push(value) != LibXR::ErrorCode::OK)
+    {
+      arg.failures->fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void ConsumerTask(WorkerArg arg)
+{
+  for (uint32_t index = 0; index < arg.count; ++index)
+  {
+    uint32_t value = 0;
+    if (arg.queue->Pop(value) != LibXR::ErrorCode::OK)
+    {
+      arg.failures->fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    arg.sum->fetch_add(value, std::memory_order_relaxed);
+  }
+}
+
+struct SleeperArg
+{
+  SPSCBlocking* queue;
+  std::atomic<uint32_t>* received;
+};
+
+void SleeperTask(SleeperArg arg)
+{
+  uint32_t value = 0;
+  if (arg.queue->Pop(value, 2000) == LibXR::ErrorCode::OK)
+  {
+    arg.received->store(value, std::memory_order_release);
+  }
+}
+}  // namespace
+
+void test_blocking_queue()
+{
+  // Event count: a stale key returns at once, a current key times out, and a
+  // notification with nobody parked leaves nothing behind.
+  {
+    LibXR::EventCount event;
+    const LibXR::EventCount::Key stale = event.PrepareWait();
+    event.NotifyOne();
+    ASSERT(event.Wait(stale, 0) == LibXR::ErrorCode::OK);
+
+    const LibXR::EventCount::Key current = event.PrepareWait();
+    ASSERT(current != stale);
+    ASSERT(event.Wait(current, 0) == LibXR::ErrorCode::TIMEOUT);
+    const uint32_t start_ms = LibXR::Thread::GetTime();
+    ASSERT(event.Wait(current, 20) == LibXR::ErrorCode::TIMEOUT);
+    ASSERT(static_cast<uint32_t>(LibXR::Thread::GetTime() - start_ms) >= 15U);
+    ASSERT(event.Waiters() == 0);
+
+    event.NotifyAll();
+    const LibXR::EventCount::Key next = event.PrepareWait();
+    ASSERT(event.Wait(next, 10) == LibXR::ErrorCode::TIMEOUT);
+  }
+
+  // Blocking queue timeouts on both sides.
+  {
+    SPSCBlocking queue(4);
+    uint32_t value = 0;
+
+    ASSERT(queue.Pop(value, 0) == LibXR::ErrorCode::TIMEOUT);
+    const uint32_t start_ms = LibXR::Thread::GetTime();
+    ASSERT(queue.Pop(value, 20) == LibXR::ErrorCode::TIMEOUT);
+    ASSERT(static_cast<uint32_t>(LibXR::Thread::GetTime() - start_ms) >= 15U);
+
+    for (uint32_t item = 0; item < 4; ++item)
+    {
+      ASSERT(queue.Push(item, 0) == LibXR::ErrorCode::OK);
+    }
+    ASSERT(queue.Size() == 4);
+    ASSERT(queue.EmptySize() == 0);
+    ASSERT(queue.Push(4, 10) == LibXR::ErrorCode::TIMEOUT);
+    ASSERT(queue.PushFromCallback(4, false) == LibXR::ErrorCode::FULL);
+
+    ASSERT(queue.PopFromCallback(value, false) == LibXR::ErrorCode::OK);
+    ASSERT(value == 0);
+    ASSERT(queue.Push(4) == LibXR::ErrorCode::OK);
+    for (uint32_t expected = 1; expected <= 4; ++expected)
+    {
+      ASSERT(queue.Pop(value) == LibXR::ErrorCode::OK);
+      ASSERT(value == expected);
+    }
+    ASSERT(queue.Raw().Size() == 0);
+  }
+
+  // A parked consumer is woken by a later push.
+  {
+    SPSCBlocking queue(2);
+    std::atomic<uint32_t> received = 0;
+    LibXR::Thread sleeper;
+    sleeper.Create<SleeperArg>(SleeperArg{&queue, &received}, SleeperTask,
+                               "blocking_sleeper", 1024,
+                               LibXR::Thread::Priority::REALTIME);
+
+    LibXR::Thread::Sleep(20);
+    ASSERT(queue.PushFromCallback(77, false) == LibXR::ErrorCode::OK);
+    ASSERT(sleeper.Join() == LibXR::ErrorCode::OK);
+    ASSERT(received.load(std::memory_order_acquire) == 77);
+  }
+
+  // Producers and consumers that only ever block, never poll, on a tiny MPMC queue.
+  {
+    constexpr uint32_t PRODUCER_COUNT = 2;
+    constexpr uint32_t CONSUMER_COUNT = 2;
+    constexpr uint32_t ITEMS_PER_PRODUCER = 20000;
+    constexpr uint32_t TOTAL_ITEMS = PRODUCER_COUNT * ITEMS_PER_PRODUCER;
+    constexpr uint64_t EXPECTED_SUM =
+        static_cast<uint64_t>(TOTAL_ITEMS) * (TOTAL_ITEMS - 1) / 2;
+
+    MPMCBlocking queue(4);
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint32_t> failures = 0;
+    LibXR::Thread producers[PRODUCER_COUNT];
+    LibXR::Thread consumers[CONSUMER_COUNT];
+
+    for (uint32_t index = 0; index < CONSUMER_COUNT; ++index)
+    {
+      consumers[index].Create<WorkerArg>(
+          WorkerArg{&queue, 0, TOTAL_ITEMS / CONSUMER_COUNT, &sum, &failures},
+          ConsumerTask, "blocking_cons", 1024, LibXR::Thread::Priority::REALTIME);
+    }
+    for (uint32_t index = 0; index < PRODUCER_COUNT; ++index)
+    {
+      producers[index].Create<WorkerArg>(
+          WorkerArg{&queue, index * ITEMS_PER_PRODUCER, ITEMS_PER_PRODUCER, &sum,
+                    &failures},
+          ProducerTask, "blocking_prod", 1024, LibXR::Thread::Priority::REALTIME);
+    }
+
+    for (auto& producer : producers)
+    {
+      ASSERT(producer.Join() == LibXR::ErrorCode::OK);
+    }
+    for (auto& consumer : consumers)
+    {
+      ASSERT(consumer.Join() == LibXR::ErrorCode::OK);
+    }
+    ASSERT(failures.load(std::memory_order_relaxed) == 0);
+    ASSERT(sum.load(std::memory_order_relaxed) == EXPECTED_SUM);
+    ASSERT(queue.Size() == 0);
+  }
+}
@@ -0,0 +1,222 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+#include "libxr.hpp"
+#include "libxr_def.hpp"
+#include "test.hpp"
+
+namespace
+{
+using Queue = LibXR::CachedSPSCQueue<uint32_t>;
+
+struct WorkerArg
+{
+  Queue* queue;
+  uint32_t total_items;
+  std::atomic<bool>* in_order;
+};
+
+void ProducerTask(WorkerArg arg)
+{
+  for (uint32_t value = 0; value < arg.total_items; ++value)
+  {
+    while (arg.queue->Push(value) != LibXR::ErrorCode::OK)
+    {
+      LibXR::Thread::Yield();
+    }
+  }
+}
+
+void ConsumerTask(WorkerArg arg)
+{
+  for (uint32_t expected = 0; expected < arg.total_items; ++expected)
+  {
+    uint32_t value = UINT32_MAX;
+    while (arg.queue->Pop(value) != LibXR::ErrorCode::OK)
+    {
+      LibXR::Thread::Yield();
+    }
+    if (value != expected)
+    {
+      arg.in_order->store(false, std::memory_order_relaxed);
+    }
+  }
+}
+
+// Use std::deque as the reference model and drive random batch pushes, pops and peeks
+// so batches keep crossing the ring end at every offset.
+template <typename QueueType>
+void CheckBatchesAgainstModel(QueueType& queue)
+{
+  using Value = typename QueueType::ValueType;
+  constexpr size_t MAX_BATCH = 64;
+  const size_t capacity = queue.MaxSize();
+  ASSERT(capacity + 1 <= MAX_BATCH);
+
+  std::deque<Value> model;
+  Value batch[MAX_BATCH] = {};
+  uint32_t next_value = 0;
+  uint32_t seed = 0x2545F491U;
+  for (uint32_t round = 0; round < 4000; ++round)
+  {
+    seed = seed * 1664525U + 1013904223U;
+    const size_t count = (seed >> 16) % (capacity + 2);
+    switch ((seed >> 8) % 3)
+    {
+      case 0:
+      {
+        for (size_t index = 0; index < count; ++index)
+        {
+          batch[index] = static_cast<Value>(next_value + index);
+        }
+        const bool fits = count <= capacity - model.size();
+        ASSERT(queue.PushBatch(batch, count) ==
+               (fits ? LibXR::ErrorCode::OK : LibXR::ErrorCode::FULL));
+        if (fits)
+        {
+          model.insert(model.end(), batch, batch + count);
+          next_value += static_cast<uint32_t>(count);
+        }
+        break;
+      }
+      case 1:
+      case 2:
+      {
+        const bool pop = (seed >> 8) % 3 == 1;
+        const bool enough = count <= model.size();
+        const LibXR::ErrorCode ans =
+            pop ? queue.PopBatch(batch, count) : queue.PeekBatch(batch, count);
+        ASSERT(ans == (enough ? LibXR::ErrorCode::OK : LibXR::ErrorCode::EMPTY));
+        if (enough)
+        {
+          for (size_t index = 0; index < count; ++index)
+          {
+            ASSERT(batch[index] == model[index]);
+          }
+          if (pop)
+          {
+            model.erase(model.begin(), model.begin() + static_cast<ptrdiff_t>(count));
+          }
+        }
+        break;
+      }
+    }
+    ASSERT(queue.Size() == model.size());
+  }
+}
+}  // namespace
+
+void test_cached_spsc_queue()
+{
+  // Capacity rounds up to a power of two and every slot is usable.
+  {
+    Queue queue(3);
+    uint32_t value = 0;
+
+    ASSERT(queue.MaxSize() == 4);
+    ASSERT(queue.Size() == 0);
+    ASSERT(queue.EmptySize() == 4);
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+    ASSERT(queue.Peek(value) == LibXR::ErrorCode::EMPTY);
+
+    for (uint32_t item = 1; item <= 4; ++item)
+    {
+      ASSERT(queue.Push(item) == LibXR::ErrorCode::OK);
+    }
+    ASSERT(queue.Push(5) == LibXR::ErrorCode::FULL);
+    ASSERT(queue.Size() == 4);
+    ASSERT(queue.EmptySize() == 0);
+
+    ASSERT(queue.Peek(value) == LibXR::ErrorCode::OK);
+    ASSERT(value == 1);
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::OK);
+    ASSERT(value == 1);
+    ASSERT(queue.Push(5) == LibXR::ErrorCode::OK);
+    for (uint32_t expected = 2; expected <= 5; ++expected)
+    {
+      ASSERT(queue.Pop(value) == LibXR::ErrorCode::OK);
+      ASSERT(value == expected);
+    }
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+
+    LibXR::CachedSPSCQueue<uint8_t> single(1);
+    ASSERT(single.MaxSize() == 1);
+    ASSERT(single.Push(7) == LibXR::ErrorCode::OK);
+    ASSERT(single.Push(8) == LibXR::ErrorCode::FULL);
+    ASSERT(single.Pop() == LibXR::ErrorCode::OK);
+    ASSERT(single.Pop() == LibXR::ErrorCode::EMPTY);
+  }
+
+  // Random batch sizes against a std::deque model, on word and byte queues.
+  {
+    Queue queue(16);
+    CheckBatchesAgainstModel(queue);
+    LibXR::CachedSPSCQueue<uint8_t> byte_queue(32);
+    CheckBatchesAgainstModel(byte_queue);
+  }
+
+  // Batch APIs across the wrap point, zero-length batches, and reset.
+  {
+    Queue queue(8);
+    uint32_t readback[8] = {};
+
+    ASSERT(queue.PushBatch(nullptr, 0) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PopBatch(nullptr, 0) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PeekBatch(nullptr, 0) == LibXR::ErrorCode::OK);
+
+    const uint32_t first[6] = {1, 2, 3, 4, 5, 6};
+    ASSERT(queue.PushBatch(first, 6) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PopBatch(readback, 5) == LibXR::ErrorCode::OK);
+    ASSERT(readback[0] == 1 && readback[4] == 5);
+
+    const uint32_t wrap[7] = {7, 8, 9, 10, 11, 12, 13};
+    ASSERT(queue.PushBatch(wrap, 7) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PushBatch(wrap, 1) == LibXR::ErrorCode::FULL);
+    ASSERT(queue.Size() == 8);
+
+    ASSERT(queue.PeekBatch(readback, 8) == LibXR::ErrorCode::OK);
+    for (uint32_t index = 0; index < 8; ++index)
+    {
+      ASSERT(readback[index] == index + 6);
+    }
+    ASSERT(queue.PopBatch(readback, 9) == LibXR::ErrorCode::EMPTY);
+    ASSERT(queue.PopBatch(nullptr, 3) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PopBatch(readback, 5) == LibXR::ErrorCode::OK);
+    ASSERT(readback[0] == 9 && readback[4] == 13);
+
+    ASSERT(queue.Push(99) == LibXR::ErrorCode::OK);
+    queue.Reset();
+    ASSERT(queue.Size() == 0);
+    uint32_t value = 0;
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+    ASSERT(queue.PushBatch(first, 6) == LibXR::ErrorCode::OK);
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::OK);
+    ASSERT(value == 1);
+  }
+
+  // End-to-end producer/consumer handoff under sustained contention. Both sides run
+  // at the same priority so they keep yielding to each other on a single core.
+  {
+    constexpr uint32_t TOTAL_ITEMS = 50000;
+    Queue queue(8);
+    std::atomic<bool> in_order = true;
+    LibXR::Thread producer;
+    LibXR::Thread consumer;
+
+    producer.Create<WorkerArg>(WorkerArg{&queue, TOTAL_ITEMS, &in_order}, ProducerTask,
+                               "cached_spsc_prod", 1024,
+                               LibXR::Thread::Priority::REALTIME);
+    consumer.Create<WorkerArg>(WorkerArg{&queue, TOTAL_ITEMS, &in_order}, ConsumerTask,
+                               "cached_spsc_cons", 1024,
+                               LibXR::Thread::Priority::REALTIME);
+
+    ASSERT(producer.Join() == LibXR::ErrorCode::OK);
+    ASSERT(consumer.Join() == LibXR::ErrorCode::OK);
+    ASSERT(in_order.load(std::memory_order_relaxed));
+    uint32_t value = 0;
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+    ASSERT(queue.Size() == 0);
+  }
+}
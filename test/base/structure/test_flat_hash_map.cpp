@@ -0,0 +1,74 @@
+/**
+ * @file test_flat_hash_map.cpp
+ * @brief 平铺哈希表插入、查找与扩容测试。 Flat hash map insertion, lookup and growth
+ * tests.
+ *
+ * 测试项目 / Test items:
+ * 1. 边界键的插入与查找。 Boundary keys: verify 0, all-ones and sign-bit keys are
+ * stored and found like any other key.
+ * 2. 重复插入与扩容。 Duplicate insert and growth: verify a duplicate key is rejected and
+ * that every key survives several rebuilds.
+ *
+ * 测试原理 / Test principles:
+ * 1. 用 0 作为键确认槽位占用标记与键值本身无关。 Use 0 as a key to confirm the slot
+ * occupancy flag is independent of the key value.
+ * 2. 从最小容量插到数千个元素，迫使表多次翻倍重建。 Insert thousands of keys from the
+ * smallest capacity so the table doubles several times.
+ */
+#include "crc.hpp"
+#include "libxr.hpp"
+#include "libxr_def.hpp"
+#include "test.hpp"
+
+/**
+ * @brief 测试入口函数 `test_flat_hash_map`。 Test entry function `test_flat_hash_map`.
+ * @details 测试内容：按本文件声明的测试项目顺序执行验证。 Execute the test items declared
+ * in this file in order. 测试原理：通过当前文件组织的测试场景组合，对外验证该模块契约。
+ * Validate the module contract through the scenarios assembled in this file.
+ */
+void test_flat_hash_map()
+{
+  // 测试内容：按文件头列出的测试项目顺序执行当前测试入口。
+  // Test coverage: execute the test items listed in this file header in sequence.
+  LibXR::FlatHashMap<int> map(1);
+  ASSERT(map.Size() == 0);
+  ASSERT(map.Find(0U) == nullptr);
+
+  constexpr uint32_t keys[] = {0U, 1U, 0x7FFFFFFFU, 0x80000000U, 0xFFFFFFFFU};
+  for (size_t i = 0; i < std::size(keys); i++)
+  {
+    ASSERT(map.Insert(keys[i], static_cast<int>(i)) == LibXR::ErrorCode::OK);
+  }
+  for (size_t i = 0; i < std::size(keys); i++)
+  {
+    const int* value = map.Find(keys[i]);
+    ASSERT(value != nullptr && *value == static_cast<int>(i));
+  }
+
+  ASSERT(map.Insert(0U, 42) == LibXR::ErrorCode::FAILED);
+  ASSERT(*map.Find(0U) == 0);
+  ASSERT(map.Size() == std::size(keys));
+
+  const int* kept = map.Find(1U);
+  constexpr uint32_t COUNT = 4096;
+  for (uint32_t i = 0; i < COUNT; i++)
+  {
+    const uint32_t key = LibXR::CRC32::Calculate(&i, sizeof(i));
+    if (map.Find(key) == nullptr)
+    {
+      ASSERT(map.Insert(key, static_cast<int>(i + 100)) == LibXR::ErrorCode::OK);
+    }
+  }
+  ASSERT(map.Size() * 2 <= map.Capacity());
+  ASSERT(*kept == 1);
+
+  for (uint32_t i = 0; i < COUNT; i++)
+  {
+    const uint32_t key = LibXR::CRC32::Calculate(&i, sizeof(i));
+    ASSERT(map.Find(key) != nullptr);
+  }
+  for (size_t i = 0; i < std::size(keys); i++)
+  {
+    ASSERT(map.Find(keys[i]) != nullptr);
+  }
+}
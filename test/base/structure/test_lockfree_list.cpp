@@ -8,6 +8,12 @@
  * the expected head-first traversal order after repeated `Add()` calls.
  * 2. `Foreach()` 非 `OK` 提前停止。 Early termination: verify `Foreach()` stops and
  * returns the callback's first non-`OK` result.
+ * 3. `Remove()` 摘除首、中、尾节点。 Blocking removal: verify `Remove()` unlinks the
+ * first, middle, and last nodes and reports `NOT_FOUND` for absent ones.
+ * 4. 遍历回调内 `Retire()` 延迟回收。 Deferred reclamation: verify a node retired from a
+ * `Foreach()` callback is only reclaimed after the traversal ends.
+ * 5. 并发遍历与删除。 Concurrent removal: verify readers never visit a node after it
+ * has been reclaimed while a writer keeps adding and removing nodes.
  *
  * 测试原理 / Test principles:
  * 1. 只观察公开遍历 API，因为 lock-free list 的契约是可见迭代行为。 Observe only the
@@ -15,23 +21,35 @@
  * behavior rather than internal link layout.
  * 2. 用显式非 `OK` 返回击中取消分支。 Use a non-`OK` callback return to drive the
  * cancellation branch explicitly.
+ * 3. 回收函数只打标记不释放内存，读者看到被标记的节点即说明宽限期失效。 Reclaim
+ * functions only mark nodes instead of freeing them, so a reader that sees a marked node
+ * proves the grace period was broken.
  */
+#include <atomic>
 #include <cstdint>
+#include <thread>
 
 #include "libxr.hpp"
 #include "libxr_def.hpp"
 #include "test.hpp"
 
-/**
- * @brief 测试入口函数 `test_lockfree_list`。 Test entry function `test_lockfree_list`.
- * @details 测试内容：按本文件声明的测试项目顺序执行验证。 Execute the test items declared
- * in this file in order. 测试原理：通过当前文件组织的测试场景组合，对外验证该模块契约。
- * Validate the module contract through the scenarios assembled in this file.
- */
-void test_lockfree_list()
+namespace
+{
+
+struct TrackedEntry
+{
+  uint32_t id = 0;
+  std::atomic<bool> alive = false;
+};
+
+void MarkReclaimed(LibXR::LockFreeList::BaseNode* node)
+{
+  static_cast<LibXR::LockFreeList::Node<TrackedEntry>*>(node)->data_.alive.store(
+      false, std::memory_order_release);
+}
+
+void TestTraversal()
 {
-  // 测试内容：按文件头列出的测试项目顺序执行当前测试入口。
-  // Test coverage: execute the test items listed in this file header in sequence.
   LibXR::LockFreeList::Node<int> node1(10);
   LibXR::LockFreeList::Node<int> node2(20);
   LibXR::LockFreeList::Node<int> node3(30);
@@ -63,4 +81,163 @@ void test_lockfree_list()
       });
   ASSERT(stop_result == LibXR::ErrorCode::BUSY);
   ASSERT(index == 2);
+
+  LibXR::LockFreeList::Node<int>* found = nullptr;
+  ASSERT(list.ForeachNode<int>(
+             [&](LibXR::LockFreeList::Node<int>& node)
+             {
+               if (*node == 20)
+               {
+                 found = &node;
+                 return LibXR::ErrorCode::BUSY;
+               }
+               return LibXR::ErrorCode::OK;
+             }) == LibXR::ErrorCode::BUSY);
+  ASSERT(found == &node2);
+}
+
+void TestRemove()
+{
+  LibXR::LockFreeList::Node<int> node1(10);
+  LibXR::LockFreeList::Node<int> node2(20);
+  LibXR::LockFreeList::Node<int> node3(30);
+  LibXR::LockFreeList::Node<int> node4(40);
+  LibXR::LockFreeList list;
+
+  list.Add(node1);
+  list.Add(node2);
+  list.Add(node3);
+  list.Add(node4);
+
+  ASSERT(list.Remove(node3) == LibXR::ErrorCode::OK);
+  ASSERT(list.Remove(node4) == LibXR::ErrorCode::OK);
+  ASSERT(list.Remove(node1) == LibXR::ErrorCode::OK);
+  ASSERT(list.Remove(node1) == LibXR::ErrorCode::NOT_FOUND);
+  ASSERT(list.Size() == 1);
+  ASSERT(node1.next_.load() == nullptr);
+
+  list.Add(node3);
+  const int expected[] = {30, 20};
+  uint32_t index = 0;
+  ASSERT(list.Foreach<int>(
+             [&](int& value)
+             {
+               ASSERT(value == expected[index]);
+               ++index;
+               return LibXR::ErrorCode::OK;
+             }) == LibXR::ErrorCode::OK);
+  ASSERT(index == 2);
+}
+
+void TestRetireFromCallback()
+{
+  LibXR::LockFreeList list;
+  auto* keep = new LibXR::LockFreeList::Node<TrackedEntry>;
+  auto* drop = new LibXR::LockFreeList::Node<TrackedEntry>;
+  keep->data_.id = 1;
+  drop->data_.id = 2;
+  drop->data_.alive.store(true);
+  list.Add(*keep);
+  list.Add(*drop);
+
+  ASSERT(list.Foreach<TrackedEntry>(
+             [&](TrackedEntry& entry)
+             {
+               if (entry.id == 2)
+               {
+                 ASSERT(list.Retire(*drop, MarkReclaimed) == LibXR::ErrorCode::OK);
+                 ASSERT(list.Reclaim() == 0);
+                 ASSERT(drop->data_.alive.load());
+               }
+               return LibXR::ErrorCode::OK;
+             }) == LibXR::ErrorCode::OK);
+
+  ASSERT(list.Reclaim() == 1);
+  ASSERT(!drop->data_.alive.load());
+  ASSERT(list.Size() == 1);
+  delete drop;
+
+  ASSERT(list.Retire(*keep, LibXR::LockFreeList::DeleteNode<TrackedEntry>) ==
+         LibXR::ErrorCode::OK);
+  ASSERT(list.Size() == 0);
+}
+
+void TestConcurrentRemoval()
+{
+  constexpr uint32_t NODE_NUM = 8;
+  constexpr uint32_t ROUND_NUM = 2000;
+
+  LibXR::LockFreeList list;
+  LibXR::LockFreeList::Node<TrackedEntry> nodes[NODE_NUM];
+  std::atomic<bool> done = false;
+  std::atomic<uint64_t> visits = 0;
+
+  auto reader = [&]()
+  {
+    while (!done.load(std::memory_order_acquire))
+    {
+      list.Foreach<TrackedEntry>(
+          [&](TrackedEntry& entry)
+          {
+            ASSERT(entry.alive.load(std::memory_order_acquire));
+            visits.fetch_add(1, std::memory_order_relaxed);
+            return LibXR::ErrorCode::OK;
+          });
+    }
+  };
+  std::thread reader_a(reader);
+  std::thread reader_b(reader);
+
+  for (uint32_t round = 0; round < ROUND_NUM; ++round)
+  {
+    auto& node = nodes[round % NODE_NUM];
+    node.data_.alive.store(true, std::memory_order_release);
+    list.Add(node);
+    if ((round % NODE_NUM) != NODE_NUM - 1)
+    {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < NODE_NUM; ++i)
+    {
+      if ((i % 2) == 0)
+      {
+        ASSERT(list.Remove(nodes[i]) == LibXR::ErrorCode::OK);
+        nodes[i].data_.alive.store(false, std::memory_order_release);
+      }
+      else
+      {
+        ASSERT(list.Retire(nodes[i], MarkReclaimed) == LibXR::ErrorCode::OK);
+      }
+    }
+    while (nodes[NODE_NUM - 1].next_.load() != nullptr)
+    {
+      list.Reclaim();
+      std::this_thread::yield();
+    }
+  }
+
+  done.store(true, std::memory_order_release);
+  reader_a.join();
+  reader_b.join();
+  ASSERT(list.Size() == 0);
+  ASSERT(visits.load() > 0);
+}
+
+}  // namespace
+
+/**
+ * @brief 测试入口函数 `test_lockfree_list`。 Test entry function `test_lockfree_list`.
+ * @details 测试内容：按本文件声明的测试项目顺序执行验证。 Execute the test items declared
+ * in this file in order. 测试原理：通过当前文件组织的测试场景组合，对外验证该模块契约。
+ * Validate the module contract through the scenarios assembled in this file.
+ */
+void test_lockfree_list()
+{
+  // 测试内容：按文件头列出的测试项目顺序执行当前测试入口。
+  // Test coverage: execute the test items listed in this file header in sequence.
+  TestTraversal();
+  TestRemove();
+  TestRetireFromCallback();
+  TestConcurrentRemoval();
 }
@@ -27,6 +27,7 @@ struct ProducerArg
   size_t count;  ///< 本生产者负责推送的元素数 / Number of items pushed by this producer.
   Queue* queue;  ///< 共享队列 / Shared queue instance.
   std::atomic<size_t>* done_count;  ///< 完成计数器 / Producer completion counter.
+  size_t batch = 1;  ///< 每次入队的元素数 / Number of items pushed per call.
 };
 
 /**
@@ -46,8 +47,11 @@ struct ConsumerArg
   std::atomic<unsigned long long>*
       pop_sum;                 ///< 已消费元素和 / Running sum of consumed values.
   std::atomic<uint8_t>* seen;  ///< 去重标记表 / Deduplication mark table.
+  size_t batch = 1;            ///< 每次出队的元素数 / Number of items popped per call.
 };
 
+constexpr size_t MAX_TEST_BATCH = 16;  ///< 压力测试的最大批量 / Largest stress batch.
+
 /**
  * @struct NoDefaultPayload
  * @brief 无默认构造 payload，用于验证普通 Push/Pop 不依赖默认构造
@@ -66,11 +70,17 @@ struct NoDefaultPayload
  */
 void ProducerTask(ProducerArg arg)
 {
-  for (size_t offset = 0; offset < arg.count; ++offset)
+  ASSERT(arg.batch <= MAX_TEST_BATCH && arg.count % arg.batch == 0);
+  Queue::ValueType values[MAX_TEST_BATCH] = {};
+  for (size_t offset = 0; offset < arg.count; offset += arg.batch)
   {
-    const size_t value = arg.begin + offset;
-    ASSERT(value <= UINT16_MAX);
-    while (arg.queue->Push(static_cast<uint16_t>(value)) != LibXR::ErrorCode::OK)
+    for (size_t index = 0; index < arg.batch; ++index)
+    {
+      const size_t value = arg.begin + offset + index;
+      ASSERT(value <= UINT16_MAX);
+      values[index] = static_cast<uint16_t>(value);
+    }
+    while (arg.queue->PushBatch(values, arg.batch) != LibXR::ErrorCode::OK)
     {
       LibXR::Thread::Yield();
     }
@@ -84,19 +94,36 @@ void ProducerTask(ProducerArg arg)
  */
 void ConsumerTask(ConsumerArg arg)
 {
+  ASSERT(arg.batch <= MAX_TEST_BATCH);
   while (true)
   {
-    Queue::ValueType value = 0;
-    const auto ec = arg.queue->Pop(value);
-    if (ec == LibXR::ErrorCode::OK)
+    Queue::ValueType values[MAX_TEST_BATCH] = {};
+    // 批量不足时退回单个出队，保证尾部零头也能取走。
+    // Fall back to single pops when a full batch is not ready so the tail drains.
+    size_t popped = 0;
+    if (arg.batch > 1 && arg.queue->PopBatch(values, arg.batch) == LibXR::ErrorCode::OK)
+    {
+      popped = arg.batch;
+    }
+    else if (arg.queue->Pop(values[0]) == LibXR::ErrorCode::OK)
     {
-      ASSERT(value < arg.total_items);
-      const auto previous = arg.seen[value].exchange(1, std::memory_order_relaxed);
-      ASSERT(previous == 0);
+      popped = 1;
+    }
 
-      arg.pop_sum->fetch_add(static_cast<unsigned long long>(value),
-                             std::memory_order_relaxed);
-      const size_t pop_index = arg.pop_count->fetch_add(1, std::memory_order_relaxed) + 1;
+    if (popped > 0)
+    {
+      for (size_t index = 0; index < popped; ++index)
+      {
+        const Queue::ValueType value = values[index];
+        ASSERT(value < arg.total_items);
+        const auto previous = arg.seen[value].exchange(1, std::memory_order_relaxed);
+        ASSERT(previous == 0);
+
+        arg.pop_sum->fetch_add(static_cast<unsigned long long>(value),
+                               std::memory_order_relaxed);
+      }
+      const size_t pop_index =
+          arg.pop_count->fetch_add(popped, std::memory_order_relaxed) + popped;
       ASSERT(pop_index <= arg.total_items);
       continue;
     }
@@ -207,6 +234,80 @@ void test_mpmc_queue()
     ASSERT(queue.Pop(popped) == LibXR::ErrorCode::EMPTY);
   }
 
+  // Batch claims are all-or-nothing, wrap around the ring, and keep FIFO order.
+  {
+    Queue queue(5);
+    Queue::ValueType readback[5] = {};
+    const Queue::ValueType first[4] = {1, 2, 3, 4};
+
+    ASSERT(queue.PushBatch(nullptr, 0) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PopBatch(nullptr, 0) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PushBatch(nullptr, 1) == LibXR::ErrorCode::PTR_NULL);
+    ASSERT(queue.PushBatch(first, 6) == LibXR::ErrorCode::FULL);
+    ASSERT(queue.PopBatch(readback, 6) == LibXR::ErrorCode::EMPTY);
+
+    ASSERT(queue.PushBatch(first, 4) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PushBatch(first, 2) == LibXR::ErrorCode::FULL);
+    ASSERT(queue.Size() == 4);
+    ASSERT(queue.PopBatch(readback, 5) == LibXR::ErrorCode::EMPTY);
+    ASSERT(queue.Size() == 4);
+    ASSERT(queue.PopBatch(readback, 3) == LibXR::ErrorCode::OK);
+    ASSERT(readback[0] == 1 && readback[1] == 2 && readback[2] == 3);
+
+    const Queue::ValueType wrap[4] = {5, 6, 7, 8};
+    ASSERT(queue.PushBatch(wrap, 4) == LibXR::ErrorCode::OK);
+    ASSERT(queue.Size() == 5);
+    Queue::ValueType value = 0;
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::OK);
+    ASSERT(value == 4);
+    ASSERT(queue.PopBatch(nullptr, 1) == LibXR::ErrorCode::OK);
+    ASSERT(queue.PopBatch(readback, 3) == LibXR::ErrorCode::OK);
+    ASSERT(readback[0] == 6 && readback[1] == 7 && readback[2] == 8);
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+  }
+
+  // The compact layout keeps the same FIFO semantics in a much smaller footprint.
+  {
+    using CellLayout = LibXR::MPMCQueueBase::CellLayout;
+    LibXR::MPMCQueue<uint64_t> padded(4096);
+    LibXR::MPMCQueue<uint64_t> compact(4096, CellLayout::COMPACT);
+    ASSERT(padded.Layout() == CellLayout::PADDED);
+    ASSERT(compact.Layout() == CellLayout::COMPACT);
+    ASSERT(compact.StorageBytes() == 4096 * 16);
+    ASSERT(compact.StorageBytes() * 4 <= padded.StorageBytes());
+
+    // Packed word-sized payloads take the two-chunk copy path across the wrap.
+    LibXR::MPMCQueue<uint64_t> words(5);
+    uint64_t readback[5] = {};
+    const uint64_t head[4] = {10, 11, 12, 13};
+    const uint64_t wrap[4] = {14, 15, 16, 17};
+    ASSERT(words.PushBatch(head, 4) == LibXR::ErrorCode::OK);
+    ASSERT(words.PopBatch(readback, 3) == LibXR::ErrorCode::OK);
+    ASSERT(words.PushBatch(wrap, 4) == LibXR::ErrorCode::OK);
+    ASSERT(words.PopBatch(readback, 5) == LibXR::ErrorCode::OK);
+    for (uint64_t index = 0; index < 5; ++index)
+    {
+      ASSERT(readback[index] == 13 + index);
+    }
+
+    LibXR::MPMCQueue<NoDefaultPayload> queue(3, CellLayout::COMPACT);
+    NoDefaultPayload popped(0);
+    for (uint32_t round = 0; round < 64; ++round)
+    {
+      const NoDefaultPayload batch[2] = {NoDefaultPayload(round * 3),
+                                         NoDefaultPayload(round * 3 + 1)};
+      ASSERT(queue.PushBatch(batch, 2) == LibXR::ErrorCode::OK);
+      ASSERT(queue.Push(NoDefaultPayload(round * 3 + 2)) == LibXR::ErrorCode::OK);
+      ASSERT(queue.Push(NoDefaultPayload(0)) == LibXR::ErrorCode::FULL);
+      for (uint32_t offset = 0; offset < 3; ++offset)
+      {
+        ASSERT(queue.Pop(popped) == LibXR::ErrorCode::OK);
+        ASSERT(popped.value == round * 3 + offset);
+      }
+      ASSERT(queue.Pop(popped) == LibXR::ErrorCode::EMPTY);
+    }
+  }
+
   // Two producers and two consumers with the smallest legal capacity.
   {
     constexpr size_t PRODUCER_COUNT = 2;
@@ -340,4 +441,73 @@ void test_mpmc_queue()
       ASSERT(seen[index].load(std::memory_order_relaxed) == 1);
     }
   }
+
+  // Batched producers and consumers on the compact layout.
+  {
+    constexpr size_t PRODUCER_COUNT = 3;
+    constexpr size_t CONSUMER_COUNT = 2;
+    constexpr size_t ITEMS_PER_PRODUCER = 2400;
+    constexpr size_t BATCH = 8;
+    constexpr size_t TOTAL_ITEMS = PRODUCER_COUNT * ITEMS_PER_PRODUCER;
+    constexpr unsigned long long EXPECTED_SUM =
+        (static_cast<unsigned long long>(TOTAL_ITEMS) *
+         static_cast<unsigned long long>(TOTAL_ITEMS - 1)) /
+        2ULL;
+    static_assert(TOTAL_ITEMS - 1 <= UINT16_MAX);
+    static_assert(ITEMS_PER_PRODUCER % BATCH == 0);
+
+    Queue queue(32, LibXR::MPMCQueueBase::CellLayout::COMPACT);
+    std::atomic<uint8_t> seen[TOTAL_ITEMS] = {};
+    std::atomic<size_t> produced_done_count = 0;
+    std::atomic<size_t> consumed_done_count = 0;
+    std::atomic<size_t> pop_count = 0;
+    std::atomic<unsigned long long> pop_sum = 0;
+    Queue::ValueType value = 0;
+
+    LibXR::Thread producers[PRODUCER_COUNT];
+    LibXR::Thread consumers[CONSUMER_COUNT];
+
+    for (size_t index = 0; index < PRODUCER_COUNT; ++index)
+    {
+      producers[index].Create<ProducerArg>(
+          ProducerArg{index * ITEMS_PER_PRODUCER, ITEMS_PER_PRODUCER, &queue,
+                      &produced_done_count, BATCH},
+          ProducerTask, "mpmc_bprod", 1024, LibXR::Thread::Priority::REALTIME);
+    }
+
+    for (size_t index = 0; index < CONSUMER_COUNT; ++index)
+    {
+      consumers[index].Create<ConsumerArg>(
+          ConsumerArg{&queue, TOTAL_ITEMS, PRODUCER_COUNT, &produced_done_count,
+                      &consumed_done_count, &pop_count, &pop_sum, seen, BATCH},
+          ConsumerTask, "mpmc_bcons", 1024, LibXR::Thread::Priority::REALTIME);
+    }
+
+    const uint32_t start_ms = LibXR::Thread::GetTime();
+    while ((produced_done_count.load(std::memory_order_acquire) != PRODUCER_COUNT ||
+            consumed_done_count.load(std::memory_order_acquire) != CONSUMER_COUNT) &&
+           (LibXR::Thread::GetTime() - start_ms) < 5000U)
+    {
+      LibXR::Thread::Sleep(1);
+    }
+
+    ASSERT(produced_done_count.load(std::memory_order_acquire) == PRODUCER_COUNT);
+    ASSERT(consumed_done_count.load(std::memory_order_acquire) == CONSUMER_COUNT);
+    for (auto& producer : producers)
+    {
+      ASSERT(producer.Join() == LibXR::ErrorCode::OK);
+    }
+    for (auto& consumer : consumers)
+    {
+      ASSERT(consumer.Join() == LibXR::ErrorCode::OK);
+    }
+    ASSERT(pop_count.load(std::memory_order_acquire) == TOTAL_ITEMS);
+    ASSERT(pop_sum.load(std::memory_order_acquire) == EXPECTED_SUM);
+    ASSERT(queue.Pop(value) == LibXR::ErrorCode::EMPTY);
+
+    for (size_t index = 0; index < TOTAL_ITEMS; ++index)
+    {
+      ASSERT(seen[index].load(std::memory_order_relaxed) == 1);
+    }
+  }
 }
@@ -64,6 +64,10 @@ void test_queue()
     ASSERT(queue_base.PopBytes(&output) == LibXR::ErrorCode::OK);
     ASSERT(output == input);
 
+    // An empty batch push must leave an empty queue empty.
+    ASSERT(queue_base.PushBatchBytes(&input, 0) == LibXR::ErrorCode::OK);
+    ASSERT(queue_base.Size() == 0);
+
     output = 0;
     LibXR::SPSCQueueBase spsc_base(sizeof(input), 2);
     ASSERT(spsc_base.PushBytes(&input) == LibXR::ErrorCode::OK);
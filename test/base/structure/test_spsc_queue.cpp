@@ -1,6 +1,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <type_traits>
 
 #include "libxr.hpp"
@@ -36,6 +37,68 @@ void ProducerTask(ProducerArg arg)
   }
   arg.producer_done->store(true, std::memory_order_release);
 }
+
+// Use std::deque as the reference model and drive random batch pushes, pops and peeks
+// so batches keep crossing the ring end at every offset.
+template <typename QueueType>
+void CheckBatchesAgainstModel(QueueType& queue)
+{
+  using Value = typename QueueType::ValueType;
+  constexpr size_t MAX_BATCH = 64;
+  const size_t capacity = queue.MaxSize();
+  ASSERT(capacity + 1 <= MAX_BATCH);
+
+  std::deque<Value> model;
+  Value batch[MAX_BATCH] = {};
+  uint32_t next_value = 0;
+  uint32_t seed = 0x2545F491U;
+  for (uint32_t round = 0; round < 4000; ++round)
+  {
+    seed = seed * 1664525U + 1013904223U;
+    const size_t count = (seed >> 16) % (capacity + 2);
+    switch ((seed >> 8) % 3)
+    {
+      case 0:
+      {
+        for (size_t index = 0; index < count; ++index)
+        {
+          batch[index] = static_cast<Value>(next_value + index);
+        }
+        const bool fits = count <= capacity - model.size();
+        ASSERT(queue.PushBatch(batch, count) ==
+               (fits ? LibXR::ErrorCode::OK : LibXR::ErrorCode::FULL));
+        if (fits)
+        {
+          model.insert(model.end(), batch, batch + count);
+          next_value += static_cast<uint32_t>(count);
+        }
+        break;
+      }
+      case 1:
+      case 2:
+      {
+        const bool pop = (seed >> 8) % 3 == 1;
+        const bool enough = count <= model.size();
+        const LibXR::ErrorCode ans =
+            pop ? queue.PopBatch(batch, count) : queue.PeekBatch(batch, count);
+        ASSERT(ans == (enough ? LibXR::ErrorCode::OK : LibXR::ErrorCode::EMPTY));
+        if (enough)
+        {
+          for (size_t index = 0; index < count; ++index)
+          {
+            ASSERT(batch[index] == model[index]);
+          }
+          if (pop)
+          {
+            model.erase(model.begin(), model.begin() + static_cast<ptrdiff_t>(count));
+          }
+        }
+        break;
+      }
+    }
+    ASSERT(queue.Size() == model.size());
+  }
+}
 }  // namespace
 
 static_assert(!std::is_default_constructible_v<NoDefaultPayload>);
@@ -87,6 +150,15 @@ void test_spsc_queue()
     ASSERT(value == 33);
   }
 
+  // Random batch sizes against a std::deque model, on word and byte queues whose
+  // capacities do not divide the batch sizes.
+  {
+    Queue queue(13);
+    CheckBatchesAgainstModel(queue);
+    LibXR::SPSCQueue<uint8_t> byte_queue(61);
+    CheckBatchesAgainstModel(byte_queue);
+  }
+
   // Batch APIs, wraparound, writer callback, and reset behavior.
   {
     Queue queue(5);
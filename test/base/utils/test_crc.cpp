@@ -1,13 +1,15 @@
 /**
  * @file test_crc.cpp
- * @brief CRC8 / CRC16 / CRC32 计算与校验测试。 CRC8 / CRC16 / CRC32 calculation and
- * verification tests.
+ * @brief CRC8 / CRC16 / CRC32 / CRC32C 计算与校验测试。 CRC8 / CRC16 / CRC32 / CRC32C
+ * calculation and verification tests.
  *
  * 测试项目 / Test items:
  * 1. 带尾校验字段的 packed 结构计算。 Packed structure checksum generation: verify each
  * CRC helper computes the trailer field over the intended prefix bytes.
  * 2. 对应 `Verify()` 校验通过。 Checksum verification: verify the generated trailer makes
  * the corresponding `Verify()` helper succeed.
+ * 3. CRC32C 标准校验值与逐字节参考实现一致。 CRC32C matches the standard check value and
+ * a bytewise reference over lengths that cover both the 8-byte and the tail path.
  *
  * 测试原理 / Test principles:
  * 1. 使用末尾 CRC 字段的 packed 载荷，贴近仓库内最主要的真实用法。 Use packed payloads
@@ -59,4 +61,36 @@ void test_crc()
   ASSERT(LibXR::CRC8::Verify(&test_crc8, sizeof(test_crc8)));
   ASSERT(LibXR::CRC16::Verify(&test_crc16, sizeof(test_crc16)));
   ASSERT(LibXR::CRC32::Verify(&test_crc32, sizeof(test_crc32)));
+
+  const char check[] = "123456789";
+  ASSERT(LibXR::CRC32C::Calculate(check, sizeof(check) - 1) == 0xE3069283U);
+
+  uint8_t bytes[67] = {};
+  for (size_t i = 0; i < sizeof(bytes); ++i)
+  {
+    bytes[i] = static_cast<uint8_t>(i * 37U + 11U);
+  }
+  for (size_t len = 0; len <= sizeof(bytes) - sizeof(uint32_t); ++len)
+  {
+    uint32_t expected = 0xFFFFFFFFU;
+    for (size_t i = 0; i < len; ++i)
+    {
+      expected = LibXR::CRC32C::TABLE.value[0][(expected ^ bytes[i]) & 0xff] ^
+                 (expected >> 8);
+    }
+    expected ^= 0xFFFFFFFFU;
+    ASSERT(LibXR::CRC32C::Calculate(bytes, len) == expected);
+
+    if (len > 0)
+    {
+      for (size_t i = 0; i < sizeof(uint32_t); ++i)
+      {
+        bytes[len + i] = static_cast<uint8_t>(expected >> (i * 8U));
+      }
+      ASSERT(LibXR::CRC32C::Verify(bytes, len + sizeof(uint32_t)));
+      bytes[0] ^= 0x01;
+      ASSERT(!LibXR::CRC32C::Verify(bytes, len + sizeof(uint32_t)));
+      bytes[0] ^= 0x01;
+    }
+  }
 }
@@ -21,6 +21,7 @@ void test_event();
 void test_flag();
 void test_inertia();
 void test_list();
+void test_lockfree_list();
 void test_kinematic();
 void test_latest_snapshot();
 void test_mpmc_queue();
@@ -30,12 +31,16 @@ void test_message_packet();
 void test_message_topic();
 void test_queue();
 void test_spsc_queue();
+void test_cached_spsc_queue();
+void test_blocking_queue();
 void test_rbt();
+void test_flat_hash_map();
 void test_ramfs();
 void test_semaphore();
 void test_serialized_service();
 void test_mutex();
 void test_stack();
+void test_task_scheduler();
 void test_terminal_command();
 void test_terminal_display();
 void test_terminal();
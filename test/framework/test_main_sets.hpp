@@ -49,6 +49,13 @@ inline int RunBenchLinuxSharedTopicSet()
   status |= LinuxSharedTopicBench::RunLatencyBenchmarksSmoke();
   status |= LinuxSharedTopicBench::RunOverloadBenchmarksSmoke();
   status |= LinuxSharedTopicBench::RunModeBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunBagBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunServerBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunTopicLookupBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunPublishBatchBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunSPSCQueueBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunMPMCQueueBenchmarksSmoke();
+  status |= LinuxSharedTopicBench::RunTaskSchedulerBenchmarksSmoke();
   return status;
 }
 
@@ -74,6 +81,8 @@ inline constexpr GroupedTestCase kMainTestCases[] = {
     {"synchronization_tests", {"semaphore", &RunVoidEntry<test_semaphore>, false}},
     {"synchronization_tests", {"mutex", &RunVoidEntry<test_mutex>, false}},
     {"synchronization_tests", {"async", &RunVoidEntry<test_async>, false}},
+    {"synchronization_tests",
+     {"task_scheduler", &RunVoidEntry<test_task_scheduler>, false}},
     {"synchronization_tests",
      {"serialized_service", &RunVoidEntry<test_serialized_service>, false}},
 
@@ -84,12 +93,19 @@ inline constexpr GroupedTestCase kMainTestCases[] = {
     {"utility_tests", {"flag", &RunVoidEntry<test_flag>, false}},
 
     {"data_structure_tests", {"rbt", &RunVoidEntry<test_rbt>, false}},
+    {"data_structure_tests",
+     {"flat_hash_map", &RunVoidEntry<test_flat_hash_map>, false}},
     {"data_structure_tests", {"queue", &RunVoidEntry<test_queue>, false}},
     {"data_structure_tests", {"spsc_queue", &RunVoidEntry<test_spsc_queue>, false}},
+    {"data_structure_tests",
+     {"cached_spsc_queue", &RunVoidEntry<test_cached_spsc_queue>, false}},
+    {"data_structure_tests",
+     {"blocking_queue", &RunVoidEntry<test_blocking_queue>, false}},
     {"data_structure_tests", {"mpmc_queue", &RunVoidEntry<test_mpmc_queue>, false}},
     {"data_structure_tests", {"object_pool", &RunVoidEntry<test_object_pool>, false}},
     {"data_structure_tests", {"stack", &RunVoidEntry<test_stack>, false}},
     {"data_structure_tests", {"list", &RunVoidEntry<test_list>, false}},
+    {"data_structure_tests", {"lockfree_list", &RunVoidEntry<test_lockfree_list>, false}},
     {"data_structure_tests", {"double_buffer", &RunVoidEntry<test_double_buffer>, false}},
     {"data_structure_tests",
      {"latest_snapshot", &RunVoidEntry<test_latest_snapshot>, false}},
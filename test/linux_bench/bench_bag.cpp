@@ -0,0 +1,185 @@
+/**
+ * @file bench_bag.cpp
+ * @brief `LinuxTopicBag` 录制基准入口。 Benchmark entry for `LinuxTopicBag` recording.
+ * @details 测试项目：
+ *          1. 只测写入器追加记录的带宽。
+ *          2. 发布者在同进程录制线程工作时持续发布，统计录制带宽和丢弃数。
+ *          Test items:
+ *          1. Measure raw writer append bandwidth.
+ *          2. Publish continuously while the in-process recording thread runs, and
+ *             report recording bandwidth and dropped messages.
+ */
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr uint64_t BAG_CHUNK_BYTES = 64ULL * 1024ULL * 1024ULL;
+constexpr uint64_t BAG_DRAIN_TIMEOUT_NS = 5ULL * 1000ULL * 1000ULL * 1000ULL;
+
+double BandwidthMiBps(uint64_t bytes, uint64_t elapsed_ns)
+{
+  // 辅助内容：把字节数和耗时换算为 MiB/s。
+  // Helper coverage: convert bytes and elapsed time into MiB/s.
+  if (elapsed_ns == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(bytes) * 1e9 / static_cast<double>(elapsed_ns) /
+         (1024.0 * 1024.0);
+}
+
+template <size_t PayloadBytes>
+int RunBagWriterCase(uint64_t count)
+{
+  // 基准内容：连续追加同一帧，测量映射文件写入带宽。
+  // Benchmark coverage: append one frame repeatedly and measure mapped-file bandwidth.
+  char path[96] = {};
+  std::snprintf(path, sizeof(path), "/tmp/libxr_bag_bench_writer_%zu_%d.bag",
+                PayloadBytes, static_cast<int>(getpid()));
+  auto cleanup = MakeScopeExit([&]() { (void)unlink(path); });
+
+  auto frame = std::make_unique<BenchFrame<PayloadBytes>>();
+  LibXR::LinuxTopicBagWriter writer(path, BAG_CHUNK_BYTES);
+  if (!writer.Valid())
+  {
+    std::fprintf(stderr, "bag writer open failed: %s\n", std::strerror(errno));
+    return 1;
+  }
+
+  const uint64_t start_ns = NowNs();
+  for (uint64_t seq = 1; seq <= count; ++seq)
+  {
+    frame->seq = seq;
+    if (writer.Append(1, LibXR::MicrosecondTimestamp(seq), seq,
+                      LibXR::ConstRawData(*frame)) != LibXR::ErrorCode::OK)
+    {
+      std::fprintf(stderr, "bag append failed at seq=%" PRIu64 "\n", seq);
+      return 1;
+    }
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  const uint64_t bytes = writer.GetBytes();
+  if (writer.Close() != LibXR::ErrorCode::OK)
+  {
+    std::fprintf(stderr, "bag writer close failed\n");
+    return 1;
+  }
+
+  std::printf("[BENCH] bag_writer payload=%zuB count=%" PRIu64
+              " bandwidth=%.2f MiB/s record_rate=%.0f msg/s\n",
+              sizeof(BenchFrame<PayloadBytes>), count,
+              BandwidthMiBps(bytes, elapsed_ns),
+              static_cast<double>(count) * 1e9 / static_cast<double>(elapsed_ns));
+  return 0;
+}
+
+template <size_t PayloadBytes>
+int RunBagRecorderCase(uint64_t count)
+{
+  // 基准内容：发布者不等待录制者，统计录制线程追上的比例与带宽。
+  // Benchmark coverage: the publisher never waits for the recorder; report how much
+  // the recording thread keeps up with and at what bandwidth.
+  using Topic = LibXR::LinuxSharedTopic<BenchFrame<PayloadBytes>>;
+  using Data = typename Topic::Data;
+
+  char topic_name[96] = {};
+  char path[96] = {};
+  std::snprintf(topic_name, sizeof(topic_name), "linux_shared_bench_bag_%zu_%d",
+                PayloadBytes, static_cast<int>(getpid()));
+  std::snprintf(path, sizeof(path), "/tmp/libxr_bag_bench_recorder_%zu_%d.bag",
+                PayloadBytes, static_cast<int>(getpid()));
+  (void)Topic::Remove(topic_name);
+  auto cleanup = MakeScopeExit(
+      [&]()
+      {
+        (void)Topic::Remove(topic_name);
+        (void)unlink(path);
+      });
+
+  Topic publisher(topic_name, ConfigForPayload<PayloadBytes>());
+  if (!publisher.Valid())
+  {
+    std::fprintf(stderr, "publisher open failed for payload=%zu\n", PayloadBytes);
+    return 1;
+  }
+
+  LibXR::LinuxTopicBagRecorder recorder(path, BAG_CHUNK_BYTES);
+  if (recorder.AddSharedTopic<BenchFrame<PayloadBytes>>(topic_name) !=
+          LibXR::ErrorCode::OK ||
+      recorder.Start() != LibXR::ErrorCode::OK)
+  {
+    std::fprintf(stderr, "bag recorder start failed for payload=%zu\n", PayloadBytes);
+    return 1;
+  }
+
+  uint64_t publish_retry = 0;
+  const uint64_t start_ns = NowNs();
+  for (uint64_t seq = 1; seq <= count; ++seq)
+  {
+    Data data;
+    while (publisher.CreateData(data) != LibXR::ErrorCode::OK)
+    {
+      ++publish_retry;
+    }
+    data.GetData()->seq = seq;
+    data.GetData()->pub_ns = NowNs();
+    data.GetData()->checksum = ComputeChecksum(*data.GetData());
+    if (publisher.Publish(data) != LibXR::ErrorCode::OK)
+    {
+      std::fprintf(stderr, "publish failed at seq=%" PRIu64 "\n", seq);
+      return 1;
+    }
+  }
+  const uint64_t publish_ns = NowNs() - start_ns;
+
+  while (recorder.GetRecordNum() + recorder.GetDroppedNum() < count &&
+         NowNs() - start_ns < BAG_DRAIN_TIMEOUT_NS)
+  {
+    usleep(100);
+  }
+  const uint64_t record_ns = NowNs() - start_ns;
+  const uint64_t recorded = recorder.GetRecordNum();
+  const uint64_t dropped = recorder.GetDroppedNum();
+  if (recorder.Close() != LibXR::ErrorCode::OK)
+  {
+    std::fprintf(stderr, "bag recorder close failed\n");
+    return 1;
+  }
+
+  std::printf("[BENCH] bag_recorder payload=%zuB count=%" PRIu64
+              " publish_rate=%.0f msg/s record_bandwidth=%.2f MiB/s recorded=%" PRIu64
+              " dropped=%" PRIu64 " publish_retry=%" PRIu64 "\n",
+              sizeof(BenchFrame<PayloadBytes>), count,
+              static_cast<double>(count) * 1e9 / static_cast<double>(publish_ns),
+              BandwidthMiBps(recorded * sizeof(BenchFrame<PayloadBytes>), record_ns),
+              recorded, dropped, publish_retry);
+  return 0;
+}
+}  // namespace
+
+int RunBagBenchmarksSmoke()
+{
+  int status = 0;
+  status |= RunBagWriterCase<65536>(256);
+  status |= RunBagRecorderCase<65536>(256);
+  return status;
+}
+
+int RunBagBenchmarks()
+{
+  int status = 0;
+  status |= RunBagWriterCase<4096>(CountForPayload<4096>());
+  status |= RunBagWriterCase<65536>(CountForPayload<65536>());
+  status |= RunBagWriterCase<1048576>(CountForPayload<1048576>());
+  status |= RunBagRecorderCase<4096>(CountForPayload<4096>());
+  status |= RunBagRecorderCase<65536>(CountForPayload<65536>());
+  status |= RunBagRecorderCase<1048576>(CountForPayload<1048576>());
+  return status;
+}
+}  // namespace LinuxSharedTopicBench
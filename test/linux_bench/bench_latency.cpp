@@ -4,20 +4,42 @@
  * `LinuxSharedTopic` one-way latency benchmarks.
  * @details 测试项目：
  *          1. 聚合不同 payload 大小与 payload touch 模式的 one-way latency case。
+ *          2. 在小 payload 上对比订阅者的三种等待方式。
  *          Test items:
  *          1. Aggregate one-way latency cases across payload sizes and payload-touch
  * modes.
+ *          2. Compare the three subscriber wait strategies on a small payload.
  */
 #include "linux_shared_topic_latency_bench_runner.hpp"
 
 namespace LinuxSharedTopicBench
 {
-int RunLatencyBenchmarksSmoke() { return RunLatencyCase<64, false>(128); }
+namespace
+{
+constexpr LibXR::LinuxSharedWaitStrategy WAIT_STRATEGIES[] = {
+    LibXR::LinuxSharedWaitStrategy::FUTEX,
+    LibXR::LinuxSharedWaitStrategy::SPIN_THEN_FUTEX,
+    LibXR::LinuxSharedWaitStrategy::BUSY_POLL,
+};
+}  // namespace
+
+int RunLatencyBenchmarksSmoke()
+{
+  int status = 0;
+  for (const auto strategy : WAIT_STRATEGIES)
+  {
+    status |= RunLatencyCase<64, false>(128, strategy);
+  }
+  return status;
+}
 
 int RunLatencyBenchmarks()
 {
   int status = 0;
-  status |= RunLatencyCase<64, false>();
+  for (const auto strategy : WAIT_STRATEGIES)
+  {
+    status |= RunLatencyCase<64, false>(0, strategy);
+  }
   status |= RunLatencyCase<64, true>();
   status |= RunLatencyCase<4096, false>();
   status |= RunLatencyCase<4096, true>();
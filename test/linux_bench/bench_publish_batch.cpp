@@ -0,0 +1,116 @@
+/**
+ * @file bench_publish_batch.cpp
+ * @brief `Topic::PublishBatch` 批量发布基准入口。 Benchmark entry for
+ * `Topic::PublishBatch`.
+ * @details 测试项目：
+ *          1. 在 32/256 条一批的突发下，对比逐条 `Publish` 与 `PublishBatch` 投递到
+ *             两个 SPSC 队列订阅者的单条开销。
+ *          Test items:
+ *          1. Compare the per-message cost of per-message `Publish` and `PublishBatch`
+ *             feeding two SPSC queue subscribers with bursts of 32 and 256.
+ */
+#include <cstdio>
+#include <vector>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr size_t PUBLISH_BATCH_SIZES[] = {32, 256};
+
+struct PublishBatchSample
+{
+  uint32_t seq;
+  int16_t axis[6];
+};
+
+double NsPerMessage(uint64_t elapsed_ns, uint64_t messages)
+{
+  // 辅助内容：把总耗时换算为单条消息纳秒数。
+  // Helper coverage: convert total elapsed time into nanoseconds per message.
+  if (messages == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(elapsed_ns) / static_cast<double>(messages);
+}
+
+template <typename Queue>
+void DrainQueue(Queue& queue)
+{
+  // 辅助内容：每轮突发后清空队列，保证下一轮不触发丢弃。
+  // Helper coverage: empty the queue after each burst so the next one drops nothing.
+  PublishBatchSample sample = {};
+  while (queue.Pop(sample) == LibXR::ErrorCode::OK)
+  {
+  }
+}
+
+int RunPublishBatchCase(size_t burst, uint64_t rounds)
+{
+  // 基准内容：同一 topic 挂两个队列订阅者，分别用逐条发布和批量发布推送相同突发。
+  // Benchmark coverage: attach two queue subscribers to one topic and push identical
+  // bursts through per-message and batch publishes.
+  auto domain = LibXR::Topic::Domain("linux_bench_publish_batch_domain");
+  char topic_name[48];
+  std::snprintf(topic_name, sizeof(topic_name), "linux_bench_publish_batch_%zu", burst);
+  auto topic = LibXR::Topic::CreateTopic<PublishBatchSample>(topic_name, &domain);
+
+  LibXR::SPSCQueue<PublishBatchSample> queue_a(burst);
+  LibXR::SPSCQueue<PublishBatchSample> queue_b(burst);
+  auto suber_a = LibXR::Topic::QueuedSubscriber(topic, queue_a);
+  auto suber_b = LibXR::Topic::QueuedSubscriber(topic, queue_b);
+
+  std::vector<PublishBatchSample> samples(burst);
+  for (size_t i = 0; i < burst; i++)
+  {
+    samples[i].seq = static_cast<uint32_t>(i);
+  }
+
+  uint64_t single_ns = 0;
+  uint64_t batch_ns = 0;
+  for (uint64_t round = 0; round < rounds; round++)
+  {
+    uint64_t start_ns = NowNs();
+    for (auto& sample : samples)
+    {
+      topic.Publish(sample, LibXR::MicrosecondTimestamp(round));
+    }
+    single_ns += NowNs() - start_ns;
+    DrainQueue(queue_a);
+    DrainQueue(queue_b);
+
+    start_ns = NowNs();
+    topic.PublishBatch(std::span(samples));
+    batch_ns += NowNs() - start_ns;
+    DrainQueue(queue_a);
+    DrainQueue(queue_b);
+  }
+
+  const uint64_t messages = rounds * burst;
+  std::printf("[BENCH] publish_batch burst=%zu publish=%.1f ns/msg "
+              "publish_batch=%.1f ns/msg\n",
+              burst, NsPerMessage(single_ns, messages), NsPerMessage(batch_ns, messages));
+
+  const auto stats_a = suber_a.GetStats();
+  const auto stats_b = suber_b.GetStats();
+  return stats_a.dropped == 0 && stats_b.dropped == 0 ? 0 : 1;
+}
+
+int RunPublishBatchCases(uint64_t messages)
+{
+  int status = 0;
+  for (size_t burst : PUBLISH_BATCH_SIZES)
+  {
+    status |= RunPublishBatchCase(burst, messages / burst);
+  }
+  return status;
+}
+}  // namespace
+
+int RunPublishBatchBenchmarksSmoke() { return RunPublishBatchCases(1ULL << 16); }
+
+int RunPublishBatchBenchmarks() { return RunPublishBatchCases(1ULL << 24); }
+}  // namespace LinuxSharedTopicBench
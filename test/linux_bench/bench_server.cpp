@@ -0,0 +1,155 @@
+/**
+ * @file bench_server.cpp
+ * @brief `Topic::Server` 重同步基准入口。 Benchmark entry for `Topic::Server`
+ * resynchronisation.
+ * @details 测试项目：
+ *          1. 随机噪声里稀疏插入有效包，按小块和大块喂给 server，统计吞吐与收包数。
+ *          2. 用逐字节 peek/pop 扫描同一段噪声作为对照。
+ *          Test items:
+ *          1. Feed random noise with sparse valid packets to the server in small and
+ *             large chunks, and report throughput and delivered packets.
+ *          2. Scan the same noise with per-byte peek/pop as a reference.
+ */
+#include <memory>
+#include <random>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr size_t SERVER_NOISE_BYTES = 4ULL * 1024ULL * 1024ULL;
+constexpr size_t SERVER_PACKET_INTERVAL = 4096;
+constexpr size_t SERVER_BUFFER_BYTES = 8192;
+
+struct ServerBenchSample
+{
+  uint64_t seq;
+  uint64_t value[3];
+};
+
+struct ServerNoise
+{
+  std::unique_ptr<uint8_t[]> bytes;
+  size_t size = 0;
+  uint64_t packets = 0;
+};
+
+double ServerMiBps(uint64_t bytes, uint64_t elapsed_ns)
+{
+  // 辅助内容：把字节数和耗时换算为 MiB/s。
+  // Helper coverage: convert bytes and elapsed time into MiB/s.
+  if (elapsed_ns == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(bytes) * 1e9 / static_cast<double>(elapsed_ns) /
+         (1024.0 * 1024.0);
+}
+
+ServerNoise MakeServerNoise(LibXR::Topic& topic, size_t size)
+{
+  // 辅助内容：生成固定种子的随机噪声，每隔固定间隔覆盖写入一条有效包。
+  // Helper coverage: generate fixed-seed random noise and overwrite one valid packet at
+  // every fixed interval.
+  constexpr size_t PACKET_SIZE = LibXR::Topic::PACK_BASE_SIZE + sizeof(ServerBenchSample);
+
+  ServerNoise noise;
+  noise.bytes = std::make_unique<uint8_t[]>(size);
+  noise.size = size;
+
+  std::mt19937_64 rng(0x5eed);
+  for (size_t i = 0; i < size; ++i)
+  {
+    noise.bytes[i] = static_cast<uint8_t>(rng());
+  }
+
+  ServerBenchSample sample = {};
+  for (size_t offset = SERVER_PACKET_INTERVAL / 2; offset + PACKET_SIZE <= size;
+       offset += SERVER_PACKET_INTERVAL)
+  {
+    sample.seq = ++noise.packets;
+    (void)topic.PackRaw(LibXR::ConstRawData(sample),
+                        LibXR::RawData(noise.bytes.get() + offset, PACKET_SIZE),
+                        LibXR::MicrosecondTimestamp(sample.seq));
+  }
+  return noise;
+}
+
+int RunServerResyncCase(const ServerNoise& noise, LibXR::Topic& topic, size_t chunk)
+{
+  // 基准内容：按固定块大小喂入整段噪声，统计重同步吞吐和成功发布的包数。
+  // Benchmark coverage: feed the whole noise stream in fixed-size chunks and report
+  // resync throughput and delivered packets.
+  LibXR::Topic::Server server(SERVER_BUFFER_BYTES);
+  server.Register(topic);
+
+  uint64_t delivered = 0;
+  const uint64_t start_ns = NowNs();
+  for (size_t offset = 0; offset < noise.size; offset += chunk)
+  {
+    const size_t size = std::min(chunk, noise.size - offset);
+    delivered +=
+        server.ParseData(LibXR::ConstRawData(noise.bytes.get() + offset, size));
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+
+  std::printf("[BENCH] server_resync chunk=%zuB bytes=%zu throughput=%.2f MiB/s "
+              "delivered=%" PRIu64 "/%" PRIu64 "\n",
+              chunk, noise.size, ServerMiBps(noise.size, elapsed_ns), delivered,
+              noise.packets);
+  // 噪声里的假前缀可能吞掉紧随其后的真包，这里只要求有包被收下。
+  // A fake prefix in the noise may swallow a real packet right after it, so only
+  // require that some packets get through.
+  return delivered > 0 ? 0 : 1;
+}
+
+int RunServerBytewiseReference(const ServerNoise& noise, size_t chunk)
+{
+  // 基准内容：逐字节 peek/pop 找前缀，作为批量扫描的对照。
+  // Benchmark coverage: find the prefix with per-byte peek/pop as the reference for the
+  // bulk scan.
+  LibXR::QueueBase queue(1, SERVER_BUFFER_BYTES);
+
+  uint64_t prefixes = 0;
+  const uint64_t start_ns = NowNs();
+  for (size_t offset = 0; offset < noise.size; offset += chunk)
+  {
+    const size_t size = std::min(chunk, noise.size - offset);
+    (void)queue.PushBatchBytes(noise.bytes.get() + offset, size);
+    while (queue.Size() > 0)
+    {
+      uint8_t byte = 0;
+      queue.PeekBytes(&byte);
+      prefixes += byte == LibXR::Topic::PACKET_PREFIX;
+      queue.PopBytes();
+    }
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+
+  std::printf("[BENCH] server_resync_bytewise_ref chunk=%zuB bytes=%zu "
+              "throughput=%.2f MiB/s prefixes=%" PRIu64 "\n",
+              chunk, noise.size, ServerMiBps(noise.size, elapsed_ns), prefixes);
+  return 0;
+}
+
+int RunServerCases(size_t noise_bytes)
+{
+  auto domain = LibXR::Topic::Domain("linux_bench_server_domain");
+  auto topic =
+      LibXR::Topic::CreateTopic<ServerBenchSample>("linux_bench_server_tp", &domain);
+  const auto noise = MakeServerNoise(topic, noise_bytes);
+
+  int status = 0;
+  status |= RunServerResyncCase(noise, topic, 64);
+  status |= RunServerResyncCase(noise, topic, 4096);
+  status |= RunServerBytewiseReference(noise, 64);
+  return status;
+}
+}  // namespace
+
+int RunServerBenchmarksSmoke() { return RunServerCases(SERVER_NOISE_BYTES / 16); }
+
+int RunServerBenchmarks() { return RunServerCases(SERVER_NOISE_BYTES * 16); }
+}  // namespace LinuxSharedTopicBench
@@ -0,0 +1,274 @@
+/**
+ * @file bench_spsc_queue.cpp
+ * @brief SPSC 队列交接与吞吐基准入口。 Handoff and throughput benchmark entry for SPSC
+ * queues.
+ * @details 测试项目：
+ *          1. 两个线程用一对队列来回传递序号，对比 `SPSCQueue` 与 `CachedSPSCQueue`
+ *             的往返延迟。
+ *          2. 一个线程持续写入、另一个线程持续读出，对比两者的单条交接开销。
+ *          3. 在 `WritePort` / `ReadPort` 同款 `SPSCQueue<uint8_t>` 上，对比逐字节收发与
+ *             64/512/4096 字节批量收发的吞吐。
+ *          4. 消费者阻塞等待时，对比 `BlockingQueue` 与“队列 + 每条一次
+ *             `Semaphore::Post`”的单条交接开销。
+ *          Test items:
+ *          1. Two threads bounce a sequence number through a pair of queues, comparing
+ *             the round-trip latency of `SPSCQueue` and `CachedSPSCQueue`.
+ *          2. One thread writes continuously while the other reads, comparing the
+ *             per-message handoff cost of both queues.
+ *          3. On the same `SPSCQueue<uint8_t>` used by `WritePort` / `ReadPort`,
+ *             compare the throughput of byte-by-byte transfer with 64/512/4096-byte
+ *             batches.
+ *          4. With a blocking consumer, compare the per-message handoff cost of
+ *             `BlockingQueue` with a queue plus one `Semaphore::Post` per message.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr size_t SPSC_BENCH_CAPACITY = 256;
+constexpr uint32_t SPSC_SPIN_BEFORE_YIELD = 64;
+constexpr size_t BYTE_QUEUE_CAPACITY = 10000;
+constexpr size_t BYTE_QUEUE_BATCHES[] = {64, 512, 4096};
+
+double NsPerItem(uint64_t elapsed_ns, uint64_t items)
+{
+  // 辅助内容：把总耗时换算为单项纳秒数。
+  // Helper coverage: convert total elapsed time into nanoseconds per item.
+  if (items == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(elapsed_ns) / static_cast<double>(items);
+}
+
+template <typename Queue>
+void PushSpin(Queue& queue, uint64_t value)
+{
+  // 辅助内容：队列满时先自旋，再让出 CPU，避免单核环境下互相饿死。
+  // Helper coverage: spin while the queue is full, then yield so single-core hosts do
+  // not starve the peer.
+  uint32_t spins = 0;
+  while (queue.Push(value) != LibXR::ErrorCode::OK)
+  {
+    if (++spins >= SPSC_SPIN_BEFORE_YIELD)
+    {
+      spins = 0;
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Queue>
+uint64_t PopSpin(Queue& queue)
+{
+  // 辅助内容：队列空时先自旋，再让出 CPU。
+  // Helper coverage: spin while the queue is empty, then yield.
+  uint64_t value = 0;
+  uint32_t spins = 0;
+  while (queue.Pop(value) != LibXR::ErrorCode::OK)
+  {
+    if (++spins >= SPSC_SPIN_BEFORE_YIELD)
+    {
+      spins = 0;
+      std::this_thread::yield();
+    }
+  }
+  return value;
+}
+
+template <typename Queue>
+double RunPingPong(uint64_t rounds, bool& ok)
+{
+  // 基准内容：回声线程把收到的序号原样送回，主线程统计往返耗时。
+  // Benchmark coverage: an echo thread sends every sequence number straight back and
+  // the main thread measures the round trip.
+  Queue forward(SPSC_BENCH_CAPACITY);
+  Queue backward(SPSC_BENCH_CAPACITY);
+  std::thread echo(
+      [&]()
+      {
+        for (uint64_t round = 0; round < rounds; round++)
+        {
+          PushSpin(backward, PopSpin(forward));
+        }
+      });
+
+  const uint64_t start_ns = NowNs();
+  for (uint64_t round = 0; round < rounds; round++)
+  {
+    PushSpin(forward, round);
+    ok = ok && PopSpin(backward) == round;
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  echo.join();
+  return NsPerItem(elapsed_ns, rounds);
+}
+
+template <typename Queue>
+double RunStream(uint64_t messages, bool& ok)
+{
+  // 基准内容：生产者线程连续写入，主线程连续读出并校验顺序。
+  // Benchmark coverage: a producer thread writes back to back while the main thread
+  // reads and checks the order.
+  Queue queue(SPSC_BENCH_CAPACITY);
+  const uint64_t start_ns = NowNs();
+  std::thread producer(
+      [&]()
+      {
+        for (uint64_t seq = 0; seq < messages; seq++)
+        {
+          PushSpin(queue, seq);
+        }
+      });
+
+  for (uint64_t seq = 0; seq < messages; seq++)
+  {
+    ok = ok && PopSpin(queue) == seq;
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  producer.join();
+  return NsPerItem(elapsed_ns, messages);
+}
+
+double MegabytesPerSecond(uint64_t elapsed_ns, uint64_t bytes)
+{
+  // 辅助内容：把总耗时换算为 MB/s。
+  // Helper coverage: convert total elapsed time into MB/s.
+  if (elapsed_ns == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(bytes) * 1000.0 / static_cast<double>(elapsed_ns);
+}
+
+bool RunByteQueueCases(uint64_t total_bytes)
+{
+  // 基准内容：单线程反复写入再读出同一批字节；容量不是批量的整数倍，批量会不断跨越
+  // 环形回绕点。
+  // Benchmark coverage: a single thread repeatedly writes and then reads one batch;
+  // the capacity is not a multiple of the batch size, so batches keep crossing the
+  // ring wrap.
+  LibXR::SPSCQueue<uint8_t> queue(BYTE_QUEUE_CAPACITY);
+  std::vector<uint8_t> input(BYTE_QUEUE_BATCHES[2]);
+  std::vector<uint8_t> output(BYTE_QUEUE_BATCHES[2]);
+  for (size_t i = 0; i < input.size(); i++)
+  {
+    input[i] = static_cast<uint8_t>(i * 31U + 7U);
+  }
+
+  bool ok = true;
+  uint64_t start_ns = NowNs();
+  for (uint64_t done = 0; done < total_bytes; done++)
+  {
+    uint8_t value = 0;
+    ok = ok && queue.Push(input[done % 64]) == LibXR::ErrorCode::OK;
+    ok = ok && queue.Pop(value) == LibXR::ErrorCode::OK && value == input[done % 64];
+  }
+  std::printf("[BENCH] byte_queue bytewise=%.1f MB/s\n",
+              MegabytesPerSecond(NowNs() - start_ns, total_bytes));
+
+  for (size_t batch : BYTE_QUEUE_BATCHES)
+  {
+    const uint64_t rounds = total_bytes / batch;
+    start_ns = NowNs();
+    for (uint64_t round = 0; round < rounds; round++)
+    {
+      ok = ok && queue.PushBatch(input.data(), batch) == LibXR::ErrorCode::OK;
+      ok = ok && queue.PopBatch(output.data(), batch) == LibXR::ErrorCode::OK;
+    }
+    const uint64_t elapsed_ns = NowNs() - start_ns;
+    ok = ok && std::equal(input.begin(), input.begin() + batch, output.begin());
+    std::printf("[BENCH] byte_queue batch=%zu %.1f MB/s\n", batch,
+                MegabytesPerSecond(elapsed_ns, rounds * batch));
+  }
+  return ok;
+}
+
+double RunBlockingStream(uint64_t messages, bool& ok)
+{
+  // 基准内容：消费者只靠 `BlockingQueue` 挂起等待，不轮询。
+  // Benchmark coverage: the consumer only parks inside `BlockingQueue`, never polls.
+  LibXR::BlockingQueue<LibXR::SPSCQueue<uint64_t>> queue(SPSC_BENCH_CAPACITY);
+  const uint64_t start_ns = NowNs();
+  std::thread producer(
+      [&]()
+      {
+        for (uint64_t seq = 0; seq < messages; seq++)
+        {
+          (void)queue.Push(seq);
+        }
+      });
+
+  for (uint64_t seq = 0; seq < messages; seq++)
+  {
+    uint64_t value = 0;
+    ok = ok && queue.Pop(value) == LibXR::ErrorCode::OK && value == seq;
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  producer.join();
+  return NsPerItem(elapsed_ns, messages);
+}
+
+double RunSemaphoreStream(uint64_t messages, bool& ok)
+{
+  // 基准内容：传统做法，每条消息配一次 `Semaphore::Post`，满时生产者让出 CPU。
+  // Benchmark coverage: the usual pairing of one `Semaphore::Post` per message, with
+  // the producer yielding while the queue is full.
+  LibXR::SPSCQueue<uint64_t> queue(SPSC_BENCH_CAPACITY);
+  LibXR::Semaphore ready(0);
+  const uint64_t start_ns = NowNs();
+  std::thread producer(
+      [&]()
+      {
+        for (uint64_t seq = 0; seq < messages; seq++)
+        {
+          PushSpin(queue, seq);
+          ready.Post();
+        }
+      });
+
+  for (uint64_t seq = 0; seq < messages; seq++)
+  {
+    uint64_t value = 0;
+    ok = ok && ready.Wait() == LibXR::ErrorCode::OK;
+    ok = ok && queue.Pop(value) == LibXR::ErrorCode::OK && value == seq;
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  producer.join();
+  return NsPerItem(elapsed_ns, messages);
+}
+
+int RunSPSCQueueCases(uint64_t rounds, uint64_t messages)
+{
+  bool ok = true;
+  const double plain_rtt = RunPingPong<LibXR::SPSCQueue<uint64_t>>(rounds, ok);
+  const double cached_rtt = RunPingPong<LibXR::CachedSPSCQueue<uint64_t>>(rounds, ok);
+  std::printf("[BENCH] spsc_pingpong spsc=%.1f ns/rtt cached_spsc=%.1f ns/rtt\n",
+              plain_rtt, cached_rtt);
+
+  const double plain_stream = RunStream<LibXR::SPSCQueue<uint64_t>>(messages, ok);
+  const double cached_stream = RunStream<LibXR::CachedSPSCQueue<uint64_t>>(messages, ok);
+  std::printf("[BENCH] spsc_stream spsc=%.1f ns/msg cached_spsc=%.1f ns/msg\n",
+              plain_stream, cached_stream);
+
+  const double blocking = RunBlockingStream(messages, ok);
+  const double semaphore = RunSemaphoreStream(messages, ok);
+  std::printf("[BENCH] spsc_blocking blocking_queue=%.1f ns/msg semaphore=%.1f ns/msg\n",
+              blocking, semaphore);
+
+  ok = RunByteQueueCases(messages * 16) && ok;
+  return ok ? 0 : 1;
+}
+}  // namespace
+
+int RunSPSCQueueBenchmarksSmoke() { return RunSPSCQueueCases(1ULL << 12, 1ULL << 16); }
+
+int RunSPSCQueueBenchmarks() { return RunSPSCQueueCases(1ULL << 20, 1ULL << 26); }
+}  // namespace LinuxSharedTopicBench
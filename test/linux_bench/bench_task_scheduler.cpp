@@ -0,0 +1,151 @@
+/**
+ * @file bench_task_scheduler.cpp
+ * @brief 工作窃取任务调度器基准入口。 Work-stealing task scheduler benchmark entry.
+ * @details 测试项目：
+ *          1. 主线程连续提交空任务，测量每个任务从提交到执行完毕的平均开销。
+ *          2. 同一段计算密集区间分别串行执行和用 `ParallelFor` 执行，对比耗时。
+ *          Test items:
+ *          1. The main thread keeps submitting empty jobs, measuring the average cost
+ *             of one job from submission to completion.
+ *          2. The same CPU-heavy range runs serially and through `ParallelFor`,
+ *             comparing the elapsed time.
+ */
+#include <atomic>
+#include <cstdio>
+#include <new>
+#include <thread>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr size_t SCHED_TASK_CAPACITY = 256;
+constexpr size_t SCHED_RANGE_GRAIN = 256;
+constexpr uint32_t SCHED_MIX_ROUNDS = 64;
+
+double NsPerItem(uint64_t elapsed_ns, uint64_t items)
+{
+  // 辅助内容：把总耗时换算为单项纳秒数。
+  // Helper coverage: convert total elapsed time into nanoseconds per item.
+  if (items == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(elapsed_ns) / static_cast<double>(items);
+}
+
+uint32_t WorkerCount()
+{
+  // 辅助内容：每个硬件线程一个工作线程。
+  // Helper coverage: one worker per hardware thread.
+  const uint32_t hardware = std::thread::hardware_concurrency();
+  return hardware == 0 ? 1 : hardware;
+}
+
+LibXR::TaskScheduler& Scheduler()
+{
+  // 辅助内容：工作线程常驻，调度器不注册退出期析构。
+  // Helper coverage: workers are permanent, so the scheduler registers no exit-time
+  // destructor.
+  alignas(LibXR::TaskScheduler) static std::byte storage[sizeof(LibXR::TaskScheduler)];
+  static LibXR::TaskScheduler* scheduler = new (storage) LibXR::TaskScheduler(
+      WorkerCount(), SCHED_TASK_CAPACITY, 1024, LibXR::Thread::Priority::MEDIUM);
+  return *scheduler;
+}
+
+uint64_t Mix(uint64_t value)
+{
+  // 辅助内容：一段不会被优化掉的整数混合运算，模拟计算密集的流水线阶段。
+  // Helper coverage: integer mixing that cannot be optimized away, standing in for a
+  // CPU-heavy pipeline stage.
+  for (uint32_t round = 0; round < SCHED_MIX_ROUNDS; round++)
+  {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+  }
+  return value;
+}
+
+void MixRange(uint64_t* output, size_t begin, size_t end)
+{
+  for (size_t index = begin; index < end; index++)
+  {
+    output[index] = Mix(index);
+  }
+}
+
+double RunSubmit(uint64_t jobs, bool& ok)
+{
+  // 基准内容：提交空任务并等待全部执行完，统计单个任务的平均开销。
+  // Benchmark coverage: submit empty jobs and wait until all have run, reporting the
+  // average cost per job.
+  LibXR::TaskScheduler& scheduler = Scheduler();
+  std::atomic<uint64_t> done = 0;
+  auto job = LibXR::TaskScheduler::Job::Create(
+      [](bool, std::atomic<uint64_t>* counter, LibXR::TaskScheduler*)
+      { counter->fetch_add(1, std::memory_order_release); },
+      &done);
+
+  const uint64_t start_ns = NowNs();
+  for (uint64_t submitted = 0; submitted < jobs; submitted++)
+  {
+    while (scheduler.Submit(job) != LibXR::ErrorCode::OK)
+    {
+      std::this_thread::yield();
+    }
+  }
+  while (done.load(std::memory_order_acquire) != jobs)
+  {
+    std::this_thread::yield();
+  }
+  const uint64_t elapsed_ns = NowNs() - start_ns;
+  ok = ok && done.load(std::memory_order_relaxed) == jobs;
+  return NsPerItem(elapsed_ns, jobs);
+}
+
+int RunTaskSchedulerCases(uint64_t jobs, size_t range)
+{
+  bool ok = true;
+  LibXR::TaskScheduler& scheduler = Scheduler();
+
+  const double submit = RunSubmit(jobs, ok);
+  std::printf("[BENCH] sched_submit workers=%u jobs=%llu %.1f ns/job\n",
+              scheduler.WorkerCount(), static_cast<unsigned long long>(jobs), submit);
+
+  uint64_t* serial = new uint64_t[range];
+  uint64_t* parallel = new uint64_t[range];
+
+  uint64_t start_ns = NowNs();
+  MixRange(serial, 0, range);
+  const uint64_t serial_ns = NowNs() - start_ns;
+
+  const uint64_t stolen_before = scheduler.StolenCount();
+  start_ns = NowNs();
+  scheduler.ParallelFor(0, range, SCHED_RANGE_GRAIN, MixRange, parallel);
+  const uint64_t parallel_ns = NowNs() - start_ns;
+
+  for (size_t index = 0; index < range; index++)
+  {
+    ok = ok && serial[index] == parallel[index];
+  }
+  std::printf(
+      "[BENCH] sched_parallel_for items=%zu serial=%.1f ns/item parallel=%.1f ns/item "
+      "stolen=%llu\n",
+      range, NsPerItem(serial_ns, range), NsPerItem(parallel_ns, range),
+      static_cast<unsigned long long>(scheduler.StolenCount() - stolen_before));
+
+  delete[] serial;
+  delete[] parallel;
+  return ok ? 0 : 1;
+}
+}  // namespace
+
+int RunTaskSchedulerBenchmarksSmoke()
+{
+  return RunTaskSchedulerCases(1ULL << 14, 1U << 16);
+}
+
+int RunTaskSchedulerBenchmarks() { return RunTaskSchedulerCases(1ULL << 20, 1U << 22); }
+}  // namespace LinuxSharedTopicBench
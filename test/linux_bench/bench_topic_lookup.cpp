@@ -0,0 +1,132 @@
+/**
+ * @file bench_topic_lookup.cpp
+ * @brief topic 查找延迟基准入口。 Benchmark entry for topic lookup latency.
+ * @details 测试项目：
+ *          1. 在 10/100/1000 个 topic 下，对比红黑树 `Search` 和平铺哈希 `Find` 按
+ *             CRC32 查找的单次延迟。
+ *          2. 同规模下测 `Topic::Find` 按名称查找（含名称 CRC32 计算）的单次延迟。
+ *          Test items:
+ *          1. Compare per-lookup latency of red-black tree `Search` and flat hash
+ *             `Find` keyed by CRC32 with 10/100/1000 topics.
+ *          2. Measure per-lookup latency of `Topic::Find` by name, including the name
+ *             CRC32, at the same sizes.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "linux_shared_topic_bench_common.hpp"
+
+namespace LinuxSharedTopicBench
+{
+namespace
+{
+constexpr size_t LOOKUP_TOPIC_COUNTS[] = {10, 100, 1000};
+
+double NsPerLookup(uint64_t elapsed_ns, uint64_t lookups)
+{
+  // 辅助内容：把总耗时换算为单次查找纳秒数。
+  // Helper coverage: convert total elapsed time into nanoseconds per lookup.
+  if (lookups == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(elapsed_ns) / static_cast<double>(lookups);
+}
+
+int RunLookupCase(size_t topic_count, uint64_t rounds)
+{
+  // 基准内容：按打乱后的顺序反复查找全部 topic，分别统计三种查找路径的单次延迟。
+  // Benchmark coverage: repeatedly look up every topic in shuffled order and report the
+  // per-lookup latency of the three lookup paths.
+  char domain_name[48];
+  std::snprintf(domain_name, sizeof(domain_name), "linux_bench_lookup_%zu", topic_count);
+  auto domain = LibXR::Topic::Domain(domain_name);
+
+  std::vector<std::unique_ptr<char[]>> names;
+  std::vector<uint32_t> keys;
+  LibXR::RBTree<uint32_t> tree([](const uint32_t& a, const uint32_t& b)
+                               { return (a > b) - (a < b); });
+  LibXR::FlatHashMap<LibXR::Topic::TopicHandle> map;
+  std::vector<std::unique_ptr<LibXR::RBTree<uint32_t>::Node<LibXR::Topic::TopicHandle>>>
+      nodes;
+
+  for (size_t i = 0; i < topic_count; i++)
+  {
+    names.emplace_back(std::make_unique<char[]>(32));
+    std::snprintf(names.back().get(), 32, "lookup_tp_%zu", i);
+    auto topic = LibXR::Topic::CreateTopic<uint32_t>(names.back().get(), &domain);
+    LibXR::Topic::TopicHandle handle = topic;
+    keys.push_back(handle->key);
+    nodes.emplace_back(
+        std::make_unique<LibXR::RBTree<uint32_t>::Node<LibXR::Topic::TopicHandle>>(
+            handle));
+    tree.Insert(*nodes.back(), handle->key);
+    (void)map.Insert(handle->key, handle);
+  }
+
+  std::vector<size_t> order(topic_count);
+  for (size_t i = 0; i < topic_count; i++)
+  {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(0x5eed));
+
+  const uint64_t lookups = rounds * topic_count;
+  uintptr_t sink = 0;
+
+  uint64_t start_ns = NowNs();
+  for (uint64_t round = 0; round < rounds; round++)
+  {
+    for (size_t index : order)
+    {
+      sink += reinterpret_cast<uintptr_t>(
+          tree.Search<LibXR::Topic::TopicHandle>(keys[index]));
+    }
+  }
+  const double rbtree_ns = NsPerLookup(NowNs() - start_ns, lookups);
+
+  start_ns = NowNs();
+  for (uint64_t round = 0; round < rounds; round++)
+  {
+    for (size_t index : order)
+    {
+      sink += reinterpret_cast<uintptr_t>(*map.Find(keys[index]));
+    }
+  }
+  const double flat_ns = NsPerLookup(NowNs() - start_ns, lookups);
+
+  start_ns = NowNs();
+  for (uint64_t round = 0; round < rounds; round++)
+  {
+    for (size_t index : order)
+    {
+      sink += reinterpret_cast<uintptr_t>(
+          LibXR::Topic::Find(names[index].get(), &domain));
+    }
+  }
+  const double find_ns = NsPerLookup(NowNs() - start_ns, lookups);
+
+  std::printf("[BENCH] topic_lookup topics=%zu rbtree=%.1f ns flat_hash=%.1f ns "
+              "topic_find=%.1f ns\n",
+              topic_count, rbtree_ns, flat_ns, find_ns);
+  return sink != 0 ? 0 : 1;
+}
+
+int RunLookupCases(uint64_t lookups_per_case)
+{
+  int status = 0;
+  for (size_t topic_count : LOOKUP_TOPIC_COUNTS)
+  {
+    status |= RunLookupCase(topic_count, lookups_per_case / topic_count);
+  }
+  return status;
+}
+}  // namespace
+
+int RunTopicLookupBenchmarksSmoke() { return RunLookupCases(100000); }
+
+int RunTopicLookupBenchmarks() { return RunLookupCases(10000000); }
+}  // namespace LinuxSharedTopicBench
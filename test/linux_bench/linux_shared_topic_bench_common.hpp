@@ -28,4 +28,18 @@ int RunOverloadBenchmarksSmoke();
 int RunOverloadBenchmarks();
 int RunModeBenchmarksSmoke();
 int RunModeBenchmarks();
+int RunBagBenchmarksSmoke();
+int RunBagBenchmarks();
+int RunServerBenchmarksSmoke();
+int RunServerBenchmarks();
+int RunTopicLookupBenchmarksSmoke();
+int RunTopicLookupBenchmarks();
+int RunPublishBatchBenchmarksSmoke();
+int RunPublishBatchBenchmarks();
+int RunSPSCQueueBenchmarksSmoke();
+int RunSPSCQueueBenchmarks();
+int RunMPMCQueueBenchmarksSmoke();
+int RunMPMCQueueBenchmarks();
+int RunTaskSchedulerBenchmarksSmoke();
+int RunTaskSchedulerBenchmarks();
 }  // namespace LinuxSharedTopicBench
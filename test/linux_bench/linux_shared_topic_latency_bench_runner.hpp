@@ -4,10 +4,11 @@
  * `LinuxSharedTopic` one-way latency benchmarks.
  * @details 作用：
  *          1. 封装单 outstanding message 的延迟测量流程。
- *          2. 让 `bench_latency.cpp` 只保留 payload case 组合。
+ *          2. 让 `bench_latency.cpp` 只保留 payload 与等待方式的 case 组合。
  *          Purpose:
  *          1. Encapsulate the single-outstanding-message latency measurement flow.
- *          2. Keep `bench_latency.cpp` focused on payload-case composition only.
+ *          2. Keep `bench_latency.cpp` focused on payload and wait-strategy case
+ *             composition only.
  */
 #pragma once
 
@@ -19,8 +20,24 @@
 namespace LinuxSharedTopicBench
 {
 
+inline const char* WaitStrategyName(LibXR::LinuxSharedWaitStrategy strategy)
+{
+  switch (strategy)
+  {
+    case LibXR::LinuxSharedWaitStrategy::SPIN_THEN_FUTEX:
+      return "spin-futex";
+    case LibXR::LinuxSharedWaitStrategy::BUSY_POLL:
+      return "busy-poll";
+    case LibXR::LinuxSharedWaitStrategy::FUTEX:
+    default:
+      return "futex";
+  }
+}
+
 template <size_t PayloadBytes, bool TouchPayload>
-int RunLatencyCase(uint64_t count_override = 0)
+int RunLatencyCase(uint64_t count_override = 0,
+                   LibXR::LinuxSharedWaitStrategy wait_strategy =
+                       LibXR::LinuxSharedWaitStrategy::FUTEX)
 {
   // 基准内容：执行当前子场景或 case。
   // Benchmark coverage: execute the current benchmark sub-case.
@@ -35,6 +52,7 @@ int RunLatencyCase(uint64_t count_override = 0)
   config.slot_num = 4;
   config.subscriber_num = 1;
   config.queue_num = 4;
+  config.wait_strategy = wait_strategy;
 
   char topic_name[96] = {};
   std::snprintf(topic_name, sizeof(topic_name), "linux_shared_latency_%zu_%d",
@@ -194,12 +212,13 @@ int RunLatencyCase(uint64_t count_override = 0)
   const BenchStats stats = BuildStats<PayloadBytes>(lat_us, 0, 0);
   const double total_s = static_cast<double>(end_ns - start_ns) / 1e9;
   const double exchange_rate = static_cast<double>(count) / total_s;
-  std::printf("[BENCH] shared_latency mode=%s payload=%zuB count=%" PRIu64
+  std::printf("[BENCH] shared_latency mode=%s wait=%s payload=%zuB count=%" PRIu64
               " exchange_rate=%.0f msg/s create_retry=%" PRIu64 " publish_retry=%" PRIu64
               " one_way_avg=%.3f us p50=%.3f us p95=%.3f us p99=%.3f us max=%.3f us\n",
-              TouchPayload ? "full-touch" : "transport", sizeof(BenchFrame<PayloadBytes>),
-              count, exchange_rate, create_retries, publish_retries, stats.avg_us,
-              stats.p50_us, stats.p95_us, stats.p99_us, stats.max_us);
+              TouchPayload ? "full-touch" : "transport", WaitStrategyName(wait_strategy),
+              sizeof(BenchFrame<PayloadBytes>), count, exchange_rate, create_retries,
+              publish_retries, stats.avg_us, stats.p50_us, stats.p95_us, stats.p99_us,
+              stats.max_us);
   std::fflush(stdout);
 
   return 0;
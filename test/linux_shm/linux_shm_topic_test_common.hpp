@@ -114,7 +114,8 @@ inline void MakeTopicName(char* topic_name, size_t topic_name_size, const char*
  * repeated helper logic locally so the main test body stays focused on the test item
  * itself.
  */
-inline void WaitForSubscriberNum(SharedTopic& topic, uint32_t expected_num)
+template <typename TopicType>
+inline void WaitForSubscriberNum(TopicType& topic, uint32_t expected_num)
 {
   // 辅助内容：为后续测试准备或校验共享状态。
   // Helper coverage: prepare or validate shared state for later tests.
@@ -147,4 +148,11 @@ void RunLifecycleScenarios();
 void RunBalanceRoundRobinScenarios();
 void RunMixedModeScenarios();
 void RunCrossProcessScenarios();
+void RunMultiPublisherScenarios();
+void RunVariablePayloadScenarios();
+void RunNotifyScenarios();
+void RunBatchReceiveScenarios();
+void RunWaitStrategyScenarios();
+void RunBagScenarios();
+void RunBridgeScenarios();
 }  // namespace LinuxShmTopicTest
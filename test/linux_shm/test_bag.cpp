@@ -0,0 +1,324 @@
+/**
+ * @file test_bag.cpp
+ * @brief 录制文件写入、录制与回放子验证。 Split verification unit for bag file writing,
+ * recording, and replay.
+ * @details 测试项目：
+ *          1. 写入器追加的记录可被读取器按索引原样读回；索引项损坏或文件未正常关闭时
+ *             按记录重建索引。
+ *          2. 录制器同时录制共享 Topic 和进程内 Topic，且不丢消息。
+ *          3. 回放器按时间戳顺序和原始间隔把消息重新发布到两类 Topic。
+ *          Test items:
+ *          1. Records appended by the writer read back unchanged through the index,
+ *             and a corrupted index entry or a file that was not closed cleanly has
+ *             its index rebuilt from records.
+ *          2. The recorder captures a shared topic and an in-process topic together
+ *             without losing messages.
+ *          3. The player republishes messages to both kinds of topic in timestamp
+ *             order with the original spacing.
+ */
+#include <fcntl.h>
+
+#include <cstddef>
+#include <cstring>
+
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+constexpr uint32_t BAG_MESSAGE_COUNT = 64;
+constexpr uint32_t BAG_SPACING_US = 500;
+
+/**
+ * @brief 辅助函数 `MakeBagPath`。 Helper function `MakeBagPath`.
+ * @details 测试内容：生成带进程号的临时录制文件路径。 Build a temporary bag path tagged
+ * with the process id. 测试原理：避免并行测试互相覆盖文件。 Keep concurrent test runs from
+ * overwriting each other's files.
+ */
+void MakeBagPath(char* path, size_t size, const char* prefix)
+{
+  std::snprintf(path, size, "/tmp/%s_%d.bag", prefix, static_cast<int>(getpid()));
+}
+
+/**
+ * @brief 辅助函数 `NameCrc32`。 Helper function `NameCrc32`.
+ * @details 测试内容：计算主题名 CRC32。 Compute a topic-name CRC32.
+ *          测试原理：与 `Topic::GetKey()` 使用同一算法。 Uses the same algorithm as
+ * `Topic::GetKey()`.
+ */
+uint32_t NameCrc32(const char* name)
+{
+  return LibXR::CRC32::Calculate(name, strlen(name));
+}
+
+/**
+ * @brief 测试项函数 `TestBagWriterRoundTrip`。 Test-item function
+ * `TestBagWriterRoundTrip`.
+ * @details 测试内容：验证记录、索引，以及索引损坏和异常退出后的索引重建。 Verify
+ * records, the index, and index rebuild after index corruption and an abnormal exit.
+ *          测试原理：很小的扩展块迫使映射多次增长；子进程用 `_exit()` 跳过关闭。 A tiny
+ * extension chunk forces repeated mapping growth; the child skips closing through
+ * `_exit()`.
+ */
+void TestBagWriterRoundTrip()
+{
+  char path[96] = {};
+  MakeBagPath(path, sizeof(path), "libxr_bag_round_trip");
+
+  {
+    LibXR::LinuxTopicBagWriter writer(path, 4096);
+    ASSERT(writer.Valid());
+    std::array<uint8_t, 3000> payload = {};
+    for (uint32_t i = 0; i < BAG_MESSAGE_COUNT; ++i)
+    {
+      std::memset(payload.data(), static_cast<int>(i), payload.size());
+      const uint32_t size = 1U + (i * 97U) % static_cast<uint32_t>(payload.size());
+      ASSERT(writer.Append(0x1000U + (i % 3U), LibXR::MicrosecondTimestamp(100U + i), i,
+                           LibXR::ConstRawData(payload.data(), size)) ==
+             LibXR::ErrorCode::OK);
+    }
+    ASSERT(writer.GetRecordNum() == BAG_MESSAGE_COUNT);
+    ASSERT(writer.Close() == LibXR::ErrorCode::OK);
+    ASSERT(writer.Append(0, LibXR::MicrosecondTimestamp(0), 0, {}) ==
+           LibXR::ErrorCode::STATE_ERR);
+  }
+
+  {
+    LibXR::LinuxTopicBagReader reader(path);
+    ASSERT(reader.Valid());
+    ASSERT(reader.Complete());
+    ASSERT(reader.Size() == BAG_MESSAGE_COUNT);
+    for (uint32_t i = 0; i < BAG_MESSAGE_COUNT; ++i)
+    {
+      const LibXR::LinuxTopicBagEntry& entry = reader.Entry(i);
+      const LibXR::ConstRawData payload = reader.Payload(i);
+      ASSERT(entry.topic_crc32 == 0x1000U + (i % 3U));
+      ASSERT(entry.timestamp_us == 100U + i);
+      ASSERT(entry.sequence == i);
+      ASSERT(payload.size_ == 1U + (i * 97U) % 3000U);
+      ASSERT(reinterpret_cast<uintptr_t>(payload.addr_) % 16U == 0);
+      const auto* bytes = static_cast<const uint8_t*>(payload.addr_);
+      ASSERT(bytes[0] == static_cast<uint8_t>(i));
+      ASSERT(bytes[payload.size_ - 1U] == static_cast<uint8_t>(i));
+    }
+  }
+
+  {
+    // 把第一条索引项的偏移改到文件之外；文件头里 `index_offset` 位于第 32 字节。
+    // Point the first index entry past the end of the file; `index_offset` sits at
+    // byte 32 of the file header.
+    const int fd = open(path, O_RDWR | O_CLOEXEC);
+    ASSERT(fd >= 0);
+    uint64_t index_offset = 0;
+    ASSERT(pread(fd, &index_offset, sizeof(index_offset), 32) ==
+           static_cast<ssize_t>(sizeof(index_offset)));
+    const uint64_t bad_offset = UINT64_MAX - 8U;
+    ASSERT(pwrite(fd, &bad_offset, sizeof(bad_offset),
+                  static_cast<off_t>(index_offset +
+                                     offsetof(LibXR::LinuxTopicBagEntry, offset))) ==
+           static_cast<ssize_t>(sizeof(bad_offset)));
+    close(fd);
+
+    LibXR::LinuxTopicBagReader reader(path);
+    ASSERT(reader.Valid());
+    ASSERT(!reader.Complete());
+    ASSERT(reader.Size() == BAG_MESSAGE_COUNT);
+    for (uint32_t i = 0; i < BAG_MESSAGE_COUNT; ++i)
+    {
+      ASSERT(reader.Entry(i).sequence == i);
+      ASSERT(reader.Payload(i).size_ == 1U + (i * 97U) % 3000U);
+    }
+  }
+
+  pid_t child = fork();
+  ASSERT(child >= 0);
+  if (child == 0)
+  {
+    LibXR::LinuxTopicBagWriter writer(path, 4096);
+    uint32_t value = 0;
+    for (; value < 10; ++value)
+    {
+      if (writer.Append(7, LibXR::MicrosecondTimestamp(value), value,
+                        LibXR::ConstRawData(value)) != LibXR::ErrorCode::OK)
+      {
+        _exit(2);
+      }
+    }
+    _exit(0);
+  }
+  ExpectChildExit(child);
+
+  {
+    LibXR::LinuxTopicBagReader reader(path);
+    ASSERT(reader.Valid());
+    ASSERT(!reader.Complete());
+    ASSERT(reader.Size() == 10);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+      uint32_t value = 0;
+      ASSERT(reader.Payload(i).size_ == sizeof(value));
+      std::memcpy(&value, reader.Payload(i).addr_, sizeof(value));
+      ASSERT(value == i);
+    }
+  }
+  unlink(path);
+
+  LibXR::LinuxTopicBagReader missing(path);
+  ASSERT(!missing.Valid());
+  ASSERT(missing.GetError() == LibXR::ErrorCode::NOT_FOUND);
+}
+
+/**
+ * @brief 测试项函数 `TestBagRecordAndReplay`。 Test-item function
+ * `TestBagRecordAndReplay`.
+ * @details 测试内容：验证录制两类 Topic 后再按原始节拍回放。 Verify recording both kinds
+ * of topic and replaying them at the original pace.
+ *          测试原理：消息间隔固定，回放耗时不应短于录制跨度；倍速回放按比例缩短。
+ * Messages are evenly spaced, so replay must not finish faster than the recorded span;
+ * accelerated replay shortens it proportionally.
+ */
+void TestBagRecordAndReplay()
+{
+  char path[96] = {};
+  MakeBagPath(path, sizeof(path), "libxr_bag_record");
+  char shared_name[96] = {};
+  MakeTopicName(shared_name, sizeof(shared_name), "linux_shm_bag_shared");
+  UNUSED(SharedTopic::Remove(shared_name));
+
+  auto domain = LibXR::Topic::Domain("linux_shm_bag_domain");
+  auto local_topic = LibXR::Topic::CreateTopic<uint32_t>("linux_shm_bag_local", &domain);
+
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = BAG_MESSAGE_COUNT;
+  config.subscriber_num = 2;
+  config.queue_num = BAG_MESSAGE_COUNT;
+
+  {
+    SharedTopic publisher(shared_name, config);
+    ASSERT(publisher.Valid());
+
+    LibXR::LinuxTopicBagRecorder recorder(path);
+    ASSERT(recorder.Valid());
+    ASSERT(recorder.AddSharedTopic<IPCFrame>("linux_shm_bag_missing") ==
+           LibXR::ErrorCode::NOT_FOUND);
+    ASSERT(recorder.AddSharedTopic<IPCFrame>(shared_name) == LibXR::ErrorCode::OK);
+    ASSERT(recorder.AddTopic(local_topic, 64) == LibXR::ErrorCode::OK);
+    ASSERT(recorder.Start() == LibXR::ErrorCode::OK);
+    ASSERT(recorder.AddTopic(local_topic) == LibXR::ErrorCode::STATE_ERR);
+
+    for (uint32_t seq = 1; seq <= BAG_MESSAGE_COUNT; ++seq)
+    {
+      IPCFrame frame;
+      FillFrame(frame, seq);
+      ASSERT(publisher.Publish(frame) == LibXR::ErrorCode::OK);
+      uint32_t value = seq;
+      local_topic.Publish(value);
+      usleep(BAG_SPACING_US);
+    }
+
+    const uint64_t deadline_ms = LibXR::MonotonicTime::NowMilliseconds() + LONG_WAIT_MS;
+    while (recorder.GetRecordNum() < 2U * BAG_MESSAGE_COUNT &&
+           LibXR::MonotonicTime::NowMilliseconds() < deadline_ms)
+    {
+      usleep(1000);
+    }
+    ASSERT(recorder.Close() == LibXR::ErrorCode::OK);
+    ASSERT(recorder.GetRecordNum() == 2U * BAG_MESSAGE_COUNT);
+    ASSERT(recorder.GetDroppedNum() == 0);
+
+    // 录制器关闭后，进程内 Topic 的回调只保留停用的小块，继续发布不受影响。
+    uint32_t after_close = 0;
+    local_topic.Publish(after_close);
+  }
+  UNUSED(SharedTopic::Remove(shared_name));
+
+  LibXR::LinuxTopicBagReader reader(path);
+  ASSERT(reader.Valid());
+  ASSERT(reader.Complete());
+  ASSERT(reader.Size() == 2U * BAG_MESSAGE_COUNT);
+
+  uint32_t shared_count = 0;
+  uint32_t local_count = 0;
+  for (size_t i = 0; i < reader.Size(); ++i)
+  {
+    const LibXR::LinuxTopicBagEntry& entry = reader.Entry(i);
+    if (entry.topic_crc32 == NameCrc32(shared_name))
+    {
+      ASSERT(entry.size == sizeof(IPCFrame));
+      AssertFrame(*static_cast<const IPCFrame*>(reader.Payload(i).addr_),
+                  ++shared_count);
+    }
+    else
+    {
+      ASSERT(entry.topic_crc32 == local_topic.GetKey());
+      ASSERT(*static_cast<const uint32_t*>(reader.Payload(i).addr_) == ++local_count);
+    }
+  }
+  ASSERT(shared_count == BAG_MESSAGE_COUNT);
+  ASSERT(local_count == BAG_MESSAGE_COUNT);
+
+  const uint64_t span_us =
+      reader.Entry(reader.Size() - 1U).timestamp_us - reader.Entry(0).timestamp_us;
+
+  {
+    SharedTopic publisher(shared_name, config);
+    ASSERT(publisher.Valid());
+    SharedSubscriber subscriber(publisher,
+                                LibXR::LinuxSharedSubscriberMode::BROADCAST_DROP_OLD);
+    ASSERT(subscriber.Valid());
+
+    static uint32_t replayed_local = 0;
+    static bool local_in_order = true;
+    replayed_local = 0;
+    auto callback = LibXR::Topic::Callback::Create(
+        [](bool, void*, uint32_t& value)
+        {
+          local_in_order = local_in_order && value == replayed_local + 1U;
+          ++replayed_local;
+        },
+        static_cast<void*>(nullptr));
+    local_topic.RegisterCallback(callback);
+
+    LibXR::LinuxTopicBagPlayer player(reader);
+    ASSERT(player.AddSharedTopic(shared_name, publisher) == LibXR::ErrorCode::OK);
+    ASSERT(player.AddTopic(local_topic) == LibXR::ErrorCode::OK);
+
+    const uint64_t start_us = LibXR::MonotonicTime::NowMicroseconds();
+    ASSERT(player.Play(2.0) == LibXR::ErrorCode::OK);
+    const uint64_t elapsed_us = LibXR::MonotonicTime::NowMicroseconds() - start_us;
+    ASSERT(elapsed_us + 1000U >= span_us / 2U);
+    ASSERT(player.GetPublishedNum() == 2U * BAG_MESSAGE_COUNT);
+    ASSERT(player.GetSkippedNum() == 0);
+
+    ASSERT(replayed_local == BAG_MESSAGE_COUNT);
+    ASSERT(local_in_order);
+    // 丢最旧订阅者只保留最后一段，序号仍应连续并以最后一条结束。
+    uint32_t last_seq = 0;
+    SharedData data;
+    while (subscriber.Wait(data, 0) == LibXR::ErrorCode::OK)
+    {
+      ASSERT(last_seq == 0 || data.GetData()->seq == last_seq + 1U);
+      last_seq = data.GetData()->seq;
+    }
+    ASSERT(last_seq == BAG_MESSAGE_COUNT);
+  }
+  UNUSED(SharedTopic::Remove(shared_name));
+  unlink(path);
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunBagScenarios`。 Test-item function `RunBagScenarios`.
+ * @details 测试内容：执行录制文件读写与录制回放子场景。 Execute the bag file read/write
+ * and record/replay sub-scenarios.
+ *          测试原理：录制回放依赖共享 Topic，与其余共享 Topic 场景放在同一组。 Record and
+ * replay depend on shared topics, so they live in the same group as the other shared
+ * topic scenarios.
+ */
+void RunBagScenarios()
+{
+  TestBagWriterRoundTrip();
+  TestBagRecordAndReplay();
+}
+}  // namespace LinuxShmTopicTest
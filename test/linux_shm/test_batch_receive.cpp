@@ -0,0 +1,180 @@
+/**
+ * @file test_batch_receive.cpp
+ * @brief `LinuxSharedTopic` 批量接收子验证。 Split verification unit for
+ * `LinuxSharedTopic` batch receive.
+ * @details 测试项目：
+ *          1. `WaitBatch()` 按序取出至多一个输出数组长度的消息，并持有槽位直到下一批。
+ *          2. 订阅进程持有一批槽位后退出，发布者申请槽位时能回收整批槽位。
+ *          Test items:
+ *          1. `WaitBatch()` takes messages in order, at most the output array length,
+ *             and holds their slots until the next batch.
+ *          2. A subscriber process exits while holding a batch, and the publisher
+ *             reclaims the whole batch when acquiring slots.
+ */
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+/**
+ * @brief 辅助函数 `PublishSequence`。 Helper function `PublishSequence`.
+ * @details 测试内容：按序号发布一段帧。 Publish one run of frames by sequence number.
+ *          测试原理：帧内容由序号生成，接收端可逐帧校验。 Frame contents derive from the
+ * sequence, so the receiver can validate each frame.
+ */
+void PublishSequence(SharedTopic& publisher, uint32_t first, uint32_t count)
+{
+  for (uint32_t seq = first; seq < first + count; ++seq)
+  {
+    IPCFrame frame;
+    FillFrame(frame, seq);
+    ASSERT(publisher.Publish(frame) == LibXR::ErrorCode::OK);
+  }
+}
+
+/**
+ * @brief 测试项函数 `TestBatchReceiveOrder`。 Test-item function
+ * `TestBatchReceiveOrder`.
+ * @details 测试内容：验证批量接收的顺序、上限和槽位持有时长。 Verify order, limit, and
+ * slot-hold duration of batch receives.
+ *          测试原理：槽位总数等于发布条数，只有批次被释放后发布者才能继续申请。 The slot
+ * count equals the publish count, so the publisher can only acquire again after a batch
+ * is released.
+ */
+void TestBatchReceiveOrder()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_batch_order");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    LibXR::LinuxSharedTopicConfig config;
+    config.slot_num = 6;
+    config.subscriber_num = 1;
+    config.queue_num = 8;
+    SharedTopic publisher(topic_name, config);
+    ASSERT(publisher.Valid());
+    SharedSubscriber subscriber(publisher);
+    ASSERT(subscriber.Valid());
+
+    std::array<SharedTopic::BatchItem, 4> items = {};
+    uint32_t count = 0;
+    ASSERT(subscriber.WaitBatch(items, count, 0) == LibXR::ErrorCode::TIMEOUT);
+    ASSERT(count == 0);
+
+    PublishSequence(publisher, 1, 6);
+    ASSERT(subscriber.WaitBatch(items, count, SHORT_WAIT_MS) == LibXR::ErrorCode::OK);
+    ASSERT(count == 4);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      AssertFrame(*items[i].data, i + 1U);
+      ASSERT(items[i].size == 1);
+      ASSERT(i == 0 || items[i].sequence == items[i - 1U].sequence + 1U);
+    }
+
+    SharedData data;
+    ASSERT(publisher.CreateData(data) == LibXR::ErrorCode::FULL);
+
+    ASSERT(subscriber.WaitBatch(items, count, SHORT_WAIT_MS) == LibXR::ErrorCode::OK);
+    ASSERT(count == 2);
+    AssertFrame(*items[0].data, 5);
+    AssertFrame(*items[1].data, 6);
+
+    ASSERT(publisher.CreateData(data) == LibXR::ErrorCode::OK);
+    data.Reset();
+
+    subscriber.ReleaseBatch();
+    PublishSequence(publisher, 7, 6);
+    ASSERT(subscriber.WaitBatch(std::span<SharedTopic::BatchItem>(items).first(1), count,
+                                SHORT_WAIT_MS) == LibXR::ErrorCode::OK);
+    ASSERT(count == 1);
+    AssertFrame(*items[0].data, 7);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestBatchReceiveDeadSubscriber`。 Test-item function
+ * `TestBatchReceiveDeadSubscriber`.
+ * @details 测试内容：验证死亡订阅者持有的整批槽位会被回收。 Verify every slot of a batch
+ * held by a dead subscriber is reclaimed.
+ *          测试原理：子进程用 `_exit()` 跳过析构，模拟崩溃。 The child skips destructors
+ * through `_exit()` to simulate a crash.
+ */
+void TestBatchReceiveDeadSubscriber()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_batch_dead");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    LibXR::LinuxSharedTopicConfig config;
+    config.slot_num = 4;
+    config.subscriber_num = 1;
+    config.queue_num = 8;
+    SharedTopic publisher(topic_name, config);
+    ASSERT(publisher.Valid());
+
+    int ready_pipe[2] = {-1, -1};
+    ASSERT(pipe(ready_pipe) == 0);
+
+    pid_t child = fork();
+    ASSERT(child >= 0);
+    if (child == 0)
+    {
+      close(ready_pipe[0]);
+      SharedSubscriber subscriber(topic_name);
+      std::array<SharedTopic::BatchItem, 4> items = {};
+      uint32_t count = 0;
+      uint32_t received = 0;
+      while (received < 4)
+      {
+        const auto window = std::span<SharedTopic::BatchItem>(items).first(4 - received);
+        if (subscriber.WaitBatch(window, count, LONG_WAIT_MS) != LibXR::ErrorCode::OK)
+        {
+          _exit(2);
+        }
+        received += count;
+      }
+      const uint8_t token = 1;
+      if (write(ready_pipe[1], &token, sizeof(token)) != 1)
+      {
+        _exit(3);
+      }
+      _exit(0);
+    }
+
+    close(ready_pipe[1]);
+    WaitForSubscriberNum(publisher, 1);
+    PublishSequence(publisher, 1, 4);
+
+    uint8_t token = 0;
+    ASSERT(read(ready_pipe[0], &token, sizeof(token)) == 1);
+    close(ready_pipe[0]);
+    ExpectChildExit(child);
+
+    SharedData reclaimed[4];
+    for (auto& data : reclaimed)
+    {
+      ASSERT(publisher.CreateData(data) == LibXR::ErrorCode::OK);
+    }
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunBatchReceiveScenarios`。 Test-item function
+ * `RunBatchReceiveScenarios`.
+ * @details 测试内容：执行批量接收的顺序与崩溃回收子场景。 Execute the batch-receive order
+ * and crash-reclaim sub-scenarios.
+ *          测试原理：把批量持有槽位的契约单独成组。 Group the batch slot-hold contract
+ * separately.
+ */
+void RunBatchReceiveScenarios()
+{
+  TestBatchReceiveOrder();
+  TestBatchReceiveDeadSubscriber();
+}
+}  // namespace LinuxShmTopicTest
@@ -0,0 +1,329 @@
+/**
+ * @file test_bridge.cpp
+ * @brief 进程内 Topic 与共享 Topic 桥接子验证。 Split verification unit for bridging
+ * in-process topics and shared topics.
+ * @details 测试项目：
+ *          1. 导出方向把进程内发布写进共享 Topic，导入方向把共享发布送进进程内 Topic。
+ *          2. 双向镜像时两边发布的消息各出现一次，不会回环。
+ *          3. 导入回调里同步发布的另一个导出 Topic 照常导出。
+ *          Test items:
+ *          1. The export direction writes in-process publishes into the shared topic,
+ *             and the import direction delivers shared publishes to the in-process
+ *             topic.
+ *          2. With a two-way mirror, messages published on either side show up exactly
+ *             once without looping.
+ *          3. Another exported topic published synchronously from an import callback
+ *             is still exported.
+ */
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+constexpr uint32_t BRIDGE_MESSAGE_COUNT = 32;
+
+struct BridgeCounter
+{
+  uint32_t count = 0;
+  uint32_t last_seq = 0;
+  bool in_order = true;
+};
+
+/**
+ * @brief 辅助函数 `CountFrames`。 Helper function `CountFrames`.
+ * @details 测试内容：统计进程内 Topic 收到的帧并检查顺序。 Count frames received by the
+ * in-process topic and check their order.
+ *          测试原理：回调里只做计数，避免干扰桥接线程。 The callback only counts so it
+ * does not disturb the bridge thread.
+ */
+void CountFrames(bool, BridgeCounter* counter, IPCFrame& frame)
+{
+  AssertFrame(frame, frame.seq);
+  counter->in_order = counter->in_order && frame.seq > counter->last_seq;
+  counter->last_seq = frame.seq;
+  ++counter->count;
+}
+
+/**
+ * @brief 辅助函数 `WaitUntil`。 Helper function `WaitUntil`.
+ * @details 测试内容：轮询等待条件成立或超时。 Poll until the condition holds or the wait
+ * times out.
+ *          测试原理：桥接线程异步转发，断言前需要给它时间。 The bridge thread forwards
+ * asynchronously, so give it time before asserting.
+ */
+template <typename Condition>
+void WaitUntil(Condition condition)
+{
+  const uint64_t deadline_ms = LibXR::MonotonicTime::NowMilliseconds() + LONG_WAIT_MS;
+  while (!condition() && LibXR::MonotonicTime::NowMilliseconds() < deadline_ms)
+  {
+    usleep(1000);
+  }
+}
+
+/**
+ * @brief 测试项函数 `TestBridgeExportImport`。 Test-item function
+ * `TestBridgeExportImport`.
+ * @details 测试内容：验证单向导出和单向导入的转发与计数。 Verify forwarding and
+ * counters of one-way export and one-way import.
+ *          测试原理：用独立的共享订阅者和共享发布者观察桥接器的两端。 Observe both ends
+ * of the bridge with a standalone shared subscriber and shared publisher.
+ */
+void TestBridgeExportImport()
+{
+  char export_name[96] = {};
+  char import_name[96] = {};
+  MakeTopicName(export_name, sizeof(export_name), "linux_shm_bridge_export");
+  MakeTopicName(import_name, sizeof(import_name), "linux_shm_bridge_import");
+
+  auto domain = LibXR::Topic::Domain("linux_shm_bridge_domain");
+  UNUSED(SharedTopic::Remove(export_name, domain));
+  UNUSED(SharedTopic::Remove(import_name, domain));
+
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = BRIDGE_MESSAGE_COUNT + 4U;
+  config.subscriber_num = 2;
+  config.queue_num = BRIDGE_MESSAGE_COUNT + 4U;
+
+  {
+    SharedTopic import_source(import_name, domain, config);
+    ASSERT(import_source.Valid());
+
+    LibXR::LinuxTopicBridge bridge(domain, config);
+    ASSERT(bridge.Import<IPCFrame>("linux_shm_bridge_missing") ==
+           LibXR::ErrorCode::NOT_FOUND);
+    ASSERT(bridge.Export<IPCFrame>(export_name) == LibXR::ErrorCode::OK);
+    ASSERT(bridge.Import<IPCFrame>(import_name) == LibXR::ErrorCode::OK);
+
+    SharedTopic export_sink(export_name, domain);
+    ASSERT(export_sink.Valid());
+    SharedSubscriber sink(export_sink);
+    ASSERT(sink.Valid());
+
+    static BridgeCounter imported;
+    imported = {};
+    auto import_topic = LibXR::Topic(LibXR::Topic::Find(import_name, &domain));
+    auto callback = LibXR::Topic::Callback::Create(CountFrames, &imported);
+    import_topic.RegisterCallback(callback);
+
+    ASSERT(bridge.Start() == LibXR::ErrorCode::OK);
+    ASSERT(bridge.Export<IPCFrame>(export_name) == LibXR::ErrorCode::STATE_ERR);
+
+    auto export_topic = LibXR::Topic(LibXR::Topic::Find(export_name, &domain));
+    for (uint32_t seq = 1; seq <= BRIDGE_MESSAGE_COUNT; ++seq)
+    {
+      IPCFrame frame;
+      FillFrame(frame, seq);
+      export_topic.Publish(frame);
+      ASSERT(import_source.Publish(frame) == LibXR::ErrorCode::OK);
+    }
+
+    // 导出在发布路径上同步完成，共享订阅者应立即能取到全部消息。
+    for (uint32_t seq = 1; seq <= BRIDGE_MESSAGE_COUNT; ++seq)
+    {
+      SharedData data;
+      ASSERT(sink.Wait(data, SHORT_WAIT_MS) == LibXR::ErrorCode::OK);
+      AssertFrame(*data.GetData(), seq);
+      ASSERT(data.GetOrigin() == bridge.GetOrigin());
+    }
+
+    WaitUntil([&]() { return imported.count >= BRIDGE_MESSAGE_COUNT; });
+    ASSERT(bridge.Close() == LibXR::ErrorCode::OK);
+    ASSERT(imported.count == BRIDGE_MESSAGE_COUNT);
+    ASSERT(imported.in_order);
+
+    const LibXR::LinuxTopicBridgeStats stats = bridge.GetStats();
+    ASSERT(stats.exported == BRIDGE_MESSAGE_COUNT);
+    ASSERT(stats.exported_bytes == BRIDGE_MESSAGE_COUNT * sizeof(IPCFrame));
+    ASSERT(stats.imported == BRIDGE_MESSAGE_COUNT);
+    ASSERT(stats.imported_bytes == BRIDGE_MESSAGE_COUNT * sizeof(IPCFrame));
+    ASSERT(stats.export_failed == 0 && stats.import_dropped == 0);
+    ASSERT(stats.loop_suppressed == 0);
+
+    // 桥接器关闭后导出回调已注销，继续发布不受影响。
+    IPCFrame after_close;
+    FillFrame(after_close, BRIDGE_MESSAGE_COUNT + 1U);
+    export_topic.Publish(after_close);
+    SharedData data;
+    ASSERT(sink.Wait(data, 0) == LibXR::ErrorCode::TIMEOUT);
+    ASSERT(bridge.GetStats().exported == BRIDGE_MESSAGE_COUNT);
+
+    // 反复导出再关闭：旧桥接器的回调已注销，每轮只导出一份。
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+      LibXR::LinuxTopicBridge again(domain, config);
+      ASSERT(again.Export<IPCFrame>(export_name) == LibXR::ErrorCode::OK);
+      export_topic.Publish(after_close);
+      ASSERT(again.Close() == LibXR::ErrorCode::OK);
+      export_topic.Publish(after_close);
+      ASSERT(again.GetStats().exported == 1);
+      ASSERT(again.GetStats().export_failed == 0);
+    }
+    ASSERT(bridge.GetStats().exported == BRIDGE_MESSAGE_COUNT);
+  }
+  UNUSED(SharedTopic::Remove(export_name, domain));
+  UNUSED(SharedTopic::Remove(import_name, domain));
+}
+
+/**
+ * @brief 测试项函数 `TestBridgeMirrorNoLoop`。 Test-item function
+ * `TestBridgeMirrorNoLoop`.
+ * @details 测试内容：验证双向镜像不会把消息转回来源。 Verify that a two-way mirror never
+ * sends a message back to where it came from.
+ *          测试原理：两边交替发布，检查进程内回调和共享订阅者各只看到对侧的一份。
+ * Publish alternately on both sides and check that the in-process callback and the
+ * shared subscriber each see exactly one copy.
+ */
+void TestBridgeMirrorNoLoop()
+{
+  char name[96] = {};
+  MakeTopicName(name, sizeof(name), "linux_shm_bridge_mirror");
+
+  auto domain = LibXR::Topic::Domain("linux_shm_bridge_domain");
+  UNUSED(SharedTopic::Remove(name, domain));
+
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = 2U * BRIDGE_MESSAGE_COUNT + 4U;
+  config.subscriber_num = 2;
+  config.queue_num = 2U * BRIDGE_MESSAGE_COUNT + 4U;
+  config.multi_publisher = true;
+
+  {
+    LibXR::LinuxTopicBridge bridge(domain, config);
+    ASSERT(bridge.Mirror<IPCFrame>(name) == LibXR::ErrorCode::OK);
+
+    SharedTopic remote(name, domain, config);
+    ASSERT(remote.Valid());
+    SharedSubscriber remote_sink(remote);
+    ASSERT(remote_sink.Valid());
+
+    static BridgeCounter local;
+    local = {};
+    auto topic = LibXR::Topic(LibXR::Topic::Find(name, &domain));
+    auto callback = LibXR::Topic::Callback::Create(CountFrames, &local);
+    topic.RegisterCallback(callback);
+
+    ASSERT(bridge.Start() == LibXR::ErrorCode::OK);
+    for (uint32_t seq = 1; seq <= 2U * BRIDGE_MESSAGE_COUNT; seq += 2U)
+    {
+      IPCFrame frame;
+      FillFrame(frame, seq);
+      topic.Publish(frame);
+      FillFrame(frame, seq + 1U);
+      ASSERT(remote.Publish(frame) == LibXR::ErrorCode::OK);
+    }
+
+    WaitUntil([&]() { return local.count >= 2U * BRIDGE_MESSAGE_COUNT; });
+    ASSERT(bridge.Close() == LibXR::ErrorCode::OK);
+
+    // 本地回调看到自己的发布和远端的发布，各一份。
+    ASSERT(local.count == 2U * BRIDGE_MESSAGE_COUNT);
+
+    // 远端订阅者看到本地导出的和自己发的，各一份，没有被桥接器再转回来的副本。
+    uint32_t remote_count = 0;
+    SharedData data;
+    while (remote_sink.Wait(data, 0) == LibXR::ErrorCode::OK)
+    {
+      AssertFrame(*data.GetData(), remote_count + 1U);
+      ++remote_count;
+    }
+    ASSERT(remote_count == 2U * BRIDGE_MESSAGE_COUNT);
+
+    const LibXR::LinuxTopicBridgeStats stats = bridge.GetStats();
+    ASSERT(stats.exported == BRIDGE_MESSAGE_COUNT);
+    ASSERT(stats.imported == BRIDGE_MESSAGE_COUNT);
+    // 自己导出的消息从共享端绕回一次，被来源标记拦下。
+    ASSERT(stats.loop_suppressed == BRIDGE_MESSAGE_COUNT);
+  }
+  UNUSED(SharedTopic::Remove(name, domain));
+}
+
+/**
+ * @brief 测试项函数 `TestBridgeDerivedExport`。 Test-item function
+ * `TestBridgeDerivedExport`.
+ * @details 测试内容：验证导入 `cmd` 时回调同步发布的 `state` 仍被导出。 Verify that a
+ * `state` message published synchronously by a callback while `cmd` is being imported
+ * is still exported.
+ *          测试原理：防环只应拦截正在导入的 Topic 本身的回声。 Loop suppression must
+ * only catch the echo of the topic being imported.
+ */
+void TestBridgeDerivedExport()
+{
+  char cmd_name[96] = {};
+  char state_name[96] = {};
+  MakeTopicName(cmd_name, sizeof(cmd_name), "linux_shm_bridge_cmd");
+  MakeTopicName(state_name, sizeof(state_name), "linux_shm_bridge_state");
+
+  auto domain = LibXR::Topic::Domain("linux_shm_bridge_domain");
+  UNUSED(SharedTopic::Remove(cmd_name, domain));
+  UNUSED(SharedTopic::Remove(state_name, domain));
+
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = BRIDGE_MESSAGE_COUNT + 4U;
+  config.subscriber_num = 2;
+  config.queue_num = BRIDGE_MESSAGE_COUNT + 4U;
+
+  {
+    SharedTopic cmd_source(cmd_name, domain, config);
+    ASSERT(cmd_source.Valid());
+
+    LibXR::LinuxTopicBridge bridge(domain, config);
+    ASSERT(bridge.Import<IPCFrame>(cmd_name) == LibXR::ErrorCode::OK);
+    ASSERT(bridge.Export<IPCFrame>(state_name) == LibXR::ErrorCode::OK);
+
+    SharedTopic state_sink_topic(state_name, domain);
+    ASSERT(state_sink_topic.Valid());
+    SharedSubscriber state_sink(state_sink_topic);
+    ASSERT(state_sink.Valid());
+
+    static LibXR::Topic state_topic;
+    state_topic = LibXR::Topic(LibXR::Topic::Find(state_name, &domain));
+    auto cmd_topic = LibXR::Topic(LibXR::Topic::Find(cmd_name, &domain));
+    auto derive = LibXR::Topic::Callback::Create(
+        [](bool, LibXR::Topic* state, IPCFrame& frame) { state->Publish(frame); },
+        &state_topic);
+    cmd_topic.RegisterCallback(derive);
+
+    ASSERT(bridge.Start() == LibXR::ErrorCode::OK);
+    for (uint32_t seq = 1; seq <= BRIDGE_MESSAGE_COUNT; ++seq)
+    {
+      IPCFrame frame;
+      FillFrame(frame, seq);
+      ASSERT(cmd_source.Publish(frame) == LibXR::ErrorCode::OK);
+    }
+
+    for (uint32_t seq = 1; seq <= BRIDGE_MESSAGE_COUNT; ++seq)
+    {
+      SharedData data;
+      ASSERT(state_sink.Wait(data, LONG_WAIT_MS) == LibXR::ErrorCode::OK);
+      AssertFrame(*data.GetData(), seq);
+    }
+    ASSERT(bridge.Close() == LibXR::ErrorCode::OK);
+    ASSERT(cmd_topic.UnregisterCallback(derive) == LibXR::ErrorCode::OK);
+
+    const LibXR::LinuxTopicBridgeStats stats = bridge.GetStats();
+    ASSERT(stats.imported == BRIDGE_MESSAGE_COUNT);
+    ASSERT(stats.exported == BRIDGE_MESSAGE_COUNT);
+    ASSERT(stats.loop_suppressed == 0);
+  }
+  UNUSED(SharedTopic::Remove(cmd_name, domain));
+  UNUSED(SharedTopic::Remove(state_name, domain));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunBridgeScenarios`。 Test-item function `RunBridgeScenarios`.
+ * @details 测试内容：执行桥接器单向转发与双向镜像子场景。 Execute the bridge one-way
+ * forwarding and two-way mirror sub-scenarios.
+ *          测试原理：桥接依赖共享 Topic，与其余共享 Topic 场景放在同一组。 Bridging
+ * depends on shared topics, so it lives in the same group as the other shared topic
+ * scenarios.
+ */
+void RunBridgeScenarios()
+{
+  TestBridgeExportImport();
+  TestBridgeMirrorNoLoop();
+  TestBridgeDerivedExport();
+}
+}  // namespace LinuxShmTopicTest
@@ -21,4 +21,11 @@ void test_linux_shm_topic()
   LinuxShmTopicTest::RunBalanceRoundRobinScenarios();
   LinuxShmTopicTest::RunMixedModeScenarios();
   LinuxShmTopicTest::RunCrossProcessScenarios();
+  LinuxShmTopicTest::RunMultiPublisherScenarios();
+  LinuxShmTopicTest::RunVariablePayloadScenarios();
+  LinuxShmTopicTest::RunNotifyScenarios();
+  LinuxShmTopicTest::RunBatchReceiveScenarios();
+  LinuxShmTopicTest::RunWaitStrategyScenarios();
+  LinuxShmTopicTest::RunBagScenarios();
+  LinuxShmTopicTest::RunBridgeScenarios();
 }
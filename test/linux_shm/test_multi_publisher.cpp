@@ -0,0 +1,270 @@
+/**
+ * @file test_multi_publisher.cpp
+ * @brief `LinuxSharedTopic` 多发布者子验证。 Split verification unit for
+ * `LinuxSharedTopic` multi-publisher mode.
+ * @details 测试项目：
+ *          1. 两个子进程加入同一多发布者共享段并各自发布，订阅者完整收到两路序列。
+ *          2. 发布者进程持有全部槽位后退出，存活发布者在申请槽位时回收这些槽位和登记项。
+ *          3. 单发布者与多发布者配置不能共享同一个存活的共享段。
+ *          Test items:
+ *          1. Two child processes join one multi-publisher segment and publish, and the
+ *             subscriber receives both sequences intact.
+ *          2. A publisher process exits while holding every slot, and a live publisher
+ *             reclaims those slots and its registry entry when acquiring a slot.
+ *          3. Single-publisher and multi-publisher configs cannot share one live
+ *             segment.
+ */
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+constexpr uint32_t MULTI_PUBLISH_COUNT = 32;
+constexpr uint32_t SECOND_PUBLISHER_BASE = 1000;
+
+/**
+ * @brief 辅助函数 `MakeMultiPublisherConfig`。 Helper function
+ * `MakeMultiPublisherConfig`.
+ * @details 测试内容：构造开启多发布者模式的共享 Topic 配置。 Build one shared-topic config
+ * with multi-publisher mode enabled. 测试原理：所有加入者必须使用同一份配置。 Every
+ * joining process must use the same config.
+ */
+LibXR::LinuxSharedTopicConfig MakeMultiPublisherConfig(uint32_t slot_num,
+                                                       uint32_t publisher_num)
+{
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = slot_num;
+  config.subscriber_num = 2;
+  config.queue_num = 64;
+  config.multi_publisher = true;
+  config.publisher_num = publisher_num;
+  return config;
+}
+
+/**
+ * @brief 辅助函数 `RunJoiningPublisher`。 Helper function `RunJoiningPublisher`.
+ * @details 测试内容：子进程加入共享段并发布一段连续序列号。 Join the segment from a child
+ * process and publish one contiguous sequence range. 测试原理：槽位暂时耗尽时退避重试，
+ * 只把加入失败或持续失败报告为退出码。 Back off and retry while slots are temporarily
+ * exhausted, and report only join failures or persistent failures as exit codes.
+ */
+[[noreturn]] void RunJoiningPublisher(const char* topic_name, uint32_t base)
+{
+  SharedTopic publisher(topic_name, MakeMultiPublisherConfig(8, 4));
+  if (!publisher.Valid())
+  {
+    _exit(2);
+  }
+
+  for (uint32_t i = 1; i <= MULTI_PUBLISH_COUNT; ++i)
+  {
+    LibXR::ErrorCode ans = LibXR::ErrorCode::FAILED;
+    for (int retry = 0; retry < 2000 && ans != LibXR::ErrorCode::OK; ++retry)
+    {
+      SharedData data;
+      ans = publisher.CreateData(data);
+      if (ans == LibXR::ErrorCode::OK)
+      {
+        FillFrame(*data.GetData(), base + i);
+        ans = publisher.Publish(data);
+      }
+      if (ans != LibXR::ErrorCode::OK)
+      {
+        usleep(500);
+      }
+    }
+    if (ans != LibXR::ErrorCode::OK)
+    {
+      _exit(3);
+    }
+  }
+  _exit(0);
+}
+
+/**
+ * @brief 测试项函数 `TestMultiPublisherJoin`。 Test-item function
+ * `TestMultiPublisherJoin`.
+ * @details 测试内容：验证两个加入的发布者都能送达完整且各自有序的序列。 Verify two
+ * joining publishers both deliver complete sequences that stay ordered per publisher.
+ *          测试原理：共享段内的发布锁串行化分发，全局序号必须严格递增。 The in-segment
+ * publish lock serializes dispatch, so the global sequence must stay strictly increasing.
+ */
+void TestMultiPublisherJoin()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_multi_join");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    SharedTopic owner(topic_name, MakeMultiPublisherConfig(8, 4));
+    ASSERT(owner.Valid());
+    SharedSubscriber subscriber(topic_name);
+    ASSERT(subscriber.Valid());
+
+    pid_t children[2] = {};
+    children[0] = fork();
+    ASSERT(children[0] >= 0);
+    if (children[0] == 0)
+    {
+      RunJoiningPublisher(topic_name, 0);
+    }
+    children[1] = fork();
+    ASSERT(children[1] >= 0);
+    if (children[1] == 0)
+    {
+      RunJoiningPublisher(topic_name, SECOND_PUBLISHER_BASE);
+    }
+
+    uint32_t last_first = 0;
+    uint32_t last_second = SECOND_PUBLISHER_BASE;
+    uint64_t last_sequence = 0;
+    for (uint32_t received = 0; received < 2 * MULTI_PUBLISH_COUNT; ++received)
+    {
+      SharedData recv_data;
+      ASSERT(subscriber.Wait(recv_data, LONG_WAIT_MS) == LibXR::ErrorCode::OK);
+      const IPCFrame* frame = recv_data.GetData();
+      ASSERT(frame != nullptr);
+      ASSERT(frame->checksum == ComputeChecksum(*frame));
+      ASSERT(recv_data.GetSequence() > last_sequence);
+      last_sequence = recv_data.GetSequence();
+
+      if (frame->seq > SECOND_PUBLISHER_BASE)
+      {
+        ASSERT(frame->seq == last_second + 1);
+        last_second = frame->seq;
+      }
+      else
+      {
+        ASSERT(frame->seq == last_first + 1);
+        last_first = frame->seq;
+      }
+    }
+
+    ExpectChildExit(children[0]);
+    ExpectChildExit(children[1]);
+    ASSERT(last_first == MULTI_PUBLISH_COUNT);
+    ASSERT(last_second == SECOND_PUBLISHER_BASE + MULTI_PUBLISH_COUNT);
+  }
+
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestMultiPublisherDeadReclaim`。 Test-item function
+ * `TestMultiPublisherDeadReclaim`.
+ * @details 测试内容：验证退出的发布者持有的未发布槽位和登记项会被回收。 Verify unpublished
+ * slots and the registry entry held by an exited publisher are reclaimed.
+ *          测试原理：子进程用 `_exit()` 跳过析构，模拟崩溃。 The child skips destructors
+ * through `_exit()` to simulate a crash.
+ */
+void TestMultiPublisherDeadReclaim()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_multi_reclaim");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    const LibXR::LinuxSharedTopicConfig config = MakeMultiPublisherConfig(4, 2);
+    SharedTopic owner(topic_name, config);
+    ASSERT(owner.Valid());
+    SharedSubscriber subscriber(topic_name);
+    ASSERT(subscriber.Valid());
+
+    pid_t child = fork();
+    ASSERT(child >= 0);
+    if (child == 0)
+    {
+      SharedTopic publisher(topic_name, config);
+      if (!publisher.Valid())
+      {
+        _exit(2);
+      }
+
+      SharedData held[4];
+      for (auto& data : held)
+      {
+        if (publisher.CreateData(data) != LibXR::ErrorCode::OK)
+        {
+          _exit(3);
+        }
+      }
+      _exit(0);
+    }
+
+    ExpectChildExit(child);
+
+    SharedData data;
+    ASSERT(owner.CreateData(data) == LibXR::ErrorCode::OK);
+    FillFrame(*data.GetData(), 7);
+    ASSERT(owner.Publish(data) == LibXR::ErrorCode::OK);
+
+    SharedData recv_data;
+    ASSERT(subscriber.Wait(recv_data, LONG_WAIT_MS) == LibXR::ErrorCode::OK);
+    AssertFrame(*recv_data.GetData(), 7);
+
+    SharedTopic rejoined(topic_name, config);
+    ASSERT(rejoined.Valid());
+  }
+
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestMultiPublisherModeMismatch`。 Test-item function
+ * `TestMultiPublisherModeMismatch`.
+ * @details 测试内容：验证存活共享段的发布者模式不能被另一种配置加入或接管。 Verify a live
+ * segment cannot be joined or taken over with the other publisher mode.
+ *          测试原理：单发布者段仍保持独占语义，多发布者段只接受多发布者配置。
+ * Single-publisher segments keep exclusive ownership, and multi-publisher segments
+ * accept only multi-publisher configs.
+ */
+void TestMultiPublisherModeMismatch()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_multi_mismatch");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  LibXR::LinuxSharedTopicConfig single_config;
+  single_config.slot_num = 4;
+  single_config.subscriber_num = 2;
+  single_config.queue_num = 8;
+
+  {
+    SharedTopic owner(topic_name, MakeMultiPublisherConfig(4, 2));
+    ASSERT(owner.Valid());
+
+    SharedTopic single(topic_name, single_config);
+    ASSERT(!single.Valid());
+    ASSERT(single.GetError() == LibXR::ErrorCode::BUSY);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    SharedTopic owner(topic_name, single_config);
+    ASSERT(owner.Valid());
+
+    SharedTopic multi(topic_name, MakeMultiPublisherConfig(4, 2));
+    ASSERT(!multi.Valid());
+    ASSERT(multi.GetError() == LibXR::ErrorCode::BUSY);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunMultiPublisherScenarios`。 Test-item function
+ * `RunMultiPublisherScenarios`.
+ * @details 测试内容：执行多发布者加入、崩溃回收和模式冲突子场景。 Execute the
+ * multi-publisher join, crash-reclaim, and mode-mismatch sub-scenarios.
+ *          测试原理：把多发布者契约单独成组，避免与单发布者生命周期场景混在一起。
+ * Group the multi-publisher contract separately from single-publisher lifecycle
+ * scenarios.
+ */
+void RunMultiPublisherScenarios()
+{
+  TestMultiPublisherJoin();
+  TestMultiPublisherDeadReclaim();
+  TestMultiPublisherModeMismatch();
+}
+}  // namespace LinuxShmTopicTest
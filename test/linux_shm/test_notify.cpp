@@ -0,0 +1,231 @@
+/**
+ * @file test_notify.cpp
+ * @brief `LinuxSharedTopic` 可 poll 就绪通知子验证。 Split verification unit for
+ * `LinuxSharedTopic` pollable readiness notification.
+ * @details 测试项目：
+ *          1. 通知描述符只在挂起后第一条消息到达时变为可读，重新挂起后再次生效。
+ *          2. 子进程用一个 `epoll` 实例同时等待两个共享 Topic，并按序收完全部消息。
+ *          Test items:
+ *          1. The notification descriptor turns readable only for the first message
+ *             after arming, and works again after re-arming.
+ *          2. A child process waits on two shared topics through one `epoll` instance
+ *             and receives every message in order.
+ */
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+/**
+ * @brief 辅助函数 `NotifyReadable`。 Helper function `NotifyReadable`.
+ * @details 测试内容：非阻塞检查通知描述符是否可读。 Check without blocking whether the
+ * notification descriptor is readable. 测试原理：`poll` 零超时只反映当前状态。 A
+ * zero-timeout `poll` only reflects the current state.
+ */
+bool NotifyReadable(int fd)
+{
+  pollfd pfd = {fd, POLLIN, 0};
+  return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN) != 0;
+}
+
+/**
+ * @brief 辅助函数 `PublishFrames`。 Helper function `PublishFrames`.
+ * @details 测试内容：按序号发布一段帧。 Publish one run of frames by sequence number.
+ *          测试原理：帧内容由序号生成，接收端可逐帧校验。 Frame contents derive from the
+ * sequence, so the receiver can validate each frame.
+ */
+void PublishFrames(SharedTopic& publisher, uint32_t first, uint32_t count)
+{
+  for (uint32_t seq = first; seq < first + count; ++seq)
+  {
+    IPCFrame frame;
+    FillFrame(frame, seq);
+    ASSERT(publisher.Publish(frame) == LibXR::ErrorCode::OK);
+  }
+}
+
+/**
+ * @brief 测试项函数 `TestNotifyArming`。 Test-item function `TestNotifyArming`.
+ * @details 测试内容：验证通知的挂起、合并和重新挂起语义。 Verify arming, coalescing, and
+ * re-arming of the notification.
+ *          测试原理：挂起期间多条消息只产生一次通知，避免每条消息一次系统调用。 Several
+ * messages while armed produce one notification, avoiding one syscall per message.
+ */
+void TestNotifyArming()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_notify_arm");
+  UNUSED(SharedTopic::Remove(topic_name));
+
+  {
+    LibXR::LinuxSharedTopicConfig config;
+    config.slot_num = 8;
+    config.subscriber_num = 2;
+    config.queue_num = 8;
+    SharedTopic publisher(topic_name, config);
+    ASSERT(publisher.Valid());
+
+    SharedSubscriber subscriber(publisher);
+    ASSERT(subscriber.GetNotifyFd() < 0);
+    ASSERT(subscriber.EnableNotify() == LibXR::ErrorCode::OK);
+    const int fd = subscriber.GetNotifyFd();
+    ASSERT(fd >= 0);
+    ASSERT(!NotifyReadable(fd));
+
+    PublishFrames(publisher, 1, 2);
+    ASSERT(NotifyReadable(fd));
+    uint8_t token = 0;
+    ASSERT(recv(fd, &token, sizeof(token), MSG_DONTWAIT) == 1);
+    ASSERT(recv(fd, &token, sizeof(token), MSG_DONTWAIT) < 0);
+
+    PublishFrames(publisher, 3, 1);
+    ASSERT(!NotifyReadable(fd));
+
+    subscriber.RearmNotify();
+    for (uint32_t seq = 1; seq <= 3; ++seq)
+    {
+      SharedData data;
+      ASSERT(subscriber.Wait(data, 0) == LibXR::ErrorCode::OK);
+      AssertFrame(*data.GetData(), seq);
+    }
+    SharedData empty;
+    ASSERT(subscriber.Wait(empty, 0) == LibXR::ErrorCode::TIMEOUT);
+
+    PublishFrames(publisher, 4, 1);
+    ASSERT(NotifyReadable(fd));
+
+    subscriber.Reset();
+    ASSERT(subscriber.GetNotifyFd() < 0);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestNotifyEpollAcrossTopics`。 Test-item function
+ * `TestNotifyEpollAcrossTopics`.
+ * @details 测试内容：验证单个 reactor 线程通过 `epoll` 等待多个共享 Topic。 Verify one
+ * reactor thread waiting on several shared topics through `epoll`.
+ *          测试原理：子进程只在 `epoll_wait` 中阻塞，每次唤醒先重新挂起再取空队列。
+ * The child blocks only in `epoll_wait`, and on every wake re-arms first and then
+ * drains the queue.
+ */
+void TestNotifyEpollAcrossTopics()
+{
+  static constexpr uint32_t FRAME_NUM[2] = {3, 5};
+
+  char topic_names[2][96] = {};
+  MakeTopicName(topic_names[0], sizeof(topic_names[0]), "linux_shm_notify_a");
+  MakeTopicName(topic_names[1], sizeof(topic_names[1]), "linux_shm_notify_b");
+  UNUSED(SharedTopic::Remove(topic_names[0]));
+  UNUSED(SharedTopic::Remove(topic_names[1]));
+
+  {
+    LibXR::LinuxSharedTopicConfig config;
+    config.slot_num = 8;
+    config.subscriber_num = 2;
+    config.queue_num = 8;
+    SharedTopic publisher_a(topic_names[0], config);
+    SharedTopic publisher_b(topic_names[1], config);
+    ASSERT(publisher_a.Valid());
+    ASSERT(publisher_b.Valid());
+
+    pid_t child = fork();
+    ASSERT(child >= 0);
+
+    if (child == 0)
+    {
+      SharedSubscriber subscribers[2] = {SharedSubscriber(topic_names[0]),
+                                         SharedSubscriber(topic_names[1])};
+      const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+      if (epoll_fd < 0)
+      {
+        _exit(2);
+      }
+
+      for (uint32_t i = 0; i < 2; ++i)
+      {
+        if (subscribers[i].EnableNotify() != LibXR::ErrorCode::OK)
+        {
+          _exit(3);
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, subscribers[i].GetNotifyFd(), &event) != 0)
+        {
+          _exit(4);
+        }
+      }
+
+      uint32_t received[2] = {};
+      auto drain = [&](uint32_t i)
+      {
+        SharedData data;
+        while (subscribers[i].Wait(data, 0) == LibXR::ErrorCode::OK)
+        {
+          ++received[i];
+          if (data.GetData()->seq != received[i] ||
+              data.GetData()->checksum != ComputeChecksum(*data.GetData()))
+          {
+            _exit(6);
+          }
+        }
+      };
+
+      // 开启通知前已入队的消息不会触发通知，先取一次队列。
+      drain(0);
+      drain(1);
+
+      while (received[0] < FRAME_NUM[0] || received[1] < FRAME_NUM[1])
+      {
+        epoll_event events[2] = {};
+        const int ready = epoll_wait(epoll_fd, events, 2, LONG_WAIT_MS);
+        if (ready <= 0)
+        {
+          _exit(5);
+        }
+
+        for (int e = 0; e < ready; ++e)
+        {
+          const uint32_t i = events[e].data.u32;
+          subscribers[i].RearmNotify();
+          drain(i);
+        }
+      }
+
+      close(epoll_fd);
+      _exit(0);
+    }
+
+    WaitForSubscriberNum(publisher_a, 1);
+    WaitForSubscriberNum(publisher_b, 1);
+
+    PublishFrames(publisher_b, 1, 2);
+    PublishFrames(publisher_a, 1, FRAME_NUM[0]);
+    usleep(5000);
+    PublishFrames(publisher_b, 3, FRAME_NUM[1] - 2);
+
+    ExpectChildExit(child);
+  }
+  UNUSED(SharedTopic::Remove(topic_names[0]));
+  UNUSED(SharedTopic::Remove(topic_names[1]));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunNotifyScenarios`。 Test-item function `RunNotifyScenarios`.
+ * @details 测试内容：执行就绪通知的挂起语义与多 Topic `epoll` 子场景。 Execute the
+ * notification arming and multi-topic `epoll` sub-scenarios.
+ *          测试原理：把 reactor 集成契约单独成组。 Group the reactor-integration contract
+ * separately.
+ */
+void RunNotifyScenarios()
+{
+  TestNotifyArming();
+  TestNotifyEpollAcrossTopics();
+}
+}  // namespace LinuxShmTopicTest
@@ -0,0 +1,257 @@
+/**
+ * @file test_variable_payload.cpp
+ * @brief `LinuxSharedTopic` 变长 payload 子验证。 Split verification unit for
+ * `LinuxSharedTopic` variable-size payload mode.
+ * @details 测试项目：
+ *          1. 按消息长度选择最小规格，耗尽时向更大规格借用，超出最大规格报告 `ARG_ERR`。
+ *          2. 子进程以零拷贝句柄发布不同长度的消息，订阅者看到一致的长度和内容。
+ *          3. 规格未按容量升序填写时创建失败。
+ *          Test items:
+ *          1. Slots come from the smallest fitting class, exhausted classes borrow
+ *             from larger ones, and oversize requests report `ARG_ERR`.
+ *          2. A child publishes messages of different lengths through zero-copy
+ *             handles, and the subscriber sees matching lengths and contents.
+ *          3. Creation fails when classes are not in ascending capacity order.
+ */
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+using ByteTopic = LibXR::LinuxSharedTopic<uint8_t>;
+using ByteData = ByteTopic::Data;
+
+/**
+ * @brief 辅助函数 `MakeVariableConfig`。 Helper function `MakeVariableConfig`.
+ * @details 测试内容：构造三档规格的变长配置。 Build one variable-size config with three
+ * size classes. 测试原理：容量跨越两个数量级，覆盖选档和借用路径。 Capacities span two
+ * orders of magnitude to cover class selection and borrowing.
+ */
+LibXR::LinuxSharedTopicConfig MakeVariableConfig()
+{
+  LibXR::LinuxSharedTopicConfig config;
+  config.subscriber_num = 2;
+  config.queue_num = 8;
+  config.size_classes[0] = {256, 4};
+  config.size_classes[1] = {4096, 2};
+  config.size_classes[2] = {65536, 1};
+  return config;
+}
+
+/**
+ * @brief 辅助函数 `FillBytes`。 Helper function `FillBytes`.
+ * @details 测试内容：按种子填充字节序列。 Fill one byte run from a seed.
+ *          测试原理：内容随位置和种子变化，便于发现越界和错位。 Content varies with
+ * position and seed so overruns and misplacement are caught.
+ */
+void FillBytes(uint8_t* data, uint32_t size, uint32_t seed)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    data[i] = static_cast<uint8_t>((i * 31U + seed) & 0xFFU);
+  }
+}
+
+/**
+ * @brief 辅助函数 `BytesMatch`。 Helper function `BytesMatch`.
+ * @details 测试内容：校验 `FillBytes` 生成的字节序列。 Validate a byte run produced by
+ * `FillBytes`. 测试原理：与填充规则逐字节比较。 Compare byte by byte against the fill
+ * rule.
+ */
+bool BytesMatch(const uint8_t* data, uint32_t size, uint32_t seed)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    if (data[i] != static_cast<uint8_t>((i * 31U + seed) & 0xFFU))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 测试项函数 `TestVariableSizeClassSelection`。 Test-item function
+ * `TestVariableSizeClassSelection`.
+ * @details 测试内容：验证选档、借用、超限和定长默认行为。 Verify class selection,
+ * borrowing, oversize rejection, and the fixed-size default.
+ *          测试原理：持有句柄占住槽位，再观察下一次申请得到的容量。 Hold handles to pin
+ * slots, then observe the capacity returned by the next request.
+ */
+void TestVariableSizeClassSelection()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_var_classes");
+  UNUSED(ByteTopic::Remove(topic_name));
+
+  {
+    ByteTopic publisher(topic_name, MakeVariableConfig());
+    ASSERT(publisher.Valid());
+
+    ByteData small;
+    ASSERT(publisher.CreateData(small, 200) == LibXR::ErrorCode::OK);
+    ASSERT(small.GetSize() == 200);
+    ASSERT(small.GetCapacity() == 256);
+    ASSERT(small.SetSize(257) == LibXR::ErrorCode::ARG_ERR);
+    ASSERT(small.SetSize(64) == LibXR::ErrorCode::OK);
+    ASSERT(small.GetSize() == 64);
+
+    ByteData medium[2];
+    for (auto& data : medium)
+    {
+      ASSERT(publisher.CreateData(data, 3000) == LibXR::ErrorCode::OK);
+      ASSERT(data.GetCapacity() == 4096);
+    }
+
+    ByteData borrowed;
+    ASSERT(publisher.CreateData(borrowed, 3000) == LibXR::ErrorCode::OK);
+    ASSERT(borrowed.GetCapacity() == 65536);
+
+    ByteData exhausted;
+    ASSERT(publisher.CreateData(exhausted, 3000) == LibXR::ErrorCode::FULL);
+    ASSERT(publisher.CreateData(exhausted, 65537) == LibXR::ErrorCode::ARG_ERR);
+    ASSERT(publisher.CreateData(exhausted, 0) == LibXR::ErrorCode::ARG_ERR);
+
+    medium[0].Reset();
+    ASSERT(publisher.CreateData(exhausted, 3000) == LibXR::ErrorCode::OK);
+    ASSERT(exhausted.GetCapacity() == 4096);
+  }
+  UNUSED(ByteTopic::Remove(topic_name));
+
+  {
+    LibXR::LinuxSharedTopicConfig config;
+    config.slot_num = 2;
+    config.subscriber_num = 1;
+    config.queue_num = 4;
+    SharedTopic fixed(topic_name, config);
+    ASSERT(fixed.Valid());
+
+    SharedData data;
+    ASSERT(fixed.CreateData(data) == LibXR::ErrorCode::OK);
+    ASSERT(data.GetSize() == 1);
+    ASSERT(data.GetCapacity() == 1);
+    ASSERT(fixed.CreateData(data, 2) == LibXR::ErrorCode::ARG_ERR);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestVariableCrossProcess`。 Test-item function
+ * `TestVariableCrossProcess`.
+ * @details 测试内容：验证跨进程变长消息的长度与内容。 Verify lengths and contents of
+ * variable-size messages across processes.
+ *          测试原理：子进程交替发布各档长度，父进程按序校验。 The child alternates lengths
+ * across classes and the parent validates them in order.
+ */
+void TestVariableCrossProcess()
+{
+  static constexpr uint32_t SIZES[] = {1, 200, 256, 4000, 60000, 17};
+
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_var_fork");
+  UNUSED(ByteTopic::Remove(topic_name));
+
+  {
+    ByteTopic publisher(topic_name, MakeVariableConfig());
+    ASSERT(publisher.Valid());
+
+    pid_t child = fork();
+    ASSERT(child >= 0);
+
+    if (child == 0)
+    {
+      ByteTopic::SyncSubscriber subscriber(topic_name);
+      if (!subscriber.Valid())
+      {
+        _exit(2);
+      }
+
+      for (uint32_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); ++i)
+      {
+        ByteData recv_data;
+        if (subscriber.Wait(recv_data, LONG_WAIT_MS) != LibXR::ErrorCode::OK)
+        {
+          _exit(3);
+        }
+        if (recv_data.GetSize() != SIZES[i] ||
+            !BytesMatch(recv_data.GetData(), SIZES[i], i))
+        {
+          _exit(4);
+        }
+      }
+      _exit(0);
+    }
+
+    WaitForSubscriberNum(publisher, 1);
+
+    for (uint32_t i = 0; i < sizeof(SIZES) / sizeof(SIZES[0]); ++i)
+    {
+      if ((i & 1U) == 0)
+      {
+        ByteData data;
+        ASSERT(publisher.CreateData(data, SIZES[i]) == LibXR::ErrorCode::OK);
+        FillBytes(data.GetData(), SIZES[i], i);
+        ASSERT(publisher.Publish(data) == LibXR::ErrorCode::OK);
+      }
+      else
+      {
+        std::array<uint8_t, 65536> buffer = {};
+        FillBytes(buffer.data(), SIZES[i], i);
+        ASSERT(publisher.Publish(buffer.data(), SIZES[i]) == LibXR::ErrorCode::OK);
+      }
+    }
+
+    ExpectChildExit(child);
+  }
+  UNUSED(ByteTopic::Remove(topic_name));
+}
+
+/**
+ * @brief 测试项函数 `TestVariableInvalidClasses`。 Test-item function
+ * `TestVariableInvalidClasses`.
+ * @details 测试内容：验证非法规格配置被拒绝。 Verify invalid class configs are rejected.
+ *          测试原理：容量必须严格升序且中间不能留空档。 Capacities must strictly ascend
+ * with no gap between configured classes.
+ */
+void TestVariableInvalidClasses()
+{
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_var_invalid");
+  UNUSED(ByteTopic::Remove(topic_name));
+
+  LibXR::LinuxSharedTopicConfig descending = MakeVariableConfig();
+  descending.size_classes[1] = {128, 2};
+  {
+    ByteTopic publisher(topic_name, descending);
+    ASSERT(!publisher.Valid());
+    ASSERT(publisher.GetError() == LibXR::ErrorCode::ARG_ERR);
+  }
+  UNUSED(ByteTopic::Remove(topic_name));
+
+  LibXR::LinuxSharedTopicConfig gap = MakeVariableConfig();
+  gap.size_classes[1] = {};
+  {
+    ByteTopic publisher(topic_name, gap);
+    ASSERT(!publisher.Valid());
+    ASSERT(publisher.GetError() == LibXR::ErrorCode::ARG_ERR);
+  }
+  UNUSED(ByteTopic::Remove(topic_name));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunVariablePayloadScenarios`。 Test-item function
+ * `RunVariablePayloadScenarios`.
+ * @details 测试内容：执行变长 payload 的选档、跨进程和配置校验子场景。 Execute the
+ * variable-size class-selection, cross-process, and config-validation sub-scenarios.
+ *          测试原理：把变长契约单独成组，定长场景保持不变。 Group the variable-size
+ * contract separately and leave the fixed-size scenarios untouched.
+ */
+void RunVariablePayloadScenarios()
+{
+  TestVariableSizeClassSelection();
+  TestVariableCrossProcess();
+  TestVariableInvalidClasses();
+}
+}  // namespace LinuxShmTopicTest
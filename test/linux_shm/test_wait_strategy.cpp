@@ -0,0 +1,181 @@
+/**
+ * @file test_wait_strategy.cpp
+ * @brief `LinuxSharedTopic` 订阅者等待方式子验证。 Split verification unit for
+ * `LinuxSharedTopic` subscriber wait strategies.
+ * @details 测试项目：
+ *          1. 三种等待方式下，跨进程订阅者都能按序收到全部消息，且按名字附着时继承创建者配置。
+ *          2. 三种等待方式在无消息时都按超时返回 `TIMEOUT`。
+ *          3. 非法等待方式在创建时被拒绝。
+ *          Test items:
+ *          1. Under all three strategies a cross-process subscriber receives every
+ *             message in order, and attaching by name inherits the creator's config.
+ *          2. All three strategies return `TIMEOUT` after the timeout when idle.
+ *          3. An invalid strategy is rejected at creation.
+ */
+#include "linux_shm_topic_test_common.hpp"
+
+namespace LinuxShmTopicTest
+{
+namespace
+{
+constexpr uint32_t WAIT_PUBLISH_COUNT = 64;
+
+constexpr LibXR::LinuxSharedWaitStrategy WAIT_STRATEGIES[] = {
+    LibXR::LinuxSharedWaitStrategy::FUTEX,
+    LibXR::LinuxSharedWaitStrategy::SPIN_THEN_FUTEX,
+    LibXR::LinuxSharedWaitStrategy::BUSY_POLL,
+};
+
+/**
+ * @brief 辅助函数 `MakeWaitConfig`。 Helper function `MakeWaitConfig`.
+ * @details 测试内容：构造指定等待方式的共享 Topic 配置。 Build one shared-topic config
+ * with the given wait strategy. 测试原理：较小的自旋次数让自旋后休眠路径也会被走到。 A
+ * small spin count makes the spin-then-sleep path reachable as well.
+ */
+LibXR::LinuxSharedTopicConfig MakeWaitConfig(LibXR::LinuxSharedWaitStrategy strategy)
+{
+  LibXR::LinuxSharedTopicConfig config;
+  config.slot_num = 8;
+  config.subscriber_num = 2;
+  config.queue_num = 8;
+  config.wait_strategy = strategy;
+  config.spin_count = 256;
+  return config;
+}
+
+/**
+ * @brief 测试项函数 `TestWaitStrategyDelivery`。 Test-item function
+ * `TestWaitStrategyDelivery`.
+ * @details 测试内容：验证每种等待方式下跨进程消息按序送达。 Verify in-order cross-process
+ * delivery under every wait strategy.
+ *          测试原理：发布者间歇停顿，使订阅者交替处于自旋和休眠状态；跳过唤醒的优化若有竞态，
+ * 订阅者会超时。 The publisher pauses intermittently so the subscriber alternates between
+ * spinning and sleeping; a race in the skipped-wake path would make it time out.
+ */
+void TestWaitStrategyDelivery()
+{
+  for (const auto strategy : WAIT_STRATEGIES)
+  {
+    char topic_name[96] = {};
+    MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_wait_delivery");
+    UNUSED(SharedTopic::Remove(topic_name));
+
+    {
+      SharedTopic publisher(topic_name, MakeWaitConfig(strategy));
+      ASSERT(publisher.Valid());
+      ASSERT(publisher.GetWaitStrategy() == strategy);
+
+      SharedTopic attached(topic_name);
+      ASSERT(attached.Valid());
+      ASSERT(attached.GetWaitStrategy() == strategy);
+
+      pid_t child = fork();
+      ASSERT(child >= 0);
+
+      if (child == 0)
+      {
+        SharedSubscriber subscriber(topic_name);
+        if (!subscriber.Valid())
+        {
+          _exit(2);
+        }
+
+        for (uint32_t seq = 1; seq <= WAIT_PUBLISH_COUNT; ++seq)
+        {
+          SharedData data;
+          if (subscriber.Wait(data, LONG_WAIT_MS) != LibXR::ErrorCode::OK)
+          {
+            _exit(3);
+          }
+          if (data.GetData()->seq != seq ||
+              data.GetData()->checksum != ComputeChecksum(*data.GetData()))
+          {
+            _exit(4);
+          }
+        }
+        _exit(0);
+      }
+
+      WaitForSubscriberNum(publisher, 1);
+
+      for (uint32_t seq = 1; seq <= WAIT_PUBLISH_COUNT; ++seq)
+      {
+        IPCFrame frame;
+        FillFrame(frame, seq);
+        while (publisher.Publish(frame) != LibXR::ErrorCode::OK)
+        {
+          usleep(100);
+        }
+        if ((seq % 8U) == 0)
+        {
+          usleep(2000);
+        }
+      }
+
+      ExpectChildExit(child);
+    }
+    UNUSED(SharedTopic::Remove(topic_name));
+  }
+}
+
+/**
+ * @brief 测试项函数 `TestWaitStrategyTimeout`。 Test-item function
+ * `TestWaitStrategyTimeout`.
+ * @details 测试内容：验证每种等待方式在空闲时按时返回超时。 Verify every wait strategy
+ * times out on schedule while idle.
+ *          测试原理：忙轮询不进入内核，只能靠周期性检查截止时间退出。 Busy polling never
+ * enters the kernel and can only leave by checking the deadline periodically.
+ */
+void TestWaitStrategyTimeout()
+{
+  for (const auto strategy : WAIT_STRATEGIES)
+  {
+    char topic_name[96] = {};
+    MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_wait_timeout");
+    UNUSED(SharedTopic::Remove(topic_name));
+
+    {
+      SharedTopic publisher(topic_name, MakeWaitConfig(strategy));
+      ASSERT(publisher.Valid());
+      SharedSubscriber subscriber(publisher);
+      ASSERT(subscriber.Valid());
+
+      SharedData data;
+      const LibXR::MillisecondTimestamp start = LibXR::Timebase::GetMilliseconds();
+      ASSERT(subscriber.Wait(data, 20) == LibXR::ErrorCode::TIMEOUT);
+      const uint32_t elapsed_ms =
+          (LibXR::Timebase::GetMilliseconds() - start).ToMillisecond();
+      ASSERT(elapsed_ms >= 19);
+      ASSERT(elapsed_ms < LONG_WAIT_MS);
+    }
+    UNUSED(SharedTopic::Remove(topic_name));
+  }
+
+  char topic_name[96] = {};
+  MakeTopicName(topic_name, sizeof(topic_name), "linux_shm_wait_invalid");
+  UNUSED(SharedTopic::Remove(topic_name));
+  {
+    LibXR::LinuxSharedTopicConfig config =
+        MakeWaitConfig(LibXR::LinuxSharedWaitStrategy::FUTEX);
+    config.wait_strategy = static_cast<LibXR::LinuxSharedWaitStrategy>(7);
+    SharedTopic publisher(topic_name, config);
+    ASSERT(!publisher.Valid());
+    ASSERT(publisher.GetError() == LibXR::ErrorCode::ARG_ERR);
+  }
+  UNUSED(SharedTopic::Remove(topic_name));
+}
+}  // namespace
+
+/**
+ * @brief 测试项函数 `RunWaitStrategyScenarios`。 Test-item function
+ * `RunWaitStrategyScenarios`.
+ * @details 测试内容：执行等待方式的送达、超时和配置校验子场景。 Execute the
+ * wait-strategy delivery, timeout, and config-validation sub-scenarios.
+ *          测试原理：把等待路径的契约单独成组。 Group the wait-path contract separately.
+ */
+void RunWaitStrategyScenarios()
+{
+  TestWaitStrategyDelivery();
+  TestWaitStrategyTimeout();
+}
+}  // namespace LinuxShmTopicTest
@@ -0,0 +1,255 @@
+/**
+ * @file test_task_scheduler.cpp
+ * @brief runtime `TaskScheduler` 工作窃取调度测试。 Runtime `TaskScheduler`
+ * work-stealing scheduling tests.
+ *
+ * 测试项目 / Test items:
+ * 1. 双端队列语义。 Deque semantics: owner pops LIFO, thieves steal FIFO.
+ * 2. 任务执行与亲和提示。 Job execution and affinity: every submitted job runs once, and
+ * an idle hinted worker runs its own jobs.
+ * 3. 并行区间与嵌套。 Parallel ranges and nesting: `ParallelFor` covers every index
+ * exactly once, including when called from inside a job.
+ * 4. 回调提交与任务槽耗尽。 Callback submission and slot exhaustion.
+ *
+ * 测试原理 / Test principles:
+ * 1. 用计数和求和校验“恰好一次”，不依赖具体由哪个线程执行。
+ * Check "exactly once" through counters and sums, independent of which thread ran what.
+ */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "libxr.hpp"
+#include "libxr_def.hpp"
+#include "test.hpp"
+
+namespace
+{
+constexpr uint32_t WORKER_COUNT = 3;
+constexpr size_t TASK_CAPACITY = 64;
+
+struct CounterArg
+{
+  std::atomic<uint32_t>* done;
+  std::atomic<uint32_t>* wrong_worker;
+  uint32_t expected_worker;
+};
+
+struct RangeArg
+{
+  std::atomic<uint8_t>* hits;
+  std::atomic<uint64_t>* sum;
+};
+
+void MarkRange(RangeArg arg, size_t begin, size_t end)
+{
+  for (size_t index = begin; index < end; ++index)
+  {
+    arg.hits[index].fetch_add(1, std::memory_order_relaxed);
+    arg.sum->fetch_add(index, std::memory_order_relaxed);
+  }
+}
+
+bool WaitCount(const std::atomic<uint32_t>& counter, uint32_t expected)
+{
+  const uint32_t start_ms = LibXR::Thread::GetTime();
+  while (counter.load(std::memory_order_acquire) != expected)
+  {
+    if (LibXR::Thread::GetTime() - start_ms > 2000U)
+    {
+      return false;
+    }
+    LibXR::Thread::Sleep(1);
+  }
+  return true;
+}
+
+LibXR::TaskScheduler* GetScheduler()
+{
+  // 工作线程常驻，测试实例不能注册退出期析构。
+  // Workers are permanent, so the test instance must not register an exit-time
+  // destructor.
+  alignas(LibXR::TaskScheduler) static std::byte storage[sizeof(LibXR::TaskScheduler)];
+  static LibXR::TaskScheduler* scheduler = new (storage) LibXR::TaskScheduler(
+      WORKER_COUNT, TASK_CAPACITY, 1024, LibXR::Thread::Priority::REALTIME);
+  return scheduler;
+}
+}  // namespace
+
+/**
+ * @brief 测试入口函数 `test_task_scheduler`。 Test entry function `test_task_scheduler`.
+ * @details 测试内容：按本文件声明的测试项目顺序执行验证。 Execute the test items declared
+ * in this file in order.
+ */
+void test_task_scheduler()
+{
+  // 1. Deque semantics on a single thread.
+  {
+    LibXR::WorkStealingDeque<uint32_t*> deque(3);
+    uint32_t values[4] = {0, 1, 2, 3};
+    uint32_t* item = nullptr;
+
+    ASSERT(deque.MaxSize() == 4);
+    ASSERT(deque.Pop(item) == LibXR::ErrorCode::EMPTY);
+    ASSERT(deque.Steal(item) == LibXR::ErrorCode::EMPTY);
+    for (auto& value : values)
+    {
+      ASSERT(deque.Push(&value) == LibXR::ErrorCode::OK);
+    }
+    ASSERT(deque.Push(&values[0]) == LibXR::ErrorCode::FULL);
+    ASSERT(deque.Size() == 4);
+
+    ASSERT(deque.Steal(item) == LibXR::ErrorCode::OK && item == &values[0]);
+    ASSERT(deque.Pop(item) == LibXR::ErrorCode::OK && item == &values[3]);
+    ASSERT(deque.Steal(item) == LibXR::ErrorCode::OK && item == &values[1]);
+    ASSERT(deque.Pop(item) == LibXR::ErrorCode::OK && item == &values[2]);
+    ASSERT(deque.Pop(item) == LibXR::ErrorCode::EMPTY);
+    ASSERT(deque.Size() == 0);
+  }
+
+  LibXR::TaskScheduler* scheduler = GetScheduler();
+  ASSERT(scheduler->WorkerCount() == WORKER_COUNT);
+  ASSERT(scheduler->CurrentWorker() == LibXR::TaskScheduler::ANY_WORKER);
+
+  // 2. Plain jobs and affinity hints.
+  {
+    std::atomic<uint32_t> done = 0;
+    std::atomic<uint32_t> wrong_worker = 0;
+    auto job = LibXR::TaskScheduler::Job::Create(
+        [](bool, CounterArg arg, LibXR::TaskScheduler* owner)
+        {
+          if (arg.expected_worker != LibXR::TaskScheduler::ANY_WORKER &&
+              owner->CurrentWorker() != arg.expected_worker)
+          {
+            arg.wrong_worker->fetch_add(1, std::memory_order_relaxed);
+          }
+          arg.done->fetch_add(1, std::memory_order_release);
+        },
+        CounterArg{&done, &wrong_worker, LibXR::TaskScheduler::ANY_WORKER});
+
+    for (uint32_t round = 0; round < 200; ++round)
+    {
+      while (scheduler->Submit(job) != LibXR::ErrorCode::OK)
+      {
+        LibXR::Thread::Sleep(1);
+      }
+    }
+    ASSERT(WaitCount(done, 200));
+
+    // Submitted one at a time to an idle pool, a hinted job is always picked up by its
+    // own worker.
+    for (uint32_t worker = 0; worker < WORKER_COUNT; ++worker)
+    {
+      LibXR::Thread::Sleep(5);
+      auto pinned = LibXR::TaskScheduler::Job::Create(
+          [](bool, CounterArg arg, LibXR::TaskScheduler* owner)
+          {
+            if (owner->CurrentWorker() != arg.expected_worker)
+            {
+              arg.wrong_worker->fetch_add(1, std::memory_order_relaxed);
+            }
+            arg.done->fetch_add(1, std::memory_order_release);
+          },
+          CounterArg{&done, &wrong_worker, worker});
+      ASSERT(scheduler->Submit(pinned, worker) == LibXR::ErrorCode::OK);
+      ASSERT(WaitCount(done, 201 + worker));
+    }
+    ASSERT(wrong_worker.load(std::memory_order_relaxed) == 0);
+  }
+
+  // 3. ParallelFor from the test thread and nested inside a job.
+  {
+    constexpr size_t RANGE = 10000;
+    constexpr uint64_t EXPECTED_SUM = static_cast<uint64_t>(RANGE) * (RANGE - 1) / 2;
+    static std::atomic<uint8_t> hits[RANGE];
+    std::atomic<uint64_t> sum = 0;
+
+    for (size_t grain : {size_t{0}, size_t{7}, size_t{256}, RANGE * 2})
+    {
+      for (auto& hit : hits)
+      {
+        hit.store(0, std::memory_order_relaxed);
+      }
+      sum.store(0, std::memory_order_relaxed);
+      scheduler->ParallelFor(0, RANGE, grain, MarkRange, RangeArg{hits, &sum});
+      for (auto& hit : hits)
+      {
+        ASSERT(hit.load(std::memory_order_relaxed) == 1);
+      }
+      ASSERT(sum.load(std::memory_order_relaxed) == EXPECTED_SUM);
+    }
+    scheduler->ParallelFor(5, 5, 1, MarkRange, RangeArg{hits, &sum});
+    ASSERT(sum.load(std::memory_order_relaxed) == EXPECTED_SUM);
+
+    struct NestedArg
+    {
+      RangeArg range;
+      std::atomic<uint32_t>* done;
+    };
+    for (auto& hit : hits)
+    {
+      hit.store(0, std::memory_order_relaxed);
+    }
+    sum.store(0, std::memory_order_relaxed);
+    std::atomic<uint32_t> done = 0;
+    auto nested = LibXR::TaskScheduler::Job::Create(
+        [](bool, NestedArg arg, LibXR::TaskScheduler* owner)
+        {
+          owner->ParallelFor(0, RANGE, 64, MarkRange, arg.range);
+          arg.done->fetch_add(1, std::memory_order_release);
+        },
+        NestedArg{RangeArg{hits, &sum}, &done});
+    ASSERT(scheduler->Submit(nested) == LibXR::ErrorCode::OK);
+    ASSERT(WaitCount(done, 1));
+    for (auto& hit : hits)
+    {
+      ASSERT(hit.load(std::memory_order_relaxed) == 1);
+    }
+    ASSERT(sum.load(std::memory_order_relaxed) == EXPECTED_SUM);
+  }
+
+  // 4. Callback submission and task slot exhaustion.
+  {
+    std::atomic<uint32_t> done = 0;
+    std::atomic<uint32_t> release = 0;
+    struct BlockArg
+    {
+      std::atomic<uint32_t>* done;
+      std::atomic<uint32_t>* release;
+    };
+    auto blocker = LibXR::TaskScheduler::Job::Create(
+        [](bool, BlockArg arg, LibXR::TaskScheduler*)
+        {
+          while (arg.release->load(std::memory_order_acquire) == 0)
+          {
+            LibXR::Thread::Sleep(1);
+          }
+          arg.done->fetch_add(1, std::memory_order_release);
+        },
+        BlockArg{&done, &release});
+
+    while (scheduler->FreeTaskCount() != TASK_CAPACITY)
+    {
+      LibXR::Thread::Sleep(1);
+    }
+    // A running job has already given its slot back, so at most one extra job per
+    // worker is accepted before the pool runs dry.
+    uint32_t accepted = 0;
+    while (scheduler->SubmitFromCallback(blocker, false) == LibXR::ErrorCode::OK)
+    {
+      ++accepted;
+      ASSERT(accepted <= TASK_CAPACITY + WORKER_COUNT);
+    }
+    ASSERT(accepted >= TASK_CAPACITY);
+    ASSERT(scheduler->Submit(blocker) == LibXR::ErrorCode::FULL);
+    ASSERT(scheduler->FreeTaskCount() == 0);
+
+    release.store(1, std::memory_order_release);
+    ASSERT(WaitCount(done, accepted));
+    while (scheduler->FreeTaskCount() != TASK_CAPACITY)
+    {
+      LibXR::Thread::Sleep(1);
+    }
+  }
+}